@@ -46,6 +46,12 @@
 
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC 300
 
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC 100
+
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC 50
+
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE 8
+
 #define CHIP_CONFIG_ENABLE_FUNCT_ERROR_LOGGING 1
 
 #define CHIP_CONFIG_DATA_MANAGEMENT_CLIENT_EXPERIMENTAL 1
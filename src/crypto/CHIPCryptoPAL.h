@@ -28,8 +28,10 @@
 
 #if CHIP_CRYPTO_OPENSSL
 #include <openssl/ec.h>
+#include <openssl/evp.h>
 #include <openssl/sha.h>
 #elif CHIP_CRYPTO_MBEDTLS
+#include <mbedtls/ccm.h>
 #include <mbedtls/ecp.h>
 #include <mbedtls/md.h>
 #include <mbedtls/sha256.h>
@@ -47,6 +49,7 @@ const size_t kMax_ECDSA_Signature_Length = 72;
 const size_t kMAX_FE_Length              = kP256_FE_Length;
 const size_t kMAX_Point_Length           = kP256_Point_Length;
 const size_t kMAX_Hash_Length            = kSHA256_Hash_Length;
+const size_t kMax_AES_Key_Length         = 32;
 
 /**
  * Spake2+ parameters for P256
@@ -128,6 +131,68 @@ CHIP_ERROR AES_CCM_decrypt(const unsigned char * ciphertext, size_t ciphertext_l
                            const unsigned char * tag, size_t tag_length, const unsigned char * key, size_t key_length,
                            const unsigned char * iv, size_t iv_length, unsigned char * plaintext);
 
+/**
+ * @brief A class that holds an AES-CCM key together with the cipher state derived from it
+ *
+ * AES_CCM_encrypt and AES_CCM_decrypt set up a cipher and expand the key schedule on every call. An AES_CCM_context is keyed
+ * once and then reused, which is cheaper when many messages are protected with the same key, as in a secure session.
+ * Arguments to Encrypt and Decrypt have the same meaning as those of AES_CCM_encrypt and AES_CCM_decrypt.
+ **/
+class AES_CCM_context
+{
+public:
+    AES_CCM_context(void);
+    ~AES_CCM_context(void);
+
+    /**
+     * @brief Set the key used by subsequent Encrypt and Decrypt calls, replacing any previous key
+     * @param key Encryption key
+     * @param key_length Length of encryption key (in bytes)
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR SetKey(const unsigned char * key, size_t key_length);
+
+    CHIP_ERROR Encrypt(const unsigned char * plaintext, size_t plaintext_length, const unsigned char * aad, size_t aad_length,
+                       const unsigned char * iv, size_t iv_length, unsigned char * ciphertext, unsigned char * tag,
+                       size_t tag_length);
+
+    CHIP_ERROR Decrypt(const unsigned char * ciphertext, size_t ciphertext_length, const unsigned char * aad, size_t aad_length,
+                       const unsigned char * tag, size_t tag_length, const unsigned char * iv, size_t iv_length,
+                       unsigned char * plaintext);
+
+    /**
+     * @brief Erase the key and release the cipher state. The context must be keyed again before further use.
+     **/
+    void Clear(void);
+
+    bool IsKeySet(void) const { return mKeyLength != 0; }
+
+private:
+    // Not defined
+    AES_CCM_context(const AES_CCM_context &);
+    AES_CCM_context & operator=(const AES_CCM_context &);
+
+    size_t mKeyLength;
+#if CHIP_CRYPTO_OPENSSL
+    // The CCM nonce and tag lengths are fixed when an OpenSSL cipher context is keyed, so each direction keeps the lengths it was
+    // last keyed for and is only keyed again (from mKey) when a call uses different ones.
+    CHIP_ERROR PrepareContext(EVP_CIPHER_CTX * context, int encrypt, size_t iv_length, size_t tag_length, size_t * keyed_iv_length,
+                              size_t * keyed_tag_length);
+
+    unsigned char mKey[kMax_AES_Key_Length];
+    EVP_CIPHER_CTX * mEncryptContext;
+    EVP_CIPHER_CTX * mDecryptContext;
+    size_t mEncryptIVLength;
+    size_t mEncryptTagLength;
+    size_t mDecryptIVLength;
+    size_t mDecryptTagLength;
+#elif CHIP_CRYPTO_MBEDTLS
+    mbedtls_ccm_context context;
+#else
+    AES_CCM_CTX_PLATFORM context; // To be defined by the platform specific implementation of AES-CCM.
+#endif
+};
+
 /**
  * @brief A function that implements SHA-256 hash
  * @param data The data to hash
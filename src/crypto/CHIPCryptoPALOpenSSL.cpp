@@ -262,6 +262,201 @@ exit:
     return error;
 }
 
+AES_CCM_context::AES_CCM_context(void) :
+    mKeyLength(0), mEncryptContext(NULL), mDecryptContext(NULL), mEncryptIVLength(0), mEncryptTagLength(0), mDecryptIVLength(0),
+    mDecryptTagLength(0)
+{}
+
+AES_CCM_context::~AES_CCM_context(void)
+{
+    Clear();
+}
+
+CHIP_ERROR AES_CCM_context::SetKey(const unsigned char * key, size_t key_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    Clear();
+
+    VerifyOrExit(key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidKeyLength(key_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    mEncryptContext = EVP_CIPHER_CTX_new();
+    VerifyOrExit(mEncryptContext != NULL, error = CHIP_ERROR_NO_MEMORY);
+
+    mDecryptContext = EVP_CIPHER_CTX_new();
+    VerifyOrExit(mDecryptContext != NULL, error = CHIP_ERROR_NO_MEMORY);
+
+    memcpy(mKey, key, key_length);
+    mKeyLength = key_length;
+
+exit:
+    if (error != CHIP_NO_ERROR)
+    {
+        Clear();
+    }
+    return error;
+}
+
+CHIP_ERROR AES_CCM_context::PrepareContext(EVP_CIPHER_CTX * context, int encrypt, size_t iv_length, size_t tag_length,
+                                           size_t * keyed_iv_length, size_t * keyed_tag_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 1;
+
+    if (*keyed_iv_length != iv_length || *keyed_tag_length != tag_length)
+    {
+        // 16 bytes key for AES-CCM-128
+        const EVP_CIPHER * type = (mKeyLength == 16) ? EVP_aes_128_ccm() : EVP_aes_256_ccm();
+
+        *keyed_iv_length  = 0;
+        *keyed_tag_length = 0;
+
+        // Pass in cipher
+        result = EVP_CipherInit_ex(context, type, NULL, NULL, NULL, encrypt);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        // Pass in IV length
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_IVLEN, iv_length, NULL);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        // Pass in tag length
+        result = EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_CCM_SET_TAG, tag_length, NULL);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        // Pass in key, which expands the key schedule
+        result = EVP_CipherInit_ex(context, NULL, NULL, mKey, NULL, encrypt);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+        *keyed_iv_length  = iv_length;
+        *keyed_tag_length = tag_length;
+    }
+
+exit:
+    return error;
+}
+
+CHIP_ERROR AES_CCM_context::Encrypt(const unsigned char * plaintext, size_t plaintext_length, const unsigned char * aad,
+                                    size_t aad_length, const unsigned char * iv, size_t iv_length, unsigned char * ciphertext,
+                                    unsigned char * tag, size_t tag_length)
+{
+    int bytesWritten         = 0;
+    size_t ciphertext_length = 0;
+    CHIP_ERROR error         = CHIP_NO_ERROR;
+    int result               = 1;
+
+    VerifyOrExit(IsKeySet(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(plaintext != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(plaintext_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(tag != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidTagLength(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    error = PrepareContext(mEncryptContext, 1, iv_length, tag_length, &mEncryptIVLength, &mEncryptTagLength);
+    SuccessOrExit(error);
+
+    // Pass in iv, reusing the key schedule
+    result = EVP_EncryptInit_ex(mEncryptContext, NULL, NULL, NULL, iv);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in plain text length
+    result = EVP_EncryptUpdate(mEncryptContext, NULL, &bytesWritten, NULL, plaintext_length);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in AAD
+    if (aad_length > 0 && aad != NULL)
+    {
+        result = EVP_EncryptUpdate(mEncryptContext, NULL, &bytesWritten, aad, aad_length);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    }
+
+    // Encrypt
+    result = EVP_EncryptUpdate(mEncryptContext, ciphertext, &bytesWritten, plaintext, plaintext_length);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    ciphertext_length = bytesWritten;
+
+    // Finalize encryption
+    result = EVP_EncryptFinal_ex(mEncryptContext, ciphertext + ciphertext_length, &bytesWritten);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    ciphertext_length += bytesWritten;
+
+    // Get tag
+    result = EVP_CIPHER_CTX_ctrl(mEncryptContext, EVP_CTRL_CCM_GET_TAG, tag_length, tag);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    return error;
+}
+
+CHIP_ERROR AES_CCM_context::Decrypt(const unsigned char * ciphertext, size_t ciphertext_length, const unsigned char * aad,
+                                    size_t aad_length, const unsigned char * tag, size_t tag_length, const unsigned char * iv,
+                                    size_t iv_length, unsigned char * plaintext)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int bytesOutput  = 0;
+    int result       = 1;
+
+    VerifyOrExit(IsKeySet(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(ciphertext != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(ciphertext_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(tag != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidTagLength(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    error = PrepareContext(mDecryptContext, 0, iv_length, tag_length, &mDecryptIVLength, &mDecryptTagLength);
+    SuccessOrExit(error);
+
+    // Pass in expected tag
+    result = EVP_CIPHER_CTX_ctrl(mDecryptContext, EVP_CTRL_CCM_SET_TAG, tag_length, (void *) tag);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in iv, reusing the key schedule
+    result = EVP_DecryptInit_ex(mDecryptContext, NULL, NULL, NULL, iv);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in cipher text length
+    result = EVP_DecryptUpdate(mDecryptContext, NULL, &bytesOutput, NULL, ciphertext_length);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+    // Pass in aad
+    if (aad_length > 0 && aad != NULL)
+    {
+        result = EVP_DecryptUpdate(mDecryptContext, NULL, &bytesOutput, aad, aad_length);
+        VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+    }
+
+    // Pass in ciphertext. We wont get anything if validation fails.
+    result = EVP_DecryptUpdate(mDecryptContext, plaintext, &bytesOutput, ciphertext, ciphertext_length);
+    VerifyOrExit(result == 1, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    return error;
+}
+
+void AES_CCM_context::Clear(void)
+{
+    if (mEncryptContext != NULL)
+    {
+        EVP_CIPHER_CTX_free(mEncryptContext);
+        mEncryptContext = NULL;
+    }
+
+    if (mDecryptContext != NULL)
+    {
+        EVP_CIPHER_CTX_free(mDecryptContext);
+        mDecryptContext = NULL;
+    }
+
+    OPENSSL_cleanse(mKey, sizeof(mKey));
+    mKeyLength        = 0;
+    mEncryptIVLength  = 0;
+    mEncryptTagLength = 0;
+    mDecryptIVLength  = 0;
+    mDecryptTagLength = 0;
+}
+
 CHIP_ERROR Hash_SHA256(const unsigned char * data, const size_t data_length, unsigned char * out_buffer)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
@@ -159,6 +159,103 @@ exit:
     return error;
 }
 
+AES_CCM_context::AES_CCM_context(void) : mKeyLength(0)
+{
+    mbedtls_ccm_init(&context);
+}
+
+AES_CCM_context::~AES_CCM_context(void)
+{
+    Clear();
+}
+
+CHIP_ERROR AES_CCM_context::SetKey(const unsigned char * key, size_t key_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 1;
+
+    Clear();
+
+    VerifyOrExit(key != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidKeyLength(key_length), error = CHIP_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
+
+    // Size of key = key_length * number of bits in a byte (8)
+    result = mbedtls_ccm_setkey(&context, MBEDTLS_CIPHER_ID_AES, key, key_length * 8);
+    _log_mbedTLS_error(result);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+    mKeyLength = key_length;
+
+exit:
+    return error;
+}
+
+CHIP_ERROR AES_CCM_context::Encrypt(const unsigned char * plaintext, size_t plaintext_length, const unsigned char * aad,
+                                    size_t aad_length, const unsigned char * iv, size_t iv_length, unsigned char * ciphertext,
+                                    unsigned char * tag, size_t tag_length)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 1;
+
+    VerifyOrExit(IsKeySet(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(plaintext != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(plaintext_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(tag != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidTagLength(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+    if (aad_length > 0)
+    {
+        VerifyOrExit(aad != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    // Encrypt
+    result = mbedtls_ccm_encrypt_and_tag(&context, plaintext_length, iv, iv_length, aad, aad_length, plaintext, ciphertext, tag,
+                                         tag_length);
+    _log_mbedTLS_error(result);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    return error;
+}
+
+CHIP_ERROR AES_CCM_context::Decrypt(const unsigned char * ciphertext, size_t ciphertext_length, const unsigned char * aad,
+                                    size_t aad_length, const unsigned char * tag, size_t tag_length, const unsigned char * iv,
+                                    size_t iv_length, unsigned char * plaintext)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    int result       = 1;
+
+    VerifyOrExit(IsKeySet(), error = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(ciphertext != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(ciphertext_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(tag != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(_isValidTagLength(tag_length), error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(iv_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+    if (aad_length > 0)
+    {
+        VerifyOrExit(aad != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    // Decrypt
+    result = mbedtls_ccm_auth_decrypt(&context, ciphertext_length, iv, iv_length, aad, aad_length, ciphertext, plaintext, tag,
+                                      tag_length);
+    _log_mbedTLS_error(result);
+    VerifyOrExit(result == 0, error = CHIP_ERROR_INTERNAL);
+
+exit:
+    return error;
+}
+
+void AES_CCM_context::Clear(void)
+{
+    // mbedtls_ccm_free() zeroes the context, including the expanded key.
+    mbedtls_ccm_free(&context);
+    mbedtls_ccm_init(&context);
+    mKeyLength = 0;
+}
+
 CHIP_ERROR Hash_SHA256(const unsigned char * data, const size_t data_length, unsigned char * out_buffer)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
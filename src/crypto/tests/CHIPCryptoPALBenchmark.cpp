@@ -0,0 +1,202 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark comparing AES-CCM throughput when
+ *      the cipher is set up on every call (AES_CCM_encrypt/AES_CCM_decrypt)
+ *      against a keyed AES_CCM_context reused across messages.
+ *
+ *      Timings are only reported; the assertions verify that both paths
+ *      produce the same ciphertext and tag, and that every message round trips.
+ */
+
+#include "TestCryptoLayer.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <support/BenchmarkUtils.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+#include <support/logging/CHIPLogging.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Crypto;
+
+constexpr size_t kIterations       = 1000;
+constexpr size_t kKeyLength        = 16;
+constexpr size_t kMaxPayloadLength = 1024;
+constexpr size_t kIVLength         = 13;
+constexpr size_t kTagLength        = 16;
+
+const size_t kPayloadLengths[] = { 64, 128, 256, 512, 1024 };
+
+const unsigned char kKey[kKeyLength] = { 0x5e, 0xde, 0xd2, 0x44, 0xe5, 0x53, 0x2b, 0x3a,
+                                         0x9c, 0x6e, 0x73, 0x61, 0x87, 0x4a, 0xcb, 0xf2 };
+
+// Megabytes per second when each message of the given length costs nsPerOp.
+uint64_t Throughput(size_t length, uint64_t nsPerOp)
+{
+    return (nsPerOp == 0) ? 0 : (length * 1000) / nsPerOp;
+}
+
+// Each message uses a distinct nonce, as SecureSession does with the message id.
+void NonceForMessage(size_t index, unsigned char * iv)
+{
+    memset(iv, 0, kIVLength);
+    iv[kIVLength - 4] = static_cast<unsigned char>(index >> 24);
+    iv[kIVLength - 3] = static_cast<unsigned char>(index >> 16);
+    iv[kIVLength - 2] = static_cast<unsigned char>(index >> 8);
+    iv[kIVLength - 1] = static_cast<unsigned char>(index);
+}
+
+void BenchmarkPayloadLength(nlTestSuite * inSuite, AES_CCM_context & context, size_t length)
+{
+    unsigned char plaintext[kMaxPayloadLength];
+    unsigned char ciphertext[kMaxPayloadLength];
+    unsigned char cached[kMaxPayloadLength];
+    unsigned char decrypted[kMaxPayloadLength];
+    unsigned char tag[kTagLength];
+    unsigned char cachedTag[kTagLength];
+    unsigned char iv[kIVLength];
+    uint64_t start, perCallEncryptNs, perCallDecryptNs, cachedEncryptNs, cachedDecryptNs;
+    size_t failures;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        plaintext[i] = static_cast<unsigned char>(i * 7 + 1);
+    }
+
+    // Both paths must agree before their timings mean anything
+    NonceForMessage(0, iv);
+    NL_TEST_ASSERT(inSuite,
+                   AES_CCM_encrypt(plaintext, length, NULL, 0, kKey, sizeof(kKey), iv, sizeof(iv), ciphertext, tag, sizeof(tag)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   context.Encrypt(plaintext, length, NULL, 0, iv, sizeof(iv), cached, cachedTag, sizeof(cachedTag)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(ciphertext, cached, length) == 0);
+    NL_TEST_ASSERT(inSuite, memcmp(tag, cachedTag, sizeof(tag)) == 0);
+
+    failures = 0;
+    start    = Benchmark::NowNs();
+    for (size_t i = 0; i < kIterations; i++)
+    {
+        NonceForMessage(i, iv);
+        if (AES_CCM_encrypt(plaintext, length, NULL, 0, kKey, sizeof(kKey), iv, sizeof(iv), ciphertext, tag, sizeof(tag)) !=
+            CHIP_NO_ERROR)
+        {
+            failures++;
+        }
+    }
+    perCallEncryptNs = Benchmark::NanosecondsPerOp(start, kIterations);
+    NL_TEST_ASSERT(inSuite, failures == 0);
+
+    failures = 0;
+    start    = Benchmark::NowNs();
+    for (size_t i = 0; i < kIterations; i++)
+    {
+        if (AES_CCM_decrypt(ciphertext, length, NULL, 0, tag, sizeof(tag), kKey, sizeof(kKey), iv, sizeof(iv), decrypted) !=
+            CHIP_NO_ERROR)
+        {
+            failures++;
+        }
+    }
+    perCallDecryptNs = Benchmark::NanosecondsPerOp(start, kIterations);
+    NL_TEST_ASSERT(inSuite, failures == 0);
+    NL_TEST_ASSERT(inSuite, memcmp(plaintext, decrypted, length) == 0);
+
+    failures = 0;
+    start    = Benchmark::NowNs();
+    for (size_t i = 0; i < kIterations; i++)
+    {
+        NonceForMessage(i, iv);
+        if (context.Encrypt(plaintext, length, NULL, 0, iv, sizeof(iv), cached, cachedTag, sizeof(cachedTag)) != CHIP_NO_ERROR)
+        {
+            failures++;
+        }
+    }
+    cachedEncryptNs = Benchmark::NanosecondsPerOp(start, kIterations);
+    NL_TEST_ASSERT(inSuite, failures == 0);
+    NL_TEST_ASSERT(inSuite, memcmp(ciphertext, cached, length) == 0);
+    NL_TEST_ASSERT(inSuite, memcmp(tag, cachedTag, sizeof(tag)) == 0);
+
+    memset(decrypted, 0, sizeof(decrypted));
+    failures = 0;
+    start    = Benchmark::NowNs();
+    for (size_t i = 0; i < kIterations; i++)
+    {
+        if (context.Decrypt(cached, length, NULL, 0, cachedTag, sizeof(cachedTag), iv, sizeof(iv), decrypted) != CHIP_NO_ERROR)
+        {
+            failures++;
+        }
+    }
+    cachedDecryptNs = Benchmark::NanosecondsPerOp(start, kIterations);
+    NL_TEST_ASSERT(inSuite, failures == 0);
+    NL_TEST_ASSERT(inSuite, memcmp(plaintext, decrypted, length) == 0);
+
+    ChipLogProgress(Crypto,
+                    "%4u bytes: per call encrypt %" PRIu64 " ns (%" PRIu64 " MB/s), decrypt %" PRIu64 " ns | cached encrypt %" PRIu64
+                    " ns (%" PRIu64 " MB/s), decrypt %" PRIu64 " ns",
+                    static_cast<unsigned>(length), perCallEncryptNs, Throughput(length, perCallEncryptNs), perCallDecryptNs,
+                    cachedEncryptNs, Throughput(length, cachedEncryptNs), cachedDecryptNs);
+}
+
+void TestAES_CCM_128Throughput(nlTestSuite * inSuite, void * inContext)
+{
+    AES_CCM_context context;
+
+    NL_TEST_ASSERT(inSuite, context.SetKey(kKey, sizeof(kKey)) == CHIP_NO_ERROR);
+    VerifyOrExit(context.IsKeySet(), );
+
+    for (size_t i = 0; i < ArraySize(kPayloadLengths); i++)
+    {
+        BenchmarkPayloadLength(inSuite, context, kPayloadLengths[i]);
+    }
+
+exit:
+    return;
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("AES_CCM_128Throughput", TestAES_CCM_128Throughput),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestCHIPCryptoPALBenchmark(void)
+{
+    nlTestSuite theSuite = { "CHIP Crypto PAL benchmark", &sTests[0], NULL, NULL };
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
+
+static void __attribute__((constructor)) TestCHIPCryptoPALBenchmarkCtor(void)
+{
+    VerifyOrDie(RegisterUnitTests(&TestCHIPCryptoPALBenchmark) == CHIP_NO_ERROR);
+}
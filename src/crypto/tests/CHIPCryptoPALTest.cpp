@@ -352,6 +352,88 @@ static void TestAES_CCM_128DecryptTestVectors(nlTestSuite * inSuite, void * inCo
     NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
 }
 
+static void TestAES_CCM_128ContextTestVectors(nlTestSuite * inSuite, void * inContext)
+{
+    // A single context is re-keyed for every vector, and reused to decrypt what it encrypted
+    AES_CCM_context context;
+    int numOfTestVectors = ArraySize(ccm_128_test_vectors);
+    int numOfTestsRan    = 0;
+    for (int vectorIndex = 0; vectorIndex < numOfTestVectors; vectorIndex++)
+    {
+        const ccm_128_test_vector * vector = ccm_128_test_vectors[vectorIndex];
+        if (vector->pt_len > 0 && vector->result == CHIP_NO_ERROR)
+        {
+            numOfTestsRan++;
+            unsigned char out_ct[vector->ct_len];
+            unsigned char out_tag[vector->tag_len];
+            unsigned char out_pt[vector->pt_len];
+
+            CHIP_ERROR err = context.SetKey(vector->key, vector->key_len);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+            err = context.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->iv, vector->iv_len, out_ct,
+                                  out_tag, vector->tag_len);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, memcmp(out_ct, vector->ct, vector->ct_len) == 0);
+            NL_TEST_ASSERT(inSuite, memcmp(out_tag, vector->tag, vector->tag_len) == 0);
+
+            err = context.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                  vector->iv, vector->iv_len, out_pt);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, memcmp(out_pt, vector->pt, vector->pt_len) == 0);
+
+            // Decrypting in place must give the same result
+            memcpy(out_pt, vector->ct, vector->ct_len);
+            err = context.Decrypt(out_pt, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len, vector->iv,
+                                  vector->iv_len, out_pt);
+            NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, memcmp(out_pt, vector->pt, vector->pt_len) == 0);
+        }
+    }
+    NL_TEST_ASSERT(inSuite, numOfTestsRan > 0);
+}
+
+static void TestAES_CCM_128ContextInvalidUse(nlTestSuite * inSuite, void * inContext)
+{
+    AES_CCM_context context;
+    const ccm_128_test_vector * vector = ccm_128_test_vectors[0];
+    unsigned char out_ct[vector->ct_len];
+    unsigned char out_tag[vector->tag_len];
+
+    NL_TEST_ASSERT(inSuite, !context.IsKeySet());
+    NL_TEST_ASSERT(inSuite,
+                   context.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->iv, vector->iv_len, out_ct,
+                                   out_tag, vector->tag_len) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, context.SetKey(NULL, vector->key_len) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, context.SetKey(vector->key, 0) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !context.IsKeySet());
+
+    NL_TEST_ASSERT(inSuite, context.SetKey(vector->key, vector->key_len) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, context.IsKeySet());
+    NL_TEST_ASSERT(inSuite,
+                   context.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->iv, 0, out_ct, out_tag,
+                                   vector->tag_len) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite,
+                   context.Encrypt(vector->pt, vector->pt_len, vector->aad, vector->aad_len, vector->iv, vector->iv_len, out_ct,
+                                   out_tag, 0) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    // A tampered tag fails authentication without spoiling the context for the next message
+    memcpy(out_tag, vector->tag, vector->tag_len);
+    out_tag[0] ^= 0x01;
+    NL_TEST_ASSERT(inSuite,
+                   context.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, out_tag, vector->tag_len, vector->iv,
+                                   vector->iv_len, out_ct) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   context.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                   vector->iv, vector->iv_len, out_ct) == CHIP_NO_ERROR);
+
+    context.Clear();
+    NL_TEST_ASSERT(inSuite, !context.IsKeySet());
+    NL_TEST_ASSERT(inSuite,
+                   context.Decrypt(vector->ct, vector->ct_len, vector->aad, vector->aad_len, vector->tag, vector->tag_len,
+                                   vector->iv, vector->iv_len, out_ct) == CHIP_ERROR_INCORRECT_STATE);
+}
+
 static void TestAES_CCM_128EncryptInvalidPlainText(nlTestSuite * inSuite, void * inContext)
 {
     int numOfTestVectors = ArraySize(ccm_128_test_vectors);
@@ -1309,6 +1391,8 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test decrypting AES-CCM-128 invalid ct", TestAES_CCM_128DecryptInvalidCipherText),
     NL_TEST_DEF("Test decrypting AES-CCM-128 invalid key", TestAES_CCM_128DecryptInvalidKey),
     NL_TEST_DEF("Test decrypting AES-CCM-128 invalid IV", TestAES_CCM_128DecryptInvalidIVLen),
+    NL_TEST_DEF("Test AES-CCM-128 context using test vectors", TestAES_CCM_128ContextTestVectors),
+    NL_TEST_DEF("Test AES-CCM-128 context invalid use", TestAES_CCM_128ContextInvalidUse),
     NL_TEST_DEF("Test encrypting AES-CCM-256 test vectors", TestAES_CCM_256EncryptTestVectors),
     NL_TEST_DEF("Test decrypting AES-CCM-256 test vectors", TestAES_CCM_256DecryptTestVectors),
     NL_TEST_DEF("Test encrypting AES-CCM-256 invalid plain text", TestAES_CCM_256EncryptInvalidPlainText),
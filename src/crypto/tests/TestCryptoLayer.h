@@ -30,6 +30,7 @@ extern "C" {
 #endif
 
 int TestCHIPCryptoPAL(void);
+int TestCHIPCryptoPALBenchmark(void);
 
 #ifdef __cplusplus
 }
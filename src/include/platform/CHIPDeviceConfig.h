@@ -83,6 +83,10 @@
  * CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE
  *
  * The maximum number of events that can be held in the chip Platform event queue.
+ *
+ * Events are posted without blocking, so an event posted while the queue is full is dropped and an
+ * error is logged. Size the queue for the largest burst of events that can be posted before the chip
+ * task next runs, e.g. while it holds the chip stack lock.
  */
 #ifndef CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE
 #define CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE 100
@@ -31,11 +31,13 @@
 #include <sched.h>
 #include <sys/select.h>
 #include <sys/time.h>
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 #include <unistd.h>
 
 #include <atomic>
 #include <pthread.h>
-#include <queue>
 
 namespace chip {
 namespace DeviceLayer {
@@ -60,9 +62,25 @@ protected:
     fd_set mErrorSet;
     struct timeval mNextTimeout;
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    // Members for epoll loop
+    struct epoll_event mEpollEvents[CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS];
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
     // OS-specific members (pthread)
     pthread_mutex_t mChipStackLock;
-    std::queue<ChipDeviceEvent> mChipEventQueue;
+
+    // Bounded multi-producer/single-consumer ring of pending device events. Any thread may post
+    // without taking mChipStackLock; only the CHIP thread removes events. Each slot carries a
+    // sequence number that tells producers and the consumer whose turn it is to use the slot.
+    struct ChipEventQueueSlot
+    {
+        std::atomic<size_t> Sequence;
+        ChipDeviceEvent Event;
+    };
+    ChipEventQueueSlot mChipEventQueue[CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE];
+    std::atomic<size_t> mChipEventQueueTail; // Next position to be claimed by a producer.
+    size_t mChipEventQueueHead;              // Next position to be dispatched; CHIP thread only.
 
     pthread_t mChipTask;
     pthread_attr_t mChipTaskAttr;
@@ -92,6 +110,7 @@ private:
     void SysProcess();
     static void SysOnEventSignal(void * arg);
 
+    void InitDeviceEventQueue();
     void ProcessDeviceEvents();
 
     std::atomic<bool> mShouldRunEventLoop;
@@ -33,6 +33,7 @@
 #include <platform/internal/GenericPlatformManagerImpl.ipp>
 
 #include <system/SystemLayer.h>
+#include <system/SystemStats.h>
 
 #include <assert.h>
 #include <errno.h>
@@ -55,6 +56,8 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_InitChipStack(void)
 
     mChipStackLock = PTHREAD_MUTEX_INITIALIZER;
 
+    InitDeviceEventQueue();
+
     // Initialize the Configuration Manager object.
     err = ConfigurationMgr().Init();
     if (err != CHIP_NO_ERROR)
@@ -98,20 +101,90 @@ CHIP_ERROR GenericPlatformManagerImpl_POSIX<ImplClass>::_StartChipTimer(uint32_t
     return CHIP_NO_ERROR;
 }
 
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::InitDeviceEventQueue()
+{
+    for (size_t i = 0; i < CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE; i++)
+    {
+        mChipEventQueue[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+    mChipEventQueueTail.store(0, std::memory_order_relaxed);
+    mChipEventQueueHead = 0;
+}
+
+/**
+ *  Queue an event for dispatch on the chip task. May be called from any thread, and never blocks.
+ *
+ *  The queue holds CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE events. An event posted while it is full
+ *  is dropped, and an error is logged.
+ */
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::_PostEvent(const ChipDeviceEvent * event)
 {
-    mChipEventQueue.push(*event); // Thread safe due to ChipStackLock taken by App thread
-    SysOnEventSignal(this);       // Trigger wake select on CHIP thread
+    size_t pos = mChipEventQueueTail.load(std::memory_order_relaxed);
+    ChipEventQueueSlot * slot;
+
+    // Claim the slot at the tail. A slot is free for position pos once its sequence number has
+    // caught up with pos; if it still lags a full lap behind, the consumer has not yet taken
+    // the event posted there and the queue is full.
+    while (true)
+    {
+        slot            = &mChipEventQueue[pos % CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE];
+        size_t sequence = slot->Sequence.load(std::memory_order_acquire);
+
+        if (sequence == pos)
+        {
+            if (mChipEventQueueTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (sequence < pos)
+        {
+            ChipLogError(DeviceLayer, "CHIP Platform event queue full, dropping event type %d", event->Type);
+            return;
+        }
+        else
+        {
+            pos = mChipEventQueueTail.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->Event = *event;
+    slot->Sequence.store(pos + 1, std::memory_order_release);
+
+    SysOnEventSignal(this); // Trigger wake select on CHIP thread
 }
 
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::ProcessDeviceEvents()
 {
-    while (!mChipEventQueue.empty())
+    // Dispatch the events that were queued when the batch started. Events posted by the handlers
+    // themselves wake the event loop again and are dispatched on its next pass, so a handler
+    // that keeps posting cannot starve the sockets and timers.
+    size_t batchEnd = mChipEventQueueTail.load(std::memory_order_relaxed);
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    size_t depth = batchEnd - mChipEventQueueHead;
+    SYSTEM_STATS_SET(System::Stats::kPlatformMgr_NumDeviceEvents,
+                     static_cast<System::Stats::count_t>(depth < INT8_MAX ? depth : INT8_MAX));
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+    while (mChipEventQueueHead != batchEnd)
     {
-        Impl()->DispatchEvent(&mChipEventQueue.front());
-        mChipEventQueue.pop();
+        ChipEventQueueSlot & slot = mChipEventQueue[mChipEventQueueHead % CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE];
+
+        // A producer has claimed this position but not finished copying its event in yet.
+        if (slot.Sequence.load(std::memory_order_acquire) != mChipEventQueueHead + 1)
+        {
+            break;
+        }
+
+        Impl()->DispatchEvent(&slot.Event);
+
+        // Hand the slot back to producers for the next lap.
+        slot.Sequence.store(mChipEventQueueHead + CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE, std::memory_order_release);
+        mChipEventQueueHead++;
     }
 }
 
@@ -121,6 +194,55 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::SysOnEventSignal(void * arg)
     SystemLayer.WakeSelect();
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::SysUpdate()
+{
+    // Sockets and timers are kept registered in the epoll instance. Endpoints update their own sockets as their state
+    // changes, so only the timers are looked at here.
+    if (SystemLayer.State() == System::kLayerState_Initialized)
+    {
+        SystemLayer.PrepareEpoll();
+    }
+}
+
+template <class ImplClass>
+void GenericPlatformManagerImpl_POSIX<ImplClass>::SysProcess()
+{
+    int eventCount;
+    int waitErrno;
+
+    Impl()->UnlockChipStack();
+    eventCount = epoll_wait(SystemLayer.GetEpollFD(), mEpollEvents, CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS, -1);
+    waitErrno  = errno;
+    Impl()->LockChipStack();
+
+    if (eventCount < 0)
+    {
+        // A signal interrupting the wait is not an error; the event loop simply waits again.
+        if (waitErrno != EINTR)
+        {
+            ChipLogError(DeviceLayer, "epoll_wait failed: %s", ErrorStr(System::MapErrorPOSIX(waitErrno)));
+        }
+        return;
+    }
+
+    if (SystemLayer.State() == System::kLayerState_Initialized)
+    {
+        SystemLayer.HandleEpollResult(mEpollEvents, eventCount);
+    }
+
+    if (InetLayer.State == InetLayer::kState_Initialized)
+    {
+        InetLayer.HandleEpollResult(mEpollEvents, eventCount);
+    }
+
+    ProcessDeviceEvents();
+}
+
+#else // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::SysUpdate()
 {
@@ -181,6 +303,8 @@ void GenericPlatformManagerImpl_POSIX<ImplClass>::SysProcess()
     ProcessDeviceEvents();
 }
 
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 template <class ImplClass>
 void GenericPlatformManagerImpl_POSIX<ImplClass>::_RunEventLoop(void)
 {
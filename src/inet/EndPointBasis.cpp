@@ -41,8 +41,59 @@ void EndPointBasis::InitEndPointBasis(InetLayer & aInetLayer, void * aAppState)
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
     mSocket = INET_INVALID_SOCKET_FD;
     mPendingIO.Clear();
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    mWatchedSocket = INET_INVALID_SOCKET_FD;
+    mWatchedIO.Clear();
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+/**
+ *  Register the endpoint's socket with the system layer's epoll instance for \c aEvents, or remove it when there are none.
+ *
+ *  Endpoints call this, with the events returned by their PrepareIO() method, whenever those events may have changed: when
+ *  they start listening, connecting or sending, when receiving is enabled or disabled, and after handling I/O. It only costs
+ *  a system call when the events did change.
+ *
+ *  @param[in]    aEvents   The socket events to wait for.
+ *
+ *  @param[in]    aKind     The kind of endpoint, which becomes part of the epoll token together with the endpoint's pool index.
+ *
+ */
+void EndPointBasis::WatchIO(SocketEvents aEvents, uint32_t aKind)
+{
+    const bool lIsWatched = (mSocket != INET_INVALID_SOCKET_FD && mWatchedSocket == mSocket);
+
+    if (!aEvents.IsSet() || mSocket == INET_INVALID_SOCKET_FD)
+    {
+        // An idle socket is removed so that hang-ups, which epoll always reports, do not wake the event loop for nothing.
+        UnwatchIO();
+    }
+    else if (!lIsWatched || aEvents.Value != mWatchedIO.Value)
+    {
+        const uint64_t lToken = (static_cast<uint64_t>(aKind) << 32) | PoolIndex();
+
+        if (SystemLayer().WatchFD(mSocket, aEvents.ToEpollEvents(), lToken, lIsWatched) == CHIP_SYSTEM_NO_ERROR)
+        {
+            mWatchedSocket = mSocket;
+            mWatchedIO     = aEvents;
+        }
+    }
+}
+
+/**
+ *  Remove the endpoint's socket from the system layer's epoll instance. Endpoints call this before closing the socket.
+ */
+void EndPointBasis::UnwatchIO(void)
+{
+    if (mSocket != INET_INVALID_SOCKET_FD && mWatchedSocket == mSocket)
+        SystemLayer().UnwatchFD(mSocket);
+
+    mWatchedSocket = INET_INVALID_SOCKET_FD;
+    mWatchedIO.Clear();
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 } // namespace Inet
 } // namespace chip
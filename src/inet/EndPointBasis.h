@@ -100,7 +100,26 @@ protected:
     int mSocket;             /**< Encapsulated socket descriptor. */
     IPAddressType mAddrType; /**< Protocol family, i.e. IPv4 or IPv6. */
     SocketEvents mPendingIO; /**< Socket event masks */
-#endif                       // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    int mWatchedSocket;      /**< Socket descriptor registered with the system layer's epoll instance, if any. */
+    SocketEvents mWatchedIO; /**< Socket events the epoll instance watches for. */
+
+    /**
+     * Kinds of endpoint, which tell InetLayer::HandleEpollResult() which pool an epoll event belongs to. The epoll token holds
+     * the kind above the endpoint's pool index; kinds start at one so that tokens never collide with the system layer's.
+     */
+    enum
+    {
+        kEpollEndPoint_Raw = 1,
+        kEpollEndPoint_TCP = 2,
+        kEpollEndPoint_UDP = 3,
+        kEpollEndPoint_Tun = 4,
+    };
+
+    void WatchIO(SocketEvents aEvents, uint32_t aKind);
+    void UnwatchIO(void);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     /** Encapsulated LwIP protocol control block */
@@ -84,6 +84,10 @@
 #error                                                                                                                             \
     "Neither IPV6_DROP_MEMBERSHIP nor IPV6_LEAVE_GROUP are defined which are required for generalized IPv6 multicast group support."
 #endif // IPV6_DROP_MEMBERSHIP
+
+#if INET_CONFIG_ENABLE_UDP_BATCH_IO && !defined(__linux__)
+#error "INET_CONFIG_ENABLE_UDP_BATCH_IO requires recvmmsg() and sendmmsg(), which are only available on Linux."
+#endif // INET_CONFIG_ENABLE_UDP_BATCH_IO && !defined(__linux__)
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -106,6 +110,16 @@ union PeerSockAddr
     sockaddr_in in;
     sockaddr_in6 in6;
 };
+
+/*
+ * Storage for the address, data vector and control data a sendmsg()/recvmsg() message header points to.
+ */
+struct SocketMsgStorage
+{
+    PeerSockAddr peerSockAddr;
+    struct iovec msgIOV[INET_CONFIG_SEND_IOV_MAX];
+    uint8_t controlData[256];
+};
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -785,46 +799,50 @@ INET_ERROR IPEndPointBasis::BindInterface(IPAddressType aAddressType, InterfaceI
     return (lRetval);
 }
 
-INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System::PacketBuffer * aBuffer, uint16_t aSendFlags)
+/*
+ * Fills in a sendmsg() message header for the buffer chain aBuffer, with one data vector entry per
+ * buffer, addressed as described by aPktInfo. The header points into aStorage, which must outlive it.
+ */
+static INET_ERROR BuildSendMsgHeader(IPAddressType aAddrType, InterfaceId aBoundIntfId, const IPPacketInfo * aPktInfo,
+                                     PacketBuffer * aBuffer, SocketMsgStorage & aStorage, struct msghdr & aMsgHeader)
 {
-    INET_ERROR res = INET_NO_ERROR;
-    PeerSockAddr peerSockAddr;
-    struct iovec msgIOV;
-    uint8_t controlData[256];
-    struct msghdr msgHeader;
+    INET_ERROR res     = INET_NO_ERROR;
     InterfaceId intfId = aPktInfo->Interface;
 
     // Ensure the destination address type is compatible with the endpoint address type.
-    VerifyOrExit(mAddrType == aPktInfo->DestAddress.Type(), res = INET_ERROR_BAD_ARGS);
+    VerifyOrExit(aAddrType == aPktInfo->DestAddress.Type(), res = INET_ERROR_BAD_ARGS);
 
-    // For now the entire message must fit within a single buffer.
-    VerifyOrExit(aBuffer->Next() == NULL, res = INET_ERROR_MESSAGE_TOO_LONG);
+    memset(&aMsgHeader, 0, sizeof(aMsgHeader));
 
-    memset(&msgHeader, 0, sizeof(msgHeader));
+    // The chain is gathered by the kernel, so it need not be compacted into its first buffer.
+    aMsgHeader.msg_iov = aStorage.msgIOV;
+    for (PacketBuffer * buf = aBuffer; buf != NULL; buf = buf->Next())
+    {
+        VerifyOrExit(aMsgHeader.msg_iovlen < INET_CONFIG_SEND_IOV_MAX, res = INET_ERROR_MESSAGE_TOO_LONG);
 
-    msgIOV.iov_base      = aBuffer->Start();
-    msgIOV.iov_len       = aBuffer->DataLength();
-    msgHeader.msg_iov    = &msgIOV;
-    msgHeader.msg_iovlen = 1;
+        aStorage.msgIOV[aMsgHeader.msg_iovlen].iov_base = buf->Start();
+        aStorage.msgIOV[aMsgHeader.msg_iovlen].iov_len  = buf->DataLength();
+        aMsgHeader.msg_iovlen++;
+    }
 
     // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
-    memset(&peerSockAddr, 0, sizeof(peerSockAddr));
-    msgHeader.msg_name = &peerSockAddr;
-    if (mAddrType == kIPAddressType_IPv6)
+    memset(&aStorage.peerSockAddr, 0, sizeof(aStorage.peerSockAddr));
+    aMsgHeader.msg_name = &aStorage.peerSockAddr;
+    if (aAddrType == kIPAddressType_IPv6)
     {
-        peerSockAddr.in6.sin6_family   = AF_INET6;
-        peerSockAddr.in6.sin6_port     = htons(aPktInfo->DestPort);
-        peerSockAddr.in6.sin6_addr     = aPktInfo->DestAddress.ToIPv6();
-        peerSockAddr.in6.sin6_scope_id = aPktInfo->Interface;
-        msgHeader.msg_namelen          = sizeof(sockaddr_in6);
+        aStorage.peerSockAddr.in6.sin6_family   = AF_INET6;
+        aStorage.peerSockAddr.in6.sin6_port     = htons(aPktInfo->DestPort);
+        aStorage.peerSockAddr.in6.sin6_addr     = aPktInfo->DestAddress.ToIPv6();
+        aStorage.peerSockAddr.in6.sin6_scope_id = aPktInfo->Interface;
+        aMsgHeader.msg_namelen                  = sizeof(sockaddr_in6);
     }
 #if INET_CONFIG_ENABLE_IPV4
     else
     {
-        peerSockAddr.in.sin_family = AF_INET;
-        peerSockAddr.in.sin_port   = htons(aPktInfo->DestPort);
-        peerSockAddr.in.sin_addr   = aPktInfo->DestAddress.ToIPv4();
-        msgHeader.msg_namelen      = sizeof(sockaddr_in);
+        aStorage.peerSockAddr.in.sin_family = AF_INET;
+        aStorage.peerSockAddr.in.sin_port   = htons(aPktInfo->DestPort);
+        aStorage.peerSockAddr.in.sin_addr   = aPktInfo->DestAddress.ToIPv4();
+        aMsgHeader.msg_namelen              = sizeof(sockaddr_in);
     }
 #endif // INET_CONFIG_ENABLE_IPV4
 
@@ -835,7 +853,7 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
     // don't seem to get sent out the correct interface, despite
     // the socket being bound.
     if (intfId == INET_NULL_INTERFACEID)
-        intfId = mBoundIntfId;
+        intfId = aBoundIntfId;
 
     // If the packet should be sent over a specific interface, or with a specific source
     // address, construct an IP_PKTINFO/IPV6_PKTINFO "control message" to that effect
@@ -844,15 +862,15 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
     if (intfId != INET_NULL_INTERFACEID || aPktInfo->SrcAddress.Type() != kIPAddressType_Any)
     {
 #if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-        memset(controlData, 0, sizeof(controlData));
-        msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        memset(aStorage.controlData, 0, sizeof(aStorage.controlData));
+        aMsgHeader.msg_control    = aStorage.controlData;
+        aMsgHeader.msg_controllen = sizeof(aStorage.controlData);
 
-        struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader);
+        struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&aMsgHeader);
 
 #if INET_CONFIG_ENABLE_IPV4
 
-        if (mAddrType == kIPAddressType_IPv4)
+        if (aAddrType == kIPAddressType_IPv4)
         {
 #if defined(IP_PKTINFO)
             controlHdr->cmsg_level = IPPROTO_IP;
@@ -863,7 +881,7 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
             pktInfo->ipi_ifindex        = intfId;
             pktInfo->ipi_spec_dst       = aPktInfo->SrcAddress.ToIPv4();
 
-            msgHeader.msg_controllen = CMSG_SPACE(sizeof(in_pktinfo));
+            aMsgHeader.msg_controllen = CMSG_SPACE(sizeof(in_pktinfo));
 #else  // !defined(IP_PKTINFO)
             ExitNow(res = INET_ERROR_NOT_SUPPORTED);
 #endif // !defined(IP_PKTINFO)
@@ -871,7 +889,7 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
 
 #endif // INET_CONFIG_ENABLE_IPV4
 
-        if (mAddrType == kIPAddressType_IPv6)
+        if (aAddrType == kIPAddressType_IPv6)
         {
 #if defined(IPV6_PKTINFO)
             controlHdr->cmsg_level = IPPROTO_IPV6;
@@ -882,24 +900,118 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System:
             pktInfo->ipi6_ifindex        = intfId;
             pktInfo->ipi6_addr           = aPktInfo->SrcAddress.ToIPv6();
 
-            msgHeader.msg_controllen = CMSG_SPACE(sizeof(in6_pktinfo));
+            aMsgHeader.msg_controllen = CMSG_SPACE(sizeof(in6_pktinfo));
 #else  // !defined(IPV6_PKTINFO)
             ExitNow(res = INET_ERROR_NOT_SUPPORTED);
 #endif // !defined(IPV6_PKTINFO)
         }
 
 #else  // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
-        IgnoreUnusedVariable(controlData);
         ExitNow(res = INET_ERROR_NOT_SUPPORTED);
 #endif // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
     }
 
+exit:
+    return (res);
+}
+
+/*
+ * Fills in a recvmsg() message header that receives into the free space of aBuffer. The header
+ * points into aStorage, which must outlive it.
+ */
+static void BuildRecvMsgHeader(PacketBuffer * aBuffer, SocketMsgStorage & aStorage, struct msghdr & aMsgHeader)
+{
+    aStorage.msgIOV[0].iov_base = aBuffer->Start();
+    aStorage.msgIOV[0].iov_len  = aBuffer->AvailableDataLength();
+
+    memset(&aStorage.peerSockAddr, 0, sizeof(aStorage.peerSockAddr));
+
+    memset(&aMsgHeader, 0, sizeof(aMsgHeader));
+
+    aMsgHeader.msg_name       = &aStorage.peerSockAddr;
+    aMsgHeader.msg_namelen    = sizeof(aStorage.peerSockAddr);
+    aMsgHeader.msg_iov        = aStorage.msgIOV;
+    aMsgHeader.msg_iovlen     = 1;
+    aMsgHeader.msg_control    = aStorage.controlData;
+    aMsgHeader.msg_controllen = sizeof(aStorage.controlData);
+}
+
+/*
+ * Sets the length of aBuffer to that of the received datagram and extracts its source, destination
+ * and arrival interface from the message header into aPacketInfo.
+ */
+static INET_ERROR ParseRecvMsgHeader(struct msghdr & aMsgHeader, size_t aRcvLen, PacketBuffer * aBuffer,
+                                     IPPacketInfo & aPacketInfo)
+{
+    INET_ERROR lStatus                 = INET_NO_ERROR;
+    const PeerSockAddr & lPeerSockAddr = *static_cast<const PeerSockAddr *>(aMsgHeader.msg_name);
+
+    VerifyOrExit(aRcvLen <= aBuffer->AvailableDataLength(), lStatus = INET_ERROR_INBOUND_MESSAGE_TOO_BIG);
+
+    aBuffer->SetDataLength((uint16_t) aRcvLen);
+
+    if (lPeerSockAddr.any.sa_family == AF_INET6)
+    {
+        aPacketInfo.SrcAddress = IPAddress::FromIPv6(lPeerSockAddr.in6.sin6_addr);
+        aPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else if (lPeerSockAddr.any.sa_family == AF_INET)
+    {
+        aPacketInfo.SrcAddress = IPAddress::FromIPv4(lPeerSockAddr.in.sin_addr);
+        aPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        ExitNow(lStatus = INET_ERROR_INCORRECT_STATE);
+    }
+
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&aMsgHeader); controlHdr != NULL;
+         controlHdr                  = CMSG_NXTHDR(&aMsgHeader, controlHdr))
+    {
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            struct in_pktinfo * inPktInfo = (struct in_pktinfo *) CMSG_DATA(controlHdr);
+            aPacketInfo.Interface         = inPktInfo->ipi_ifindex;
+            aPacketInfo.DestAddress       = IPAddress::FromIPv4(inPktInfo->ipi_addr);
+            continue;
+        }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            struct in6_pktinfo * in6PktInfo = (struct in6_pktinfo *) CMSG_DATA(controlHdr);
+            aPacketInfo.Interface           = in6PktInfo->ipi6_ifindex;
+            aPacketInfo.DestAddress         = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
+            continue;
+        }
+#endif // defined(IPV6_PKTINFO)
+    }
+
+exit:
+    return (lStatus);
+}
+
+INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo * aPktInfo, chip::System::PacketBuffer * aBuffer, uint16_t aSendFlags)
+{
+    INET_ERROR res = INET_NO_ERROR;
+    SocketMsgStorage msgStorage;
+    struct msghdr msgHeader;
+
+    res = BuildSendMsgHeader(mAddrType, mBoundIntfId, aPktInfo, aBuffer, msgStorage, msgHeader);
+    SuccessOrExit(res);
+
     // Send IP packet.
     {
         const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
         if (lenSent == -1)
             res = chip::System::MapErrorPOSIX(errno);
-        else if (lenSent != aBuffer->DataLength())
+        else if (lenSent != aBuffer->TotalLength())
             res = INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED;
     }
 
@@ -907,6 +1019,74 @@ exit:
     return (res);
 }
 
+#if INET_CONFIG_ENABLE_UDP_BATCH_IO
+/**
+ * Sends several messages, INET_CONFIG_UDP_BATCH_SIZE at a time, with sendmmsg().
+ *
+ * Messages are sent in order and sending stops at the first message that fails; its error is
+ * returned and aSentCount tells how many messages went out before it. The buffers are not freed.
+ */
+INET_ERROR IPEndPointBasis::SendMsgs(const IPPacketInfo * aPktInfos, chip::System::PacketBuffer * const * aBuffers, size_t aCount,
+                                     size_t & aSentCount)
+{
+    INET_ERROR res = INET_NO_ERROR;
+    SocketMsgStorage msgStorage[INET_CONFIG_UDP_BATCH_SIZE];
+    struct mmsghdr msgHeaders[INET_CONFIG_UDP_BATCH_SIZE];
+
+    aSentCount = 0;
+
+    while (aSentCount < aCount)
+    {
+        size_t batchCount = aCount - aSentCount;
+        int lenSent;
+
+        if (batchCount > INET_CONFIG_UDP_BATCH_SIZE)
+            batchCount = INET_CONFIG_UDP_BATCH_SIZE;
+
+        memset(msgHeaders, 0, sizeof(msgHeaders));
+
+        for (size_t i = 0; i < batchCount; i++)
+        {
+            res = BuildSendMsgHeader(mAddrType, mBoundIntfId, &aPktInfos[aSentCount + i], aBuffers[aSentCount + i], msgStorage[i],
+                                     msgHeaders[i].msg_hdr);
+            if (res != INET_NO_ERROR)
+            {
+                // Send the messages ahead of the bad one, then report it
+                batchCount = i;
+                break;
+            }
+        }
+
+        if (batchCount == 0)
+            break;
+
+        lenSent = sendmmsg(mSocket, msgHeaders, static_cast<unsigned int>(batchCount), 0);
+        if (lenSent == -1)
+        {
+            res = chip::System::MapErrorPOSIX(errno);
+            break;
+        }
+
+        SYSTEM_STATS_SET(chip::System::Stats::kInetLayer_UDPSendBatchSize, lenSent);
+
+        for (int i = 0; i < lenSent; i++)
+        {
+            if (msgHeaders[i].msg_len != aBuffers[aSentCount]->TotalLength())
+                ExitNow(res = INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED);
+
+            aSentCount++;
+        }
+
+        // A message the kernel did not take reports its error on the next call,
+        // and one that failed to build is reported here.
+        SuccessOrExit(res);
+    }
+
+exit:
+    return (res);
+}
+#endif // INET_CONFIG_ENABLE_UDP_BATCH_IO
+
 INET_ERROR IPEndPointBasis::GetSocket(IPAddressType aAddressType, int aType, int aProtocol)
 {
     INET_ERROR res = INET_NO_ERROR;
@@ -1042,24 +1222,10 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
 
     if (lBuffer != NULL)
     {
-        struct iovec msgIOV;
-        PeerSockAddr lPeerSockAddr;
-        uint8_t controlData[256];
+        SocketMsgStorage msgStorage;
         struct msghdr msgHeader;
 
-        msgIOV.iov_base = lBuffer->Start();
-        msgIOV.iov_len  = lBuffer->AvailableDataLength();
-
-        memset(&lPeerSockAddr, 0, sizeof(lPeerSockAddr));
-
-        memset(&msgHeader, 0, sizeof(msgHeader));
-
-        msgHeader.msg_name       = &lPeerSockAddr;
-        msgHeader.msg_namelen    = sizeof(lPeerSockAddr);
-        msgHeader.msg_iov        = &msgIOV;
-        msgHeader.msg_iovlen     = 1;
-        msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        BuildRecvMsgHeader(lBuffer, msgStorage, msgHeader);
 
         ssize_t rcvLen = recvmsg(mSocket, &msgHeader, MSG_DONTWAIT);
 
@@ -1067,59 +1233,9 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
         {
             lStatus = chip::System::MapErrorPOSIX(errno);
         }
-        else if (rcvLen > lBuffer->AvailableDataLength())
-        {
-            lStatus = INET_ERROR_INBOUND_MESSAGE_TOO_BIG;
-        }
         else
         {
-            lBuffer->SetDataLength((uint16_t) rcvLen);
-
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv6(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv4(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = INET_ERROR_INCORRECT_STATE;
-            }
-        }
-
-        if (lStatus == INET_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != NULL;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    struct in_pktinfo * inPktInfo = (struct in_pktinfo *) CMSG_DATA(controlHdr);
-                    lPacketInfo.Interface         = inPktInfo->ipi_ifindex;
-                    lPacketInfo.DestAddress       = IPAddress::FromIPv4(inPktInfo->ipi_addr);
-                    continue;
-                }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
-
-#ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    struct in6_pktinfo * in6PktInfo = (struct in6_pktinfo *) CMSG_DATA(controlHdr);
-                    lPacketInfo.Interface           = in6PktInfo->ipi6_ifindex;
-                    lPacketInfo.DestAddress         = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
-            }
+            lStatus = ParseRecvMsgHeader(msgHeader, static_cast<size_t>(rcvLen), lBuffer, lPacketInfo);
         }
     }
     else
@@ -1138,6 +1254,98 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
 
     return;
 }
+
+#if INET_CONFIG_ENABLE_UDP_BATCH_IO
+/**
+ * Receives up to aCount pending datagrams with a single recvmmsg() call.
+ *
+ * aBuffers holds the endpoint's receive buffers between calls: empty slots are refilled here, buffers
+ * that receive a datagram are handed to OnMessageReceived and their slots cleared, and the others stay
+ * in place for the next call. The owner frees whatever is left when it closes. Once a receive handler
+ * closes the endpoint or stops it listening, the rest of the batch is dropped.
+ */
+void IPEndPointBasis::HandlePendingIOBatch(uint16_t aPort, chip::System::PacketBuffer ** aBuffers, size_t aCount)
+{
+    INET_ERROR lStatus = INET_NO_ERROR;
+    SocketMsgStorage msgStorage[INET_CONFIG_UDP_BATCH_SIZE];
+    struct mmsghdr msgHeaders[INET_CONFIG_UDP_BATCH_SIZE];
+    PacketBuffer * lReceived[INET_CONFIG_UDP_BATCH_SIZE];
+    size_t lReadyCount = 0;
+    int lRcvCount;
+    int lDelivered = 0;
+
+    if (aCount > INET_CONFIG_UDP_BATCH_SIZE)
+        aCount = INET_CONFIG_UDP_BATCH_SIZE;
+
+    // recvmmsg() fills the buffers in order, so ready buffers are kept at the front.
+    for (size_t i = 0; i < aCount; i++)
+    {
+        if (aBuffers[i] == NULL)
+            aBuffers[i] = PacketBuffer::New(0);
+
+        if (aBuffers[i] == NULL)
+            break;
+
+        BuildRecvMsgHeader(aBuffers[i], msgStorage[i], msgHeaders[i].msg_hdr);
+        msgHeaders[i].msg_len = 0;
+        lReadyCount++;
+    }
+
+    VerifyOrExit(lReadyCount > 0, lStatus = INET_ERROR_NO_MEMORY);
+
+    lRcvCount = recvmmsg(mSocket, msgHeaders, static_cast<unsigned int>(lReadyCount), MSG_DONTWAIT, NULL);
+    VerifyOrExit(lRcvCount >= 0, lStatus = chip::System::MapErrorPOSIX(errno));
+
+    SYSTEM_STATS_SET(chip::System::Stats::kInetLayer_UDPRecvBatchSize, lRcvCount);
+
+    // Take the filled buffers off the endpoint before delivering any of them, since a
+    // receive handler may close the endpoint and free the buffers it still owns.
+    for (int i = 0; i < lRcvCount; i++)
+    {
+        lReceived[i] = aBuffers[i];
+        aBuffers[i]  = NULL;
+    }
+
+    // Prevent the end point from being freed while in the middle of a callback.
+    Retain();
+
+    for (; lDelivered < lRcvCount; lDelivered++)
+    {
+        IPPacketInfo lPacketInfo;
+
+        // Stop delivering once a handler has closed the endpoint or stopped listening.
+        if (mState != kState_Listening || OnMessageReceived == NULL)
+            break;
+
+        lPacketInfo.Clear();
+        lPacketInfo.DestPort = aPort;
+
+        lStatus = ParseRecvMsgHeader(msgHeaders[lDelivered].msg_hdr, msgHeaders[lDelivered].msg_len, lReceived[lDelivered],
+                                     lPacketInfo);
+
+        if (lStatus == INET_NO_ERROR)
+            OnMessageReceived(this, lReceived[lDelivered], &lPacketInfo);
+        else
+        {
+            PacketBuffer::Free(lReceived[lDelivered]);
+            if (OnReceiveError != NULL)
+                OnReceiveError(this, lStatus, NULL);
+        }
+    }
+
+    // Drop the datagrams that were not delivered.
+    for (int i = lDelivered; i < lRcvCount; i++)
+        PacketBuffer::Free(lReceived[i]);
+
+    Release();
+
+    lStatus = INET_NO_ERROR;
+
+exit:
+    if (lStatus != INET_NO_ERROR && OnReceiveError != NULL && lStatus != chip::System::MapErrorPOSIX(EAGAIN))
+        OnReceiveError(this, lStatus, NULL);
+}
+#endif // INET_CONFIG_ENABLE_UDP_BATCH_IO
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -149,6 +149,11 @@ protected:
     INET_ERROR GetSocket(IPAddressType aAddressType, int aType, int aProtocol);
     SocketEvents PrepareIO(void);
     void HandlePendingIO(uint16_t aPort);
+#if INET_CONFIG_ENABLE_UDP_BATCH_IO
+    INET_ERROR SendMsgs(const IPPacketInfo * aPktInfos, chip::System::PacketBuffer * const * aBuffers, size_t aCount,
+                        size_t & aSentCount);
+    void HandlePendingIOBatch(uint16_t aPort, chip::System::PacketBuffer ** aBuffers, size_t aCount);
+#endif // INET_CONFIG_ENABLE_UDP_BATCH_IO
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -543,6 +543,83 @@
 #ifndef INET_CONFIG_IP_MULTICAST_HOP_LIMIT
 #define INET_CONFIG_IP_MULTICAST_HOP_LIMIT                 (64)
 #endif // INET_CONFIG_IP_MULTICAST_HOP_LIMIT
+
+/**
+ *  @def INET_CONFIG_ENABLE_UDP_BATCH_IO
+ *
+ *  @brief
+ *    Defines whether (1) or not (0) UDP endpoints move datagrams
+ *    to and from the socket in batches.
+ *
+ *  @details
+ *    When enabled, a readable UDP endpoint drains up to
+ *    #INET_CONFIG_UDP_BATCH_SIZE datagrams with a single recvmmsg()
+ *    call into packet buffers it keeps allocated between wake-ups,
+ *    and UDPEndPoint::SendMsgs hands its messages to sendmmsg().
+ *    The size of the most recent batch in each direction is reported
+ *    through the system statistics.
+ *
+ *    This option is only supported on Linux sockets.
+ */
+#ifndef INET_CONFIG_ENABLE_UDP_BATCH_IO
+#define INET_CONFIG_ENABLE_UDP_BATCH_IO                    0
+#endif // INET_CONFIG_ENABLE_UDP_BATCH_IO
+
+/**
+ *  @def INET_CONFIG_UDP_BATCH_SIZE
+ *
+ *  @brief
+ *    The maximum number of datagrams a UDP endpoint receives or
+ *    sends with one system call when #INET_CONFIG_ENABLE_UDP_BATCH_IO
+ *    is enabled.
+ *
+ *  @note
+ *    Each listening endpoint keeps up to this many packet buffers
+ *    allocated for reception.
+ */
+#ifndef INET_CONFIG_UDP_BATCH_SIZE
+#define INET_CONFIG_UDP_BATCH_SIZE                         8
+#endif // INET_CONFIG_UDP_BATCH_SIZE
+
+/**
+ *  @def INET_CONFIG_SEND_IOV_MAX
+ *
+ *  @brief
+ *    The maximum number of packet buffers of a chain handed to the
+ *    socket with one sendmsg() call.
+ *
+ *  @details
+ *    UDP and raw endpoints send a buffer chain of up to this many
+ *    buffers as one datagram, with one data vector entry per buffer,
+ *    without copying it into a single buffer first. TCP endpoints
+ *    write up to this many buffers of their send queue at a time.
+ *
+ *    This should not exceed the IOV_MAX of the platform, which is at
+ *    least 16 on POSIX systems.
+ */
+#ifndef INET_CONFIG_SEND_IOV_MAX
+#define INET_CONFIG_SEND_IOV_MAX                           16
+#endif // INET_CONFIG_SEND_IOV_MAX
+
+/**
+ *  @def INET_CONFIG_TCP_RECEIVE_BUFFERS
+ *
+ *  @brief
+ *    The largest number of new packet buffers a TCP endpoint reads into
+ *    with one readv() call each time its socket becomes readable.
+ *
+ *  @details
+ *    Besides the free space left at the end of its receive queue, an
+ *    endpoint reads into one new buffer, or into twice as many as the
+ *    last time, up to this number, while its reads keep filling all the
+ *    space they are given. Buffers that receive data are appended to the
+ *    receive queue and the others are freed right away, so an idle
+ *    connection holds no buffers. This bounds how much one connection
+ *    reads before the other endpoints are serviced.
+ */
+#ifndef INET_CONFIG_TCP_RECEIVE_BUFFERS
+#define INET_CONFIG_TCP_RECEIVE_BUFFERS                    4
+#endif // INET_CONFIG_TCP_RECEIVE_BUFFERS
 // clang-format on
 
 #endif /* INETCONFIG_H */
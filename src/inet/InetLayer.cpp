@@ -1348,6 +1348,97 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set * readfds, fd_set * wri
     }
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+template <class EndPointType>
+void InetLayer::DispatchEpollEvent(EndPointType * aEndPoint, uint32_t aKind, uint32_t aEvents, bool aSetPendingIO)
+{
+    if ((aEndPoint == NULL) || !aEndPoint->IsCreatedByInetLayer(*this))
+        return;
+
+    if (!aSetPendingIO)
+    {
+        aEndPoint->HandlePendingIO();
+
+        // The callbacks may have changed what the endpoint waits for, e.g. by setting a handler, unless they freed it.
+        if (aEndPoint->IsRetained(*mSystemLayer) && aEndPoint->IsCreatedByInetLayer(*this))
+            aEndPoint->WatchIO(aEndPoint->PrepareIO(), aKind);
+    }
+    else if (aEndPoint->mSocket != INET_INVALID_SOCKET_FD && aEndPoint->mSocket == aEndPoint->mWatchedSocket)
+    {
+        // Like select(), only report the events that were asked for.
+        aEndPoint->mPendingIO = SocketEvents::FromEpollEvents(aEvents);
+        aEndPoint->mPendingIO.Value &= aEndPoint->mWatchedIO.Value;
+    }
+}
+
+void InetLayer::DispatchEpollEvent(const struct epoll_event & aEvent, bool aSetPendingIO)
+{
+    const size_t lIndex = static_cast<size_t>(aEvent.data.u64 & UINT32_MAX);
+
+    switch (aEvent.data.u64 >> 32)
+    {
+#if INET_CONFIG_ENABLE_RAW_ENDPOINT
+    case RawEndPoint::kEpollEndPoint_Raw:
+        DispatchEpollEvent(RawEndPoint::sPool.Get(*mSystemLayer, lIndex), RawEndPoint::kEpollEndPoint_Raw, aEvent.events,
+                           aSetPendingIO);
+        break;
+#endif // INET_CONFIG_ENABLE_RAW_ENDPOINT
+
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    case TCPEndPoint::kEpollEndPoint_TCP:
+        DispatchEpollEvent(TCPEndPoint::sPool.Get(*mSystemLayer, lIndex), TCPEndPoint::kEpollEndPoint_TCP, aEvent.events,
+                           aSetPendingIO);
+        break;
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+    case UDPEndPoint::kEpollEndPoint_UDP:
+        DispatchEpollEvent(UDPEndPoint::sPool.Get(*mSystemLayer, lIndex), UDPEndPoint::kEpollEndPoint_UDP, aEvent.events,
+                           aSetPendingIO);
+        break;
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+
+#if INET_CONFIG_ENABLE_TUN_ENDPOINT
+    case TunEndPoint::kEpollEndPoint_Tun:
+        DispatchEpollEvent(TunEndPoint::sPool.Get(*mSystemLayer, lIndex), TunEndPoint::kEpollEndPoint_Tun, aEvent.events,
+                           aSetPendingIO);
+        break;
+#endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
+
+    default:
+        // Registered by the system layer.
+        break;
+    }
+}
+
+/**
+ *  Handle I/O from an @p epoll_wait() call on System::Layer::GetEpollFD(). Only the endpoints that have events
+ *  are visited.
+ *
+ *  @note
+ *    As in HandleSelectResult(), the pending I/O fields of all ready endpoints are set *before* any callback is
+ *    made, so that an endpoint closed and re-opened by a callback does not act on events of its previous socket.
+ *
+ *  @param[in]    aEvents      The events returned by epoll_wait().
+ *
+ *  @param[in]    aEventCount  The return value of epoll_wait().
+ *
+ */
+void InetLayer::HandleEpollResult(const struct epoll_event * aEvents, int aEventCount)
+{
+    if (State != kState_Initialized)
+        return;
+
+    for (int i = 0; i < aEventCount; i++)
+        DispatchEpollEvent(aEvents[i], true);
+
+    for (int i = 0; i < aEventCount; i++)
+        DispatchEpollEvent(aEvents[i], false);
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 /**
@@ -232,6 +232,10 @@ public:
     void HandleSelectResult(int selectRes, fd_set * readfds, fd_set * writefds, fd_set * exceptfds);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    void HandleEpollResult(const struct epoll_event * aEvents, int aEventCount);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
     static void UpdateSnapshot(chip::System::Stats::Snapshot & aSnapshot);
 
     void * GetPlatformData(void);
@@ -314,6 +318,12 @@ private:
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    template <class EndPointType>
+    void DispatchEpollEvent(EndPointType * aEndPoint, uint32_t aKind, uint32_t aEvents, bool aSetPendingIO);
+    void DispatchEpollEvent(const struct epoll_event & aEvent, bool aSetPendingIO);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
     friend INET_ERROR Platform::InetLayer::WillInit(Inet::InetLayer * aLayer, void * aContext);
     friend void Platform::InetLayer::DidInit(Inet::InetLayer * aLayer, void * aContext, INET_ERROR anError);
 
@@ -87,6 +87,51 @@ SocketEvents SocketEvents::FromFDs(int socket, fd_set * readfds, fd_set * writef
 
     return res;
 }
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+/**
+ *  Convert the bit flags to the events an epoll instance should watch for.
+ *
+ *  @return  The epoll events corresponding to the bit flags; exceptional conditions map to EPOLLPRI, as with @p select().
+ *
+ */
+uint32_t SocketEvents::ToEpollEvents(void) const
+{
+    uint32_t events = 0;
+
+    if (IsReadable())
+        events |= EPOLLIN;
+    if (IsWriteable())
+        events |= EPOLLOUT;
+    if (IsError())
+        events |= EPOLLPRI;
+
+    return events;
+}
+
+/**
+ *  Set the read, write or exception bit flags based on the events reported by an epoll instance.
+ *
+ *  @param[in]    events    The events reported by @p epoll_wait() for a file descriptor.
+ *
+ *  @return  The bit flags. An error or hang-up is reported as readable and writable, as @p select() does, so that
+ *           the next read or write surfaces the socket error.
+ *
+ */
+SocketEvents SocketEvents::FromEpollEvents(uint32_t events)
+{
+    SocketEvents res;
+
+    if (events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+        res.SetRead();
+    if (events & (EPOLLOUT | EPOLLERR | EPOLLHUP))
+        res.SetWrite();
+    if (events & EPOLLPRI)
+        res.SetError();
+
+    return res;
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 } // namespace Inet
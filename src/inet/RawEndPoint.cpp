@@ -432,6 +432,10 @@ INET_ERROR RawEndPoint::Listen(void)
     if (res == INET_NO_ERROR)
     {
         mState = kState_Listening;
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+        WatchIO(PrepareIO(), kEpollEndPoint_Raw);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
     }
 
 exit:
@@ -480,6 +484,10 @@ void RawEndPoint::Close(void)
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+            UnwatchIO();
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
             close(mSocket);
             mSocket = INET_INVALID_SOCKET_FD;
         }
@@ -543,7 +551,8 @@ INET_ERROR RawEndPoint::SendTo(IPAddress addr, chip::System::PacketBuffer * msg,
  *      have matching protocol versions or address type.
  *
  * @retval  INET_ERROR_MESSAGE_TOO_LONG
- *      \c msg does not contain the whole ICMP message.
+ *      \c msg is a chain of more than INET_CONFIG_SEND_IOV_MAX buffers,
+ *      which cannot be gathered into one ICMP message.
  *
  * @retval  INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED
  *      On some platforms, only a truncated portion of \c msg was queued
@@ -586,7 +595,8 @@ INET_ERROR RawEndPoint::SendTo(IPAddress addr, InterfaceId intfId, chip::System:
  *      have matching protocol versions or address type.
  *
  * @retval  INET_ERROR_MESSAGE_TOO_LONG
- *      \c msg does not contain the whole ICMP message.
+ *      \c msg is a chain of more than INET_CONFIG_SEND_IOV_MAX buffers,
+ *      which cannot be gathered into one ICMP message.
  *
  * @retval  INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED
  *      On some platforms, only a truncated portion of \c msg was queued
@@ -54,6 +54,7 @@
 #include <sys/ioctl.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -289,6 +290,10 @@ INET_ERROR TCPEndPoint::Listen(uint16_t backlog)
         // [or on LwIP, DeferredRelease()] will happen in DoClose().
         Retain();
         State = kState_Listening;
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+        WatchIO(PrepareIO(), kEpollEndPoint_TCP);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
     }
 
     return res;
@@ -502,6 +507,10 @@ INET_ERROR TCPEndPoint::Connect(IPAddress addr, uint16_t port, InterfaceId intf)
     // Wake the thread calling select so that it recognizes the new socket.
     lSystemLayer.WakeSelect();
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    WatchIO(PrepareIO(), kEpollEndPoint_TCP);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
     StartConnectTimerIfSet();
@@ -727,12 +736,21 @@ INET_ERROR TCPEndPoint::Send(PacketBuffer * data, bool push)
     if (push)
         res = DriveSending();
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    // Wait for the socket to become writable while data remains queued.
+    WatchIO(PrepareIO(), kEpollEndPoint_TCP);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
     return res;
 }
 
 void TCPEndPoint::DisableReceive()
 {
     ReceiveEnabled = false;
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    WatchIO(PrepareIO(), kEpollEndPoint_TCP);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 void TCPEndPoint::EnableReceive()
@@ -751,6 +769,10 @@ void TCPEndPoint::EnableReceive()
     // in the select read fd_set.
     lSystemLayer.WakeSelect();
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    WatchIO(PrepareIO(), kEpollEndPoint_TCP);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 }
 
@@ -1089,6 +1111,10 @@ INET_ERROR TCPEndPoint::Shutdown()
     else if (State == kState_ReceiveShutdown)
         err = DoClose(err, false);
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    WatchIO(PrepareIO(), kEpollEndPoint_TCP);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
     return err;
 }
 
@@ -1197,6 +1223,10 @@ void TCPEndPoint::Init(InetLayer * inetLayer)
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #endif // INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    mRcvBurst = 1;
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 }
 
 INET_ERROR TCPEndPoint::DriveSending()
@@ -1306,9 +1336,25 @@ INET_ERROR TCPEndPoint::DriveSending()
 
     while (mSendQueue != NULL)
     {
-        uint16_t bufLen = mSendQueue->DataLength();
+        struct iovec sendIOV[INET_CONFIG_SEND_IOV_MAX];
+        struct msghdr msgHeader;
+        size_t bufLen = 0;
+
+        // Hand the first buffers of the send queue to the kernel together, up to as much data as OnDataSent can report.
+        memset(&msgHeader, 0, sizeof(msgHeader));
+        msgHeader.msg_iov = sendIOV;
+        for (PacketBuffer * buf = mSendQueue; buf != NULL && msgHeader.msg_iovlen < INET_CONFIG_SEND_IOV_MAX; buf = buf->Next())
+        {
+            if (msgHeader.msg_iovlen > 0 && bufLen + buf->DataLength() > UINT16_MAX)
+                break;
+
+            sendIOV[msgHeader.msg_iovlen].iov_base = buf->Start();
+            sendIOV[msgHeader.msg_iovlen].iov_len  = buf->DataLength();
+            msgHeader.msg_iovlen++;
+            bufLen += buf->DataLength();
+        }
 
-        ssize_t lenSent = send(mSocket, mSendQueue->Start(), (size_t) bufLen, sendFlags);
+        ssize_t lenSent = sendmsg(mSocket, &msgHeader, sendFlags);
 
         if (lenSent == -1)
         {
@@ -1320,9 +1366,9 @@ INET_ERROR TCPEndPoint::DriveSending()
         // Mark the connection as being active.
         MarkActive();
 
-        if (lenSent < bufLen)
-            mSendQueue->ConsumeHead(lenSent);
-        else
+        // Free the buffers sent in full, including empty ones, and skip the sent part of the next one.
+        mSendQueue = mSendQueue->Consume((uint16_t) lenSent);
+        while (mSendQueue != NULL && mSendQueue->DataLength() == 0)
             mSendQueue = PacketBuffer::FreeHead(mSendQueue);
 
         if (OnDataSent != NULL)
@@ -1361,7 +1407,7 @@ INET_ERROR TCPEndPoint::DriveSending()
         }
 #endif // INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
 
-        if (lenSent < bufLen)
+        if ((size_t) lenSent < bufLen)
             break;
     }
 
@@ -1540,6 +1586,10 @@ INET_ERROR TCPEndPoint::DoClose(INET_ERROR err, bool suppressCallback)
                     ChipLogError(Inet, "SO_LINGER: %d", errno);
             }
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+            UnwatchIO();
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
             if (close(mSocket) != 0 && err == INET_NO_ERROR)
                 err = chip::System::MapErrorPOSIX(errno);
             mSocket = INET_INVALID_SOCKET_FD;
@@ -1547,6 +1597,11 @@ INET_ERROR TCPEndPoint::DoClose(INET_ERROR err, bool suppressCallback)
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
         }
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+        // Otherwise only the unsent data remains to be written.
+        else
+            WatchIO(PrepareIO(), kEpollEndPoint_TCP);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
     }
 
     // Clear any results from select() that indicate pending I/O for the socket.
@@ -2330,34 +2385,95 @@ void TCPEndPoint::HandlePendingIO()
 
 void TCPEndPoint::ReceiveData()
 {
-    PacketBuffer * rcvBuf;
-    bool isNewBuf = true;
-
-    if (mRcvQueue == NULL)
-        rcvBuf = PacketBuffer::New(0);
-    else
+    struct iovec rcvIOV[INET_CONFIG_TCP_RECEIVE_BUFFERS + 1];
+    PacketBuffer * newBufs[INET_CONFIG_TCP_RECEIVE_BUFFERS];
+    PacketBuffer * tailBuf = NULL;
+    size_t newBufCount     = 0;
+    size_t rcvSpace        = 0;
+    int iovCount           = 0;
+
+    // Read into the free space at the end of the receive queue first...
+    if (mRcvQueue != NULL)
     {
-        rcvBuf = mRcvQueue;
-        for (PacketBuffer * nextBuf = rcvBuf->Next(); nextBuf != NULL; rcvBuf = nextBuf, nextBuf = nextBuf->Next())
+        for (tailBuf = mRcvQueue; tailBuf->Next() != NULL; tailBuf = tailBuf->Next())
             ;
 
-        if (rcvBuf->AvailableDataLength() == 0)
-            rcvBuf = PacketBuffer::New(0);
+        if (tailBuf->AvailableDataLength() == 0)
+            tailBuf = NULL;
         else
         {
-            isNewBuf = false;
-            rcvBuf->CompactHead();
+            tailBuf->CompactHead();
+            rcvIOV[iovCount].iov_base = tailBuf->Start() + tailBuf->DataLength();
+            rcvIOV[iovCount].iov_len  = tailBuf->AvailableDataLength();
+            rcvSpace += rcvIOV[iovCount].iov_len;
+            iovCount++;
         }
     }
 
-    if (rcvBuf == NULL)
+    // ... then into new buffers: one, or more while the previous reads filled all the space they were given.
+    for (; newBufCount < mRcvBurst; newBufCount++)
+    {
+        newBufs[newBufCount] = PacketBuffer::New(0);
+        if (newBufs[newBufCount] == NULL)
+            break;
+
+        rcvIOV[iovCount].iov_base = newBufs[newBufCount]->Start();
+        rcvIOV[iovCount].iov_len  = newBufs[newBufCount]->AvailableDataLength();
+        rcvSpace += rcvIOV[iovCount].iov_len;
+        iovCount++;
+    }
+
+    if (iovCount == 0)
     {
         DoClose(INET_ERROR_NO_MEMORY, false);
         return;
     }
 
     // Attempt to receive data from the socket.
-    ssize_t rcvLen = recv(mSocket, rcvBuf->Start() + rcvBuf->DataLength(), rcvBuf->AvailableDataLength(), 0);
+    ssize_t rcvLen     = readv(mSocket, rcvIOV, iovCount);
+    const int rcvErrno = errno;
+
+    // Add any new data onto the receive queue, and free the new buffers that received none.
+    {
+        size_t remaining = (rcvLen > 0) ? (size_t) rcvLen : 0;
+
+        if (tailBuf != NULL && remaining > 0)
+        {
+            const size_t avail = tailBuf->AvailableDataLength();
+            const uint16_t len = (uint16_t)(remaining < avail ? remaining : avail);
+            tailBuf->SetDataLength(tailBuf->DataLength() + len, mRcvQueue);
+            remaining -= len;
+        }
+
+        for (size_t i = 0; i < newBufCount; i++)
+        {
+            PacketBuffer * rcvBuf = newBufs[i];
+            const size_t avail    = rcvBuf->AvailableDataLength();
+            const uint16_t len    = (uint16_t)(remaining < avail ? remaining : avail);
+
+            if (len == 0)
+            {
+                PacketBuffer::Free(rcvBuf);
+                continue;
+            }
+
+            rcvBuf->SetDataLength(len);
+            if (mRcvQueue == NULL)
+                mRcvQueue = rcvBuf;
+            else
+                mRcvQueue->AddToEnd(rcvBuf);
+            remaining -= len;
+        }
+
+        if (rcvLen > 0 && (size_t) rcvLen == rcvSpace && newBufCount == mRcvBurst)
+        {
+            mRcvBurst = (uint8_t)(mRcvBurst * 2);
+            if (mRcvBurst > INET_CONFIG_TCP_RECEIVE_BUFFERS)
+                mRcvBurst = INET_CONFIG_TCP_RECEIVE_BUFFERS;
+        }
+        else
+            mRcvBurst = 1;
+    }
 
 #if INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
     INET_ERROR err;
@@ -2396,12 +2512,7 @@ void TCPEndPoint::ReceiveData()
     // If an error occurred, abort the connection.
     if (rcvLen < 0)
     {
-        int systemErrno = errno;
-
-        if (isNewBuf)
-        {
-            PacketBuffer::Free(rcvBuf);
-        }
+        int systemErrno = rcvErrno;
 
         if (systemErrno == EAGAIN)
         {
@@ -2425,9 +2536,6 @@ void TCPEndPoint::ReceiveData()
         // If the peer closed their end of the connection...
         if (rcvLen == 0)
         {
-            if (isNewBuf)
-                PacketBuffer::Free(rcvBuf);
-
             // If in the Connected state and the app has provided an OnPeerClose callback,
             // enter the ReceiveShutdown state.  Providing an OnPeerClose callback allows
             // the app to decide whether to keep the send side of the connection open after
@@ -2442,19 +2550,6 @@ void TCPEndPoint::ReceiveData()
             if (OnPeerClose != NULL)
                 OnPeerClose(this);
         }
-
-        // Otherwise, add the new data onto the receive queue.
-        else if (isNewBuf)
-        {
-            rcvBuf->SetDataLength(rcvBuf->DataLength() + (uint16_t) rcvLen);
-            if (mRcvQueue == NULL)
-                mRcvQueue = rcvBuf;
-            else
-                mRcvQueue->AddToEnd(rcvBuf);
-        }
-
-        else
-            rcvBuf->SetDataLength(rcvBuf->DataLength() + (uint16_t) rcvLen, mRcvQueue);
     }
 
     // Drive any received data into the app.
@@ -2528,6 +2623,12 @@ void TCPEndPoint::HandleIncomingConnection()
 
         // Call the app's callback function.
         OnConnectionReceived(this, conEP, peerAddr, peerPort);
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+        // Watch the new connection for the events its callbacks, set by the app above, wait for.
+        if (conEP->IsRetained(SystemLayer()))
+            conEP->WatchIO(conEP->PrepareIO(), kEpollEndPoint_TCP);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
     }
 
     // Otherwise immediately close the connection, clean up and call the app's error callback.
@@ -554,6 +554,9 @@ private:
 
     chip::System::PacketBuffer * mRcvQueue;
     chip::System::PacketBuffer * mSendQueue;
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    uint8_t mRcvBurst; // Number of new buffers to read into at the next wake-up.
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 #if INET_TCP_IDLE_CHECK_INTERVAL > 0
     uint16_t mIdleTimeout;       // in units of INET_TCP_IDLE_CHECK_INTERVAL; zero means no timeout
     uint16_t mRemainingIdleTime; // in units of INET_TCP_IDLE_CHECK_INTERVAL
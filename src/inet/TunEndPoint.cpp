@@ -111,8 +111,14 @@ INET_ERROR TunEndPoint::Open(void)
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
     if (err == INET_NO_ERROR)
+    {
         mState = kState_Open;
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+        WatchIO(PrepareIO(), kEpollEndPoint_Tun);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+    }
+
 exit:
 
     return err;
@@ -138,6 +144,9 @@ void TunEndPoint::Close(void)
 
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+            UnwatchIO();
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
             TunDevClose();
         }
 
@@ -358,6 +358,10 @@ INET_ERROR UDPEndPoint::Listen(void)
     if (res == INET_NO_ERROR)
     {
         mState = kState_Listening;
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+        WatchIO(PrepareIO(), kEpollEndPoint_UDP);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
     }
 
 exit:
@@ -406,6 +410,10 @@ void UDPEndPoint::Close(void)
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+            UnwatchIO();
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
             close(mSocket);
             mSocket = INET_INVALID_SOCKET_FD;
         }
@@ -413,6 +421,15 @@ void UDPEndPoint::Close(void)
         // Clear any results from select() that indicate pending I/O for the socket.
         mPendingIO.Clear();
 
+#if INET_CONFIG_ENABLE_UDP_BATCH_IO
+        // Release the buffers kept for receiving the next batch.
+        for (size_t i = 0; i < INET_CONFIG_UDP_BATCH_SIZE; i++)
+        {
+            PacketBuffer::Free(mRecvBuffers[i]);
+            mRecvBuffers[i] = NULL;
+        }
+#endif // INET_CONFIG_ENABLE_UDP_BATCH_IO
+
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 #if CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -472,7 +489,8 @@ INET_ERROR UDPEndPoint::SendTo(IPAddress addr, uint16_t port, chip::System::Pack
  *      have matching protocol versions or address type.
  *
  * @retval  INET_ERROR_MESSAGE_TOO_LONG
- *      \c msg does not contain the whole UDP message.
+ *      \c msg is a chain of more than INET_CONFIG_SEND_IOV_MAX buffers,
+ *      which cannot be gathered into one UDP message.
  *
  * @retval  INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED
  *      On some platforms, only a truncated portion of \c msg was queued
@@ -521,7 +539,8 @@ INET_ERROR UDPEndPoint::SendTo(IPAddress addr, uint16_t port, InterfaceId intfId
  *      have matching protocol versions or address type.
  *
  * @retval  INET_ERROR_MESSAGE_TOO_LONG
- *      \c msg does not contain the whole UDP message.
+ *      \c msg is a chain of more than INET_CONFIG_SEND_IOV_MAX buffers,
+ *      which cannot be gathered into one UDP message.
  *
  * @retval  INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED
  *      On some platforms, only a truncated portion of \c msg was queued
@@ -710,6 +729,68 @@ exit:
     return res;
 }
 
+/**
+ * @brief   Send several UDP messages.
+ *
+ * @param[in]   pktInfos    source and destination information, one entry per message
+ * @param[in]   msgs        the packet buffers containing the UDP messages
+ * @param[in]   count       the number of messages
+ * @param[in]   sendFlags   optional transmit option flags
+ *
+ * @retval  INET_NO_ERROR
+ *      success: all messages are queued for transmit.
+ *
+ * @retval  other
+ *      the error of the first message that could not be sent, as
+ *      returned by \c SendMsg.
+ *
+ * @details
+ *      Sends the messages in order, stopping at the first one that fails.
+ *      With #INET_CONFIG_ENABLE_UDP_BATCH_IO, the messages are handed to the
+ *      socket up to #INET_CONFIG_UDP_BATCH_SIZE at a time; they must then all
+ *      be addressed to the same IP version.  Otherwise each message is sent
+ *      with \c SendMsg.
+ *
+ *      Unless <tt>(sendFlags & kSendFlag_RetainBuffer) != 0</tt>, every buffer
+ *      in \c msgs is freed, whether or not its message was sent.
+ */
+INET_ERROR UDPEndPoint::SendMsgs(const IPPacketInfo * pktInfos, PacketBuffer * const * msgs, size_t count, uint16_t sendFlags)
+{
+    INET_ERROR res = INET_NO_ERROR;
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_BATCH_IO
+    size_t sentCount = 0;
+
+    VerifyOrExit(count > 0, );
+
+    // Make sure we have the appropriate type of socket based on the
+    // destination address.
+    res = GetSocket(pktInfos[0].DestAddress.Type());
+    SuccessOrExit(res);
+
+    res = IPEndPointBasis::SendMsgs(pktInfos, msgs, count, sentCount);
+
+exit:
+    if ((sendFlags & kSendFlag_RetainBuffer) == 0)
+    {
+        for (size_t i = 0; i < count; i++)
+            PacketBuffer::Free(msgs[i]);
+    }
+
+    CHIP_SYSTEM_FAULT_INJECT_ASYNC_EVENT();
+#else  // !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_BATCH_IO)
+    for (size_t i = 0; i < count; i++)
+    {
+        if (res == INET_NO_ERROR)
+            res = SendMsg(&pktInfos[i], msgs[i], sendFlags);
+        else if ((sendFlags & kSendFlag_RetainBuffer) == 0)
+            PacketBuffer::Free(msgs[i]);
+    }
+#endif // !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_BATCH_IO)
+
+    return res;
+}
+
 /**
  * @brief   Bind the endpoint to a network interface.
  *
@@ -783,6 +864,10 @@ exit:
 void UDPEndPoint::Init(InetLayer * inetLayer)
 {
     IPEndPointBasis::Init(inetLayer);
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_BATCH_IO
+    memset(mRecvBuffers, 0, sizeof(mRecvBuffers));
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_BATCH_IO
 }
 
 /**
@@ -980,7 +1065,11 @@ void UDPEndPoint::HandlePendingIO(void)
     {
         const uint16_t lPort = mBoundPort;
 
+#if INET_CONFIG_ENABLE_UDP_BATCH_IO
+        IPEndPointBasis::HandlePendingIOBatch(lPort, mRecvBuffers, INET_CONFIG_UDP_BATCH_SIZE);
+#else  // !INET_CONFIG_ENABLE_UDP_BATCH_IO
         IPEndPointBasis::HandlePendingIO(lPort);
+#endif // !INET_CONFIG_ENABLE_UDP_BATCH_IO
     }
 
     mPendingIO.Clear();
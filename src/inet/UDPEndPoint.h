@@ -61,6 +61,8 @@ public:
     INET_ERROR SendTo(IPAddress addr, uint16_t port, chip::System::PacketBuffer * msg, uint16_t sendFlags = 0);
     INET_ERROR SendTo(IPAddress addr, uint16_t port, InterfaceId intfId, chip::System::PacketBuffer * msg, uint16_t sendFlags = 0);
     INET_ERROR SendMsg(const IPPacketInfo * pktInfo, chip::System::PacketBuffer * msg, uint16_t sendFlags = 0);
+    INET_ERROR SendMsgs(const IPPacketInfo * pktInfos, chip::System::PacketBuffer * const * msgs, size_t count,
+                        uint16_t sendFlags = 0);
     void Close(void);
     void Free(void);
 
@@ -85,6 +87,9 @@ private:
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
     uint16_t mBoundPort;
+#if INET_CONFIG_ENABLE_UDP_BATCH_IO
+    chip::System::PacketBuffer * mRecvBuffers[INET_CONFIG_UDP_BATCH_SIZE];
+#endif // INET_CONFIG_ENABLE_UDP_BATCH_IO
 
     INET_ERROR GetSocket(IPAddressType addrType);
     SocketEvents PrepareIO(void);
@@ -72,6 +72,9 @@
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
 #include <arpa/inet.h>
 #include <sys/select.h>
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
 using namespace chip;
@@ -509,6 +512,27 @@ void ServiceEvents(struct ::timeval & aSleepTime)
             printed = true;
         }
     }
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    struct epoll_event events[CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS];
+
+    // Endpoints keep their own sockets registered with the system layer's epoll instance.
+    if (gSystemLayer.State() == System::kLayerState_Initialized)
+        gSystemLayer.PrepareEpoll();
+
+    int eventCount = epoll_wait(gSystemLayer.GetEpollFD(), events, CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS,
+                                static_cast<int>(aSleepTime.tv_sec * 1000 + aSleepTime.tv_usec / 1000));
+    if (eventCount < 0)
+    {
+        printf("epoll_wait failed: %s\n", ErrorStr(System::MapErrorPOSIX(errno)));
+        return;
+    }
+
+    if (gSystemLayer.State() == System::kLayerState_Initialized)
+        gSystemLayer.HandleEpollResult(events, eventCount);
+
+    if (gInet.State == InetLayer::kState_Initialized)
+        gInet.HandleEpollResult(events, eventCount);
+#else // !CHIP_SYSTEM_CONFIG_USE_EPOLL
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
     fd_set readFDs, writeFDs, exceptFDs;
     int numFDs = 0;
@@ -585,6 +609,7 @@ void ServiceEvents(struct ::timeval & aSleepTime)
 
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
     }
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP && !CHIP_SYSTEM_CONFIG_USE_SOCKETS
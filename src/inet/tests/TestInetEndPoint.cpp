@@ -506,6 +506,526 @@ static void TestInetEndPoint(nlTestSuite * inSuite, void * inContext)
     testTCPEP1->Shutdown();
 }
 
+static size_t sUDPMessagesReceived = 0;
+
+static void HandleUDPMessageReceived(IPEndPointBasis * endPoint, PacketBuffer * msg, const IPPacketInfo * pktInfo)
+{
+    sUDPMessagesReceived++;
+    PacketBuffer::Free(msg);
+}
+
+// Send a batch of datagrams to ourselves over the loopback interface
+static void TestInetUDPSendMsgs(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kMessageCount = INET_CONFIG_UDP_BATCH_SIZE + 3;
+    constexpr uint16_t kPort       = 3100;
+    UDPEndPoint * testUDPEP        = NULL;
+    IPPacketInfo pktInfos[kMessageCount];
+    PacketBuffer * bufs[kMessageCount];
+    IPAddress addr;
+    INET_ERROR err;
+
+    IPAddress::FromString("::1", addr);
+
+    err = gInet.NewUDPEndPoint(&testUDPEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    err = testUDPEP->Bind(kIPAddressType_IPv6, addr, kPort);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    testUDPEP->OnMessageReceived = HandleUDPMessageReceived;
+    err                          = testUDPEP->Listen();
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        pktInfos[i].Clear();
+        pktInfos[i].DestAddress = addr;
+        pktInfos[i].DestPort    = kPort;
+
+        bufs[i] = PacketBuffer::New();
+        NL_TEST_ASSERT(inSuite, bufs[i] != NULL);
+        VerifyOrExit(bufs[i] != NULL, );
+        memset(bufs[i]->Start(), static_cast<int>(i), 16);
+        bufs[i]->SetDataLength(16);
+    }
+
+    sUDPMessagesReceived = 0;
+    err                  = testUDPEP->SendMsgs(pktInfos, bufs, kMessageCount);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    for (int i = 0; i < 100 && sUDPMessagesReceived < kMessageCount; i++)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 10000;
+        ServiceNetwork(sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sUDPMessagesReceived == kMessageCount);
+
+exit:
+    if (testUDPEP != NULL)
+        testUDPEP->Free();
+}
+
+static UDPEndPoint * sUDPClosingEP  = NULL;
+static size_t sUDPClosingReceived = 0;
+
+static void HandleUDPMessageReceivedAndFree(IPEndPointBasis * endPoint, PacketBuffer * msg, const IPPacketInfo * pktInfo)
+{
+    sUDPClosingReceived++;
+    PacketBuffer::Free(msg);
+
+    sUDPClosingEP->Free();
+    sUDPClosingEP = NULL;
+}
+
+// Free the endpoint from its receive handler while more datagrams are pending, and check that none of them is
+// delivered afterwards and that their buffers are released
+static void TestInetUDPFreeInHandler(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kMessageCount = 4;
+    constexpr uint16_t kPort       = 3104;
+    IPAddress addr;
+    INET_ERROR err;
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    chip::System::Stats::count_t lBufsInUse = 0;
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+    IPAddress::FromString("::1", addr);
+
+    sUDPClosingReceived = 0;
+
+    err = gInet.NewUDPEndPoint(&sUDPClosingEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    err = sUDPClosingEP->Bind(kIPAddressType_IPv6, addr, kPort);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    lBufsInUse = chip::System::Stats::GetResourcesInUse()[chip::System::Stats::kSystemLayer_NumPacketBufs];
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+    // Queue all the datagrams on the socket before the endpoint starts receiving, so they are read together.
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        PacketBuffer * buf = PacketBuffer::New();
+
+        NL_TEST_ASSERT(inSuite, buf != NULL);
+        VerifyOrExit(buf != NULL, );
+        memset(buf->Start(), static_cast<int>(i), 16);
+        buf->SetDataLength(16);
+
+        err = sUDPClosingEP->SendTo(addr, kPort, buf);
+        NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    }
+
+    sUDPClosingEP->OnMessageReceived = HandleUDPMessageReceivedAndFree;
+    err                              = sUDPClosingEP->Listen();
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    for (int i = 0; i < 20; i++)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 10000;
+        ServiceNetwork(sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sUDPClosingReceived == 1);
+    NL_TEST_ASSERT(inSuite, sUDPClosingEP == NULL);
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    NL_TEST_ASSERT(inSuite,
+                   chip::System::Stats::GetResourcesInUse()[chip::System::Stats::kSystemLayer_NumPacketBufs] == lBufsInUse);
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+exit:
+    if (sUDPClosingEP != NULL)
+        sUDPClosingEP->Free();
+    sUDPClosingEP = NULL;
+}
+
+static constexpr uint16_t kUDPChainBufSize = 100;
+
+static size_t sUDPChainMessages = 0;
+static uint32_t sUDPChainLength  = 0;
+
+static PacketBuffer * MakeUDPChain(size_t aCount)
+{
+    PacketBuffer * head = NULL;
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        PacketBuffer * buf = PacketBuffer::NewWithAvailableSize(0, kUDPChainBufSize);
+
+        VerifyOrDie(buf != NULL);
+        for (uint16_t k = 0; k < kUDPChainBufSize; k++)
+            buf->Start()[k] = static_cast<uint8_t>((i * kUDPChainBufSize + k) % 251);
+        buf->SetDataLength(kUDPChainBufSize);
+
+        if (head == NULL)
+            head = buf;
+        else
+            head->AddToEnd(buf);
+    }
+
+    return head;
+}
+
+static void HandleUDPChainReceived(IPEndPointBasis * endPoint, PacketBuffer * msg, const IPPacketInfo * pktInfo)
+{
+    uint32_t offset = 0;
+
+    sUDPChainMessages++;
+    sUDPChainLength = msg->TotalLength();
+
+    for (PacketBuffer * buf = msg; buf != NULL; buf = buf->Next())
+    {
+        for (uint16_t k = 0; k < buf->DataLength(); k++, offset++)
+        {
+            if (buf->Start()[k] != static_cast<uint8_t>(offset % 251))
+            {
+                sUDPChainLength = 0;
+                break;
+            }
+        }
+    }
+
+    PacketBuffer::Free(msg);
+}
+
+// Send a buffer chain as one datagram, and check that a chain too long to gather is refused
+static void TestInetUDPSendChain(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kChainCount = 3;
+    constexpr uint16_t kPort     = 3102;
+    UDPEndPoint * testUDPEP      = NULL;
+    IPAddress addr;
+    INET_ERROR err;
+
+    IPAddress::FromString("::1", addr);
+
+    err = gInet.NewUDPEndPoint(&testUDPEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    err = testUDPEP->Bind(kIPAddressType_IPv6, addr, kPort);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    testUDPEP->OnMessageReceived = HandleUDPChainReceived;
+    err                          = testUDPEP->Listen();
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    sUDPChainMessages = 0;
+    sUDPChainLength   = 0;
+    err               = testUDPEP->SendTo(addr, kPort, MakeUDPChain(kChainCount));
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    for (int i = 0; i < 100 && sUDPChainMessages == 0; i++)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 10000;
+        ServiceNetwork(sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sUDPChainMessages == 1);
+    NL_TEST_ASSERT(inSuite, sUDPChainLength == kChainCount * kUDPChainBufSize);
+
+    err = testUDPEP->SendTo(addr, kPort, MakeUDPChain(INET_CONFIG_SEND_IOV_MAX + 1));
+    NL_TEST_ASSERT(inSuite, err == INET_ERROR_MESSAGE_TOO_LONG);
+
+exit:
+    if (testUDPEP != NULL)
+        testUDPEP->Free();
+}
+
+static constexpr uint32_t kTCPStreamBufCount = 40;
+static constexpr uint16_t kTCPStreamBufSize  = 1000;
+
+static nlTestSuite * sTCPStreamSuite  = NULL;
+static TCPEndPoint * sTCPStreamConn   = NULL;
+static uint32_t sTCPStreamMaxRead     = 0;
+static uint32_t sTCPStreamLastPending = 0;
+static bool sTCPStreamDone            = false;
+
+static PacketBuffer * MakeTCPStreamChain(void)
+{
+    PacketBuffer * head = NULL;
+
+    for (uint32_t i = 0; i < kTCPStreamBufCount; i++)
+    {
+        PacketBuffer * buf = PacketBuffer::NewWithAvailableSize(0, kTCPStreamBufSize);
+
+        VerifyOrDie(buf != NULL);
+        for (uint16_t k = 0; k < kTCPStreamBufSize; k++)
+            buf->Start()[k] = static_cast<uint8_t>((i * kTCPStreamBufSize + k) % 251);
+        buf->SetDataLength(kTCPStreamBufSize);
+
+        if (head == NULL)
+            head = buf;
+        else
+            head->AddToEnd(buf);
+    }
+
+    return head;
+}
+
+// Hand the received data back until all of it has arrived, so that it accumulates in the receive queue.
+static void HandleTCPStreamDataReceived(TCPEndPoint * endPoint, PacketBuffer * data)
+{
+    uint32_t total  = data->TotalLength();
+    uint32_t offset = 0;
+
+    if (total - sTCPStreamLastPending > sTCPStreamMaxRead)
+        sTCPStreamMaxRead = total - sTCPStreamLastPending;
+    sTCPStreamLastPending = total;
+
+    if (total < kTCPStreamBufCount * kTCPStreamBufSize)
+    {
+        endPoint->PutBackReceivedData(data);
+        return;
+    }
+
+    NL_TEST_ASSERT(sTCPStreamSuite, total == kTCPStreamBufCount * kTCPStreamBufSize);
+    for (PacketBuffer * buf = data; buf != NULL; buf = buf->Next())
+    {
+        NL_TEST_ASSERT(sTCPStreamSuite, buf->DataLength() > 0);
+        for (uint16_t k = 0; k < buf->DataLength(); k++, offset++)
+        {
+            if (buf->Start()[k] != static_cast<uint8_t>(offset % 251))
+            {
+                NL_TEST_ASSERT(sTCPStreamSuite, false);
+                break;
+            }
+        }
+    }
+
+    endPoint->AckReceive(static_cast<uint16_t>(total > UINT16_MAX ? UINT16_MAX : total));
+    PacketBuffer::Free(data);
+    sTCPStreamDone = true;
+}
+
+static void HandleTCPStreamConnectionReceived(TCPEndPoint * listeningEndPoint, TCPEndPoint * conEndPoint,
+                                              const IPAddress & peerAddr, uint16_t peerPort)
+{
+    sTCPStreamConn              = conEndPoint;
+    conEndPoint->OnDataReceived = HandleTCPStreamDataReceived;
+}
+
+static void HandleTCPStreamConnectComplete(TCPEndPoint * endPoint, INET_ERROR err)
+{
+    NL_TEST_ASSERT(sTCPStreamSuite, err == INET_NO_ERROR);
+    if (err == INET_NO_ERROR)
+        endPoint->Send(MakeTCPStreamChain());
+}
+
+// Stream more data over loopback than one wake-up reads, and check that the receive queue reassembles it
+static void TestInetTCPReceiveStream(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr uint16_t kPort = 3101;
+    TCPEndPoint * listenEP   = NULL;
+    TCPEndPoint * clientEP   = NULL;
+    IPAddress addr;
+    INET_ERROR err;
+
+    IPAddress::FromString("::1", addr);
+
+    sTCPStreamSuite       = inSuite;
+    sTCPStreamConn        = NULL;
+    sTCPStreamMaxRead     = 0;
+    sTCPStreamLastPending = 0;
+    sTCPStreamDone        = false;
+
+    err = gInet.NewTCPEndPoint(&listenEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    err = listenEP->Bind(kIPAddressType_IPv6, addr, kPort, true);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    listenEP->OnConnectionReceived = HandleTCPStreamConnectionReceived;
+    err                            = listenEP->Listen(1);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    err = gInet.NewTCPEndPoint(&clientEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    clientEP->OnConnectComplete = HandleTCPStreamConnectComplete;
+    err                         = clientEP->Connect(addr, kPort);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    for (int i = 0; i < 200 && !sTCPStreamDone; i++)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 10000;
+        ServiceNetwork(sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sTCPStreamDone);
+
+    // Once reads kept filling everything they were given, later wake-ups read into more than one new buffer.
+    NL_TEST_ASSERT(inSuite, sTCPStreamMaxRead > CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX);
+
+exit:
+    if (sTCPStreamConn != NULL)
+        sTCPStreamConn->Free();
+    if (clientEP != NULL)
+        clientEP->Free();
+    if (listenEP != NULL)
+        listenEP->Free();
+}
+
+static TCPEndPoint * sTCPPartialConn = NULL;
+static uint32_t sTCPPartialReceived  = 0;
+
+static void HandleTCPPartialDataReceived(TCPEndPoint * endPoint, PacketBuffer * data)
+{
+    uint32_t total = data->TotalLength();
+
+    sTCPPartialReceived += total;
+    endPoint->AckReceive(static_cast<uint16_t>(total > UINT16_MAX ? UINT16_MAX : total));
+    PacketBuffer::Free(data);
+}
+
+static void HandleTCPPartialConnectionReceived(TCPEndPoint * listeningEndPoint, TCPEndPoint * conEndPoint,
+                                               const IPAddress & peerAddr, uint16_t peerPort)
+{
+    sTCPPartialConn             = conEndPoint;
+    conEndPoint->OnDataReceived = HandleTCPPartialDataReceived;
+    conEndPoint->DisableReceive();
+}
+
+// Send while the peer is not reading until a write is cut short, and check that the buffers the kernel accepted
+// in full left the send queue, that the next one was consumed up to the bytes accepted, and that the rest is sent
+// once the peer reads again
+static void TestInetTCPPartialSend(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kChainLength = INET_CONFIG_SEND_IOV_MAX;
+    constexpr uint16_t kBufSize   = 1024;
+    constexpr uint16_t kPort      = 3103;
+    TCPEndPoint * listenEP        = NULL;
+    TCPEndPoint * clientEP        = NULL;
+    PacketBuffer * bufs[kChainLength];
+    uint32_t totalSent = 0;
+    uint32_t accepted  = 0;
+    uint32_t pending   = 0;
+    IPAddress addr;
+    INET_ERROR err;
+
+    IPAddress::FromString("::1", addr);
+    memset(bufs, 0, sizeof(bufs));
+
+    sTCPPartialConn     = NULL;
+    sTCPPartialReceived = 0;
+
+    err = gInet.NewTCPEndPoint(&listenEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    err = listenEP->Bind(kIPAddressType_IPv6, addr, kPort, true);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    listenEP->OnConnectionReceived = HandleTCPPartialConnectionReceived;
+    err                            = listenEP->Listen(1);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    err = gInet.NewTCPEndPoint(&clientEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    err = clientEP->Connect(addr, kPort);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    for (int i = 0; i < 100 && (sTCPPartialConn == NULL || !clientEP->IsConnected()); i++)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 10000;
+        ServiceNetwork(sleepTime);
+    }
+    NL_TEST_ASSERT(inSuite, sTCPPartialConn != NULL && clientEP->IsConnected());
+    VerifyOrExit(sTCPPartialConn != NULL && clientEP->IsConnected(), );
+
+    // Keep a reference to each buffer sent, to see what the send queue does with it.
+    for (int i = 0; i < 8192 && pending == 0; i++)
+    {
+        PacketBuffer * chain = NULL;
+
+        for (size_t k = 0; k < kChainLength; k++)
+        {
+            PacketBuffer::Free(bufs[k]);
+            bufs[k] = PacketBuffer::NewWithAvailableSize(0, kBufSize);
+            NL_TEST_ASSERT(inSuite, bufs[k] != NULL);
+            VerifyOrExit(bufs[k] != NULL, );
+            memset(bufs[k]->Start(), 0x5A, kBufSize);
+            bufs[k]->SetDataLength(kBufSize);
+            bufs[k]->AddRef();
+
+            if (chain == NULL)
+                chain = bufs[k];
+            else
+                chain->AddToEnd(bufs[k]);
+        }
+
+        err = clientEP->Send(chain);
+        NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+        VerifyOrExit(err == INET_NO_ERROR, );
+
+        totalSent += kChainLength * kBufSize;
+        pending = clientEP->PendingSendLength();
+    }
+    NL_TEST_ASSERT(inSuite, pending > 0);
+
+    accepted = kChainLength * kBufSize - pending;
+    for (size_t k = 0; k < kChainLength; k++)
+    {
+        if ((k + 1) * kBufSize <= accepted)
+        {
+            NL_TEST_ASSERT(inSuite, bufs[k]->Next() == NULL);
+        }
+        else if (k * kBufSize < accepted)
+        {
+            NL_TEST_ASSERT(inSuite, bufs[k]->DataLength() == (k + 1) * kBufSize - accepted);
+        }
+        else
+        {
+            NL_TEST_ASSERT(inSuite, bufs[k]->DataLength() == kBufSize);
+        }
+    }
+
+    sTCPPartialConn->EnableReceive();
+
+    // Each wake-up reads a few buffers at most, so wait for the data to stop arriving rather than for a fixed time.
+    for (int idle = 0; idle < 100 && sTCPPartialReceived < totalSent;)
+    {
+        struct timeval sleepTime;
+        uint32_t received = sTCPPartialReceived;
+
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 10000;
+        ServiceNetwork(sleepTime);
+
+        idle = (sTCPPartialReceived == received) ? idle + 1 : 0;
+    }
+
+    NL_TEST_ASSERT(inSuite, sTCPPartialReceived == totalSent);
+    NL_TEST_ASSERT(inSuite, clientEP->PendingSendLength() == 0);
+
+exit:
+    for (size_t k = 0; k < kChainLength; k++)
+        PacketBuffer::Free(bufs[k]);
+    if (sTCPPartialConn != NULL)
+        sTCPPartialConn->Free();
+    if (clientEP != NULL)
+        clientEP->Free();
+    if (listenEP != NULL)
+        listenEP->Free();
+}
+
 // Test the InetLayer resource limitation
 static void TestInetEndPointLimit(nlTestSuite * inSuite, void * inContext)
 {
@@ -564,6 +1084,11 @@ static const nlTest sTests[] = { NL_TEST_DEF("InetEndPoint::PreTest", TestInetPr
                                  NL_TEST_DEF("InetEndPoint::TestInetError", TestInetError),
                                  NL_TEST_DEF("InetEndPoint::TestInetInterface", TestInetInterface),
                                  NL_TEST_DEF("InetEndPoint::TestInetEndPoint", TestInetEndPoint),
+                                 NL_TEST_DEF("InetEndPoint::TestUDPSendMsgs", TestInetUDPSendMsgs),
+                                 NL_TEST_DEF("InetEndPoint::TestUDPFreeInHandler", TestInetUDPFreeInHandler),
+                                 NL_TEST_DEF("InetEndPoint::TestUDPSendChain", TestInetUDPSendChain),
+                                 NL_TEST_DEF("InetEndPoint::TestTCPReceiveStream", TestInetTCPReceiveStream),
+                                 NL_TEST_DEF("InetEndPoint::TestTCPPartialSend", TestInetTCPPartialSend),
                                  NL_TEST_DEF("InetEndPoint::TestEndPointLimit", TestInetEndPointLimit),
                                  NL_TEST_SENTINEL() };
 
@@ -0,0 +1,500 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for moving data through
+ *      UDP and TCP endpoints over the loopback interface, driven by the
+ *      same event loop as the platform (select(), or epoll when
+ *      CHIP_SYSTEM_CONFIG_USE_EPOLL is enabled).
+ *
+ */
+
+#include "TestInetLayer.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <inet/InetError.h>
+#include <inet/InetLayer.h>
+
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <support/TestUtils.h>
+
+#include <system/SystemError.h>
+#include <system/SystemLayer.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <nlunit-test.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#include <sys/select.h>
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+using namespace chip;
+using namespace chip::Inet;
+using namespace chip::System;
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+static System::Layer sSystemLayer;
+static InetLayer sInet;
+
+static void ServiceEvents(void)
+{
+    struct timeval sleepTime;
+
+    sleepTime.tv_sec  = 0;
+    sleepTime.tv_usec = 10000;
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    struct epoll_event events[CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS];
+
+    sSystemLayer.PrepareEpoll();
+
+    int eventCount = epoll_wait(sSystemLayer.GetEpollFD(), events, CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS,
+                                static_cast<int>(sleepTime.tv_usec / 1000));
+    if (eventCount < 0)
+    {
+        printf("epoll_wait failed: %s\n", ErrorStr(MapErrorPOSIX(errno)));
+        return;
+    }
+
+    sSystemLayer.HandleEpollResult(events, eventCount);
+    sInet.HandleEpollResult(events, eventCount);
+#else  // !CHIP_SYSTEM_CONFIG_USE_EPOLL
+    fd_set readFDs, writeFDs, exceptFDs;
+    int numFDs = 0;
+
+    FD_ZERO(&readFDs);
+    FD_ZERO(&writeFDs);
+    FD_ZERO(&exceptFDs);
+
+    sSystemLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+    sInet.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+
+    int selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &sleepTime);
+    if (selectRes < 0)
+    {
+        printf("select failed: %s\n", ErrorStr(MapErrorPOSIX(errno)));
+        return;
+    }
+
+    sSystemLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+    sInet.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
+}
+
+static void ServiceEventsUntil(const bool & aDone)
+{
+    for (int i = 0; i < 200 && !aDone; i++)
+        ServiceEvents();
+}
+
+static void GetLoopbackAddress(IPAddress & aAddr, IPAddressType & aAddrType)
+{
+#if INET_CONFIG_ENABLE_IPV4
+    IPAddress::FromString("127.0.0.1", aAddr);
+    aAddrType = kIPAddressType_IPv4;
+#else  // !INET_CONFIG_ENABLE_IPV4
+    IPAddress::FromString("::1", aAddr);
+    aAddrType = kIPAddressType_IPv6;
+#endif // !INET_CONFIG_ENABLE_IPV4
+}
+
+static PacketBuffer * MakeMessage(uint8_t aValue, uint16_t aLength)
+{
+    PacketBuffer * lBuf = PacketBuffer::New();
+
+    if (lBuf != NULL)
+    {
+        memset(lBuf->Start(), aValue, aLength);
+        lBuf->SetDataLength(aLength);
+    }
+
+    return lBuf;
+}
+
+// UDP
+
+static const uint16_t kUDPServerPort = 4201;
+static const uint16_t kUDPClientPort = 4202;
+static const uint16_t kUDPReusePort  = 4203;
+static const size_t kUDPMessageCount = 10;
+
+static size_t sUDPEchoed   = 0;
+static size_t sUDPReceived = 0;
+static bool sUDPDone       = false;
+
+static void HandleUDPEcho(IPEndPointBasis * endPoint, PacketBuffer * msg, const IPPacketInfo * pktInfo)
+{
+    static_cast<UDPEndPoint *>(endPoint)->SendTo(pktInfo->SrcAddress, pktInfo->SrcPort, msg);
+    sUDPEchoed++;
+}
+
+static void HandleUDPReceived(IPEndPointBasis * endPoint, PacketBuffer * msg, const IPPacketInfo * pktInfo)
+{
+    PacketBuffer::Free(msg);
+    sUDPReceived++;
+    sUDPDone = (sUDPReceived == kUDPMessageCount);
+}
+
+static void CheckUDPEcho(nlTestSuite * inSuite, void * inContext)
+{
+    UDPEndPoint * serverEP = NULL;
+    UDPEndPoint * clientEP = NULL;
+    IPAddress addr;
+    IPAddressType addrType;
+    INET_ERROR err;
+
+    GetLoopbackAddress(addr, addrType);
+
+    sUDPEchoed   = 0;
+    sUDPReceived = 0;
+    sUDPDone     = false;
+
+    err = sInet.NewUDPEndPoint(&serverEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    err = serverEP->Bind(addrType, addr, kUDPServerPort);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    serverEP->OnMessageReceived = HandleUDPEcho;
+    err                         = serverEP->Listen();
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    err = sInet.NewUDPEndPoint(&clientEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    err = clientEP->Bind(addrType, addr, kUDPClientPort);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    clientEP->OnMessageReceived = HandleUDPReceived;
+    err                         = clientEP->Listen();
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    for (size_t i = 0; i < kUDPMessageCount; i++)
+    {
+        err = clientEP->SendTo(addr, kUDPServerPort, MakeMessage(static_cast<uint8_t>(i), 64));
+        NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    }
+
+    ServiceEventsUntil(sUDPDone);
+
+    NL_TEST_ASSERT(inSuite, sUDPEchoed == kUDPMessageCount);
+    NL_TEST_ASSERT(inSuite, sUDPReceived == kUDPMessageCount);
+
+exit:
+    if (clientEP != NULL)
+        clientEP->Free();
+    if (serverEP != NULL)
+        serverEP->Free();
+}
+
+static void CheckUDPReuse(nlTestSuite * inSuite, void * inContext)
+{
+    UDPEndPoint * firstEP  = NULL;
+    UDPEndPoint * secondEP = NULL;
+    UDPEndPoint * senderEP = NULL;
+    IPAddress addr;
+    IPAddressType addrType;
+    INET_ERROR err;
+
+    GetLoopbackAddress(addr, addrType);
+
+    sUDPReceived = 0;
+    sUDPDone     = false;
+
+    // Free a listening endpoint, so that the next one is likely to be allocated in the same pool slot, and check that
+    // the new socket is watched rather than the old one.
+    err = sInet.NewUDPEndPoint(&firstEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    err = firstEP->Bind(addrType, addr, kUDPReusePort);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    firstEP->OnMessageReceived = HandleUDPReceived;
+    err                        = firstEP->Listen();
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    firstEP->Free();
+    firstEP = NULL;
+
+    err = sInet.NewUDPEndPoint(&secondEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    err = secondEP->Bind(addrType, addr, kUDPReusePort);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    secondEP->OnMessageReceived = HandleUDPReceived;
+    err                         = secondEP->Listen();
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    err = sInet.NewUDPEndPoint(&senderEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    err = senderEP->Bind(addrType, addr, 0);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    for (size_t i = 0; i < kUDPMessageCount; i++)
+    {
+        err = senderEP->SendTo(addr, kUDPReusePort, MakeMessage(static_cast<uint8_t>(i), 16));
+        NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    }
+
+    ServiceEventsUntil(sUDPDone);
+
+    NL_TEST_ASSERT(inSuite, sUDPReceived == kUDPMessageCount);
+
+exit:
+    if (senderEP != NULL)
+        senderEP->Free();
+    if (secondEP != NULL)
+        secondEP->Free();
+    if (firstEP != NULL)
+        firstEP->Free();
+}
+
+// TCP
+
+static const uint16_t kTCPPort        = 4204;
+static const uint16_t kTCPMessageSize = 512;
+
+static nlTestSuite * sTCPSuite  = NULL;
+static TCPEndPoint * sTCPConn   = NULL;
+static bool sTCPDisableOnAccept = false;
+static uint32_t sTCPServerBytes = 0;
+static uint32_t sTCPClientBytes = 0;
+static bool sTCPClientDone      = false;
+static bool sTCPServerClosed    = false;
+
+static void HandleTCPServerDataReceived(TCPEndPoint * endPoint, PacketBuffer * data)
+{
+    sTCPServerBytes += data->TotalLength();
+
+    // Echo what was received; the endpoint takes ownership of the buffers.
+    endPoint->Send(data);
+}
+
+static void HandleTCPServerConnectionClosed(TCPEndPoint * endPoint, INET_ERROR err)
+{
+    sTCPServerClosed = true;
+}
+
+static void HandleTCPServerPeerClose(TCPEndPoint * endPoint)
+{
+    endPoint->Close();
+    sTCPServerClosed = true;
+}
+
+static void HandleTCPConnectionReceived(TCPEndPoint * listeningEndPoint, TCPEndPoint * conEndPoint, const IPAddress & peerAddr,
+                                        uint16_t peerPort)
+{
+    sTCPConn                        = conEndPoint;
+    conEndPoint->OnDataReceived     = HandleTCPServerDataReceived;
+    conEndPoint->OnConnectionClosed = HandleTCPServerConnectionClosed;
+    conEndPoint->OnPeerClose        = HandleTCPServerPeerClose;
+
+    if (sTCPDisableOnAccept)
+        conEndPoint->DisableReceive();
+}
+
+static void HandleTCPClientDataReceived(TCPEndPoint * endPoint, PacketBuffer * data)
+{
+    sTCPClientBytes += data->TotalLength();
+    endPoint->AckReceive(data->TotalLength());
+    PacketBuffer::Free(data);
+
+    if (sTCPClientBytes == kTCPMessageSize)
+    {
+        endPoint->Shutdown();
+        sTCPClientDone = true;
+    }
+}
+
+static void HandleTCPClientConnectComplete(TCPEndPoint * endPoint, INET_ERROR err)
+{
+    NL_TEST_ASSERT(sTCPSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    // Set from within a callback: the endpoint waits for data from here on.
+    endPoint->OnDataReceived = HandleTCPClientDataReceived;
+
+    err = endPoint->Send(MakeMessage(0x5a, kTCPMessageSize));
+    NL_TEST_ASSERT(sTCPSuite, err == INET_NO_ERROR);
+
+exit:
+    return;
+}
+
+static void RunTCPEcho(nlTestSuite * inSuite, bool aDisableOnAccept)
+{
+    TCPEndPoint * listenEP = NULL;
+    TCPEndPoint * clientEP = NULL;
+    IPAddress addr;
+    IPAddressType addrType;
+    INET_ERROR err;
+
+    GetLoopbackAddress(addr, addrType);
+
+    sTCPSuite           = inSuite;
+    sTCPConn            = NULL;
+    sTCPDisableOnAccept = aDisableOnAccept;
+    sTCPServerBytes     = 0;
+    sTCPClientBytes     = 0;
+    sTCPClientDone      = false;
+    sTCPServerClosed    = false;
+
+    err = sInet.NewTCPEndPoint(&listenEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    err = listenEP->Bind(addrType, addr, kTCPPort, true);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    listenEP->OnConnectionReceived = HandleTCPConnectionReceived;
+    err                            = listenEP->Listen(1);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    err = sInet.NewTCPEndPoint(&clientEP);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+    VerifyOrExit(err == INET_NO_ERROR, );
+
+    clientEP->OnConnectComplete = HandleTCPClientConnectComplete;
+    err                         = clientEP->Connect(addr, kTCPPort);
+    NL_TEST_ASSERT(inSuite, err == INET_NO_ERROR);
+
+    if (aDisableOnAccept)
+    {
+        // Nothing is read from a connection while its receive is disabled.
+        for (int i = 0; i < 20; i++)
+            ServiceEvents();
+
+        NL_TEST_ASSERT(inSuite, sTCPConn != NULL);
+        VerifyOrExit(sTCPConn != NULL, );
+        NL_TEST_ASSERT(inSuite, sTCPServerBytes == 0);
+
+        // Enabled outside of any callback.
+        sTCPConn->EnableReceive();
+    }
+
+    ServiceEventsUntil(sTCPClientDone);
+
+    NL_TEST_ASSERT(inSuite, sTCPServerBytes == kTCPMessageSize);
+    NL_TEST_ASSERT(inSuite, sTCPClientBytes == kTCPMessageSize);
+
+    // The client shut down its side once it had the echo; the server sees the peer close.
+    ServiceEventsUntil(sTCPServerClosed);
+
+    NL_TEST_ASSERT(inSuite, sTCPServerClosed);
+
+exit:
+    if (sTCPConn != NULL)
+        sTCPConn->Free();
+    if (clientEP != NULL)
+        clientEP->Free();
+    if (listenEP != NULL)
+        listenEP->Free();
+}
+
+static void CheckTCPEcho(nlTestSuite * inSuite, void * inContext)
+{
+    RunTCPEcho(inSuite, false);
+}
+
+static void CheckTCPReceiveDisabled(nlTestSuite * inSuite, void * inContext)
+{
+    RunTCPEcho(inSuite, true);
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("InetEndPointIO::UDPEcho",            CheckUDPEcho),
+    NL_TEST_DEF("InetEndPointIO::UDPReuse",           CheckUDPReuse),
+    NL_TEST_DEF("InetEndPointIO::TCPEcho",            CheckTCPEcho),
+    NL_TEST_DEF("InetEndPointIO::TCPReceiveDisabled", CheckTCPReceiveDisabled),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void * inContext)
+{
+    if (sSystemLayer.Init(NULL) != CHIP_SYSTEM_NO_ERROR)
+        return FAILURE;
+
+    if (sInet.Init(sSystemLayer, NULL) != INET_NO_ERROR)
+        return FAILURE;
+
+    return SUCCESS;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void * inContext)
+{
+    sInet.Shutdown();
+    sSystemLayer.Shutdown();
+
+    return SUCCESS;
+}
+
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+int TestInetEndPointIO(void)
+{
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "inet-endpoint-io",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+    // clang-format on
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+#else  // !CHIP_SYSTEM_CONFIG_USE_SOCKETS
+    return (0);
+#endif // !CHIP_SYSTEM_CONFIG_USE_SOCKETS
+}
+
+static void __attribute__((constructor)) TestCHIPInetEndPointIOCtor(void)
+{
+    VerifyOrDie(RegisterUnitTests(&TestInetEndPointIO) == CHIP_NO_ERROR);
+}
@@ -31,6 +31,7 @@ extern "C" {
 
 int TestInetAddress(void);
 int TestInetBuffer(void);
+int TestInetEndPointIO(void);
 int TestInetErrorStr(void);
 int TestInetTimer(void);
 
@@ -1002,6 +1002,21 @@
 #define CHIP_CONFIG_MAX_PEER_NODES                         128
 #endif // CHIP_CONFIG_MAX_PEER_NODES
 
+/**
+ *  @def CHIP_CONFIG_PEER_NODE_HASH_BUCKETS
+ *
+ *  @brief
+ *    Number of hash buckets used by the fabric state to look up the
+ *    message counter state of a peer node.
+ *
+ *    Each bucket costs two bytes.  Using about as many buckets as
+ *    #CHIP_CONFIG_MAX_PEER_NODES keeps lookups close to constant time.
+ *
+ */
+#ifndef CHIP_CONFIG_PEER_NODE_HASH_BUCKETS
+#define CHIP_CONFIG_PEER_NODE_HASH_BUCKETS                 CHIP_CONFIG_MAX_PEER_NODES
+#endif // CHIP_CONFIG_PEER_NODE_HASH_BUCKETS
+
 /**
  *  @def CHIP_CONFIG_MAX_CONNECTIONS
  *
@@ -1066,6 +1081,21 @@
 #define CHIP_CONFIG_MAX_SESSION_KEYS                       CHIP_CONFIG_MAX_CONNECTIONS
 #endif // CHIP_CONFIG_MAX_SESSION_KEYS
 
+/**
+ *  @def CHIP_CONFIG_SESSION_KEY_HASH_BUCKETS
+ *
+ *  @brief
+ *    Number of hash buckets used by the fabric state to look up the
+ *    session keys shared with a peer node.
+ *
+ *    Each bucket costs two bytes.  Using about as many buckets as
+ *    #CHIP_CONFIG_MAX_SESSION_KEYS keeps lookups close to constant time.
+ *
+ */
+#ifndef CHIP_CONFIG_SESSION_KEY_HASH_BUCKETS
+#define CHIP_CONFIG_SESSION_KEY_HASH_BUCKETS               CHIP_CONFIG_MAX_SESSION_KEYS
+#endif // CHIP_CONFIG_SESSION_KEY_HASH_BUCKETS
+
 /**
  *  @def CHIP_CONFIG_MAX_APPLICATION_EPOCH_KEYS
  *
@@ -1221,6 +1251,60 @@
 #define CHIP_CONFIG_DEFAULT_SECURITY_SESSION_IDLE_TIMEOUT           15000
 #endif // CHIP_CONFIG_DEFAULT_SECURITY_SESSION_IDLE_TIMEOUT
 
+/**
+ *  @def CHIP_CONFIG_MAX_SESSION_ESTABLISHMENTS
+ *
+ *  @brief
+ *    The maximum number of CASE, PASE, TAKE or key export interactions
+ *    that the security manager can have in progress at the same time.
+ *
+ *    Each one holds an exchange context and, while it runs, the engine
+ *    state of its protocol. Further requests fail with
+ *    #CHIP_ERROR_SECURITY_MANAGER_BUSY until one of them completes.
+ *    ChipSecurityManager::MaxConcurrentSessionEstablishments can lower
+ *    the limit at run time.
+ *
+ *    The fixed-size security memory pools are sized for one interaction,
+ *    so MaxConcurrentSessionEstablishments starts at this value only with
+ *    #CHIP_CONFIG_MEMORY_MGMT_MALLOC, and at 1 otherwise.
+ *
+ */
+#ifndef CHIP_CONFIG_MAX_SESSION_ESTABLISHMENTS
+#define CHIP_CONFIG_MAX_SESSION_ESTABLISHMENTS                      4
+#endif // CHIP_CONFIG_MAX_SESSION_ESTABLISHMENTS
+
+/**
+ *  @def CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+ *
+ *  @brief
+ *    Run the ECDH and signature steps of CASE session establishment,
+ *    the ones bracketed by OnTimeConsumingCryptoStart() and
+ *    OnTimeConsumingCryptoDone(), on a worker thread instead of the
+ *    CHIP thread, so that other exchanges and session establishments
+ *    progress while they run.
+ *
+ *    The CASE auth delegate is called from the worker thread while a
+ *    step runs, and so must not rely on being called from the CHIP thread.
+ *    The security manager never calls it from both threads at once.
+ *
+ *    Requires POSIX threads (#CHIP_SYSTEM_CONFIG_POSIX_LOCKING), and the
+ *    thread-safe malloc allocator (#CHIP_CONFIG_MEMORY_MGMT_MALLOC) and
+ *    OpenSSL random number generator (#CHIP_CONFIG_RNG_IMPLEMENTATION_OPENSSL),
+ *    as both threads allocate security memory and draw random data.
+ *
+ */
+#ifndef CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+#define CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER                      0
+#endif // CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER && !CHIP_CONFIG_MEMORY_MGMT_MALLOC
+#error "Please assert CHIP_CONFIG_MEMORY_MGMT_MALLOC when CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER is asserted"
+#endif // CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER && !CHIP_CONFIG_MEMORY_MGMT_MALLOC
+
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER && !CHIP_CONFIG_RNG_IMPLEMENTATION_OPENSSL
+#error "Please assert CHIP_CONFIG_RNG_IMPLEMENTATION_OPENSSL when CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER is asserted"
+#endif // CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER && !CHIP_CONFIG_RNG_IMPLEMENTATION_OPENSSL
+
 /**
  *  @def CHIP_CONFIG_NUM_MESSAGE_BUFS
  *
@@ -1256,6 +1340,34 @@
 #define CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS                  16
 #endif // CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS
 
+/**
+ *  @def CHIP_CONFIG_EXCHANGE_CONTEXT_HASH_BUCKETS
+ *
+ *  @brief
+ *    Number of hash buckets used by the exchange manager to look up
+ *    the exchange context an inbound message belongs to.
+ *
+ *    Each bucket costs two bytes.  Using about as many buckets as
+ *    #CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS keeps lookups close to
+ *    constant time.
+ *
+ */
+#ifndef CHIP_CONFIG_EXCHANGE_CONTEXT_HASH_BUCKETS
+#define CHIP_CONFIG_EXCHANGE_CONTEXT_HASH_BUCKETS          CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS
+#endif // CHIP_CONFIG_EXCHANGE_CONTEXT_HASH_BUCKETS
+
+/**
+ *  @def CHIP_CONFIG_UNSOLICITED_MESSAGE_HANDLER_HASH_BUCKETS
+ *
+ *  @brief
+ *    Number of hash buckets used by the exchange manager to look up
+ *    the unsolicited message handler for a profile and message type.
+ *
+ */
+#ifndef CHIP_CONFIG_UNSOLICITED_MESSAGE_HANDLER_HASH_BUCKETS
+#define CHIP_CONFIG_UNSOLICITED_MESSAGE_HANDLER_HASH_BUCKETS 16
+#endif // CHIP_CONFIG_UNSOLICITED_MESSAGE_HANDLER_HASH_BUCKETS
+
 
 /**
  *  @def CHIP_CONFIG_CONNECT_IP_ADDRS
@@ -2294,12 +2406,36 @@
 /**
  * @def CHIP_PEER_CONNECTION_TIMEOUT_CHECK_FREQUENCY_MS
  *
- * @brief How frequent are peer connections checked for timeouts.
+ * @brief Minimum interval between two checks of peer connections for
+ * timeouts. Checks are otherwise only scheduled for when the least
+ * recently active connection is due to expire.
  */
 #ifndef CHIP_PEER_CONNECTION_TIMEOUT_CHECK_FREQUENCY_MS
 #define CHIP_PEER_CONNECTION_TIMEOUT_CHECK_FREQUENCY_MS      5000
 #endif // CHIP_PEER_CONNECTION_TIMEOUT_CHECK_FREQUENCY_MS
 
+/**
+ * @def CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE
+ *
+ * @brief Number of message counters below the highest received one
+ * (inclusive) that are tracked per peer connection to detect replayed
+ * messages. Older messages are rejected. Must be a multiple of 32.
+ */
+#ifndef CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE
+#define CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE              64
+#endif // CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE
+
+/**
+ * @def CHIP_CONFIG_SECURE_SEND_BATCH_SIZE
+ *
+ * @brief Maximum number of messages encrypted together when a batch of
+ * messages is sent to a peer. Larger batches are processed in chunks of
+ * this size, each of which needs a message header on the stack per message.
+ */
+#ifndef CHIP_CONFIG_SECURE_SEND_BATCH_SIZE
+#define CHIP_CONFIG_SECURE_SEND_BATCH_SIZE                   8
+#endif // CHIP_CONFIG_SECURE_SEND_BATCH_SIZE
+
 /**
    *  @def CHIP_CONFIG_MAX_BINDINGS
    *
@@ -612,6 +612,9 @@ bool FormatCHIPError(char * buf, uint16_t bufSize, int32_t err)
     case CHIP_ERROR_UNSUPPORTED_WIRELESS_OPERATING_LOCATION:
         desc = "Unsupported wireless operating location";
         break;
+    case CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED:
+        desc = "Duplicate message received";
+        break;
     }
 #endif // !CHIP_CONFIG_SHORT_ERROR_STR
 
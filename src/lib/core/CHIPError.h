@@ -1756,6 +1756,16 @@ typedef CHIP_CONFIG_ERROR_TYPE CHIP_ERROR;
  */
 #define CHIP_ERROR_UNSUPPORTED_WIRELESS_OPERATING_LOCATION      _CHIP_ERROR(190)
 
+/**
+ *  @def CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED
+ *
+ *  @brief
+ *    A message with the same message counter was already received, or the
+ *    message counter is too old to tell.
+ *
+ */
+#define CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED                   _CHIP_ERROR(191)
+
 /**
  *  @}
  */
@@ -37,13 +37,19 @@
 #include <stdarg.h>
 #include <stdlib.h>
 
-// forward declaration of the PacketBuffer class used within the header.
+// forward declaration of the PacketBuffer and MemoryArena classes used within the header.
 namespace chip {
 namespace System {
 
 class PacketBuffer;
 
 } // namespace System
+
+namespace Platform {
+
+class MemoryArena;
+
+} // namespace Platform
 } // namespace chip
 
 /**
@@ -125,8 +131,10 @@ public:
     CHIP_ERROR Get(double & v);
     CHIP_ERROR GetBytes(uint8_t * buf, uint32_t bufSize);
     CHIP_ERROR DupBytes(uint8_t *& buf, uint32_t & dataLen);
+    CHIP_ERROR DupBytes(uint8_t *& buf, uint32_t & dataLen, chip::Platform::MemoryArena & arena);
     CHIP_ERROR GetString(char * buf, uint32_t bufSize);
     CHIP_ERROR DupString(char *& buf);
+    CHIP_ERROR DupString(char *& buf, chip::Platform::MemoryArena & arena);
     CHIP_ERROR GetDataPtr(const uint8_t *& data);
 
     CHIP_ERROR EnterContainer(TLVType & outerContainerType);
@@ -232,6 +240,7 @@ public:
     CHIP_ERROR Put(uint64_t tag, double v);
     CHIP_ERROR PutBoolean(uint64_t tag, bool v);
     CHIP_ERROR PutBytes(uint64_t tag, const uint8_t * buf, uint32_t len);
+    CHIP_ERROR PutBytes(uint64_t tag, PacketBuffer * data);
     CHIP_ERROR PutString(uint64_t tag, const char * buf);
     CHIP_ERROR PutString(uint64_t tag, const char * buf, uint32_t len);
     CHIP_ERROR PutStringF(uint64_t tag, const char * fmt, ...);
@@ -378,8 +387,13 @@ public:
     CHIP_ERROR Get(double & v) { return mUpdaterReader.Get(v); }
     CHIP_ERROR GetBytes(uint8_t * buf, uint32_t bufSize) { return mUpdaterReader.GetBytes(buf, bufSize); }
     CHIP_ERROR DupBytes(uint8_t *& buf, uint32_t & dataLen) { return mUpdaterReader.DupBytes(buf, dataLen); }
+    CHIP_ERROR DupBytes(uint8_t *& buf, uint32_t & dataLen, chip::Platform::MemoryArena & arena)
+    {
+        return mUpdaterReader.DupBytes(buf, dataLen, arena);
+    }
     CHIP_ERROR GetString(char * buf, uint32_t bufSize) { return mUpdaterReader.GetString(buf, bufSize); }
     CHIP_ERROR DupString(char *& buf) { return mUpdaterReader.DupString(buf); }
+    CHIP_ERROR DupString(char *& buf, chip::Platform::MemoryArena & arena) { return mUpdaterReader.DupString(buf, arena); }
 
     TLVType GetType(void) const { return mUpdaterReader.GetType(); }
     uint64_t GetTag(void) const { return mUpdaterReader.GetTag(); }
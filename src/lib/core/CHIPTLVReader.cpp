@@ -27,6 +27,7 @@
 #include <core/CHIPCore.h>
 #include <core/CHIPEncoding.h>
 #include <core/CHIPTLV.h>
+#include <support/CHIPMemArena.h>
 #include <support/CodeUtils.h>
 #include <system/SystemPacketBuffer.h>
 
@@ -757,6 +758,100 @@ CHIP_ERROR TLVReader::DupString(char *& buf)
 #endif // HAVE_MALLOC && HAVE_FREE
 }
 
+/**
+ * Allocates from an arena and returns a buffer containing the value of the current byte or UTF8
+ * string.
+ *
+ * This method behaves like DupBytes(uint8_t *&, uint32_t &), except that the buffer is allocated
+ * from @p arena and is released with the arena's other allocations rather than freed by the caller.
+ *
+ * @note The data returned by this method is NOT null-terminated.
+ *
+ * @param[out] buf                      A reference to a pointer to which a buffer of @p dataLen bytes
+ *                                      will be assigned on success.
+ * @param[out] dataLen                  A reference to storage for the size, in bytes, of @p buf on
+ *                                      success.
+ * @param[in]  arena                    The arena to allocate the buffer from.
+ *
+ * @retval #CHIP_NO_ERROR              If the method succeeded.
+ * @retval #CHIP_ERROR_WRONG_TLV_TYPE  If the current element is not a TLV byte or UTF8 string, or
+ *                                      the reader is not positioned on an element.
+ * @retval #CHIP_ERROR_NO_MEMORY       If the arena does not have enough space left for the buffer.
+ * @retval #CHIP_ERROR_TLV_UNDERRUN    If the underlying TLV encoding ended prematurely.
+ * @retval other                        Other CHIP or platform error codes returned by the configured
+ *                                      GetNextBuffer() function. Only possible when GetNextBuffer
+ *                                      is non-NULL.
+ *
+ */
+CHIP_ERROR TLVReader::DupBytes(uint8_t *& buf, uint32_t & dataLen, chip::Platform::MemoryArena & arena)
+{
+    const size_t mark = arena.Mark();
+
+    if (!TLVTypeIsString(ElementType()))
+        return CHIP_ERROR_WRONG_TLV_TYPE;
+
+    buf = (uint8_t *) arena.Alloc(mElemLenOrVal);
+    if (buf == NULL)
+        return CHIP_ERROR_NO_MEMORY;
+
+    CHIP_ERROR err = ReadData(buf, (uint32_t) mElemLenOrVal);
+    if (err != CHIP_NO_ERROR)
+    {
+        arena.Rewind(mark);
+        return err;
+    }
+
+    dataLen       = mElemLenOrVal;
+    mElemLenOrVal = 0;
+
+    return CHIP_NO_ERROR;
+}
+
+/**
+ * Allocates from an arena and returns a buffer containing the null-terminated value of the current
+ * byte or UTF8 string.
+ *
+ * This method behaves like DupString(char *&), except that the buffer is allocated from @p arena
+ * and is released with the arena's other allocations rather than freed by the caller.
+ *
+ * @param[out] buf                      A reference to a pointer to which a buffer will be assigned
+ *                                      on success.
+ * @param[in]  arena                    The arena to allocate the buffer from.
+ *
+ * @retval #CHIP_NO_ERROR              If the method succeeded.
+ * @retval #CHIP_ERROR_WRONG_TLV_TYPE  If the current element is not a TLV byte or UTF8 string, or
+ *                                      the reader is not positioned on an element.
+ * @retval #CHIP_ERROR_NO_MEMORY       If the arena does not have enough space left for the buffer.
+ * @retval #CHIP_ERROR_TLV_UNDERRUN    If the underlying TLV encoding ended prematurely.
+ * @retval other                        Other CHIP or platform error codes returned by the configured
+ *                                      GetNextBuffer() function. Only possible when GetNextBuffer
+ *                                      is non-NULL.
+ *
+ */
+CHIP_ERROR TLVReader::DupString(char *& buf, chip::Platform::MemoryArena & arena)
+{
+    const size_t mark = arena.Mark();
+
+    if (!TLVTypeIsString(ElementType()))
+        return CHIP_ERROR_WRONG_TLV_TYPE;
+
+    buf = (char *) arena.Alloc((size_t) mElemLenOrVal + 1);
+    if (buf == NULL)
+        return CHIP_ERROR_NO_MEMORY;
+
+    CHIP_ERROR err = ReadData((uint8_t *) buf, (uint32_t) mElemLenOrVal);
+    if (err != CHIP_NO_ERROR)
+    {
+        arena.Rewind(mark);
+        return err;
+    }
+
+    buf[mElemLenOrVal] = 0;
+    mElemLenOrVal      = 0;
+
+    return err;
+}
+
 /**
  * Get a pointer to the initial encoded byte of a TLV byte or UTF8 string element.
  *
@@ -663,6 +663,104 @@ CHIP_ERROR TLVWriter::PutBytes(uint64_t tag, const uint8_t * buf, uint32_t len)
     return WriteElementWithData(kTLVType_ByteString, tag, (const uint8_t *) buf, len);
 }
 
+/**
+ * Encodes a TLV byte string value whose bytes are held in a chain of PacketBuffers, without copying
+ * them.
+ *
+ * When the writer is writing to a chain of PacketBuffers (i.e. it uses the GetNewPacketBuffer() and
+ * FinalizePacketBuffer() functions), the element head is written to the current output buffer and
+ * the buffers in @p data are then linked into the output chain as they are.  Subsequent elements are
+ * written to a new buffer following them, so the unused space at the end of @p data is never written
+ * to.  With any other output, the bytes are copied as by PutBytes(uint64_t, const uint8_t *, uint32_t).
+ *
+ * The writer takes ownership of @p data in all cases, including on error.  The buffers must not be
+ * part of another chain, nor be referenced elsewhere once they are linked into the output.
+ *
+ * @param[in]   tag             The TLV tag to be encoded with the value, or @p AnonymousTag if the
+ *                              value should be encoded without a tag.  Tag values should be
+ *                              constructed with one of the tag definition functions ProfileTag(),
+ *                              ContextTag() or CommonTag().
+ * @param[in]   data            A chain of PacketBuffers holding the bytes to be encoded.
+ *
+ * @retval #CHIP_NO_ERROR      If the method succeeded.
+ * @retval #CHIP_ERROR_TLV_CONTAINER_OPEN
+ *                              If a container writer has been opened on the current writer and not
+ *                              yet closed.
+ * @retval #CHIP_ERROR_INVALID_TLV_TAG
+ *                              If the specified tag value is invalid or inappropriate in the context
+ *                              in which the value is being written.
+ * @retval #CHIP_ERROR_BUFFER_TOO_SMALL
+ *                              If writing the value would exceed the limit on the maximum number of
+ *                              bytes specified when the writer was initialized.
+ * @retval #CHIP_ERROR_NO_MEMORY
+ *                              If an attempt to allocate an output buffer failed due to lack of
+ *                              memory.
+ * @retval other                Other CHIP or platform-specific errors returned by the configured
+ *                              GetNewBuffer() or FinalizeBuffer() functions.
+ *
+ */
+CHIP_ERROR TLVWriter::PutBytes(uint64_t tag, PacketBuffer * data)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    TLVFieldSize lenFieldSize;
+    PacketBuffer * outBuf;
+    PacketBuffer * lastBuf = NULL;
+    uint32_t dataLen       = 0;
+
+    VerifyOrExit(data != NULL, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    for (PacketBuffer * p = data; p != NULL; p = p->Next())
+    {
+        dataLen += p->DataLength();
+        lastBuf = p;
+    }
+
+    if (dataLen <= UINT8_MAX)
+        lenFieldSize = kTLVFieldSize_1Byte;
+    else if (dataLen <= UINT16_MAX)
+        lenFieldSize = kTLVFieldSize_2Byte;
+    else
+        lenFieldSize = kTLVFieldSize_4Byte;
+
+    err = WriteElementHead((TLVElementType)(kTLVType_ByteString | lenFieldSize), tag, dataLen);
+    SuccessOrExit(err);
+
+    if (GetNewBuffer != GetNewPacketBuffer || FinalizeBuffer != FinalizePacketBuffer || dataLen == 0)
+    {
+        for (PacketBuffer * p = data; p != NULL; p = p->Next())
+        {
+            err = WriteData(p->Start(), p->DataLength());
+            SuccessOrExit(err);
+        }
+
+        ExitNow();
+    }
+
+    VerifyOrExit(dataLen <= mMaxLen - mLenWritten, err = CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    err = FinalizeBuffer(*this, mBufHandle, mBufStart, mWritePoint - mBufStart);
+    SuccessOrExit(err);
+
+    // Link the data in after the current output buffer, ahead of any buffers already chained to it.
+    outBuf = (PacketBuffer *) mBufHandle;
+    if (outBuf->Next() != NULL)
+        data->AddToEnd(outBuf->DetachTail());
+    outBuf->AddToEnd(data);
+    data = NULL;
+
+    // Carry on at the end of the data with no space left, so that the next write moves to a new buffer.
+    mBufHandle = (uintptr_t) lastBuf;
+    mBufStart = mWritePoint = lastBuf->Start() + lastBuf->DataLength();
+    mRemainingLen           = 0;
+    mLenWritten += dataLen;
+
+exit:
+    if (data != NULL)
+        PacketBuffer::Free(data);
+
+    return err;
+}
+
 /**
  * Encodes a TLV UTF8 string value.
  *
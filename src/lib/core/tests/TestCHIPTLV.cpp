@@ -35,6 +35,7 @@
 #include <core/CHIPTLVDebug.hpp>
 #include <core/CHIPTLVUtilities.hpp>
 
+#include <support/CHIPMemArena.h>
 #include <support/CodeUtils.h>
 #include <support/RandUtils.h>
 
@@ -2476,6 +2477,127 @@ void CheckBufferOverflow(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+/**
+ *  Test PutBytes() with the bytes held in PacketBuffers
+ */
+void CheckPutBytesPacketBuffer(nlTestSuite * inSuite, void * inContext)
+{
+    const uint16_t kHeadLen    = 400;
+    const uint16_t kPayloadLen = 1000;
+    uint8_t payload[kPayloadLen];
+    uint8_t expected[kPayloadLen + 32];
+    uint8_t copied[kPayloadLen + 32];
+    uint8_t readBack[kPayloadLen];
+    uint32_t expectedLen;
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType outerContainerType;
+    CHIP_ERROR err;
+
+    for (uint16_t i = 0; i < kPayloadLen; i++)
+        payload[i] = static_cast<uint8_t>(i * 7);
+
+    // Encode the expected result, copying the payload.
+    writer.Init(expected, sizeof(expected));
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Put(ContextTag(1), static_cast<uint8_t>(1));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.PutBytes(ContextTag(2), payload, kPayloadLen);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Put(ContextTag(3), static_cast<uint32_t>(3));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.EndContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    expectedLen = writer.GetLengthWritten();
+
+    // Split the payload over two buffers and link them into a chain of PacketBuffers.
+    PacketBuffer * buf      = PacketBuffer::New(0);
+    PacketBuffer * data     = PacketBuffer::New(0);
+    PacketBuffer * dataTail = PacketBuffer::New(0);
+
+    memcpy(data->Start(), payload, kHeadLen);
+    data->SetDataLength(kHeadLen);
+    memcpy(dataTail->Start(), payload + kHeadLen, kPayloadLen - kHeadLen);
+    dataTail->SetDataLength(kPayloadLen - kHeadLen);
+    data->AddToEnd(dataTail);
+
+    writer.Init(buf, 0xFFFFFFFFUL, true);
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Put(ContextTag(1), static_cast<uint8_t>(1));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.PutBytes(ContextTag(2), data);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Put(ContextTag(3), static_cast<uint32_t>(3));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.EndContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, writer.GetLengthWritten() == expectedLen);
+    TestBufferContents(inSuite, buf, expected, expectedLen);
+
+    // The payload buffers were linked in rather than copied.
+    NL_TEST_ASSERT(inSuite, buf->Next() == data);
+    NL_TEST_ASSERT(inSuite, data->Next() == dataTail);
+    NL_TEST_ASSERT(inSuite, dataTail->Next() != NULL);
+    NL_TEST_ASSERT(inSuite, dataTail->DataLength() == kPayloadLen - kHeadLen);
+
+    reader.Init(buf, 0xFFFFFFFFUL, true);
+
+    TestNext<TLVReader>(inSuite, reader);
+    err = reader.EnterContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    TestNext<TLVReader>(inSuite, reader);
+    TestGet<TLVReader, uint8_t>(inSuite, reader, kTLVType_UnsignedInteger, ContextTag(1), 1);
+    TestNext<TLVReader>(inSuite, reader);
+    NL_TEST_ASSERT(inSuite, reader.GetType() == kTLVType_ByteString);
+    NL_TEST_ASSERT(inSuite, reader.GetLength() == kPayloadLen);
+    err = reader.GetBytes(readBack, sizeof(readBack));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(readBack, payload, kPayloadLen) == 0);
+    TestNext<TLVReader>(inSuite, reader);
+    TestGet<TLVReader, uint32_t>(inSuite, reader, kTLVType_UnsignedInteger, ContextTag(3), 3);
+    TestEndAndExitContainer<TLVReader>(inSuite, reader, outerContainerType);
+
+    PacketBuffer::Free(buf);
+
+    // Any other output gets a copy of the bytes.
+    data = PacketBuffer::New(0);
+    memcpy(data->Start(), payload, kHeadLen);
+    data->SetDataLength(kHeadLen);
+
+    writer.Init(expected, sizeof(expected));
+    err = writer.PutBytes(AnonymousTag, payload, kHeadLen);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    expectedLen = writer.GetLengthWritten();
+
+    writer.Init(copied, sizeof(copied));
+    err = writer.PutBytes(AnonymousTag, data);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.GetLengthWritten() == expectedLen);
+    NL_TEST_ASSERT(inSuite, memcmp(copied, expected, expectedLen) == 0);
+
+    // The payload must fit within the writer's limit.
+    buf  = PacketBuffer::New(0);
+    data = PacketBuffer::New(0);
+    data->SetDataLength(kHeadLen);
+
+    writer.Init(buf, kHeadLen, true);
+    err = writer.PutBytes(AnonymousTag, data);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, buf->Next() == NULL);
+
+    PacketBuffer::Free(buf);
+}
+
 /**
  * Test case to verify the correctness of TLVReader::GetTag()
  *
@@ -2972,6 +3094,65 @@ void TestCHIPTLVReaderDup(nlTestSuite * inSuite)
 
     TestEnd<TLVReader>(inSuite, reader);
 }
+/**
+ *  Test duplicating strings into a memory arena with CHIP TLV Reader
+ */
+void TestCHIPTLVReaderDupArena(nlTestSuite * inSuite)
+{
+    uint8_t buf[64];
+    uint8_t arenaBuf[64];
+    TLVWriter writer;
+    TLVReader reader;
+    chip::Platform::MemoryArena arena;
+    uint8_t * bytes = NULL;
+    char * str      = NULL;
+    uint32_t len    = 0;
+    CHIP_ERROR err;
+
+    writer.Init(buf, sizeof(buf));
+    err = writer.PutString(ProfileTag(TestProfile_1, 1), "This is a test");
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.PutString(ProfileTag(TestProfile_1, 2), "This is another test");
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Put(ProfileTag(TestProfile_1, 3), (uint32_t) 1);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = arena.Init(arenaBuf, sizeof(arenaBuf));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    reader.Init(buf, writer.GetLengthWritten());
+
+    TestNext<TLVReader>(inSuite, reader);
+    err = reader.DupBytes(bytes, len, arena);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, len == 14 && memcmp(bytes, "This is a test", 14) == 0);
+
+    TestNext<TLVReader>(inSuite, reader);
+    err = reader.DupString(str, arena);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, strcmp(str, "This is another test") == 0);
+    NL_TEST_ASSERT(inSuite, (uint8_t *) str >= arenaBuf && (uint8_t *) str < arenaBuf + sizeof(arenaBuf));
+
+    // A failed duplication leaves the arena as it was
+    size_t used = arena.Used();
+    TestNext<TLVReader>(inSuite, reader);
+    err = reader.DupString(str, arena);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_WRONG_TLV_TYPE);
+    NL_TEST_ASSERT(inSuite, arena.Used() == used);
+
+    // Strings that do not fit in the arena are refused
+    arena.Reset();
+    arena.Alloc(arena.Capacity() - 8);
+    reader.Init(buf, writer.GetLengthWritten());
+    TestNext<TLVReader>(inSuite, reader);
+    err = reader.DupString(str, arena);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_NO_MEMORY);
+
+    arena.Shutdown();
+}
+
 /**
  *  Test error handling of CHIP TLV Reader
  */
@@ -3162,6 +3343,8 @@ void CheckCHIPTLVReader(nlTestSuite * inSuite, void * inContext)
 
     TestCHIPTLVReaderDup(inSuite);
 
+    TestCHIPTLVReaderDupArena(inSuite);
+
     TestCHIPTLVReaderErrorHandling(inSuite);
 
     TestCHIPTLVReaderInPractice(inSuite);
@@ -3790,6 +3973,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Simple Write Read Test",              CheckSimpleWriteRead),
     NL_TEST_DEF("Inet Buffer Test",                    CheckPacketBuffer),
     NL_TEST_DEF("Buffer Overflow Test",                CheckBufferOverflow),
+    NL_TEST_DEF("PutBytes PacketBuffer Test",          CheckPutBytesPacketBuffer),
     NL_TEST_DEF("Pretty Print Test",                   CheckPrettyPrinter),
     NL_TEST_DEF("Data Macro Test",                     CheckDataMacro),
     NL_TEST_DEF("Strict Aliasing Test",                CheckStrictAliasing),
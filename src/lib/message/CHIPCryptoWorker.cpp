@@ -0,0 +1,113 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the crypto worker, which runs the time-consuming
+ *      steps of session establishment off the CHIP thread.
+ *
+ */
+
+#include <message/CHIPCryptoWorker.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <support/logging/CHIPLogging.h>
+
+namespace chip {
+
+CryptoWorker::CryptoWorker(void) : mOwnerLayer(NULL) {}
+
+/**
+ * Start the thread of the worker.
+ *
+ * @param[in]  aOwnerLayer  The system layer on which steps are handed back once done.
+ *
+ * @retval #CHIP_ERROR_INCORRECT_STATE  If the worker is already running.
+ * @retval #CHIP_NO_ERROR               On success.
+ * @retval other                        Errors from starting the thread.
+ */
+CHIP_ERROR CryptoWorker::Start(System::Layer & aOwnerLayer)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    VerifyOrExit(!mThread.IsRunning(), err = CHIP_ERROR_INCORRECT_STATE);
+
+    mOwnerLayer = &aOwnerLayer;
+
+    err = mThread.Start();
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+/**
+ * Stop the thread of the worker, waiting for the step in progress to finish. Steps that have not run yet are dropped,
+ * and are never done, so their owners must free them.
+ */
+void CryptoWorker::Stop(void)
+{
+    mThread.Stop();
+}
+
+/**
+ * Hand a step to the worker. Called on the CHIP thread.
+ *
+ * @param[in]  aStep      The state of the step, which must stay allocated until the step is done or the worker stopped.
+ * @param[in]  aWork      The function that carries the step out on the thread of the worker. It must not touch
+ *                        state shared with other threads without locking it.
+ * @param[in]  aOnDone    The function scheduled on the owner's system layer once the step is done.
+ * @param[in]  aAppState  The argument passed to @a aOnDone.
+ *
+ * @retval #CHIP_NO_ERROR  On success.
+ * @retval other           Errors from scheduling the step, in which case it still belongs to the caller.
+ */
+CHIP_ERROR CryptoWorker::Run(Step & aStep, Step::WorkFunct aWork, System::Layer::TimerCompleteFunct aOnDone, void * aAppState)
+{
+    aStep.Worker   = this;
+    aStep.Work     = aWork;
+    aStep.OnDone   = aOnDone;
+    aStep.AppState = aAppState;
+    __atomic_store_n(&aStep.Done, false, __ATOMIC_RELAXED);
+
+    return mThread.ScheduleWork(HandleRun, &aStep);
+}
+
+void CryptoWorker::HandleRun(System::Layer * aLayer, void * aAppState, System::Error aError)
+{
+    Step & step                              = *static_cast<Step *>(aAppState);
+    System::Layer & ownerLayer               = *step.Worker->mOwnerLayer;
+    System::Layer::TimerCompleteFunct onDone = step.OnDone;
+    void * appState                          = step.AppState;
+    System::Error err;
+
+    step.Work(step);
+
+    // The step belongs to its owner again from here on, and may be freed at any time.
+    __atomic_store_n(&step.Done, true, __ATOMIC_RELEASE);
+
+    err = ownerLayer.ScheduleWork(onDone, appState);
+    if (err != CHIP_SYSTEM_NO_ERROR)
+        ChipLogError(SecurityManager, "Failed to hand back crypto worker step, left for its owner to reclaim: %s", ErrorStr(err));
+}
+
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
@@ -0,0 +1,94 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the crypto worker, which runs the time-consuming
+ *      steps of session establishment off the CHIP thread.
+ *
+ */
+
+#ifndef CHIPCRYPTOWORKER_H_
+#define CHIPCRYPTOWORKER_H_
+
+#include <system/SystemConfig.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#include <core/CHIPError.h>
+#include <support/DLLUtil.h>
+#include <system/SystemEventLoopThread.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+
+/**
+ *  @class CryptoWorker
+ *
+ *  @brief
+ *    Runs steps on a thread of its own and hands each one back to the system layer of its owner, the CHIP thread, once
+ *    it is done.
+ *
+ *    A step belongs to the worker from Run() until it is done. The worker marks the step done before it schedules the
+ *    hand-back, and does not touch it afterwards. Scheduling the hand-back can fail, so the owner must not rely on it
+ *    alone: a step that IsDone() belongs to the owner again, which may free it whether or not the hand-back has run.
+ *    For the same reason the hand-back is passed the application state given to Run() rather than the step.
+ */
+class DLL_EXPORT CryptoWorker
+{
+public:
+    /**
+     * The state of a step handed to the worker. Owners derive their step state from it.
+     */
+    struct Step
+    {
+        typedef void (*WorkFunct)(Step & step);
+
+        CryptoWorker * Worker;                    // [READ ONLY] The worker running the step.
+        WorkFunct Work;                           // [READ ONLY] Called on the thread of the worker.
+        System::Layer::TimerCompleteFunct OnDone; // [READ ONLY] Scheduled on the owner's system layer once done.
+        void * AppState;                          // [READ ONLY] Passed to OnDone.
+        bool Done;                                // Access with IsDone() only.
+    };
+
+    CryptoWorker(void);
+
+    CHIP_ERROR Start(System::Layer & aOwnerLayer);
+    void Stop(void);
+
+    bool IsRunning(void) const { return mThread.IsRunning(); }
+
+    CHIP_ERROR Run(Step & aStep, Step::WorkFunct aWork, System::Layer::TimerCompleteFunct aOnDone, void * aAppState);
+
+    static bool IsDone(const Step & aStep) { return __atomic_load_n(&aStep.Done, __ATOMIC_ACQUIRE); }
+
+private:
+    System::Layer * mOwnerLayer;
+    System::EventLoopThread mThread;
+
+    static void HandleRun(System::Layer * aLayer, void * aAppState, System::Error aError);
+
+    // Not defined
+    CryptoWorker(const CryptoWorker &) = delete;
+    CryptoWorker & operator=(const CryptoWorker &) = delete;
+};
+
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#endif // CHIPCRYPTOWORKER_H_
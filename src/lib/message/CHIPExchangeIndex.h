@@ -0,0 +1,105 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the index the exchange manager uses to find the
+ *      exchange context that a received message belongs to.
+ *
+ */
+#ifndef CHIP_EXCHANGE_INDEX_H_
+#define CHIP_EXCHANGE_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <support/PoolHashIndex.h>
+
+namespace chip {
+
+/**
+ *  @class ExchangeIndex
+ *
+ *  @brief
+ *    Indexes the exchange contexts of a pool on the keys that identify the
+ *    exchange of a received message.
+ *
+ *    An exchange carried over a connection is keyed on (connection, exchange
+ *    id, initiator): the connection identifies the peer, whose node id may not
+ *    be known, e.g. on a connection that was accepted rather than made. Any
+ *    other exchange is keyed on (peer node id, exchange id, initiator).
+ *
+ *    ContextType must have Con, PeerNodeId and ExchangeId members and an
+ *    IsInitiator() method. As with PoolHashIndex, different keys may share a
+ *    bucket, so callers confirm every candidate.
+ */
+template <class ContextType, size_t kPoolSize, size_t kBucketCount>
+class ExchangeIndex
+{
+public:
+    typedef PoolHashIndex<kPoolSize, kBucketCount> Index;
+
+    static constexpr uint16_t kInvalidIndex = Index::kInvalidIndex;
+
+    /**
+     *  @brief Remove every slot from the index.
+     */
+    void Init() { mIndex.Init(); }
+
+    /**
+     *  @brief Index the context in slot index under its current keys, replacing any keys it was indexed under.
+     */
+    void Link(uint16_t index, const ContextType & ec)
+    {
+        mIndex.Link(index, Hash(ec.Con, ec.PeerNodeId, ec.ExchangeId, ec.IsInitiator()));
+    }
+
+    /**
+     *  @brief Remove a slot from the index. Does nothing if the slot is not linked.
+     */
+    void Unlink(uint16_t index) { mIndex.Unlink(index); }
+
+    /**
+     *  @brief Return the first candidate slot for a message of an exchange received over con, or over UDP if con is
+     *         NULL, or kInvalidIndex if there is none. peerNodeId is only used for messages received over UDP.
+     */
+    uint16_t First(const void * con, uint64_t peerNodeId, uint16_t exchangeId, bool isInitiator) const
+    {
+        return mIndex.First(Hash(con, peerNodeId, exchangeId, isInitiator));
+    }
+
+    /**
+     *  @brief Return the candidate slot after index, or kInvalidIndex at the end of the chain.
+     */
+    uint16_t Next(uint16_t index) const { return mIndex.Next(index); }
+
+private:
+    Index mIndex;
+
+    static uint32_t Hash(const void * con, uint64_t peerNodeId, uint16_t exchangeId, bool isInitiator)
+    {
+        const uint32_t kind = (isInitiator ? 1 : 0) | (con != NULL ? 2 : 0);
+        const uint64_t peer = (con != NULL) ? static_cast<uint64_t>(reinterpret_cast<uintptr_t>(con)) : peerNodeId;
+
+        return Index::Combine(Index::Combine(kind, peer), exchangeId);
+    }
+};
+
+} // namespace chip
+
+#endif // CHIP_EXCHANGE_INDEX_H_
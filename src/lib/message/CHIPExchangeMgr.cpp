@@ -93,10 +93,13 @@ CHIP_ERROR ChipExchangeManager::Init(ChipMessageLayer * msgLayer)
 
     memset(ContextPool, 0, sizeof(ContextPool));
     mContextsInUse = 0;
+    mExchangeIndex.Init();
+    mPeerIndex.Init();
 
     InitBindingPool();
 
     memset(UMHandlerPool, 0, sizeof(UMHandlerPool));
+    mUMHIndex.Init();
     OnExchangeContextChanged = NULL;
 
     msgLayer->ExchangeMgr       = this;
@@ -107,8 +110,17 @@ CHIP_ERROR ChipExchangeManager::Init(ChipMessageLayer * msgLayer)
     mWRMPTimerInterval = CHIP_CONFIG_WRMP_TIMER_DEFAULT_PERIOD; // WRMP Timer tick period
 
     memset(RetransTable, 0, sizeof(RetransTable));
+    mRetransPeerIndex.Init();
+
+    for (int i = 0; i < CHIP_CONFIG_WRMP_PEER_RTT_TABLE_SIZE; i++)
+    {
+        PeerRttTable[i].estimator.Reset();
+    }
+    mPeerRttIndex.Init();
 
     mWRMPTimeStampBase = System::Timer::GetCurrentEpoch();
+    mWRMPCurrentTick   = 0;
+    mRetransWheel.Init(mWRMPCurrentTick);
 
     mWRMPCurrentTimerExpiry = 0;
 #endif
@@ -228,6 +240,7 @@ ExchangeContext * ChipExchangeManager::NewContext(const uint64_t & peerNodeId, c
         ec->PeerIntf   = sendIntfId;
         ec->AppState   = appState;
         ec->SetInitiator(true);
+        IndexContext(ec);
         // Initialize WRMP variables
         ec->mMsgProtocolVersion = 0;
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
@@ -273,6 +286,7 @@ ExchangeContext * ChipExchangeManager::NewContext(ChipConnection * con, void * a
         ec->Con            = con;
         ec->KeyId          = con->DefaultKeyId;
         ec->EncryptionType = con->DefaultEncryptionType;
+        IndexContext(ec);
     }
     return ec;
 }
@@ -294,11 +308,13 @@ ExchangeContext * ChipExchangeManager::NewContext(ChipConnection * con, void * a
  */
 ExchangeContext * ChipExchangeManager::FindContext(uint64_t peerNodeId, ChipConnection * con, void * appState, bool isInitiator)
 {
-    ExchangeContext * ec = (ExchangeContext *) ContextPool;
-    for (int i = 0; i < CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+    for (uint16_t i = mPeerIndex.First(PeerHash(peerNodeId, isInitiator)); i != mPeerIndex.kInvalidIndex; i = mPeerIndex.Next(i))
+    {
+        ExchangeContext * ec = &ContextPool[i];
         if (ec->ExchangeMgr != NULL && ec->PeerNodeId == peerNodeId && ec->Con == con && ec->AppState == appState &&
             ec->IsInitiator() == isInitiator)
             return ec;
+    }
     return NULL;
 }
 
@@ -516,6 +532,10 @@ void ChipExchangeManager::HandleConnectionClosed(ChipConnection * con, CHIP_ERRO
         if (ec->ExchangeMgr != NULL && ec->Con == con)
         {
             ec->HandleConnectionClosed(conErr);
+
+            // Re-key an exchange that outlives its connection.
+            if (ec->ExchangeMgr != NULL)
+                IndexContext(ec);
         }
 
     UnsolicitedMessageHandler * umh = (UnsolicitedMessageHandler *) UMHandlerPool;
@@ -524,6 +544,7 @@ void ChipExchangeManager::HandleConnectionClosed(ChipConnection * con, CHIP_ERRO
         {
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
             umh->Handler = NULL;
+            mUMHIndex.Unlink(static_cast<uint16_t>(i));
         }
 }
 
@@ -564,6 +585,10 @@ ExchangeContext * ChipExchangeManager::AllocContext()
     for (int i = 0; i < CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
         if (ec->ExchangeMgr == NULL)
         {
+            // The slot may still be indexed under the keys of the exchange that last used it.
+            mExchangeIndex.Unlink(static_cast<uint16_t>(i));
+            mPeerIndex.Unlink(static_cast<uint16_t>(i));
+
             *ec             = ExchangeContext();
             ec->ExchangeMgr = this;
             ec->mRefCount   = 1;
@@ -581,38 +606,140 @@ ExchangeContext * ChipExchangeManager::AllocContext()
     return NULL;
 }
 
+/**
+ *  Add an ExchangeContext to the lookup indices. Must be called once the peer node id, exchange id
+ *  and initiator flag of the context are set, and again if any of them changes.
+ */
+void ChipExchangeManager::IndexContext(ExchangeContext * ec)
+{
+    const uint16_t index = static_cast<uint16_t>(ec - ContextPool);
+
+    mExchangeIndex.Link(index, *ec);
+    mPeerIndex.Link(index, PeerHash(ec->PeerNodeId, ec->IsInitiator()));
+}
+
+/**
+ *  Look up the ExchangeContext that a received message belongs to. For a message received over a connection, the
+ *  candidates are the exchanges on that connection, whatever their peer node id; otherwise they are the exchanges
+ *  with the given peer node id. MatchExchange() has the final say on whether a context matches.
+ */
+ExchangeContext * ChipExchangeManager::LookupContext(uint64_t peerNodeId, ChipConnection * msgCon, const ChipMessageInfo * msgInfo,
+                                                     const ChipExchangeHeader * exchangeHeader)
+{
+    // A message sent by the initiator belongs to an exchange in which the local node is the responder, and vice versa.
+    const bool isInitiator = (exchangeHeader->Flags & kChipExchangeFlag_Initiator) == 0;
+
+    for (uint16_t i = mExchangeIndex.First(msgCon, peerNodeId, exchangeHeader->ExchangeId, isInitiator);
+         i != mExchangeIndex.kInvalidIndex; i = mExchangeIndex.Next(i))
+    {
+        ExchangeContext * ec = &ContextPool[i];
+        if (ec->ExchangeMgr != NULL && ec->Con == msgCon && (msgCon != NULL || ec->PeerNodeId == peerNodeId) &&
+            ec->MatchExchange(msgCon, msgInfo, exchangeHeader))
+            return ec;
+    }
+    return NULL;
+}
+
+/**
+ *  Look up the ExchangeContext that a received message belongs to: among the exchanges on the connection it was
+ *  received over, or, for a message received over UDP, first among the exchanges with the sending node and then
+ *  among those open to any node.
+ */
+ExchangeContext * ChipExchangeManager::MatchContext(ChipConnection * msgCon, const ChipMessageInfo * msgInfo,
+                                                    const ChipExchangeHeader * exchangeHeader)
+{
+    ExchangeContext * ec = LookupContext(msgInfo->SourceNodeId, msgCon, msgInfo, exchangeHeader);
+
+    if (ec == NULL && msgCon == NULL && msgInfo->SourceNodeId != kAnyNodeId)
+    {
+        ec = LookupContext(kAnyNodeId, msgCon, msgInfo, exchangeHeader);
+    }
+    return ec;
+}
+
+/**
+ *  Look up a registered unsolicited message handler for a profile and message type (-1 for handlers of
+ *  any message type) that accepts a message received over msgCon. When several handlers qualify, the
+ *  first or the last one in pool order is returned.
+ */
+ChipExchangeManager::UnsolicitedMessageHandler * ChipExchangeManager::LookupUMH(uint32_t profileId, int16_t msgType,
+                                                                                ChipConnection * msgCon, bool isDuplicate,
+                                                                                bool lastMatch)
+{
+    UnsolicitedMessageHandler * matchingUMH = NULL;
+
+    for (uint16_t i = mUMHIndex.First(UMHHash(profileId, msgType)); i != mUMHIndex.kInvalidIndex; i = mUMHIndex.Next(i))
+    {
+        UnsolicitedMessageHandler * umh = &UMHandlerPool[i];
+        if (umh->Handler != NULL && umh->ProfileId == profileId && umh->MessageType == msgType &&
+            (umh->Con == NULL || umh->Con == msgCon) && (!isDuplicate || umh->AllowDuplicateMsgs))
+        {
+            matchingUMH = umh;
+            if (!lastMatch)
+                break;
+        }
+    }
+    return matchingUMH;
+}
+
+/**
+ *  Find the registered unsolicited message handler with exactly the given profile, message type and connection.
+ */
+ChipExchangeManager::UnsolicitedMessageHandler * ChipExchangeManager::FindUMH(uint32_t profileId, int16_t msgType,
+                                                                              ChipConnection * con)
+{
+    for (uint16_t i = mUMHIndex.First(UMHHash(profileId, msgType)); i != mUMHIndex.kInvalidIndex; i = mUMHIndex.Next(i))
+    {
+        UnsolicitedMessageHandler * umh = &UMHandlerPool[i];
+        if (umh->Handler != NULL && umh->ProfileId == profileId && umh->MessageType == msgType && umh->Con == con)
+            return umh;
+    }
+    return NULL;
+}
+
+uint32_t ChipExchangeManager::PeerHash(uint64_t peerNodeId, bool isInitiator)
+{
+    return ContextIndex::Combine(isInitiator ? 1 : 0, peerNodeId);
+}
+
+uint32_t ChipExchangeManager::UMHHash(uint32_t profileId, int16_t msgType)
+{
+    return UMHIndex::Combine(static_cast<uint32_t>(msgType), profileId);
+}
+
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
 void ChipExchangeManager::WRMPProcessDDMessage(uint32_t PauseTimeMillis, uint64_t DelayedNodeId)
 {
+    uint16_t entries[CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE];
+    size_t count;
+
     // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
     WRMPExpireTicks();
 
     // Go through the retrans table entries for that node and adjust the timer.
-    for (int i = 0; i < CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
+    count = CollectPeerRetransEntries(DelayedNodeId, entries);
+    for (size_t i = 0; i < count; i++)
     {
-        // Exchcontext is the sentinel object to ascertain validity of the element
-        if (RetransTable[i].exchContext)
-        {
-            // Adjust the retrans timer value if Delayed Node identifier matches Peer in ExchangeContext
-            if (DelayedNodeId == RetransTable[i].exchContext->PeerNodeId)
-            {
+        RetransTableEntry & entry = RetransTable[entries[i]];
 
-                // Paustime is specified in milliseconds; Update retrans values
-                RetransTable[i].nextRetransTime += (PauseTimeMillis / mWRMPTimerInterval);
+        // The callback for an earlier entry may have removed this one
+        if (entry.exchContext == NULL || entry.exchContext->PeerNodeId != DelayedNodeId)
+            continue;
 
-                // Call the application callback
-                if (RetransTable[i].exchContext->OnDDRcvd)
-                {
-                    RetransTable[i].exchContext->OnDDRcvd(RetransTable[i].exchContext, PauseTimeMillis);
-                }
-                else
-                {
-                    ChipLogError(ExchangeManager, "No App Handler for Delayed Delivery for ExchangeContext with Id %04" PRIX16,
-                                 RetransTable[i].exchContext->ExchangeId);
-                }
-            } // DelayedNodeId == PeerNodeId
-        }     // exchContext
-    }         // for loop in table entry
+        // Paustime is specified in milliseconds; Update retrans values
+        ScheduleRetrans(entry, mRetransWheel.DueTick(entries[i]) + (PauseTimeMillis / mWRMPTimerInterval));
+
+        // Call the application callback
+        if (entry.exchContext->OnDDRcvd)
+        {
+            entry.exchContext->OnDDRcvd(entry.exchContext, PauseTimeMillis);
+        }
+        else
+        {
+            ChipLogError(ExchangeManager, "No App Handler for Delayed Delivery for ExchangeContext with Id %04" PRIX16,
+                         entry.exchContext->ExchangeId);
+        }
+    }
 
     // Schedule next physical wakeup
     WRMPStartTimer();
@@ -631,7 +758,6 @@ static void DefaultOnMessageReceived(ExchangeContext * ec, const IPPacketInfo *
 void ChipExchangeManager::DispatchMessage(ChipMessageInfo * msgInfo, PacketBuffer * msgBuf)
 {
     ChipExchangeHeader exchangeHeader;
-    UnsolicitedMessageHandler * umh         = NULL;
     UnsolicitedMessageHandler * matchingUMH = NULL;
     ExchangeContext * ec                    = NULL;
     ChipConnection * msgCon                 = NULL;
@@ -725,30 +851,43 @@ void ChipExchangeManager::DispatchMessage(ChipMessageInfo * msgInfo, PacketBuffe
         // Return after processing Delayed Delivery message
         ExitNow(err = CHIP_NO_ERROR);
     } // If delayed delivery Msg
+
+    // Received Multi-Ack Message: acknowledgments for several exchanges with the sending node
+    if (exchangeHeader.ProfileId == chip::Profiles::kChipProfile_Common &&
+        exchangeHeader.MessageType == chip::Profiles::Common::kMsgType_WRMP_Multi_Ack)
+    {
+        WRMPProcessMultiAck(msgCon, msgInfo, &exchangeHeader, msgBuf);
+
+        // Return after processing Multi-Ack message
+        ExitNow(err = CHIP_NO_ERROR);
+    }
 #endif
 
     // Search for an existing exchange that the message applies to. If a match is found...
-    ec = (ExchangeContext *) ContextPool;
-    for (int i = 0; i < CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+    ec = MatchContext(msgCon, msgInfo, &exchangeHeader);
+    if (ec != NULL)
     {
-        if (ec->ExchangeMgr != NULL && ec->MatchExchange(msgCon, msgInfo, &exchangeHeader))
-        {
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
-            // Found a matching exchange. Set flag for correct subsequent WRM
-            // retransmission timeout selection.
-            if (!ec->HasRcvdMsgFromPeer())
-            {
-                ec->SetMsgRcvdFromPeer(true);
-            }
+        // Found a matching exchange. Set flag for correct subsequent WRM
+        // retransmission timeout selection.
+        if (!ec->HasRcvdMsgFromPeer())
+        {
+            ec->SetMsgRcvdFromPeer(true);
+        }
+
+        // Time the round trip of the message being acknowledged before the acknowledgment removes it from the table.
+        if (exchangeHeader.Flags & kChipExchangeFlag_AckId)
+        {
+            SampleRtt(ec, exchangeHeader.AckMsgId);
+        }
 #endif
 
-            // Matched ExchangeContext; send to message handler.
-            ec->HandleMessage(msgInfo, &exchangeHeader, msgBuf);
+        // Matched ExchangeContext; send to message handler.
+        ec->HandleMessage(msgInfo, &exchangeHeader, msgBuf);
 
-            msgBuf = NULL;
+        msgBuf = NULL;
 
-            ExitNow(err = CHIP_NO_ERROR);
-        }
+        ExitNow(err = CHIP_NO_ERROR);
     }
 
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
@@ -763,24 +902,15 @@ void ChipExchangeManager::DispatchMessage(ChipMessageInfo * msgInfo, PacketBuffe
     if (exchangeHeader.Flags & kChipExchangeFlag_Initiator)
     {
         // Search for an unsolicited message handler that can handle the message. Prefer handlers that can explicitly
-        // handle the message type over handlers that handle all messages for a profile.
-        umh = (UnsolicitedMessageHandler *) UMHandlerPool;
-
-        matchingUMH = NULL;
-
-        for (int i = 0; i < CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; i++, umh++)
-            if (umh->Handler != NULL && umh->ProfileId == exchangeHeader.ProfileId && (umh->Con == NULL || umh->Con == msgCon) &&
-                (!(msgInfo->Flags & kChipMessageFlag_DuplicateMessage) || umh->AllowDuplicateMsgs))
-            {
-                if (umh->MessageType == exchangeHeader.MessageType)
-                {
-                    matchingUMH = umh;
-                    break;
-                }
+        // handle the message type over handlers that handle all messages for a profile. Among the former the first
+        // registered handler wins, among the latter the last one.
+        const bool isDuplicate = (msgInfo->Flags & kChipMessageFlag_DuplicateMessage) != 0;
 
-                if (umh->MessageType == -1)
-                    matchingUMH = umh;
-            }
+        matchingUMH = LookupUMH(exchangeHeader.ProfileId, exchangeHeader.MessageType, msgCon, isDuplicate, false);
+        if (matchingUMH == NULL)
+        {
+            matchingUMH = LookupUMH(exchangeHeader.ProfileId, -1, msgCon, isDuplicate, true);
+        }
     }
     // Discard the message if it isn't marked as being sent by an initiator and the message is not a duplicate
     // that needs to send ack to the peer.
@@ -888,6 +1018,8 @@ void ChipExchangeManager::DispatchMessage(ChipMessageInfo * msgInfo, PacketBuffe
         }
 #endif
 
+        IndexContext(ec);
+
         // If support for ephemeral UDP ports is enabled, arrange to send outbound messages on this exchange from the
         // local ephemeral UDP port IF the inbound message that initiated the exchange was sent TO the local ephemeral port.
 #if CHIP_CONFIG_ENABLE_EPHEMERAL_UDP_PORT
@@ -927,20 +1059,23 @@ exit:
 CHIP_ERROR ChipExchangeManager::RegisterUMH(uint32_t profileId, int16_t msgType, ChipConnection * con, bool allowDups,
                                             ExchangeContext::MessageReceiveFunct handler, void * appState)
 {
-    UnsolicitedMessageHandler * umh      = (UnsolicitedMessageHandler *) UMHandlerPool;
+    UnsolicitedMessageHandler * umh      = FindUMH(profileId, msgType, con);
     UnsolicitedMessageHandler * selected = NULL;
+
+    if (umh != NULL)
+    {
+        umh->Handler  = handler;
+        umh->AppState = appState;
+        return CHIP_NO_ERROR;
+    }
+
+    umh = (UnsolicitedMessageHandler *) UMHandlerPool;
     for (int i = 0; i < CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; i++, umh++)
     {
         if (umh->Handler == NULL)
         {
-            if (selected == NULL)
-                selected = umh;
-        }
-        else if (umh->ProfileId == profileId && umh->MessageType == msgType && umh->Con == con)
-        {
-            umh->Handler  = handler;
-            umh->AppState = appState;
-            return CHIP_NO_ERROR;
+            selected = umh;
+            break;
         }
     }
 
@@ -954,6 +1089,8 @@ CHIP_ERROR ChipExchangeManager::RegisterUMH(uint32_t profileId, int16_t msgType,
     selected->MessageType        = msgType;
     selected->AllowDuplicateMsgs = allowDups;
 
+    mUMHIndex.Link(static_cast<uint16_t>(selected - UMHandlerPool), UMHHash(profileId, msgType));
+
     SYSTEM_STATS_INCREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
 
     return CHIP_NO_ERROR;
@@ -961,17 +1098,15 @@ CHIP_ERROR ChipExchangeManager::RegisterUMH(uint32_t profileId, int16_t msgType,
 
 CHIP_ERROR ChipExchangeManager::UnregisterUMH(uint32_t profileId, int16_t msgType, ChipConnection * con)
 {
-    UnsolicitedMessageHandler * umh = (UnsolicitedMessageHandler *) UMHandlerPool;
-    for (int i = 0; i < CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; i++, umh++)
-    {
-        if (umh->Handler != NULL && umh->ProfileId == profileId && umh->MessageType == msgType && umh->Con == con)
-        {
-            umh->Handler = NULL;
-            SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
-            return CHIP_NO_ERROR;
-        }
-    }
-    return CHIP_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER;
+    UnsolicitedMessageHandler * umh = FindUMH(profileId, msgType, con);
+
+    if (umh == NULL)
+        return CHIP_ERROR_NO_UNSOLICITED_MESSAGE_HANDLER;
+
+    umh->Handler = NULL;
+    mUMHIndex.Unlink(static_cast<uint16_t>(umh - UMHandlerPool));
+    SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumUMHandlers);
+    return CHIP_NO_ERROR;
 }
 
 void ChipExchangeManager::HandleMessageReceived(ChipMessageLayer * msgLayer, ChipMessageInfo * msgInfo, PacketBuffer * msgBuf)
@@ -1173,13 +1308,15 @@ void ChipExchangeManager::NotifySecurityManagerAvailable()
  */
 void ChipExchangeManager::ClearMsgCounterSyncReq(uint64_t peerNodeId)
 {
-    RetransTableEntry * re = (RetransTableEntry *) RetransTable;
+    uint16_t entries[CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE];
+    size_t count = CollectPeerRetransEntries(peerNodeId, entries);
 
     // Find all retransmit entries (re) matching peerNodeId and using application group key.
-    for (int i = 0; i < CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++, re++)
+    for (size_t i = 0; i < count; i++)
     {
-        if (re->exchContext != NULL && re->exchContext->PeerNodeId == peerNodeId &&
-            ChipKeyId::IsAppGroupKey(re->exchContext->KeyId))
+        RetransTableEntry * re = &RetransTable[entries[i]];
+
+        if (ChipKeyId::IsAppGroupKey(re->exchContext->KeyId))
         {
             // Clear MsgCounterSyncReq flag.
             uint16_t headerField = LittleEndian::Get16(re->msgBuf->Start());
@@ -1198,11 +1335,15 @@ void ChipExchangeManager::ClearMsgCounterSyncReq(uint64_t peerNodeId)
  */
 void ChipExchangeManager::RetransPendingAppGroupMsgs(uint64_t peerNodeId)
 {
-    RetransTableEntry * re = (RetransTableEntry *) RetransTable;
+    uint16_t entries[CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE];
+    size_t count = CollectPeerRetransEntries(peerNodeId, entries);
 
     // Find all retransmit entries (re) matching peerNodeId and using application group key.
-    for (int i = 0; i < CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++, re++)
+    for (size_t i = 0; i < count; i++)
     {
+        RetransTableEntry * re = &RetransTable[entries[i]];
+
+        // A failed retransmission of an earlier entry may have removed this one
         if (re->exchContext != NULL && re->exchContext->PeerNodeId == peerNodeId &&
             ChipKeyId::IsAppGroupKey(re->exchContext->KeyId))
         {
@@ -1255,8 +1396,8 @@ void ChipExchangeManager::TicklessDebugDumpRetransTable(const char * log)
     {
         if (RetransTable[i].exchContext)
         {
-            ChipLogProgress(ExchangeManager, "EC:%04" PRIX16 " MsgId:%08" PRIX32 " NextRetransTimeCtr:%04" PRIX16,
-                            RetransTable[i].exchContext, RetransTable[i].msgId, RetransTable[i].nextRetransTime);
+            ChipLogProgress(ExchangeManager, "EC:%04" PRIX16 " MsgId:%08" PRIX32 " RetransTick:%08" PRIX32,
+                            RetransTable[i].exchContext, RetransTable[i].msgId, mRetransWheel.DueTick(static_cast<uint16_t>(i)));
         }
     }
 }
@@ -1276,6 +1417,8 @@ void ChipExchangeManager::TicklessDebugDumpRetransTable(const char * log)
 void ChipExchangeManager::WRMPExecuteActions(void)
 {
     ExchangeContext * ec = NULL;
+    uint16_t due[CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE];
+    size_t dueCount;
 
     // Process Ack Tables for all ExchangeContexts
     ec = (ExchangeContext *) ContextPool;
@@ -1293,8 +1436,12 @@ void ChipExchangeManager::WRMPExecuteActions(void)
 #if defined(WRMP_TICKLESS_DEBUG)
                 ChipLogProgress(ExchangeManager, "WRMPExecuteActions sending ACK");
 #endif
-                // Send the Ack in a Common::Null message
-                ec->SendCommonNullMessage();
+                // Send the Ack, along with those pending on other exchanges with the same peer, in a
+                // Common::WRMP_Multi_Ack message, or on its own in a Common::Null message
+                if (!WRMPSendCoalescedAcks(ec))
+                {
+                    ec->SendCommonNullMessage();
+                }
                 ec->SetAckPending(false);
             }
         }
@@ -1304,54 +1451,53 @@ void ChipExchangeManager::WRMPExecuteActions(void)
 
     // Retransmit / cancel anything in the retrans table whose retrans timeout
     // has expired
-    for (int i = 0; i < CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
+    dueCount = mRetransWheel.CollectDue(mWRMPCurrentTick, due);
+    for (size_t i = 0; i < dueCount; i++)
     {
-        ec = RetransTable[i].exchContext;
-        if (ec)
+        RetransTableEntry & entry = RetransTable[due[i]];
+
+        ec = entry.exchContext;
+
+        // Callbacks for earlier entries may have removed or rescheduled this one
+        if (ec && mRetransWheel.IsDue(due[i], mWRMPCurrentTick))
         {
-            CHIP_ERROR err = CHIP_NO_ERROR;
+            CHIP_ERROR err    = CHIP_NO_ERROR;
+            uint8_t sendCount = entry.sendCount;
+            void * msgCtxt    = entry.msgCtxt;
 
-            if (0 == RetransTable[i].nextRetransTime)
+            if (sendCount > ec->mWRMPConfig.mMaxRetrans)
             {
-                uint8_t sendCount = RetransTable[i].sendCount;
-                void * msgCtxt    = RetransTable[i].msgCtxt;
+                err = CHIP_ERROR_MESSAGE_NOT_ACKNOWLEDGED;
 
-                if (sendCount > ec->mWRMPConfig.mMaxRetrans)
-                {
-                    err = CHIP_ERROR_MESSAGE_NOT_ACKNOWLEDGED;
-
-                    ChipLogError(ExchangeManager,
-                                 "Failed to Send CHIP MsgId:%08" PRIX32 " sendCount: %" PRIu8 " max retries: %" PRIu8,
-                                 RetransTable[i].msgId, sendCount, ec->mWRMPConfig.mMaxRetrans);
+                ChipLogError(ExchangeManager, "Failed to Send CHIP MsgId:%08" PRIX32 " sendCount: %" PRIu8 " max retries: %" PRIu8,
+                             entry.msgId, sendCount, ec->mWRMPConfig.mMaxRetrans);
 
-                    // Remove from Table
-                    ClearRetransmitTable(RetransTable[i]);
-                }
+                // Remove from Table
+                ClearRetransmitTable(entry);
+            }
 
-                if (err == CHIP_NO_ERROR)
-                {
-                    // Resend from Table (if the operation fails, the entry is cleared)
-                    err = SendFromRetransTable(&(RetransTable[i]));
-                }
+            if (err == CHIP_NO_ERROR)
+            {
+                // Resend from Table (if the operation fails, the entry is cleared)
+                err = SendFromRetransTable(&entry);
+            }
 
-                if (err == CHIP_NO_ERROR)
-                {
-                    // If the retransmission was successful, update the passive timer
-                    RetransTable[i].nextRetransTime = ec->GetCurrentRetransmitTimeout() / mWRMPTimerInterval;
+            if (err == CHIP_NO_ERROR)
+            {
+                // If the retransmission was successful, update the passive timer
+                ScheduleRetrans(entry, mWRMPCurrentTick + GetRetransTimeout(ec, entry.sendCount) / mWRMPTimerInterval);
 #if defined(DEBUG)
-                    ChipLogProgress(ExchangeManager, "Retransmit MsgId:%08" PRIX32 " Send Cnt %d", RetransTable[i].msgId,
-                                    RetransTable[i].sendCount);
+                ChipLogProgress(ExchangeManager, "Retransmit MsgId:%08" PRIX32 " Send Cnt %d", entry.msgId, entry.sendCount);
 #endif
-                }
+            }
 
-                if (err != CHIP_NO_ERROR)
+            if (err != CHIP_NO_ERROR)
+            {
+                if (ec->OnSendError)
                 {
-                    if (ec->OnSendError)
-                    {
-                        ec->OnSendError(ec, err, msgCtxt);
-                    }
+                    ec->OnSendError(ec, err, msgCtxt);
                 }
-            } // nextRetransTime = 0
+            }
         }
     }
 
@@ -1360,11 +1506,11 @@ void ChipExchangeManager::WRMPExecuteActions(void)
 
 /**
  * Calculate number of virtual WRMP ticks that have expired since we last
- * called this function. Iterate through active exchange contexts and
- * retrans table entries, subtracting expired virtual ticks to synchronize
- * wakeup times with the current system time. Do not perform any actions
- * beyond updating tick counts, actions will be performed by the physical
- * WRMP timer tick expiry.
+ * called this function. Iterate through active exchange contexts,
+ * subtracting expired virtual ticks to synchronize wakeup times with the
+ * current system time, and advance the current tick of the retransmission
+ * timing wheel. Do not perform any actions beyond updating tick counts,
+ * actions will be performed by the physical WRMP timer tick expiry.
  *
  */
 void ChipExchangeManager::WRMPExpireTicks(void)
@@ -1394,9 +1540,19 @@ void ChipExchangeManager::WRMPExpireTicks(void)
     ChipLogProgress(ExchangeManager, "WRMPExpireTicks at %" PRIu64 ", %" PRIu64 ", %u", now, mWRMPTimeStampBase, deltaTicks);
 #endif
 
+    if (deltaTicks == 0)
+    {
+        return;
+    }
+
     for (int i = 0; i < CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
     {
-        if (ec->ExchangeMgr != NULL && ec->IsAckPending())
+        if (ec->ExchangeMgr == NULL)
+        {
+            continue;
+        }
+
+        if (ec->IsAckPending())
         {
             // Decrement counter of Ack timestamp by the elapsed timer ticks
             if (ec->mWRMPNextAckTime >= deltaTicks)
@@ -1411,17 +1567,11 @@ void ChipExchangeManager::WRMPExpireTicks(void)
             ChipLogProgress(ExchangeManager, "WRMPExpireTicks set mWRMPNextAckTime to %u", ec->mWRMPNextAckTime);
 #endif
         }
-    }
 
-    // Process Throttle Time
-    // Check Throttle timeout stored in EC to set/unset Throttle flag
-    for (int i = 0; i < CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
-    {
-        ec = RetransTable[i].exchContext;
-        if (ec)
+        // Process Throttle Time
+        // Decrement Throttle timeout stored in EC by elapsed timeticks
+        if (ec->mWRMPThrottleTimeout != 0)
         {
-            // Process Retransmit Table
-            // Decrement Throttle timeout by elapsed timeticks
             if (ec->mWRMPThrottleTimeout >= deltaTicks)
             {
                 ec->mWRMPThrottleTimeout -= deltaTicks;
@@ -1431,24 +1581,14 @@ void ChipExchangeManager::WRMPExpireTicks(void)
                 ec->mWRMPThrottleTimeout = 0;
             }
 #if defined(WRMP_TICKLESS_DEBUG)
-            ChipLogProgress(ExchangeManager, "WRMPExpireTicks set mWRMPThrottleTimeout to %u", RetransTable[i].nextRetransTime);
+            ChipLogProgress(ExchangeManager, "WRMPExpireTicks set mWRMPThrottleTimeout to %u", ec->mWRMPThrottleTimeout);
 #endif
-
-            // Decrement Retransmit timeout by elapsed timeticks
-            if (RetransTable[i].nextRetransTime >= deltaTicks)
-            {
-                RetransTable[i].nextRetransTime -= deltaTicks;
-            }
-            else
-            {
-                RetransTable[i].nextRetransTime = 0;
-            }
-#if defined(WRMP_TICKLESS_DEBUG)
-            ChipLogProgress(ExchangeManager, "WRMPExpireTicks set nextRetransTime to %u", RetransTable[i].nextRetransTime);
-#endif
-        } // ec entry is allocated
+        }
     }
 
+    // Retransmission entries hold absolute ticks, so moving the wheel forward is all they need
+    mWRMPCurrentTick += deltaTicks;
+
     // Re-Adjust the base time stamp to the most recent tick boundary
 
     // Note on math: we cast deltaTicks to a 64bit value to ensure that that we
@@ -1521,15 +1661,18 @@ CHIP_ERROR ChipExchangeManager::AddToRetransTable(ExchangeContext * ec, PacketBu
             // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
             WRMPExpireTicks();
 
-            RetransTable[i].exchContext     = ec;
-            RetransTable[i].msgId           = messageId;
-            RetransTable[i].msgBuf          = msgBuf;
-            RetransTable[i].sendCount       = 0;
-            RetransTable[i].nextRetransTime = GetTickCounterFromTimeDelta(
-                ec->GetCurrentRetransmitTimeout() + System::Timer::GetCurrentEpoch(), mWRMPTimeStampBase);
-
-            RetransTable[i].msgCtxt = msgCtxt;
-            *rEntry                 = &RetransTable[i];
+            RetransTable[i].exchContext = ec;
+            RetransTable[i].msgId       = messageId;
+            RetransTable[i].msgBuf      = msgBuf;
+            RetransTable[i].sendCount   = 0;
+            RetransTable[i].msgCtxt     = msgCtxt;
+            *rEntry                     = &RetransTable[i];
+
+            ScheduleRetrans(RetransTable[i],
+                            mWRMPCurrentTick +
+                                GetTickCounterFromTimeDelta(GetRetransTimeout(ec, 0) + System::Timer::GetCurrentEpoch(),
+                                                            mWRMPTimeStampBase));
+            mRetransPeerIndex.Link(static_cast<uint16_t>(i), RetransPeerHash(ec->PeerNodeId));
             // Increment the reference count
             ec->AddRef();
             added = true;
@@ -1570,7 +1713,7 @@ CHIP_ERROR ChipExchangeManager::SendFromRetransTable(RetransTableEntry * entry)
     // restart the timer immediately, and ExitNow.
 
     CHIP_FAULT_INJECT(FaultInjection::kFault_WRMSendError, entry->sendCount = (ec->mWRMPConfig.mMaxRetrans + 1);
-                      entry->nextRetransTime = 0; WRMPStartTimer(); ExitNow());
+                      ScheduleRetrans(*entry, mWRMPCurrentTick); WRMPStartTimer(); ExitNow());
 
     if (ec)
     {
@@ -1591,6 +1734,7 @@ CHIP_ERROR ChipExchangeManager::SendFromRetransTable(RetransTableEntry * entry)
         entry->msgBuf->SetDataLength(len);
 
         // Update the counters
+        entry->sentTime = System::Timer::GetCurrentEpoch();
         entry->sendCount++;
     }
     else
@@ -1630,12 +1774,15 @@ exit:
  */
 void ChipExchangeManager::ClearRetransmitTable(ExchangeContext * ec)
 {
-    for (int i = 0; i < CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
+    uint16_t entries[CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE];
+    size_t count = CollectPeerRetransEntries(ec->PeerNodeId, entries);
+
+    for (size_t i = 0; i < count; i++)
     {
-        if (RetransTable[i].exchContext == ec)
+        if (RetransTable[entries[i]].exchContext == ec)
         {
             // Clear the retransmit table entry.
-            ClearRetransmitTable(RetransTable[i]);
+            ClearRetransmitTable(RetransTable[entries[i]]);
         }
     }
 }
@@ -1653,6 +1800,9 @@ void ChipExchangeManager::ClearRetransmitTable(RetransTableEntry & rEntry)
         // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
         WRMPExpireTicks();
 
+        mRetransWheel.Cancel(static_cast<uint16_t>(&rEntry - RetransTable));
+        mRetransPeerIndex.Unlink(static_cast<uint16_t>(&rEntry - RetransTable));
+
         rEntry.exchContext->Release();
         rEntry.exchContext = NULL;
 
@@ -1680,14 +1830,17 @@ void ChipExchangeManager::ClearRetransmitTable(RetransTableEntry & rEntry)
  */
 void ChipExchangeManager::FailRetransmitTableEntries(ExchangeContext * ec, CHIP_ERROR err)
 {
-    for (int i = 0; i < CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
+    uint16_t entries[CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE];
+    size_t count = CollectPeerRetransEntries(ec->PeerNodeId, entries);
+
+    for (size_t i = 0; i < count; i++)
     {
-        if (RetransTable[i].exchContext == ec)
+        if (RetransTable[entries[i]].exchContext == ec)
         {
-            void * msgCtxt = RetransTable[i].msgCtxt;
+            void * msgCtxt = RetransTable[entries[i]].msgCtxt;
 
             // Remove the entry from the retransmission table.
-            ClearRetransmitTable(RetransTable[i]);
+            ClearRetransmitTable(RetransTable[entries[i]]);
 
             // Application callback OnSendError.
             if (ec->OnSendError)
@@ -1709,13 +1862,19 @@ void ChipExchangeManager::WRMPStartTimer()
     uint32_t nextWakeTime = UINT32_MAX;
     bool foundWake        = false;
     ExchangeContext * ec  = NULL;
+    uint32_t retransTicks;
 
     // When do we need to next wake up to send an ACK?
     ec = (ExchangeContext *) ContextPool;
 
     for (int i = 0; i < CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
     {
-        if (ec->ExchangeMgr != NULL && ec->IsAckPending() && ec->mWRMPNextAckTime < nextWakeTime)
+        if (ec->ExchangeMgr == NULL)
+        {
+            continue;
+        }
+
+        if (ec->IsAckPending() && ec->mWRMPNextAckTime < nextWakeTime)
         {
             nextWakeTime = ec->mWRMPNextAckTime;
             foundWake    = true;
@@ -1723,33 +1882,26 @@ void ChipExchangeManager::WRMPStartTimer()
             ChipLogProgress(ExchangeManager, "WRMPStartTimer next ACK time %u", nextWakeTime);
 #endif
         }
-    }
 
-    for (int i = 0; i < CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
-    {
-        ec = RetransTable[i].exchContext;
-        if (ec)
+        // When do we need to next wake up for throttle retransmission?
+        if (ec->mWRMPThrottleTimeout != 0 && ec->mWRMPThrottleTimeout < nextWakeTime)
         {
-            // When do we need to next wake up for throttle retransmission?
-            if (ec->mWRMPThrottleTimeout != 0 && ec->mWRMPThrottleTimeout < nextWakeTime)
-            {
-                nextWakeTime = ec->mWRMPThrottleTimeout;
-                foundWake    = true;
+            nextWakeTime = ec->mWRMPThrottleTimeout;
+            foundWake    = true;
 #if defined(WRMP_TICKLESS_DEBUG)
-                ChipLogProgress(ExchangeManager, "WRMPStartTimer throttle timeout %u", nextWakeTime);
+            ChipLogProgress(ExchangeManager, "WRMPStartTimer throttle timeout %u", nextWakeTime);
 #endif
-            }
+        }
+    }
 
-            // When do we need to next wake up for WRMP retransmit?
-            if (RetransTable[i].nextRetransTime < nextWakeTime)
-            {
-                nextWakeTime = RetransTable[i].nextRetransTime;
-                foundWake    = true;
+    // When do we need to next wake up for WRMP retransmit?
+    if (mRetransWheel.GetNextDueTicks(mWRMPCurrentTick, retransTicks) && retransTicks < nextWakeTime)
+    {
+        nextWakeTime = retransTicks;
+        foundWake    = true;
 #if defined(WRMP_TICKLESS_DEBUG)
-                ChipLogProgress(ExchangeManager, "WRMPStartTimer RetransTime %u", nextWakeTime);
+        ChipLogProgress(ExchangeManager, "WRMPStartTimer RetransTime %u", nextWakeTime);
 #endif
-            }
-        }
     }
 
     if (foundWake)
@@ -1803,6 +1955,287 @@ void ChipExchangeManager::WRMPStopTimer()
 {
     MessageLayer->SystemLayer->CancelTimer(WRMPTimeout, this);
 }
+
+/**
+ *  Set the tick at which a retransmission table entry is next due, and move it to the matching slot of the timing wheel.
+ *
+ *  @param[in]    rEntry   A reference to the RetransTableEntry object.
+ *
+ *  @param[in]    tick     The WRMP tick at which the entry is due, not earlier than the current tick.
+ *
+ */
+void ChipExchangeManager::ScheduleRetrans(RetransTableEntry & rEntry, uint32_t tick)
+{
+    mRetransWheel.Schedule(static_cast<uint16_t>(&rEntry - RetransTable), tick);
+}
+
+/**
+ *  Collect the retransmission table entries of the exchanges with a given peer node.
+ *
+ *  @param[in]    peerNodeId   Node ID of the peer node.
+ *
+ *  @param[out]   indices      Receives the indices of the entries; must hold CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE items.
+ *
+ *  @return The number of entries.
+ *
+ */
+size_t ChipExchangeManager::CollectPeerRetransEntries(uint64_t peerNodeId, uint16_t * indices)
+{
+    size_t count = 0;
+
+    for (uint16_t i = mRetransPeerIndex.First(RetransPeerHash(peerNodeId)); i != mRetransPeerIndex.kInvalidIndex;
+         i = mRetransPeerIndex.Next(i))
+    {
+        if (RetransTable[i].exchContext != NULL && RetransTable[i].exchContext->PeerNodeId == peerNodeId)
+        {
+            indices[count++] = i;
+        }
+    }
+
+    return count;
+}
+
+uint32_t ChipExchangeManager::RetransPeerHash(uint64_t peerNodeId)
+{
+    return RetransPeerIndex::Combine(0, peerNodeId);
+}
+
+/**
+ *  Return the timeout after which a message on an exchange is retransmitted.
+ *
+ *  Once a round-trip time has been measured to the peer, the timeout is derived from it, kept between
+ *  #CHIP_CONFIG_WRMP_MIN_RETRANS_TIMEOUT and #CHIP_CONFIG_WRMP_MAX_RETRANS_TIMEOUT, and doubled for every
+ *  retransmission. Until then the configured timeout of the exchange is used.
+ *
+ *  @param[in]    ec          A pointer to the ExchangeContext object.
+ *
+ *  @param[in]    sendCount   The number of times the message has been sent so far.
+ *
+ *  @return The retransmission timeout in milliseconds.
+ *
+ */
+uint32_t ChipExchangeManager::GetRetransTimeout(ExchangeContext * ec, uint8_t sendCount)
+{
+    PeerRttEntry * peer = FindPeerRtt(ec->PeerNodeId);
+
+    if (peer == NULL)
+    {
+        return ec->GetCurrentRetransmitTimeout();
+    }
+
+    return peer->estimator.GetRetransTimeout(mWRMPTimerInterval, CHIP_CONFIG_WRMP_MIN_RETRANS_TIMEOUT,
+                                             CHIP_CONFIG_WRMP_MAX_RETRANS_TIMEOUT, sendCount);
+}
+
+/**
+ *  Add a round-trip time sample for the peer of an exchange, taken from an acknowledgment received on it.
+ *
+ *  Following Karn's algorithm, acknowledgments of retransmitted messages are ignored, as they cannot be
+ *  matched to one transmission.
+ *
+ *  @param[in]    ec         A pointer to the ExchangeContext object the acknowledgment was received on.
+ *
+ *  @param[in]    ackMsgId   The message identifier being acknowledged.
+ *
+ */
+void ChipExchangeManager::SampleRtt(ExchangeContext * ec, uint32_t ackMsgId)
+{
+    RetransTableEntry * rEntry = NULL;
+    PeerRttEntry * peer        = NULL;
+    uint16_t index;
+
+    for (uint16_t i = mRetransPeerIndex.First(RetransPeerHash(ec->PeerNodeId)); i != mRetransPeerIndex.kInvalidIndex;
+         i = mRetransPeerIndex.Next(i))
+    {
+        if (RetransTable[i].exchContext == ec && RetransTable[i].msgId == ackMsgId)
+        {
+            rEntry = &RetransTable[i];
+            break;
+        }
+    }
+
+    VerifyOrExit(rEntry != NULL && WRMPRttEstimator::IsSampleValid(rEntry->sendCount), );
+
+    peer = FindPeerRtt(ec->PeerNodeId);
+    if (peer == NULL)
+    {
+        // Take a free entry, or else the one of the peer least recently heard from
+        peer = &PeerRttTable[0];
+        for (int i = 0; i < CHIP_CONFIG_WRMP_PEER_RTT_TABLE_SIZE && peer->estimator.HasSample(); i++)
+        {
+            if (!PeerRttTable[i].estimator.HasSample() ||
+                mWRMPCurrentTick - PeerRttTable[i].lastSampleTick > mWRMPCurrentTick - peer->lastSampleTick)
+            {
+                peer = &PeerRttTable[i];
+            }
+        }
+
+        index = static_cast<uint16_t>(peer - PeerRttTable);
+
+        peer->peerNodeId = ec->PeerNodeId;
+        peer->estimator.Reset();
+        mPeerRttIndex.Link(index, RetransPeerHash(ec->PeerNodeId));
+    }
+
+    peer->estimator.AddSample(static_cast<uint32_t>(System::Timer::GetCurrentEpoch() - rEntry->sentTime), rEntry->sendCount);
+    peer->lastSampleTick = mWRMPCurrentTick;
+
+#if defined(WRMP_TICKLESS_DEBUG)
+    ChipLogProgress(ExchangeManager, "SampleRtt peer %016" PRIX64 " SRTT %" PRIu32 " ms RTO %" PRIu32 " ms", ec->PeerNodeId,
+                    peer->estimator.GetSmoothedRtt(), peer->estimator.GetRetransTimeout(mWRMPTimerInterval));
+#endif
+
+exit:
+    return;
+}
+
+/**
+ *  Find the round-trip time estimate for a peer node.
+ *
+ *  @param[in]    peerNodeId   Node ID of the peer node.
+ *
+ *  @return A pointer to the PeerRttEntry of the peer, or NULL if no round-trip time was measured to it yet.
+ *
+ */
+ChipExchangeManager::PeerRttEntry * ChipExchangeManager::FindPeerRtt(uint64_t peerNodeId)
+{
+    for (uint16_t i = mPeerRttIndex.First(RetransPeerHash(peerNodeId)); i != mPeerRttIndex.kInvalidIndex;
+         i = mPeerRttIndex.Next(i))
+    {
+        if (PeerRttTable[i].estimator.HasSample() && PeerRttTable[i].peerNodeId == peerNodeId)
+        {
+            return &PeerRttTable[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ *  Send the pending acknowledgment of an exchange together with those pending on other exchanges
+ *  with the same peer, in a single Common::WRMP_Multi_Ack message.
+ *
+ *  The message is sent on the given exchange, so its own acknowledgment is piggybacked in the exchange
+ *  header; the payload lists the acknowledgments of the other exchanges, which are then no longer pending.
+ *
+ *  @param[in]    ec           A pointer to the ExchangeContext whose acknowledgment is due.
+ *
+ *  @return true if the acknowledgment was sent, false if there was nothing to send with it or the
+ *          message could not be sent, in which case the caller should send it on its own.
+ *
+ */
+bool ChipExchangeManager::WRMPSendCoalescedAcks(ExchangeContext * ec)
+{
+    WRMPAckCoalescer<ExchangeContext, CHIP_CONFIG_WRMP_MAX_COALESCED_ACKS> acks(*ec);
+    PacketBuffer * buf = NULL;
+    CHIP_ERROR err     = CHIP_NO_ERROR;
+
+    VerifyOrExit(CHIP_CONFIG_WRMP_MAX_COALESCED_ACKS > 0, err = CHIP_ERROR_INCORRECT_STATE);
+
+    // Acknowledgments pending on other exchanges with the peer are sent now, even if they are not due yet.
+    for (int role = 0; role < 2 && !acks.IsFull(); role++)
+    {
+        const uint32_t hash = PeerHash(ec->PeerNodeId, role != 0);
+
+        for (uint16_t i = mPeerIndex.First(hash); i != mPeerIndex.kInvalidIndex && !acks.IsFull(); i = mPeerIndex.Next(i))
+        {
+            acks.Add(ContextPool[i]);
+        }
+    }
+
+    VerifyOrExit(acks.Count() > 0, err = CHIP_ERROR_INCORRECT_STATE);
+
+    buf = PacketBuffer::New();
+    VerifyOrExit(buf != NULL, err = CHIP_ERROR_NO_MEMORY);
+
+    err = acks.Encode(buf->Start(), buf->AvailableDataLength());
+    SuccessOrExit(err);
+    buf->SetDataLength(static_cast<uint16_t>(acks.PayloadLength()));
+
+    err = ec->SendMessage(chip::Profiles::kChipProfile_Common, chip::Profiles::Common::kMsgType_WRMP_Multi_Ack, buf,
+                          ExchangeContext::kSendFlag_NoAutoRequestAck);
+    buf = NULL;
+    SuccessOrExit(err);
+
+    acks.MarkSent();
+
+exit:
+    if (buf != NULL)
+    {
+        PacketBuffer::Free(buf);
+    }
+
+    return err == CHIP_NO_ERROR;
+}
+
+/**
+ *  Process a received Common::WRMP_Multi_Ack message: the acknowledgment piggybacked in its exchange header,
+ *  if any, and each acknowledgment listed in its payload.
+ *
+ *  A payload of an unknown version or of the wrong length is ignored, apart from the piggybacked acknowledgment.
+ *
+ *  @param[in]    msgCon          A pointer to the ChipConnection the message was received on, or NULL.
+ *
+ *  @param[in]    msgInfo         A pointer to the ChipMessageInfo of the message.
+ *
+ *  @param[in]    exchangeHeader  A pointer to the decoded exchange header of the message.
+ *
+ *  @param[in]    msgBuf          A pointer to the PacketBuffer holding the message payload.
+ *
+ */
+void ChipExchangeManager::WRMPProcessMultiAck(ChipConnection * msgCon, ChipMessageInfo * msgInfo,
+                                              const ChipExchangeHeader * exchangeHeader, PacketBuffer * msgBuf)
+{
+    ChipExchangeHeader ackHeader = *exchangeHeader;
+    WRMPMultiAckReader reader;
+    bool isInitiator;
+    CHIP_ERROR err;
+
+    if (exchangeHeader->Flags & kChipExchangeFlag_AckId)
+    {
+        WRMPHandleAck(msgCon, msgInfo, exchangeHeader);
+    }
+
+    err = reader.Init(msgBuf->Start(), msgBuf->DataLength());
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(ExchangeManager, "Ignoring Multi-Ack payload: %s", ErrorStr(err));
+        return;
+    }
+
+    while (reader.Next(ackHeader.ExchangeId, isInitiator, ackHeader.AckMsgId))
+    {
+        ackHeader.Flags = (isInitiator ? kChipExchangeFlag_Initiator : 0) | kChipExchangeFlag_AckId;
+
+        WRMPHandleAck(msgCon, msgInfo, &ackHeader);
+    }
+}
+
+/**
+ *  Apply an acknowledgment received from a peer to the exchange it belongs to, if that exchange is still open.
+ *
+ *  @param[in]    msgCon          A pointer to the ChipConnection the acknowledgment was received on, or NULL.
+ *
+ *  @param[in]    msgInfo         A pointer to the ChipMessageInfo of the message carrying the acknowledgment.
+ *
+ *  @param[in]    ackHeader       A pointer to an exchange header identifying the exchange and the acknowledged message.
+ *
+ */
+void ChipExchangeManager::WRMPHandleAck(ChipConnection * msgCon, ChipMessageInfo * msgInfo, const ChipExchangeHeader * ackHeader)
+{
+    ExchangeContext * ec = MatchContext(msgCon, msgInfo, ackHeader);
+
+    if (ec != NULL)
+    {
+        if (!ec->HasRcvdMsgFromPeer())
+        {
+            ec->SetMsgRcvdFromPeer(true);
+        }
+
+        SampleRtt(ec, ackHeader->AckMsgId);
+        ec->WRMPHandleRcvdAck(ackHeader, msgInfo);
+    }
+}
 #endif // CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
 
 /**
@@ -27,10 +27,15 @@
 #define CHIP_EXCHANGE_MGR_H
 
 #include <message/CHIPBinding.h>
+#include <message/CHIPExchangeIndex.h>
 #include <message/CHIPFabricState.h>
 #include <message/CHIPMessageLayer.h>
 #include <message/CHIPWRMPConfig.h>
+#include <message/CHIPWRMPMultiAck.h>
+#include <message/CHIPWRMPRttEstimator.h>
+#include <message/CHIPWRMPTimingWheel.h>
 #include <support/DLLUtil.h>
+#include <support/PoolHashIndex.h>
 #include <system/SystemTimer.h>
 
 #define EXCHANGE_CONTEXT_ID(x) ((x) + 1)
@@ -119,6 +124,8 @@ class DLL_EXPORT ExchangeContext
 {
     friend class ChipExchangeManager;
     friend class ChipMessageLayer;
+    template <class ContextType, size_t kMaxAcks>
+    friend class WRMPAckCoalescer;
 
 public:
     typedef uint32_t Timeout; /**< Type used to express the timeout in this ExchangeContext, in milliseconds */
@@ -461,6 +468,7 @@ private:
     uint64_t mWRMPTimeStampBase;                  // WRMP timer base value to add offsets to evaluate timeouts
     System::Timer::Epoch mWRMPCurrentTimerExpiry; // Tracks when the WRM timer will next expire
     uint16_t mWRMPTimerInterval;                  // WRMP Timer tick period
+    uint32_t mWRMPCurrentTick;                    // Number of WRMP ticks elapsed up to mWRMPTimeStampBase
     /**
      *  @class RetransTableEntry
      *
@@ -478,9 +486,26 @@ private:
         ExchangeContext * exchContext; /**< The ExchangeContext for the stored CHIP message. */
         PacketBuffer * msgBuf;         /**< A pointer to the PacketBuffer object holding the CHIP message. */
         void * msgCtxt;                /**< A pointer to an application level context object associated with the message. */
-        uint16_t nextRetransTime;      /**< A counter representing the next retransmission time for the message. */
+        System::Timer::Epoch sentTime; /**< The time at which the message was last sent. */
         uint8_t sendCount;             /**< A counter representing the number of times the message has been sent. */
     };
+
+    /**
+     *  @class PeerRttEntry
+     *
+     *  @brief
+     *    This class is part of the CHIP Reliable Messaging Protocol and is used
+     *    to keep the round-trip time estimate from which the retransmission
+     *    timeouts for a peer node are derived.
+     *
+     */
+    class PeerRttEntry
+    {
+    public:
+        uint64_t peerNodeId;        /**< The node identifier of the peer. */
+        WRMPRttEstimator estimator; /**< The round-trip time estimate for the peer. */
+        uint32_t lastSampleTick;    /**< The WRMP timer tick at which the last sample was added. */
+    };
     void WRMPExecuteActions(void);
     void WRMPExpireTicks(void);
     void WRMPStartTimer(void);
@@ -497,11 +522,33 @@ private:
     void ClearRetransmitTable(RetransTableEntry & rEntry);
     void FailRetransmitTableEntries(ExchangeContext * ec, CHIP_ERROR err);
     void RetransPendingAppGroupMsgs(uint64_t peerNodeId);
+    void ScheduleRetrans(RetransTableEntry & rEntry, uint32_t tick);
+    size_t CollectPeerRetransEntries(uint64_t peerNodeId, uint16_t * indices);
+    static uint32_t RetransPeerHash(uint64_t peerNodeId);
+    uint32_t GetRetransTimeout(ExchangeContext * ec, uint8_t sendCount);
+    void SampleRtt(ExchangeContext * ec, uint32_t ackMsgId);
+    PeerRttEntry * FindPeerRtt(uint64_t peerNodeId);
+    bool WRMPSendCoalescedAcks(ExchangeContext * ec);
+    void WRMPProcessMultiAck(ChipConnection * msgCon, ChipMessageInfo * msgInfo, const ChipExchangeHeader * exchangeHeader,
+                             PacketBuffer * msgBuf);
+    void WRMPHandleAck(ChipConnection * msgCon, ChipMessageInfo * msgInfo, const ChipExchangeHeader * ackHeader);
 
     void TicklessDebugDumpRetransTable(const char * log);
 
     // WRMP Global tables for timer context
     RetransTableEntry RetransTable[CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE];
+
+    // Timing wheel over RetransTable, which holds the tick at which each entry in use is next due.
+    WRMPTimingWheel<CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE, CHIP_CONFIG_WRMP_TIMER_WHEEL_SIZE> mRetransWheel;
+
+    // Index over RetransTable keyed on the PeerNodeId of each entry's exchange.
+    typedef PoolHashIndex<CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE, CHIP_CONFIG_WRMP_PEER_HASH_BUCKETS> RetransPeerIndex;
+    RetransPeerIndex mRetransPeerIndex;
+
+    // Round-trip time estimates for recently active peers. An entry is in use once its estimator has a sample.
+    PeerRttEntry PeerRttTable[CHIP_CONFIG_WRMP_PEER_RTT_TABLE_SIZE];
+    typedef PoolHashIndex<CHIP_CONFIG_WRMP_PEER_RTT_TABLE_SIZE, CHIP_CONFIG_WRMP_PEER_HASH_BUCKETS> PeerRttIndex;
+    PeerRttIndex mPeerRttIndex;
 #endif // CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
 
     class UnsolicitedMessageHandler
@@ -524,7 +571,30 @@ private:
     UnsolicitedMessageHandler UMHandlerPool[CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
     void (*OnExchangeContextChanged)(size_t numContextsInUse);
 
+    // Indices over ContextPool, keyed on (Con or PeerNodeId, ExchangeId, IsInitiator()) for message dispatch and on
+    // (PeerNodeId, IsInitiator()) for FindContext. A context is indexed once its keys are set, and stays in the
+    // index after it is freed until its slot is reused, so lookups must check that a context is in use.
+    typedef PoolHashIndex<CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS, CHIP_CONFIG_EXCHANGE_CONTEXT_HASH_BUCKETS> ContextIndex;
+    ExchangeIndex<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS, CHIP_CONFIG_EXCHANGE_CONTEXT_HASH_BUCKETS> mExchangeIndex;
+    ContextIndex mPeerIndex;
+
+    // Index over UMHandlerPool, keyed on (ProfileId, MessageType). Only registered handlers are indexed.
+    typedef PoolHashIndex<CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS, CHIP_CONFIG_UNSOLICITED_MESSAGE_HANDLER_HASH_BUCKETS>
+        UMHIndex;
+    UMHIndex mUMHIndex;
+
     ExchangeContext * AllocContext(void);
+    void IndexContext(ExchangeContext * ec);
+    ExchangeContext * LookupContext(uint64_t peerNodeId, ChipConnection * msgCon, const ChipMessageInfo * msgInfo,
+                                    const ChipExchangeHeader * exchangeHeader);
+    ExchangeContext * MatchContext(ChipConnection * msgCon, const ChipMessageInfo * msgInfo,
+                                   const ChipExchangeHeader * exchangeHeader);
+    UnsolicitedMessageHandler * LookupUMH(uint32_t profileId, int16_t msgType, ChipConnection * msgCon, bool isDuplicate,
+                                          bool lastMatch);
+    UnsolicitedMessageHandler * FindUMH(uint32_t profileId, int16_t msgType, ChipConnection * con);
+
+    static uint32_t PeerHash(uint64_t peerNodeId, bool isInitiator);
+    static uint32_t UMHHash(uint32_t profileId, int16_t msgType);
 
     void HandleConnectionReceived(ChipConnection * con);
     void HandleConnectionClosed(ChipConnection * con, CHIP_ERROR conErr);
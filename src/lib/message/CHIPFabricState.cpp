@@ -250,6 +250,7 @@ CHIP_ERROR ChipFabricState::Init(GroupKeyStoreBase * groupKeyStore)
     NextUnencTCPMsgId.Init(0);
     for (int i = 0; i < CHIP_CONFIG_MAX_SESSION_KEYS; i++)
         SessionKeys[i].Init();
+    SessionKeysByNode.Init();
 #if CHIP_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
     CHIP_ERROR err =
         NextGroupKeyMsgId.Init(CHIP_CONFIG_PERSISTED_STORAGE_ENC_MSG_CNTR_ID, CHIP_CONFIG_PERSISTED_STORAGE_ENC_MSG_CNTR_EPOCH);
@@ -261,6 +262,8 @@ CHIP_ERROR ChipFabricState::Init(GroupKeyStoreBase * groupKeyStore)
     AppKeyCache.Init();
 #endif
     memset(&PeerStates, 0, sizeof(PeerStates));
+    PeerStatesByNode.Init();
+    PeerStatesByRecentUse.Init();
     Delegate = NULL;
     memset(SharedSessionsNodes, 0, sizeof(SharedSessionsNodes));
 
@@ -336,6 +339,8 @@ CHIP_ERROR ChipFabricState::AllocSessionKey(uint64_t peerNodeId, uint16_t keyId,
     sessionKey->Flags        = ChipSessionKey::kFlag_RecentlyActive;
     sessionKey->ReserveCount = 1;
 
+    IndexSessionKey(sessionKey);
+
     return CHIP_NO_ERROR;
 }
 
@@ -411,6 +416,7 @@ void ChipFabricState::RemoveSessionKey(ChipSessionKey * sessionKey, bool wasIdle
                   sessionKey->MsgEncKey.KeyId, sessionKey->NodeId);
 
     RemoveSharedSessionEndNodes(sessionKey);
+    SessionKeysByNode.Unlink(static_cast<uint16_t>(sessionKey - SessionKeys));
     sessionKey->Clear();
 }
 
@@ -433,15 +439,15 @@ CHIP_ERROR ChipFabricState::GetSessionKey(uint16_t keyId, uint64_t peerNodeId, C
  */
 ChipSessionKey * ChipFabricState::FindSharedSession(uint64_t terminatingNodeId, ChipAuthMode authMode, uint8_t encType)
 {
-    ChipSessionKey * sessionKey;
-
-    // Search the session keys table for an established shared session key that targets the specified
-    // terminating node and matches the given auth mode and encryption type.
-    sessionKey = SessionKeys;
-    for (int i = 0; i < CHIP_CONFIG_MAX_SESSION_KEYS; i++, sessionKey++)
+    // Search the session keys of the terminating node for an established shared session key that
+    // matches the given auth mode and encryption type.
+    for (uint16_t i = SessionKeysByNode.First(NodeHash(terminatingNodeId)); i != SessionKeyNodeIndex::kInvalidIndex;
+         i = SessionKeysByNode.Next(i))
     {
-        if (sessionKey->IsAllocated() && sessionKey->IsKeySet() && sessionKey->IsSharedSession() &&
-            sessionKey->NodeId == terminatingNodeId && sessionKey->AuthMode == authMode && sessionKey->MsgEncKey.EncType == encType)
+        ChipSessionKey * sessionKey = &SessionKeys[i];
+
+        if (sessionKey->IsKeySet() && sessionKey->IsSharedSession() && sessionKey->NodeId == terminatingNodeId &&
+            sessionKey->AuthMode == authMode && sessionKey->MsgEncKey.EncType == encType)
         {
             return sessionKey;
         }
@@ -792,6 +798,7 @@ CHIP_ERROR ChipFabricState::RestoreSession(uint8_t * serializedSession, uint16_t
         sessionKey->BoundCon        = NULL;
         sessionKey->ReserveCount    = 0;
         sessionKey->Flags           = 0;
+        IndexSessionKey(sessionKey);
     }
     else
     {
@@ -1258,16 +1265,17 @@ exit:
  */
 bool ChipFabricState::FindOrAllocPeerEntry(uint64_t peerNodeId, bool allocEntry, PeerIndexType & retPeerIndex)
 {
+    const uint32_t hash = NodeHash(peerNodeId);
     uint16_t i;
     bool retVal = false;
 
     // Find peer entry in the peer state table.
-    for (i = 0; i < PeerCount; i++)
+    for (i = PeerStatesByNode.First(hash); i != PeerNodeIndex::kInvalidIndex; i = PeerStatesByNode.Next(i))
     {
-        retPeerIndex = PeerStates.MostRecentlyUsedIndexes[i];
-        if (PeerStates.NodeId[retPeerIndex] == peerNodeId)
+        if (PeerStates.NodeId[i] == peerNodeId)
         {
-            retVal = true;
+            retPeerIndex = static_cast<PeerIndexType>(i);
+            retVal       = true;
             break;
         }
     }
@@ -1282,14 +1290,13 @@ bool ChipFabricState::FindOrAllocPeerEntry(uint64_t peerNodeId, bool allocEntry,
         if (PeerCount == CHIP_CONFIG_MAX_PEER_NODES)
         {
             // Choose the least recently used peer entry by default.
-            i = CHIP_CONFIG_MAX_PEER_NODES - 1;
+            i = PeerStatesByRecentUse.LeastRecent();
 
 #if CHIP_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
             // Try to find the least recently used peer entry that didn't use encryption.
-            for (int j = CHIP_CONFIG_MAX_PEER_NODES - 1; j >= 0; j--)
+            for (uint16_t j = i; j != PeerRecentUseList::kInvalidIndex; j = PeerStatesByRecentUse.Newer(j))
             {
-                PeerIndexType peerInd = PeerStates.MostRecentlyUsedIndexes[j];
-                if ((PeerStates.GroupKeyRcvFlags[peerInd] & ChipSessionState::kReceiveFlags_MessageIdSynchronized) == 0)
+                if ((PeerStates.GroupKeyRcvFlags[j] & ChipSessionState::kReceiveFlags_MessageIdSynchronized) == 0)
                 {
                     i = j;
                     break;
@@ -1298,17 +1305,17 @@ bool ChipFabricState::FindOrAllocPeerEntry(uint64_t peerNodeId, bool allocEntry,
 #endif
 
             // The peer index chosen for replacement.
-            retPeerIndex = PeerStates.MostRecentlyUsedIndexes[i];
+            retPeerIndex = static_cast<PeerIndexType>(i);
         }
 
-        // If PeerStates table is not full then the next available entry is "i".
+        // If PeerStates table is not full then the next available entry is "PeerCount".
         // Entries in the table are allocated sequentially and never discarded until
         // the table is full. Only when table is full the least recently used entry
         // is discarded and replaced with the new entry.
         else
         {
+            retPeerIndex = PeerCount;
             PeerCount++;
-            retPeerIndex = i;
         }
 
         PeerStates.NodeId[retPeerIndex]               = peerNodeId;
@@ -1318,14 +1325,14 @@ bool ChipFabricState::FindOrAllocPeerEntry(uint64_t peerNodeId, bool allocEntry,
         PeerStates.GroupKeyRcvFlags[retPeerIndex]     = 0;
 #endif
         PeerStates.UnencRcvFlags[retPeerIndex] = 0;
-        retVal                                 = true;
+        PeerStatesByNode.Link(retPeerIndex, hash);
+        retVal = true;
     }
 
-    // Move the requested entry to the top of the most recently used indexes list.
+    // Make the requested entry the most recently used one.
     if (retVal)
     {
-        memmove(&PeerStates.MostRecentlyUsedIndexes[1], &PeerStates.MostRecentlyUsedIndexes[0], i * sizeof(PeerIndexType));
-        PeerStates.MostRecentlyUsedIndexes[0] = retPeerIndex;
+        PeerStatesByRecentUse.Touch(retPeerIndex);
     }
 
     return retVal;
@@ -1872,26 +1879,32 @@ exit:
  */
 CHIP_ERROR ChipFabricState::FindSessionKey(uint16_t keyId, uint64_t peerNodeId, bool create, ChipSessionKey *& retRec)
 {
-    ChipSessionKey * curRec  = SessionKeys;
-    ChipSessionKey * freeRec = NULL;
-
     if (!ChipKeyId::IsSessionKey(keyId))
         return CHIP_ERROR_WRONG_KEY_TYPE;
 
     if (peerNodeId == kNodeIdNotSpecified || peerNodeId == kAnyNodeId)
         return CHIP_ERROR_INVALID_ARGUMENT;
 
-    for (int i = 0; i < CHIP_CONFIG_MAX_SESSION_KEYS; i++, curRec++)
+    // Look for the key among the session keys shared with the peer.
+    for (uint16_t i = SessionKeysByNode.First(NodeHash(peerNodeId)); i != SessionKeyNodeIndex::kInvalidIndex;
+         i = SessionKeysByNode.Next(i))
     {
-        if (!curRec->IsAllocated())
+        if (SessionKeys[i].MsgEncKey.KeyId == keyId && SessionKeys[i].NodeId == peerNodeId)
         {
-            if (freeRec == NULL)
-                freeRec = curRec;
+            retRec = &SessionKeys[i];
+            return CHIP_NO_ERROR;
         }
-        else if (curRec->MsgEncKey.KeyId == keyId &&
-                 (curRec->NodeId == peerNodeId || (curRec->IsSharedSession() && FindSharedSessionEndNode(peerNodeId, curRec))))
+    }
+
+    // Otherwise look for a shared session that the peer is an end node of.
+    for (int i = 0; i < CHIP_CONFIG_MAX_SHARED_SESSIONS_END_NODES; i++)
+    {
+        ChipSessionKey * sessionKey = SharedSessionsNodes[i].SessionKey;
+
+        if (SharedSessionsNodes[i].EndNodeId == peerNodeId && sessionKey != NULL && sessionKey->IsAllocated() &&
+            sessionKey->IsSharedSession() && sessionKey->MsgEncKey.KeyId == keyId)
         {
-            retRec = curRec;
+            retRec = sessionKey;
             return CHIP_NO_ERROR;
         }
     }
@@ -1899,12 +1912,29 @@ CHIP_ERROR ChipFabricState::FindSessionKey(uint16_t keyId, uint64_t peerNodeId,
     if (!create)
         return CHIP_ERROR_KEY_NOT_FOUND;
 
-    if (freeRec == NULL)
-        return CHIP_ERROR_TOO_MANY_KEYS;
+    for (int i = 0; i < CHIP_CONFIG_MAX_SESSION_KEYS; i++)
+    {
+        if (!SessionKeys[i].IsAllocated())
+        {
+            retRec = &SessionKeys[i];
+            return CHIP_NO_ERROR;
+        }
+    }
 
-    retRec = freeRec;
+    return CHIP_ERROR_TOO_MANY_KEYS;
+}
 
-    return CHIP_NO_ERROR;
+/**
+ * Add a session key to the index, once its key id and peer node id are set.
+ */
+void ChipFabricState::IndexSessionKey(ChipSessionKey * sessionKey)
+{
+    SessionKeysByNode.Link(static_cast<uint16_t>(sessionKey - SessionKeys), NodeHash(sessionKey->NodeId));
+}
+
+uint32_t ChipFabricState::NodeHash(uint64_t nodeId)
+{
+    return SessionKeyNodeIndex::Combine(0, nodeId);
 }
 
 #if CHIP_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
@@ -1923,6 +1953,9 @@ CHIP_ERROR ChipFabricState::FindMsgEncAppKey(uint16_t keyId, uint8_t encType, Ch
         err = DeriveMsgEncAppKey(keyId, encType, *retRec, appGroupGlobalId);
         SuccessOrExit(err);
 
+        // Only a derived key can be found in the cache; after a failure the entry is reused as it is.
+        AppKeyCache.IndexKeyEntry(retRec);
+
 #if CHIP_CONFIG_SECURITY_TEST_MODE && CHIP_DETAIL_LOGGING
         if (LogKeys)
         {
@@ -2067,7 +2100,9 @@ void ChipMsgEncryptionKeyCache::Reset()
 {
     for (uint8_t keyEntry = 0; keyEntry < CHIP_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS; keyEntry++)
         Clear(keyEntry);
-    memset(mMostRecentlyUsedKeyEntries, 0, sizeof(mMostRecentlyUsedKeyEntries));
+    mKeyEntryIndex.Init();
+    mRecentlyUsedKeyEntries.Init();
+    mUsedKeyEntryCount = 0;
 }
 
 // Clear key cache entry.
@@ -2078,48 +2113,60 @@ void ChipMsgEncryptionKeyCache::Clear(uint8_t keyEntryIndex)
     mKeyCache[keyEntryIndex].EncType = kChipEncryptionType_None;
 }
 
+uint32_t ChipMsgEncryptionKeyCache::KeyEntryHash(uint16_t keyId, uint8_t encType)
+{
+    return KeyEntryIndex::Combine(encType, keyId);
+}
+
 // If the key is found in the cache then function returns pointer to the key.
-// If the key is not found in the cache then function allocates and returns pointer to the empty key entry in the cache.
+// If the key is not found in the cache then function returns pointer to an empty key entry, which is only added to the
+// cache by IndexKeyEntry() once a key has been derived into it. Until then the same entry is handed out again.
 ChipMsgEncryptionKey * ChipMsgEncryptionKeyCache::FindOrAllocateKeyEntry(uint16_t keyId, uint8_t encType)
 {
-    ChipMsgEncryptionKey * keyEntry;
-    uint8_t retKeyEntryIndex = CHIP_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS;
-    uint8_t i;
+    const uint32_t hash = KeyEntryHash(keyId, encType);
+    uint16_t keyEntryIndex;
 
     // Find if key is in the cache.
-    for (i = 0, keyEntry = mKeyCache; i < CHIP_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS; i++, keyEntry++)
+    for (keyEntryIndex = mKeyEntryIndex.First(hash); keyEntryIndex != KeyEntryIndex::kInvalidIndex;
+         keyEntryIndex = mKeyEntryIndex.Next(keyEntryIndex))
     {
-        if (keyEntry->KeyId == keyId && keyEntry->EncType == encType)
-        {
-            retKeyEntryIndex = i;
+        if (mKeyCache[keyEntryIndex].KeyId == keyId && mKeyCache[keyEntryIndex].EncType == encType)
             break;
-        }
-        else if (retKeyEntryIndex == CHIP_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS && keyEntry->KeyId == ChipKeyId::kNone)
-        {
-            retKeyEntryIndex = i;
-        }
     }
 
-    // If cache is full and specified key was not found in the cache then replace the least-recently used key entry.
-    if (retKeyEntryIndex == CHIP_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS)
+    // Mark found key entry as most-recently used.
+    if (keyEntryIndex != KeyEntryIndex::kInvalidIndex)
     {
-        // Chose the least-recently used entry in the key cache.
-        retKeyEntryIndex = mMostRecentlyUsedKeyEntries[CHIP_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS - 1];
+        mRecentlyUsedKeyEntries.Touch(keyEntryIndex);
+    }
 
-        // Clear replaced key cache entry.
-        Clear(retKeyEntryIndex);
+    // Otherwise use an entry that has not been handed out yet, if any.
+    else if (mUsedKeyEntryCount < CHIP_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS)
+    {
+        keyEntryIndex = mUsedKeyEntryCount;
     }
 
-    // Find key entry index in the most-recently used list of entries.
-    for (i = 0; i < CHIP_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS; i++)
-        if (mMostRecentlyUsedKeyEntries[i] == retKeyEntryIndex)
-            break;
+    // Otherwise replace the least-recently used key entry.
+    else
+    {
+        keyEntryIndex = mRecentlyUsedKeyEntries.LeastRecent();
+        mKeyEntryIndex.Unlink(keyEntryIndex);
+        Clear(static_cast<uint8_t>(keyEntryIndex));
+    }
+
+    return &mKeyCache[keyEntryIndex];
+}
+
+// Add an entry returned by FindOrAllocateKeyEntry() to the cache, as the most-recently used one, once its key is set.
+void ChipMsgEncryptionKeyCache::IndexKeyEntry(ChipMsgEncryptionKey * keyEntry)
+{
+    const uint16_t keyEntryIndex = static_cast<uint16_t>(keyEntry - mKeyCache);
 
-    // Mark selected key entry as most-recently used by moving it to the top of the most-recently used key entries list.
-    memmove(&mMostRecentlyUsedKeyEntries[1], &mMostRecentlyUsedKeyEntries[0], i * sizeof(uint8_t));
-    mMostRecentlyUsedKeyEntries[0] = retKeyEntryIndex;
+    if (keyEntryIndex == mUsedKeyEntryCount)
+        mUsedKeyEntryCount++;
 
-    return &mKeyCache[retKeyEntryIndex];
+    mKeyEntryIndex.Link(keyEntryIndex, KeyEntryHash(keyEntry->KeyId, keyEntry->EncType));
+    mRecentlyUsedKeyEntries.Touch(keyEntryIndex);
 }
 
 #if CHIP_CONFIG_SECURITY_TEST_MODE
@@ -44,6 +44,8 @@
 #include <support/DLLUtil.h>
 #include <support/FlagUtils.hpp>
 #include <support/PersistedCounter.h>
+#include <support/PoolHashIndex.h>
+#include <support/PoolLruList.h>
 
 namespace chip {
 
@@ -436,14 +438,22 @@ public:
     void Shutdown(void);
 
     ChipMsgEncryptionKey * FindOrAllocateKeyEntry(uint16_t keyId, uint8_t encType);
+    void IndexKeyEntry(ChipMsgEncryptionKey * keyEntry);
 
 private:
+    typedef PoolHashIndex<CHIP_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS, CHIP_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS> KeyEntryIndex;
+
     // Array of CHIP message encryption keys.
     ChipMsgEncryptionKey mKeyCache[CHIP_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS];
-    // Array of key entry indexes in sorted order from most- to least- recently used.
-    uint8_t mMostRecentlyUsedKeyEntries[CHIP_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS];
+    // Index of key entries keyed on (KeyId, EncType).
+    KeyEntryIndex mKeyEntryIndex;
+    // Key entries in order from most- to least- recently used.
+    PoolLruList<CHIP_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS> mRecentlyUsedKeyEntries;
+    // Number of key entries added to the cache since the last reset; entries are added in index order.
+    uint8_t mUsedKeyEntryCount;
 
     void Clear(uint8_t keyEntryIndex);
+    static uint32_t KeyEntryHash(uint16_t keyId, uint8_t encType);
 };
 
 /**
@@ -618,6 +628,9 @@ private:
     MonotonicallyIncreasingCounter NextUnencUDPMsgId;
     MonotonicallyIncreasingCounter NextUnencTCPMsgId;
     ChipSessionKey SessionKeys[CHIP_CONFIG_MAX_SESSION_KEYS];
+    // Index of allocated session keys keyed on NodeId; a shared session is indexed under its terminating node.
+    typedef PoolHashIndex<CHIP_CONFIG_MAX_SESSION_KEYS, CHIP_CONFIG_SESSION_KEY_HASH_BUCKETS> SessionKeyNodeIndex;
+    SessionKeyNodeIndex SessionKeysByNode;
 #if CHIP_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
     PersistedCounter NextGroupKeyMsgId;
 
@@ -650,9 +663,12 @@ private:
         ChipSessionState::ReceiveFlagsType GroupKeyRcvFlags[CHIP_CONFIG_MAX_PEER_NODES];
 #endif
         ChipSessionState::ReceiveFlagsType UnencRcvFlags[CHIP_CONFIG_MAX_PEER_NODES];
-        // Array of peer indexes in sorted order from most- to least- recently used.
-        PeerIndexType MostRecentlyUsedIndexes[CHIP_CONFIG_MAX_PEER_NODES];
     } PeerStates;
+    // Index of the peer entries in use keyed on NodeId, and the same entries from most- to least- recently used.
+    typedef PoolHashIndex<CHIP_CONFIG_MAX_PEER_NODES, CHIP_CONFIG_PEER_NODE_HASH_BUCKETS> PeerNodeIndex;
+    typedef PoolLruList<CHIP_CONFIG_MAX_PEER_NODES> PeerRecentUseList;
+    PeerNodeIndex PeerStatesByNode;
+    PeerRecentUseList PeerStatesByRecentUse;
     FabricStateDelegate * Delegate;
 
     // This structure contains information about shared session end node.
@@ -676,6 +692,9 @@ private:
     static void OnMsgCounterSyncRespTimeout(System::Layer * aSystemLayer, void * aAppState, System::Error aError);
 #endif
 
+    void IndexSessionKey(ChipSessionKey * sessionKey);
+    static uint32_t NodeHash(uint64_t nodeId);
+
     bool FindOrAllocPeerEntry(uint64_t peerNodeId, bool allocEntry, PeerIndexType & retPeerIndex);
     CHIP_ERROR FindMsgEncAppKey(uint16_t keyId, uint8_t encType, ChipMsgEncryptionKey *& retRec);
     CHIP_ERROR DeriveMsgEncAppKey(uint32_t keyId, uint8_t encType, ChipMsgEncryptionKey & appKey, uint32_t & appGroupGlobalId);
@@ -70,6 +70,12 @@ ChipSecurityManager::ChipSecurityManager(void)
 {
     State        = kState_NotInitialized;
     mSystemLayer = NULL;
+    mSession     = NULL;
+
+    for (size_t i = 0; i < CHIP_CONFIG_MAX_SESSION_ESTABLISHMENTS; i++)
+    {
+        mSessionPool[i].Init(this);
+    }
 }
 
 CHIP_ERROR ChipSecurityManager::Init(ChipExchangeManager & aExchangeMgr, System::Layer & aSystemLayer)
@@ -87,17 +93,16 @@ CHIP_ERROR ChipSecurityManager::Init(ChipExchangeManager & aExchangeMgr, System:
     OnSessionEstablished    = NULL;
     OnSessionError          = NULL;
     OnKeyErrorMsgRcvd       = NULL;
-    mEC                     = NULL;
-    mCon                    = NULL;
-#if CHIP_CONFIG_ENABLE_PASE_INITIATOR || CHIP_CONFIG_ENABLE_PASE_RESPONDER
-    mPASEEngine = NULL;
-#endif
+    mSession                = NULL;
+
+    // The fixed-size security memory pools only hold one session establishment's worth of state.
+    MaxConcurrentSessionEstablishments = CHIP_CONFIG_MEMORY_MGMT_MALLOC ? CHIP_CONFIG_MAX_SESSION_ESTABLISHMENTS : 1;
+
 #if CHIP_CONFIG_ENABLE_PASE_RESPONDER
     mPASERateLimiterTimeout = 0;
     mPASERateLimiterCount   = 0;
 #endif
 #if CHIP_CONFIG_ENABLE_CASE_INITIATOR || CHIP_CONFIG_ENABLE_CASE_RESPONDER
-    mCASEEngine          = NULL;
     mDefaultAuthDelegate = NULL;
 #endif
 #if CHIP_CONFIG_ENABLE_CASE_INITIATOR
@@ -110,9 +115,6 @@ CHIP_ERROR ChipSecurityManager::Init(ChipExchangeManager & aExchangeMgr, System:
     ResponderAllowedCASEConfigs = CASE::kCASEAllowedConfig_Config2 | CASE::kCASEAllowedConfig_Config1;
     ResponderAllowedCASECurves  = CHIP_CONFIG_DEFAULT_CASE_ALLOWED_CURVES;
 #endif
-#if CHIP_CONFIG_ENABLE_TAKE_INITIATOR || CHIP_CONFIG_ENABLE_TAKE_RESPONDER
-    mTAKEEngine = NULL;
-#endif
 #if CHIP_CONFIG_ENABLE_TAKE_RESPONDER
     mDefaultTAKETokenAuthDelegate = NULL;
 #endif
@@ -120,7 +122,6 @@ CHIP_ERROR ChipSecurityManager::Init(ChipExchangeManager & aExchangeMgr, System:
     mDefaultTAKEChallengerAuthDelegate = NULL;
 #endif
 #if CHIP_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
-    mKeyExport                       = NULL;
     InitiatorKeyExportConfig         = KeyExport::kKeyExportConfig_Config1;
     InitiatorAllowedKeyExportConfigs = KeyExport::kKeyExportSupportedConfig_All;
 #endif
@@ -133,15 +134,17 @@ CHIP_ERROR ChipSecurityManager::Init(ChipExchangeManager & aExchangeMgr, System:
 #if CHIP_CONFIG_ENABLE_KEY_EXPORT_INITIATOR || CHIP_CONFIG_ENABLE_KEY_EXPORT_RESPONDER
     mDefaultKeyExportDelegate = NULL;
 #endif
-    mStartSecureSession_OnComplete = NULL;
-    mStartSecureSession_OnError    = NULL;
-    mStartSecureSession_ReqState   = NULL;
-    mRequestedAuthMode             = kChipAuthMode_NotSpecified;
-    mSessionKeyId                  = ChipKeyId::kNone;
-    mEncType                       = kChipEncryptionType_None;
 
     mFlags = 0;
 
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    err = System::Mutex::Init(mAuthDelegateLock);
+    SuccessOrExit(err);
+
+    err = mCryptoWorker.Start(aSystemLayer);
+    SuccessOrExit(err);
+#endif
+
     err = ExchangeManager->RegisterUnsolicitedMessageHandler(kChipProfile_Security, HandleUnsolicitedMessage, this);
     SuccessOrExit(err);
 
@@ -168,9 +171,26 @@ CHIP_ERROR ChipSecurityManager::Shutdown(void)
         ExchangeManager->UnregisterUnsolicitedMessageHandler(kChipProfile_Security);
         ExchangeManager = NULL;
 
-        // TODO: clean-up in-progress session establishment
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+        // Wait for the step in progress on the crypto worker, if any, to finish.
+        mCryptoWorker.Stop();
+#endif
 
-        Reset();
+        for (size_t i = 0; i < CHIP_CONFIG_MAX_SESSION_ESTABLISHMENTS; i++)
+        {
+            SessionScope scope(this, &mSessionPool[i]);
+
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+            // The worker no longer runs nor hands back steps, so free any along with their engine now.
+            if (mSession->mCryptoStep != NULL)
+            {
+                FreeCASEResponderStep(*mSession, true);
+                mSession->mCASEEngine = NULL;
+            }
+#endif
+
+            Reset();
+        }
 
         State = kState_NotInitialized;
     }
@@ -182,8 +202,9 @@ void ChipSecurityManager::HandleUnsolicitedMessage(ExchangeContext * ec, const I
                                                    const ChipMessageInfo * msgInfo, uint32_t profileId, uint8_t msgType,
                                                    PacketBuffer * msgBuf)
 {
-    CHIP_ERROR err               = CHIP_NO_ERROR;
-    ChipSecurityManager * secMgr = (ChipSecurityManager *) ec->AppState;
+    CHIP_ERROR err                 = CHIP_NO_ERROR;
+    ChipSecurityManager * secMgr   = (ChipSecurityManager *) ec->AppState;
+    SessionEstablishment * session = NULL;
 
     // Handle Key Error Messages.
     if (profileId == kChipProfile_Security && msgType == kMsgType_KeyError)
@@ -195,8 +216,9 @@ void ChipSecurityManager::HandleUnsolicitedMessage(ExchangeContext * ec, const I
         ExitNow();
     }
 
-    // Verify that we don't already have a session establishment in progress.
-    VerifyOrExit(secMgr->State == kState_Idle, err = CHIP_ERROR_SECURITY_MANAGER_BUSY);
+    // Verify that another session establishment can be started.
+    session = secMgr->AllocSession();
+    VerifyOrExit(session != NULL, err = CHIP_ERROR_SECURITY_MANAGER_BUSY);
 
     CHIP_FAULT_INJECT(chip::FaultInjection::kFault_SecMgrBusy, {
         secMgr->AsyncNotifySecurityManagerAvailable();
@@ -227,6 +249,7 @@ void ChipSecurityManager::HandleUnsolicitedMessage(ExchangeContext * ec, const I
                          secMgr->mPASERateLimiterTimeout < nowTimeMS,
                      err = CHIP_ERROR_RATE_LIMIT_EXCEEDED);
 
+        SessionScope scope(secMgr, session);
         secMgr->HandlePASESessionStart(ec, pktInfo, msgInfo, msgBuf);
         msgBuf = NULL;
 #else
@@ -238,6 +261,7 @@ void ChipSecurityManager::HandleUnsolicitedMessage(ExchangeContext * ec, const I
     else if (profileId == kChipProfile_Security && msgType == kMsgType_CASEBeginSessionRequest)
     {
 #if CHIP_CONFIG_ENABLE_CASE_RESPONDER
+        SessionScope scope(secMgr, session);
         secMgr->HandleCASESessionStart(ec, pktInfo, msgInfo, msgBuf);
         msgBuf = NULL;
 #else
@@ -253,6 +277,7 @@ void ChipSecurityManager::HandleUnsolicitedMessage(ExchangeContext * ec, const I
         // TAKE is not supported over WRMP.
         VerifyOrExit(ec->Con != NULL, err = CHIP_ERROR_INVALID_ARGUMENT);
 
+        SessionScope scope(secMgr, session);
         secMgr->HandleTAKESessionStart(ec, pktInfo, msgInfo, msgBuf);
         msgBuf = NULL;
 #else
@@ -264,6 +289,7 @@ void ChipSecurityManager::HandleUnsolicitedMessage(ExchangeContext * ec, const I
     else if (profileId == kChipProfile_Security && msgType == kMsgType_KeyExportRequest)
     {
 #if CHIP_CONFIG_ENABLE_KEY_EXPORT_RESPONDER
+        SessionScope scope(secMgr, session);
         secMgr->HandleKeyExportRequest(ec, pktInfo, msgInfo, msgBuf);
         msgBuf = NULL;
 #else
@@ -312,12 +338,13 @@ CHIP_ERROR ChipSecurityManager::StartPASESession(ChipConnection * con, ChipAuthM
     CHIP_ERROR err = CHIP_NO_ERROR;
     ChipSessionKey * sessionKey;
     bool clearStateOnError = false;
+    SessionScope scope(this, AllocSession());
 
     // Verify security manager has been initialized.
     VerifyOrExit(State != kState_NotInitialized, err = CHIP_ERROR_INCORRECT_STATE);
 
-    // Verify there is no session in process.
-    VerifyOrExit(State == kState_Idle, err = CHIP_ERROR_SECURITY_MANAGER_BUSY);
+    // Verify another session establishment can be started.
+    VerifyOrExit(mSession != NULL, err = CHIP_ERROR_SECURITY_MANAGER_BUSY);
 
     CHIP_FAULT_INJECT(chip::FaultInjection::kFault_SecMgrBusy, {
         AsyncNotifySecurityManagerAvailable();
@@ -331,14 +358,14 @@ CHIP_ERROR ChipSecurityManager::StartPASESession(ChipConnection * con, ChipAuthM
     // PASE is not yet supported over WRMP.
     VerifyOrExit(con != NULL, err = CHIP_ERROR_INVALID_ARGUMENT);
 
-    State                          = kState_PASEInProgress;
-    mRequestedAuthMode             = requestedAuthMode;
-    mEncType                       = kChipEncryptionType_AES128CTRSHA1;
-    mCon                           = con;
-    mStartSecureSession_OnComplete = onComplete;
-    mStartSecureSession_OnError    = onError;
-    mStartSecureSession_ReqState   = reqState;
-    mSessionKeyId                  = ChipKeyId::kNone;
+    mSession->State                          = kState_PASEInProgress;
+    mSession->mRequestedAuthMode             = requestedAuthMode;
+    mSession->mEncType                       = kChipEncryptionType_AES128CTRSHA1;
+    mSession->mCon                           = con;
+    mSession->mStartSecureSession_OnComplete = onComplete;
+    mSession->mStartSecureSession_OnError    = onError;
+    mSession->mStartSecureSession_ReqState   = reqState;
+    mSession->mSessionKeyId                  = ChipKeyId::kNone;
 
     // Any error after this point requires call to the Reset() function.
     clearStateOnError = true;
@@ -348,10 +375,10 @@ CHIP_ERROR ChipSecurityManager::StartPASESession(ChipConnection * con, ChipAuthM
     err = FabricState->AllocSessionKey(con->PeerNodeId, ChipKeyId::kNone, con, sessionKey);
     SuccessOrExit(err);
     sessionKey->SetLocallyInitiated(true);
-    mSessionKeyId = sessionKey->MsgEncKey.KeyId;
+    mSession->mSessionKeyId = sessionKey->MsgEncKey.KeyId;
 
     // Create a new exchange context.
-    err = NewSessionExchange(mCon->PeerNodeId, mCon->PeerAddr, mCon->PeerPort);
+    err = NewSessionExchange(mSession->mCon->PeerNodeId, mSession->mCon->PeerAddr, mSession->mCon->PeerPort);
     SuccessOrExit(err);
 
     // Initialize CHIP platform memory.
@@ -359,15 +386,15 @@ CHIP_ERROR ChipSecurityManager::StartPASESession(ChipConnection * con, ChipAuthM
     SuccessOrExit(err);
 
     // Allocate and initialize PASE engine object.
-    mPASEEngine = (ChipPASEEngine *) chip::Platform::Security::MemoryAlloc(sizeof(ChipPASEEngine), true);
-    VerifyOrExit(mPASEEngine != NULL, err = CHIP_ERROR_NO_MEMORY);
-    mPASEEngine->Init();
+    mSession->mPASEEngine = (ChipPASEEngine *) chip::Platform::Security::MemoryAlloc(sizeof(ChipPASEEngine), true);
+    VerifyOrExit(mSession->mPASEEngine != NULL, err = CHIP_ERROR_NO_MEMORY);
+    mSession->mPASEEngine->Init();
 
     // Initialize PASE password if provided.
     if (pw != NULL)
     {
-        mPASEEngine->Pw    = pw;
-        mPASEEngine->PwLen = pwLen;
+        mSession->mPASEEngine->Pw    = pw;
+        mSession->mPASEEngine->PwLen = pwLen;
     }
 
     // Start PASE session.
@@ -376,8 +403,8 @@ CHIP_ERROR ChipSecurityManager::StartPASESession(ChipConnection * con, ChipAuthM
 exit:
     if (err != CHIP_NO_ERROR && clearStateOnError)
     {
-        if (mSessionKeyId != ChipKeyId::kNone)
-            FabricState->RemoveSessionKey(mSessionKeyId, con->PeerNodeId);
+        if (mSession->mSessionKeyId != ChipKeyId::kNone)
+            FabricState->RemoveSessionKey(mSession->mSessionKeyId, con->PeerNodeId);
 
         Reset();
     }
@@ -392,8 +419,8 @@ void ChipSecurityManager::StartPASESession(void)
     err = SendPASEInitiatorStep1(kPASEConfig_ConfigDefault);
     SuccessOrExit(err);
 
-    mEC->OnMessageReceived  = HandlePASEMessageInitiator;
-    mEC->OnConnectionClosed = HandleConnectionClosed;
+    mSession->mEC->OnMessageReceived  = HandlePASEMessageInitiator;
+    mSession->mEC->OnConnectionClosed = HandleConnectionClosed;
 
     // Time limit overall PASE duration.
     StartSessionTimer();
@@ -409,8 +436,9 @@ void ChipSecurityManager::HandlePASEMessageInitiator(ExchangeContext * ec, const
 {
     CHIP_ERROR err               = CHIP_NO_ERROR;
     ChipSecurityManager * secMgr = (ChipSecurityManager *) ec->AppState;
+    SessionScope scope(secMgr, secMgr->FindSession(ec));
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(secMgr->mSession != NULL);
 
     // Abort the PASE interaction immediately if we receive a status report message from the responder.
     // This is a signal that the responder does not want to continue.
@@ -477,7 +505,7 @@ void ChipSecurityManager::HandlePASEMessageInitiator(ExchangeContext * ec, const
         err = secMgr->SendPASEInitiatorStep2();
         SuccessOrExit(err);
 
-        if (secMgr->mPASEEngine->State == ChipPASEEngine::kState_InitiatorDone)
+        if (secMgr->mSession->mPASEEngine->State == ChipPASEEngine::kState_InitiatorDone)
         {
             err = secMgr->HandleSessionEstablished();
             SuccessOrExit(err);
@@ -523,17 +551,18 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::SendPASEInitiatorStep1
     VerifyOrExit(msgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
 
     // Extract the password source from the requested auth mode.
-    pwSource = PasswordSourceFromAuthMode(mRequestedAuthMode);
+    pwSource = PasswordSourceFromAuthMode(mSession->mRequestedAuthMode);
 
     // Generate and encode PASE step 1 message.
     chip::Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->GenerateInitiatorStep1(msgBuf, paseConfig, FabricState->LocalNodeId, mEC->PeerNodeId, mSessionKeyId,
-                                              kChipEncryptionType_AES128CTRSHA1, pwSource, FabricState, true);
+    err = mSession->mPASEEngine->GenerateInitiatorStep1(msgBuf, paseConfig, FabricState->LocalNodeId, mSession->mEC->PeerNodeId,
+                                                        mSession->mSessionKeyId, kChipEncryptionType_AES128CTRSHA1, pwSource,
+                                                        FabricState, true);
     chip::Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
     // Send PASE step 1 message.
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_PASEInitiatorStep1, msgBuf, 0);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_PASEInitiatorStep1, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -549,7 +578,7 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::ProcessPASEResponderRe
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     // Decode and process the responder's reconfigure message.
-    err = mPASEEngine->ProcessResponderReconfigure(msgBuf, newConfig);
+    err = mSession->mPASEEngine->ProcessResponderReconfigure(msgBuf, newConfig);
     SuccessOrExit(err);
 
 exit:
@@ -562,7 +591,7 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::ProcessPASEResponderSt
 
     // Decode and process the responder's step 1 message.
     chip::Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->ProcessResponderStep1(msgBuf);
+    err = mSession->mPASEEngine->ProcessResponderStep1(msgBuf);
     chip::Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -576,7 +605,7 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::ProcessPASEResponderSt
 
     // Decode and process the responder's step 2 message.
     chip::Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->ProcessResponderStep2(msgBuf);
+    err = mSession->mPASEEngine->ProcessResponderStep2(msgBuf);
     chip::Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -595,12 +624,12 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::SendPASEInitiatorStep2
 
     // Generate and encode PASE step 1 message.
     chip::Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->GenerateInitiatorStep2(msgBuf);
+    err = mSession->mPASEEngine->GenerateInitiatorStep2(msgBuf);
     chip::Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
     // Send PASE step 2 message.
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_PASEInitiatorStep2, msgBuf, 0);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_PASEInitiatorStep2, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -615,7 +644,7 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::ProcessPASEResponderKe
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     // Decode and process the responder's key confirmation message.
-    err = mPASEEngine->ProcessResponderKeyConfirm(msgBuf);
+    err = mSession->mPASEEngine->ProcessResponderKeyConfirm(msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -641,9 +670,9 @@ void ChipSecurityManager::HandlePASESessionStart(ExchangeContext * ec, const IPP
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     // Setup state for the new PASE exchange.
-    State                  = kState_PASEInProgress;
-    mEC                    = ec;
-    mCon                   = ec->Con;
+    mSession->State        = kState_PASEInProgress;
+    mSession->mEC          = ec;
+    mSession->mCon         = ec->Con;
     ec->OnMessageReceived  = HandlePASEMessageResponder;
     ec->OnConnectionClosed = HandleConnectionClosed;
 
@@ -660,9 +689,9 @@ void ChipSecurityManager::HandlePASESessionStart(ExchangeContext * ec, const IPP
     SuccessOrExit(err);
 
     // Prepare PASE engine and start session
-    mPASEEngine = (ChipPASEEngine *) chip::Platform::Security::MemoryAlloc(sizeof(ChipPASEEngine), true);
-    VerifyOrExit(mPASEEngine != NULL, err = CHIP_ERROR_NO_MEMORY);
-    mPASEEngine->Init();
+    mSession->mPASEEngine = (ChipPASEEngine *) chip::Platform::Security::MemoryAlloc(sizeof(ChipPASEEngine), true);
+    VerifyOrExit(mSession->mPASEEngine != NULL, err = CHIP_ERROR_NO_MEMORY);
+    mSession->mPASEEngine->Init();
 
     err = ProcessPASEInitiatorStep1(ec, msgBuf);
 
@@ -703,8 +732,9 @@ void ChipSecurityManager::HandlePASEMessageResponder(ExchangeContext * ec, const
 {
     CHIP_ERROR err               = CHIP_NO_ERROR;
     ChipSecurityManager * secMgr = (ChipSecurityManager *) ec->AppState;
+    SessionScope scope(secMgr, secMgr->FindSession(ec));
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(secMgr->mSession != NULL);
 
     // Abort the PASE interaction immediately if we receive a status report message from the initiator.
     // This is a signal that the initiator does not want to continue.
@@ -723,14 +753,14 @@ void ChipSecurityManager::HandlePASEMessageResponder(ExchangeContext * ec, const
     msgBuf = NULL;
 
     // If performing key confirmation send a responder key confirmation message.
-    if (secMgr->mPASEEngine->PerformKeyConfirmation)
+    if (secMgr->mSession->mPASEEngine->PerformKeyConfirmation)
     {
         err = secMgr->SendPASEResponderKeyConfirm();
         SuccessOrExit(err);
     }
 
     // If we've successfully establish a session, go perform the appropriate actions.
-    if (secMgr->mPASEEngine->State == ChipPASEEngine::kState_ResponderDone)
+    if (secMgr->mSession->mPASEEngine->State == ChipPASEEngine::kState_ResponderDone)
     {
         err = secMgr->HandleSessionEstablished();
         SuccessOrExit(err);
@@ -752,7 +782,7 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::ProcessPASEInitiatorSt
 
     // Generate and encode PASE step 1 message.
     chip::Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->ProcessInitiatorStep1(msgBuf, FabricState->LocalNodeId, ec->PeerNodeId, FabricState);
+    err = mSession->mPASEEngine->ProcessInitiatorStep1(msgBuf, FabricState->LocalNodeId, ec->PeerNodeId, FabricState);
     chip::Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -762,14 +792,14 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::ProcessPASEInitiatorSt
     //
     // If the initiator has proposed a key id that already exists, make sure we don't remove the
     // existing key during the error clean-up process.
-    err = FabricState->AllocSessionKey(ec->PeerNodeId, mPASEEngine->SessionKeyId, ec->Con, sessionKey);
+    err = FabricState->AllocSessionKey(ec->PeerNodeId, mSession->mPASEEngine->SessionKeyId, ec->Con, sessionKey);
     SuccessOrExit(err);
     sessionKey->SetLocallyInitiated(false);
     sessionKey->SetRemoveOnIdle(false); // TODO FUTURE: Set this to true when support for PASE over WRM is implemented.
 
     // Save the proposed session key id and encryption type.
-    mSessionKeyId = mPASEEngine->SessionKeyId;
-    mEncType      = mPASEEngine->EncryptionType;
+    mSession->mSessionKeyId = mSession->mPASEEngine->SessionKeyId;
+    mSession->mEncType      = mSession->mPASEEngine->EncryptionType;
 
 exit:
     return err;
@@ -785,11 +815,11 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::SendPASEResponderRecon
     VerifyOrExit(msgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
 
     // Generate PASE reconfigure message.
-    err = mPASEEngine->GenerateResponderReconfigure(msgBuf);
+    err = mSession->mPASEEngine->GenerateResponderReconfigure(msgBuf);
     SuccessOrExit(err);
 
     // Send PASE reconfigure message.
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_PASEResponderReconfigure, msgBuf, 0);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_PASEResponderReconfigure, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -810,12 +840,12 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::SendPASEResponderStep1
 
     // Generate PASE step 1 message.
     chip::Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->GenerateResponderStep1(msgBuf);
+    err = mSession->mPASEEngine->GenerateResponderStep1(msgBuf);
     chip::Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
     // Send PASE step 1 message.
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_PASEResponderStep1, msgBuf, 0);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_PASEResponderStep1, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -836,12 +866,12 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::SendPASEResponderStep2
 
     // Generate PASE step 2 message.
     chip::Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->GenerateResponderStep2(msgBuf);
+    err = mSession->mPASEEngine->GenerateResponderStep2(msgBuf);
     chip::Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
     // Send PASE step 2 message.
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_PASEResponderStep2, msgBuf, 0);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_PASEResponderStep2, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -857,7 +887,7 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::ProcessPASEInitiatorSt
 
     // Decode and process the initiator's step 2 message.
     chip::Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->ProcessInitiatorStep2(msgBuf);
+    err = mSession->mPASEEngine->ProcessInitiatorStep2(msgBuf);
     chip::Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -875,11 +905,11 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::SendPASEResponderKeyCo
     VerifyOrExit(msgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
 
     // Generate and encode a key confirmation message.
-    err = mPASEEngine->GenerateResponderKeyConfirm(msgBuf);
+    err = mSession->mPASEEngine->GenerateResponderKeyConfirm(msgBuf);
     SuccessOrExit(err);
 
     // Send a key confirmation message.
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_PASEResponderKeyConfirm, msgBuf, 0);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_PASEResponderKeyConfirm, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -925,6 +955,7 @@ CHIP_ERROR ChipSecurityManager::StartCASESession(ChipConnection * con, uint64_t
     bool clearStateOnError      = false;
     bool isSharedSession        = (terminatingNodeId != kNodeIdNotSpecified);
     const uint8_t encType       = kChipEncryptionType_AES128CTRSHA1; // Only one encryption type supported for now.
+    SessionScope scope(this, AllocSession());
 
     // Verify security manager has been initialized.
     VerifyOrExit(State != kState_NotInitialized, err = CHIP_ERROR_INCORRECT_STATE);
@@ -949,8 +980,7 @@ CHIP_ERROR ChipSecurityManager::StartCASESession(ChipConnection * con, uint64_t
             // the concurrent request to wait until the session is fully established.
             //
             // If the located shared session is NOT in the process of being established...
-            if (State != kState_CASEInProgress || mEC->PeerNodeId != terminatingNodeId ||
-                mSessionKeyId != sessionKey->MsgEncKey.KeyId)
+            if (FindCASESession(terminatingNodeId, sessionKey->MsgEncKey.KeyId) == NULL)
             {
                 // Add a new end node to the list of end nodes associated with the session.
                 err = FabricState->AddSharedSessionEndNode(sessionKey, peerNodeId);
@@ -964,25 +994,27 @@ CHIP_ERROR ChipSecurityManager::StartCASESession(ChipConnection * con, uint64_t
 
                 ExitNow();
             }
+
+            ExitNow(err = CHIP_ERROR_SECURITY_MANAGER_BUSY);
         }
     }
 
-    // Verify there is no session in process.
-    VerifyOrExit(State == kState_Idle, err = CHIP_ERROR_SECURITY_MANAGER_BUSY);
+    // Verify another session establishment can be started.
+    VerifyOrExit(mSession != NULL, err = CHIP_ERROR_SECURITY_MANAGER_BUSY);
 
     CHIP_FAULT_INJECT(chip::FaultInjection::kFault_SecMgrBusy, {
         AsyncNotifySecurityManagerAvailable();
         ExitNow(err = CHIP_ERROR_SECURITY_MANAGER_BUSY);
     });
 
-    State                          = kState_CASEInProgress;
-    mRequestedAuthMode             = requestedAuthMode;
-    mEncType                       = encType;
-    mCon                           = con;
-    mStartSecureSession_OnComplete = onComplete;
-    mStartSecureSession_OnError    = onError;
-    mStartSecureSession_ReqState   = reqState;
-    mSessionKeyId                  = ChipKeyId::kNone;
+    mSession->State                          = kState_CASEInProgress;
+    mSession->mRequestedAuthMode             = requestedAuthMode;
+    mSession->mEncType                       = encType;
+    mSession->mCon                           = con;
+    mSession->mStartSecureSession_OnComplete = onComplete;
+    mSession->mStartSecureSession_OnError    = onError;
+    mSession->mStartSecureSession_ReqState   = reqState;
+    mSession->mSessionKeyId                  = ChipKeyId::kNone;
 
     // Any error after that would require state clearing in case of error.
     clearStateOnError = true;
@@ -993,7 +1025,7 @@ CHIP_ERROR ChipSecurityManager::StartCASESession(ChipConnection * con, uint64_t
     SuccessOrExit(err);
     sessionKey->SetLocallyInitiated(true);
     sessionKey->SetSharedSession(isSharedSession);
-    mSessionKeyId = sessionKey->MsgEncKey.KeyId;
+    mSession->mSessionKeyId = sessionKey->MsgEncKey.KeyId;
 
     // If requested session is shared.
     if (isSharedSession)
@@ -1012,25 +1044,30 @@ CHIP_ERROR ChipSecurityManager::StartCASESession(ChipConnection * con, uint64_t
     SuccessOrExit(err);
 
     // Allocate and Initialize CASE Engine object
-    mCASEEngine = (ChipCASEEngine *) chip::Platform::Security::MemoryAlloc(sizeof(ChipCASEEngine), true);
-    VerifyOrExit(mCASEEngine != NULL, err = CHIP_ERROR_NO_MEMORY);
-    mCASEEngine->Init();
+    mSession->mCASEEngine = (ChipCASEEngine *) chip::Platform::Security::MemoryAlloc(sizeof(ChipCASEEngine), true);
+    VerifyOrExit(mSession->mCASEEngine != NULL, err = CHIP_ERROR_NO_MEMORY);
+    mSession->mCASEEngine->Init();
 
     // Initialize CASE Authentication Delegate
     if (authDelegate == NULL)
         authDelegate = mDefaultAuthDelegate;
     VerifyOrExit(authDelegate != NULL, err = CHIP_ERROR_NO_CASE_AUTH_DELEGATE);
-    mCASEEngine->AuthDelegate = authDelegate;
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    mSession->mCASEAuthDelegate.Target  = authDelegate;
+    mSession->mCASEEngine->AuthDelegate = &mSession->mCASEAuthDelegate;
+#else
+    mSession->mCASEEngine->AuthDelegate = authDelegate;
+#endif
 
     // Set the allowed CASE configs and ECDH curves.
-    mCASEEngine->SetAllowedConfigs(InitiatorAllowedCASEConfigs);
-    mCASEEngine->SetAllowedCurves(InitiatorAllowedCASECurves);
+    mSession->mCASEEngine->SetAllowedConfigs(InitiatorAllowedCASEConfigs);
+    mSession->mCASEEngine->SetAllowedCurves(InitiatorAllowedCASECurves);
 
     // Set the expected peer certificate type based on the requested authentication mode.
-    mCASEEngine->SetCertType(CertTypeFromAuthMode(requestedAuthMode));
+    mSession->mCASEEngine->SetCertType(CertTypeFromAuthMode(requestedAuthMode));
 
 #if CHIP_CONFIG_SECURITY_TEST_MODE
-    mCASEEngine->SetUseKnownECDHKey(CASEUseKnownECDHKey);
+    mSession->mCASEEngine->SetUseKnownECDHKey(CASEUseKnownECDHKey);
 #endif
 
     // Start CASE Session using specified initiator parameters.
@@ -1064,35 +1101,35 @@ void ChipSecurityManager::StartCASESession(uint32_t config, uint32_t curveId)
 
         reqCtx.Reset();
         reqCtx.SetIsInitiator(true);
-        reqCtx.PeerNodeId     = mEC->PeerNodeId;
+        reqCtx.PeerNodeId     = mSession->mEC->PeerNodeId;
         reqCtx.ProtocolConfig = config;
-        mCASEEngine->SetAlternateConfigs(reqCtx);
+        mSession->mCASEEngine->SetAlternateConfigs(reqCtx);
         reqCtx.CurveId = curveId;
-        mCASEEngine->SetAlternateCurves(reqCtx);
+        mSession->mCASEEngine->SetAlternateCurves(reqCtx);
         reqCtx.SetPerformKeyConfirm(true);
-        reqCtx.SessionKeyId   = mSessionKeyId;
-        reqCtx.EncryptionType = mEncType;
+        reqCtx.SessionKeyId   = mSession->mSessionKeyId;
+        reqCtx.EncryptionType = mSession->mEncType;
 
         chip::Platform::Security::OnTimeConsumingCryptoStart();
-        err = mCASEEngine->GenerateBeginSessionRequest(reqCtx, msgBuf);
+        err = mSession->mCASEEngine->GenerateBeginSessionRequest(reqCtx, msgBuf);
         chip::Platform::Security::OnTimeConsumingCryptoDone();
         SuccessOrExit(err);
     }
 
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (mSession->mCon == NULL)
     {
         sendFlags = ExchangeContext::kSendFlag_RequestAck;
     }
 #endif
 
     // Send the message.
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_CASEBeginSessionRequest, msgBuf, sendFlags);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_CASEBeginSessionRequest, msgBuf, sendFlags);
     msgBuf = NULL;
     SuccessOrExit(err);
 
-    mEC->OnMessageReceived  = HandleCASEMessageInitiator;
-    mEC->OnConnectionClosed = HandleConnectionClosed;
+    mSession->mEC->OnMessageReceived  = HandleCASEMessageInitiator;
+    mSession->mEC->OnConnectionClosed = HandleConnectionClosed;
 
     // Time limit overall CASE duration.
     StartSessionTimer();
@@ -1111,8 +1148,9 @@ void ChipSecurityManager::HandleCASEMessageInitiator(ExchangeContext * ec, const
     CHIP_ERROR err               = CHIP_NO_ERROR;
     ChipSecurityManager * secMgr = (ChipSecurityManager *) ec->AppState;
     uint16_t sendFlags           = 0;
+    SessionScope scope(secMgr, secMgr->FindSession(ec));
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(secMgr->mSession != NULL);
 
     // Abort the CASE interaction immediately if we receive a status report message from the responder.
     // This is a signal that the responder does not want to continue.
@@ -1128,7 +1166,7 @@ void ChipSecurityManager::HandleCASEMessageInitiator(ExchangeContext * ec, const
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
         // Flush any pending WRM ACKs before we begin the long crypto operation,
         // to prevent the peer from re-transmitting the Begin Session response.
-        err = secMgr->mEC->WRMPFlushAcks();
+        err = secMgr->mSession->mEC->WRMPFlushAcks();
         SuccessOrExit(err);
 #endif
 
@@ -1142,7 +1180,7 @@ void ChipSecurityManager::HandleCASEMessageInitiator(ExchangeContext * ec, const
             respCtx.MsgInfo    = msgInfo;
 
             chip::Platform::Security::OnTimeConsumingCryptoStart();
-            err = secMgr->mCASEEngine->ProcessBeginSessionResponse(msgBuf, respCtx);
+            err = secMgr->mSession->mCASEEngine->ProcessBeginSessionResponse(msgBuf, respCtx);
             chip::Platform::Security::OnTimeConsumingCryptoDone();
             SuccessOrExit(err);
         }
@@ -1152,23 +1190,23 @@ void ChipSecurityManager::HandleCASEMessageInitiator(ExchangeContext * ec, const
         msgBuf = NULL;
 
         // If performing key confirmation...
-        if (secMgr->mCASEEngine->PerformingKeyConfirm())
+        if (secMgr->mSession->mCASEEngine->PerformingKeyConfirm())
         {
             // Generate and encode an InitiatorKeyConfirm message.
             msgBuf = PacketBuffer::New();
             VerifyOrExit(msgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
-            err = secMgr->mCASEEngine->GenerateInitiatorKeyConfirm(msgBuf);
+            err = secMgr->mSession->mCASEEngine->GenerateInitiatorKeyConfirm(msgBuf);
             SuccessOrExit(err);
 
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
-            if (secMgr->mCon == NULL)
+            if (secMgr->mSession->mCon == NULL)
             {
                 sendFlags = ExchangeContext::kSendFlag_RequestAck;
             }
 #endif
 
             // Send the InitiatorKeyConfirm message to the peer.
-            err    = secMgr->mEC->SendMessage(kChipProfile_Security, kMsgType_CASEInitiatorKeyConfirm, msgBuf, sendFlags);
+            err    = secMgr->mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_CASEInitiatorKeyConfirm, msgBuf, sendFlags);
             msgBuf = NULL;
             SuccessOrExit(err);
         }
@@ -1185,7 +1223,7 @@ void ChipSecurityManager::HandleCASEMessageInitiator(ExchangeContext * ec, const
         // on one of these events:
         //     - Received Ack from the peer for the last message on this exchange (CASEInitiatorKeyConfirm)
         //     - Received first message from the peer encrypted with established session key (mSessionKeyId)
-        if (secMgr->mCon || !secMgr->mCASEEngine->PerformingKeyConfirm())
+        if (secMgr->mSession->mCon || !secMgr->mSession->mCASEEngine->PerformingKeyConfirm())
 #endif
         {
             secMgr->HandleSessionComplete();
@@ -1198,7 +1236,7 @@ void ChipSecurityManager::HandleCASEMessageInitiator(ExchangeContext * ec, const
         // Process the reconfigure message.  If this proposed alternate configuration is not acceptable,
         // the call will fail with an error.
         CASE::ReconfigureContext reconfCtx;
-        err = secMgr->mCASEEngine->ProcessReconfigure(msgBuf, reconfCtx);
+        err = secMgr->mSession->mCASEEngine->ProcessReconfigure(msgBuf, reconfCtx);
         SuccessOrExit(err);
 
         // Release the buffer containing the response.
@@ -1240,19 +1278,41 @@ CHIP_ERROR ChipSecurityManager::StartCASESession(ChipConnection * con, uint64_t
 
 #if CHIP_CONFIG_ENABLE_CASE_RESPONDER
 
+/**
+ * The state carried across the time-consuming part of a CASE responder interaction.
+ */
+struct ChipSecurityManager::CASEResponderStep
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    : public CryptoWorker::Step
+#endif
+{
+    ChipCASEEngine * Engine;
+    PacketBuffer * MsgBuf;
+    PacketBuffer * RespMsgBuf;
+    ChipMessageInfo MsgInfo;
+    uint64_t PeerNodeId;
+    CASE::BeginSessionRequestContext ReqCtx;
+    CASE::ReconfigureContext ReconfCtx;
+    uint16_t SendFlags;
+    CHIP_ERROR Err;
+};
+
 void ChipSecurityManager::HandleCASESessionStart(ExchangeContext * ec, const IPPacketInfo * pktInfo,
                                                  const ChipMessageInfo * msgInfo, PacketBuffer * msgBuf)
 {
     CHIP_ERROR err;
-    ChipSessionKey * sessionKey;
-    CASE::BeginSessionRequestContext reqCtx;
-    CASE::ReconfigureContext reconfCtx;
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    CASEResponderStep * step = NULL;
+#else
+    CASEResponderStep stepStorage;
+    CASEResponderStep * step = &stepStorage;
+#endif
     PacketBuffer * respMsgBuf = NULL;
     uint16_t sendFlags        = 0;
 
-    State                  = kState_CASEInProgress;
-    mEC                    = ec;
-    mCon                   = ec->Con;
+    mSession->State        = kState_CASEInProgress;
+    mSession->mEC          = ec;
+    mSession->mCon         = ec->Con;
     ec->OnMessageReceived  = HandleCASEMessageResponder;
     ec->OnConnectionClosed = HandleConnectionClosed;
 
@@ -1260,14 +1320,14 @@ void ChipSecurityManager::HandleCASESessionStart(ExchangeContext * ec, const IPP
     ec->AddRef();
 
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (mSession->mCon == NULL)
     {
-        mEC->OnAckRcvd   = WRMPHandleAckRcvd;
-        mEC->OnSendError = WRMPHandleSendError;
+        mSession->mEC->OnAckRcvd   = WRMPHandleAckRcvd;
+        mSession->mEC->OnSendError = WRMPHandleSendError;
 
         // Flush any pending WRM ACKs before we begin the long crypto operation,
         // to prevent the peer from re-transmitting the Begin Session request.
-        err = mEC->WRMPFlushAcks();
+        err = mSession->mEC->WRMPFlushAcks();
         SuccessOrExit(err);
 
         sendFlags |= ExchangeContext::kSendFlag_RequestAck;
@@ -1279,51 +1339,146 @@ void ChipSecurityManager::HandleCASESessionStart(ExchangeContext * ec, const IPP
     SuccessOrExit(err);
 
     // Allocate and initialize a CASE engine.
-    mCASEEngine = (ChipCASEEngine *) chip::Platform::Security::MemoryAlloc(sizeof(ChipCASEEngine), true);
-    VerifyOrExit(mCASEEngine != NULL, err = CHIP_ERROR_NO_MEMORY);
-    mCASEEngine->Init();
+    mSession->mCASEEngine = (ChipCASEEngine *) chip::Platform::Security::MemoryAlloc(sizeof(ChipCASEEngine), true);
+    VerifyOrExit(mSession->mCASEEngine != NULL, err = CHIP_ERROR_NO_MEMORY);
+    mSession->mCASEEngine->Init();
 
     // Since this session is being initiated by a remote node, use the default auth delegate.
     // Reject the request if no auth delegate has been set.
     VerifyOrExit(mDefaultAuthDelegate != NULL, err = CHIP_ERROR_NO_CASE_AUTH_DELEGATE);
-    mCASEEngine->AuthDelegate = mDefaultAuthDelegate;
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    mSession->mCASEAuthDelegate.Target  = mDefaultAuthDelegate;
+    mSession->mCASEEngine->AuthDelegate = &mSession->mCASEAuthDelegate;
+#else
+    mSession->mCASEEngine->AuthDelegate = mDefaultAuthDelegate;
+#endif
 
     // Set the allowed protocol options for a responder.
-    mCASEEngine->SetAllowedConfigs(ResponderAllowedCASEConfigs);
-    mCASEEngine->SetAllowedCurves(ResponderAllowedCASECurves);
-    mCASEEngine->SetResponderRequiresKeyConfirm(true);
+    mSession->mCASEEngine->SetAllowedConfigs(ResponderAllowedCASEConfigs);
+    mSession->mCASEEngine->SetAllowedCurves(ResponderAllowedCASECurves);
+    mSession->mCASEEngine->SetResponderRequiresKeyConfirm(true);
 
 #if CHIP_CONFIG_SECURITY_TEST_MODE
-    mCASEEngine->SetUseKnownECDHKey(CASEUseKnownECDHKey);
+    mSession->mCASEEngine->SetUseKnownECDHKey(CASEUseKnownECDHKey);
+#endif
+
+    // Allocate a buffer to hold the encoded response up front, as the crypto step may not run on the CHIP thread.
+    respMsgBuf = PacketBuffer::New();
+    VerifyOrExit(respMsgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
+
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    step = (CASEResponderStep *) chip::Platform::Security::MemoryAlloc(sizeof(CASEResponderStep));
+    VerifyOrExit(step != NULL, err = CHIP_ERROR_NO_MEMORY);
+#endif
+
+    step->Engine     = mSession->mCASEEngine;
+    step->MsgBuf     = msgBuf;
+    step->RespMsgBuf = respMsgBuf;
+    step->MsgInfo    = *msgInfo;
+    step->PeerNodeId = ec->PeerNodeId;
+    step->SendFlags  = sendFlags;
+    step->Err        = CHIP_NO_ERROR;
+    msgBuf           = NULL;
+    respMsgBuf       = NULL;
+
+    // The packet info belongs to the caller.
+    step->MsgInfo.InPacketInfo = NULL;
+
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    // Process the request on the crypto worker, so that other messages and session establishments
+    // are handled meanwhile. The session timer limits how long the session waits for the worker.
+    err = mCryptoWorker.Run(*step, HandleCASEResponderStepWork, HandleCASEResponderStepDone, mSession);
+    SuccessOrExit(err);
+    mSession->mCryptoStep = step;
+    step                  = NULL;
+
+    StartSessionTimer();
+#else
+    RunCASEResponderStep(*step);
+    FinishCASEResponderStep(*step);
 #endif
 
+exit:
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    if (step != NULL)
+    {
+        DiscardCASEResponderStep(*step, false);
+        chip::Platform::Security::MemoryFree(step);
+    }
+#endif
+    if (err != CHIP_NO_ERROR)
+        HandleSessionError(err, NULL);
+    if (msgBuf != NULL)
+        PacketBuffer::Free(msgBuf);
+    if (respMsgBuf != NULL)
+        PacketBuffer::Free(respMsgBuf);
+}
+
+/**
+ * Process a BeginSessionRequest and generate the BeginSessionResponse, unless the request calls
+ * for a reconfigure. This is the time-consuming part of a CASE responder interaction, so it must
+ * not touch the security manager: with CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER it runs on the
+ * crypto worker thread.
+ */
+void ChipSecurityManager::RunCASEResponderStep(CASEResponderStep & step)
+{
+    CHIP_ERROR err;
+
     // Process the BeginSessionRequest
-    reqCtx.Reset();
-    reqCtx.PeerNodeId = ec->PeerNodeId;
-    reqCtx.MsgInfo    = msgInfo;
-    reconfCtx.Reset();
+    step.ReqCtx.Reset();
+    step.ReqCtx.PeerNodeId = step.PeerNodeId;
+    step.ReqCtx.MsgInfo    = &step.MsgInfo;
+    step.ReconfCtx.Reset();
     chip::Platform::Security::OnTimeConsumingCryptoStart();
-    err = mCASEEngine->ProcessBeginSessionRequest(msgBuf, reqCtx, reconfCtx);
+    err = step.Engine->ProcessBeginSessionRequest(step.MsgBuf, step.ReqCtx, step.ReconfCtx);
     chip::Platform::Security::OnTimeConsumingCryptoDone();
-    if (err != CHIP_ERROR_CASE_RECONFIG_REQUIRED)
+    SuccessOrExit(err);
+
+    // Generate the BeginSessionResponse message.
+    {
+        CASE::BeginSessionResponseContext respCtx;
+
+        respCtx.Reset();
+        respCtx.PeerNodeId     = step.PeerNodeId;
+        respCtx.MsgInfo        = &step.MsgInfo;
+        respCtx.ProtocolConfig = step.ReqCtx.ProtocolConfig;
+        respCtx.CurveId        = step.ReqCtx.CurveId;
+        respCtx.SetPerformKeyConfirm(true);
+
+        chip::Platform::Security::OnTimeConsumingCryptoStart();
+        err = step.Engine->GenerateBeginSessionResponse(respCtx, step.RespMsgBuf, step.ReqCtx);
+        chip::Platform::Security::OnTimeConsumingCryptoDone();
         SuccessOrExit(err);
+    }
+
+exit:
+    step.Err = err;
+}
+
+/**
+ * Send the outcome of a CASE responder step to the peer and advance the session accordingly.
+ * Called on the CHIP thread with the step's session as the current session.
+ */
+void ChipSecurityManager::FinishCASEResponderStep(CASEResponderStep & step)
+{
+    CHIP_ERROR err       = step.Err;
+    ExchangeContext * ec = mSession->mEC;
+    ChipSessionKey * sessionKey;
 
     // If a reconfigure is required...
     if (err == CHIP_ERROR_CASE_RECONFIG_REQUIRED)
     {
         // Discard the request buffer.
-        PacketBuffer::Free(msgBuf);
-        msgBuf = NULL;
+        PacketBuffer::Free(step.MsgBuf);
+        step.MsgBuf = NULL;
 
-        // Encode a CASE Reconfigure message into a new buffer.
-        respMsgBuf = PacketBuffer::New();
-        VerifyOrExit(respMsgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
-        err = reconfCtx.Encode(respMsgBuf);
+        // Encode a CASE Reconfigure message into the response buffer.
+        err = step.ReconfCtx.Encode(step.RespMsgBuf);
         SuccessOrExit(err);
 
         // Send the Reconfigure message to the peer.
-        err        = ec->SendMessage(kChipProfile_Security, kMsgType_CASEReconfigure, respMsgBuf, sendFlags);
-        respMsgBuf = NULL;
+        err             = ec->SendMessage(kChipProfile_Security, kMsgType_CASEReconfigure, step.RespMsgBuf, step.SendFlags);
+        step.RespMsgBuf = NULL;
         SuccessOrExit(err);
 
         // Reset the security manager.
@@ -1333,44 +1488,26 @@ void ChipSecurityManager::HandleCASESessionStart(ExchangeContext * ec, const IPP
     // Otherwise the proposed protocol parameters are acceptable, so...
     else
     {
+        SuccessOrExit(err);
+
         // Allocate an entry in the session key table using the key id proposed by the peer.
         // If the session is being established over a CHIP connection, arrange for the session key to
         // be bound to the connection, such that when the connection closes, the key is removed.
         // Set the RemoveOnIdle flag so that the session will be automatically removed after a period of
         // inactivity (note that this only applies to sessions that are NOT bound to connections).
-        err = FabricState->AllocSessionKey(ec->PeerNodeId, reqCtx.SessionKeyId, ec->Con, sessionKey);
+        err = FabricState->AllocSessionKey(ec->PeerNodeId, step.ReqCtx.SessionKeyId, ec->Con, sessionKey);
         SuccessOrExit(err);
         sessionKey->SetLocallyInitiated(false);
         sessionKey->SetRemoveOnIdle(true);
 
         // Save the proposed session key id and encryption type.
-        mSessionKeyId = reqCtx.SessionKeyId;
-        mEncType      = reqCtx.EncryptionType;
-
-        // Allocate a buffer to hold the encoded BeginSessionResponse message.
-        respMsgBuf = PacketBuffer::New();
-        VerifyOrExit(respMsgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
-
-        // Generate the BeginSessionResponse message.
-        {
-            CASE::BeginSessionResponseContext respCtx;
-
-            respCtx.Reset();
-            respCtx.PeerNodeId     = ec->PeerNodeId;
-            respCtx.MsgInfo        = msgInfo;
-            respCtx.ProtocolConfig = reqCtx.ProtocolConfig;
-            respCtx.CurveId        = reqCtx.CurveId;
-            respCtx.SetPerformKeyConfirm(true);
-
-            chip::Platform::Security::OnTimeConsumingCryptoStart();
-            err = mCASEEngine->GenerateBeginSessionResponse(respCtx, respMsgBuf, reqCtx);
-            chip::Platform::Security::OnTimeConsumingCryptoDone();
-            SuccessOrExit(err);
-        }
+        mSession->mSessionKeyId = step.ReqCtx.SessionKeyId;
+        mSession->mEncType      = step.ReqCtx.EncryptionType;
 
         // Send the BeginSessionResponse message to the peer.
-        err        = ec->SendMessage(kChipProfile_Security, kMsgType_CASEBeginSessionResponse, respMsgBuf, sendFlags);
-        respMsgBuf = NULL;
+        err = ec->SendMessage(kChipProfile_Security, kMsgType_CASEBeginSessionResponse, step.RespMsgBuf,
+                              step.SendFlags);
+        step.RespMsgBuf = NULL;
         SuccessOrExit(err);
 
         // Start a timer to limit the overall duration of session establishment.
@@ -1378,7 +1515,7 @@ void ChipSecurityManager::HandleCASESessionStart(ExchangeContext * ec, const IPP
 
         // If the CASE interaction is complete...
         // (NOTE: this will only be true if the initiator didn't request key confirmation).
-        if (mCASEEngine->State == CASE::ChipCASEEngine::kState_Complete)
+        if (mSession->mCASEEngine->State == CASE::ChipCASEEngine::kState_Complete)
         {
             // Initialize the new session.
             err = HandleSessionEstablished();
@@ -1389,7 +1526,7 @@ void ChipSecurityManager::HandleCASESessionStart(ExchangeContext * ec, const IPP
             // 2. For WRMP the session will be completed on one of these events:
             //     - Received Ack from the peer for the last message on this exchange (CASEBeginSessionResponse)
             //     - Received first message from the peer encrypted with established session key (mSessionKeyId)
-            if (mCon)
+            if (mSession->mCon)
 #endif
             {
                 HandleSessionComplete();
@@ -1398,22 +1535,126 @@ void ChipSecurityManager::HandleCASESessionStart(ExchangeContext * ec, const IPP
     }
 
 exit:
+    if (step.MsgBuf != NULL)
+    {
+        PacketBuffer::Free(step.MsgBuf);
+        step.MsgBuf = NULL;
+    }
+    if (step.RespMsgBuf != NULL)
+    {
+        PacketBuffer::Free(step.RespMsgBuf);
+        step.RespMsgBuf = NULL;
+    }
     if (err != CHIP_NO_ERROR)
         HandleSessionError(err, NULL);
-    if (msgBuf != NULL)
-        PacketBuffer::Free(msgBuf);
-    if (respMsgBuf != NULL)
-        PacketBuffer::Free(respMsgBuf);
 }
 
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+
+void ChipSecurityManager::HandleCASEResponderStepWork(CryptoWorker::Step & step)
+{
+    RunCASEResponderStep(static_cast<CASEResponderStep &>(step));
+}
+
+/**
+ * Called on the CHIP thread once a CASE responder step is done. Should the worker fail to schedule
+ * this call, the step is freed by Reset() when the session times out, or by ReclaimCryptoSteps()
+ * if the session already ended.
+ */
+void ChipSecurityManager::HandleCASEResponderStepDone(System::Layer * aSystemLayer, void * aAppState, System::Error aError)
+{
+    SessionEstablishment * session = reinterpret_cast<SessionEstablishment *>(aAppState);
+    ChipSecurityManager * secMgr   = session->SecMgr;
+    CASEResponderStep step;
+
+    // Nothing to do if the step was freed meanwhile, or the session started another that is still running.
+    VerifyOrExit(session->mCryptoStep != NULL && CryptoWorker::IsDone(*session->mCryptoStep), );
+
+    // Free the step before going on, as finishing the session may release the platform memory.
+    step = *session->mCryptoStep;
+    chip::Platform::Security::MemoryFree(session->mCryptoStep);
+    session->mCryptoStep = NULL;
+
+    {
+        SessionScope scope(secMgr, session);
+
+        if (session->State == kState_CASEInProgress && session->mCASEEngine == step.Engine)
+        {
+            secMgr->FinishCASEResponderStep(step);
+        }
+
+        // Otherwise the session failed or was canceled while the step was running, and Reset() left
+        // the engine to be freed here.
+        else
+        {
+            DiscardCASEResponderStep(step, true);
+
+            if (secMgr->ActiveSessionCount() == 0)
+                chip::Platform::Security::MemoryShutdown();
+
+            secMgr->AsyncNotifySecurityManagerAvailable();
+        }
+    }
+
+exit:
+    return;
+}
+
+void ChipSecurityManager::DiscardCASEResponderStep(CASEResponderStep & step, bool freeEngine)
+{
+    if (step.MsgBuf != NULL)
+        PacketBuffer::Free(step.MsgBuf);
+    if (step.RespMsgBuf != NULL)
+        PacketBuffer::Free(step.RespMsgBuf);
+
+    if (freeEngine)
+    {
+        step.Engine->Shutdown();
+        chip::Platform::Security::MemoryFree(step.Engine);
+    }
+}
+
+void ChipSecurityManager::FreeCASEResponderStep(SessionEstablishment & session, bool freeEngine)
+{
+    DiscardCASEResponderStep(*session.mCryptoStep, freeEngine);
+    chip::Platform::Security::MemoryFree(session.mCryptoStep);
+    session.mCryptoStep = NULL;
+}
+
+/**
+ * Free the done CASE responder steps of sessions that ended while the steps were running, should
+ * their hand-back to the CHIP thread have failed.
+ */
+void ChipSecurityManager::ReclaimCryptoSteps(void)
+{
+    bool reclaimed = false;
+
+    for (size_t i = 0; i < CHIP_CONFIG_MAX_SESSION_ESTABLISHMENTS; i++)
+    {
+        SessionEstablishment & session = mSessionPool[i];
+
+        if (session.State == kState_Idle && session.mCryptoStep != NULL && CryptoWorker::IsDone(*session.mCryptoStep))
+        {
+            FreeCASEResponderStep(session, true);
+            reclaimed = true;
+        }
+    }
+
+    if (reclaimed && ActiveSessionCount() == 0)
+        chip::Platform::Security::MemoryShutdown();
+}
+
+#endif // CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+
 void ChipSecurityManager::HandleCASEMessageResponder(ExchangeContext * ec, const IPPacketInfo * pktInfo,
                                                      const ChipMessageInfo * msgInfo, uint32_t profileId, uint8_t msgType,
                                                      PacketBuffer * msgBuf)
 {
     CHIP_ERROR err               = CHIP_NO_ERROR;
     ChipSecurityManager * secMgr = (ChipSecurityManager *) ec->AppState;
+    SessionScope scope(secMgr, secMgr->FindSession(ec));
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(secMgr->mSession != NULL);
 
     // Abort the CASE interaction immediately if we receive a status report message from the initiator.
     // This is a signal that the initiator does not want to continue.
@@ -1427,13 +1668,13 @@ void ChipSecurityManager::HandleCASEMessageResponder(ExchangeContext * ec, const
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
     // Flush any pending WRM ACKs to give sooner notification to the peer that current
     // CASE session establishment can be finalized.
-    err = secMgr->mEC->WRMPFlushAcks();
+    err = secMgr->mSession->mEC->WRMPFlushAcks();
     SuccessOrExit(err);
 #endif
 
     // Process the initiator's key confirm message.
     // NOTE: No need to initialize crypto memory for this call.
-    err = secMgr->mCASEEngine->ProcessInitiatorKeyConfirm(msgBuf);
+    err = secMgr->mSession->mCASEEngine->ProcessInitiatorKeyConfirm(msgBuf);
     SuccessOrExit(err);
 
     // At this point the session is established.
@@ -1452,6 +1693,177 @@ exit:
 
 #endif // CHIP_CONFIG_ENABLE_CASE_RESPONDER
 
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER && (CHIP_CONFIG_ENABLE_CASE_INITIATOR || CHIP_CONFIG_ENABLE_CASE_RESPONDER)
+
+#if !CHIP_CONFIG_LEGACY_CASE_AUTH_DELEGATE
+
+CHIP_ERROR ChipSecurityManager::LockedCASEAuthDelegate::EncodeNodeCertInfo(const BeginSessionContext & msgCtx, TLVWriter & writer)
+{
+    CHIP_ERROR err;
+
+    SecMgr->mAuthDelegateLock.Lock();
+    err = Target->EncodeNodeCertInfo(msgCtx, writer);
+    SecMgr->mAuthDelegateLock.Unlock();
+
+    return err;
+}
+
+CHIP_ERROR ChipSecurityManager::LockedCASEAuthDelegate::GenerateNodeSignature(const BeginSessionContext & msgCtx, const uint8_t * msgHash,
+                                                                        uint8_t msgHashLen, TLVWriter & writer, uint64_t tag)
+{
+    CHIP_ERROR err;
+
+    SecMgr->mAuthDelegateLock.Lock();
+    err = Target->GenerateNodeSignature(msgCtx, msgHash, msgHashLen, writer, tag);
+    SecMgr->mAuthDelegateLock.Unlock();
+
+    return err;
+}
+
+CHIP_ERROR ChipSecurityManager::LockedCASEAuthDelegate::EncodeNodePayload(const BeginSessionContext & msgCtx, uint8_t * payloadBuf,
+                                                                    uint16_t payloadBufSize, uint16_t & payloadLen)
+{
+    CHIP_ERROR err;
+
+    SecMgr->mAuthDelegateLock.Lock();
+    err = Target->EncodeNodePayload(msgCtx, payloadBuf, payloadBufSize, payloadLen);
+    SecMgr->mAuthDelegateLock.Unlock();
+
+    return err;
+}
+
+CHIP_ERROR ChipSecurityManager::LockedCASEAuthDelegate::BeginValidation(const BeginSessionContext & msgCtx, ValidationContext & validCtx,
+                                                                  ChipCertificateSet & certSet)
+{
+    CHIP_ERROR err;
+
+    SecMgr->mAuthDelegateLock.Lock();
+    err = Target->BeginValidation(msgCtx, validCtx, certSet);
+    SecMgr->mAuthDelegateLock.Unlock();
+
+    return err;
+}
+
+CHIP_ERROR ChipSecurityManager::LockedCASEAuthDelegate::OnPeerCertsLoaded(const BeginSessionContext & msgCtx, ChipDN & subjectDN,
+                                                                    CertificateKeyId & subjectKeyId, ValidationContext & validCtx,
+                                                                    ChipCertificateSet & certSet)
+{
+    CHIP_ERROR err;
+
+    SecMgr->mAuthDelegateLock.Lock();
+    err = Target->OnPeerCertsLoaded(msgCtx, subjectDN, subjectKeyId, validCtx, certSet);
+    SecMgr->mAuthDelegateLock.Unlock();
+
+    return err;
+}
+
+CHIP_ERROR ChipSecurityManager::LockedCASEAuthDelegate::HandleValidationResult(const BeginSessionContext & msgCtx, ValidationContext & validCtx,
+                                                                         ChipCertificateSet & certSet, CHIP_ERROR & validRes)
+{
+    CHIP_ERROR err;
+
+    SecMgr->mAuthDelegateLock.Lock();
+    err = Target->HandleValidationResult(msgCtx, validCtx, certSet, validRes);
+    SecMgr->mAuthDelegateLock.Unlock();
+
+    return err;
+}
+
+void ChipSecurityManager::LockedCASEAuthDelegate::EndValidation(const BeginSessionContext & msgCtx, ValidationContext & validCtx,
+                                                          ChipCertificateSet & certSet)
+{
+    SecMgr->mAuthDelegateLock.Lock();
+    Target->EndValidation(msgCtx, validCtx, certSet);
+    SecMgr->mAuthDelegateLock.Unlock();
+}
+
+#else // !CHIP_CONFIG_LEGACY_CASE_AUTH_DELEGATE
+
+CHIP_ERROR ChipSecurityManager::LockedCASEAuthDelegate::GetNodeCertInfo(bool isInitiator, uint8_t * buf, uint16_t bufSize, uint16_t & certInfoLen)
+{
+    CHIP_ERROR err;
+
+    SecMgr->mAuthDelegateLock.Lock();
+    err = Target->GetNodeCertInfo(isInitiator, buf, bufSize, certInfoLen);
+    SecMgr->mAuthDelegateLock.Unlock();
+
+    return err;
+}
+
+CHIP_ERROR ChipSecurityManager::LockedCASEAuthDelegate::GetNodePrivateKey(bool isInitiator, const uint8_t *& weavePrivKey,
+                                                                    uint16_t & weavePrivKeyLen)
+{
+    CHIP_ERROR err;
+
+    SecMgr->mAuthDelegateLock.Lock();
+    err = Target->GetNodePrivateKey(isInitiator, weavePrivKey, weavePrivKeyLen);
+    SecMgr->mAuthDelegateLock.Unlock();
+
+    return err;
+}
+
+CHIP_ERROR ChipSecurityManager::LockedCASEAuthDelegate::ReleaseNodePrivateKey(const uint8_t * weavePrivKey)
+{
+    CHIP_ERROR err;
+
+    SecMgr->mAuthDelegateLock.Lock();
+    err = Target->ReleaseNodePrivateKey(weavePrivKey);
+    SecMgr->mAuthDelegateLock.Unlock();
+
+    return err;
+}
+
+CHIP_ERROR ChipSecurityManager::LockedCASEAuthDelegate::GetNodePayload(bool isInitiator, uint8_t * buf, uint16_t bufSize, uint16_t & payloadLen)
+{
+    CHIP_ERROR err;
+
+    SecMgr->mAuthDelegateLock.Lock();
+    err = Target->GetNodePayload(isInitiator, buf, bufSize, payloadLen);
+    SecMgr->mAuthDelegateLock.Unlock();
+
+    return err;
+}
+
+CHIP_ERROR ChipSecurityManager::LockedCASEAuthDelegate::BeginCertValidation(bool isInitiator, ChipCertificateSet & certSet,
+                                                                      ValidationContext & validCtx)
+{
+    CHIP_ERROR err;
+
+    SecMgr->mAuthDelegateLock.Lock();
+    err = Target->BeginCertValidation(isInitiator, certSet, validCtx);
+    SecMgr->mAuthDelegateLock.Unlock();
+
+    return err;
+}
+
+CHIP_ERROR ChipSecurityManager::LockedCASEAuthDelegate::HandleCertValidationResult(bool isInitiator, CHIP_ERROR & validRes,
+                                                                             ChipCertificateData * peerCert, uint64_t peerNodeId,
+                                                                             ChipCertificateSet & certSet, ValidationContext & validCtx)
+{
+    CHIP_ERROR err;
+
+    SecMgr->mAuthDelegateLock.Lock();
+    err = Target->HandleCertValidationResult(isInitiator, validRes, peerCert, peerNodeId, certSet, validCtx);
+    SecMgr->mAuthDelegateLock.Unlock();
+
+    return err;
+}
+
+CHIP_ERROR ChipSecurityManager::LockedCASEAuthDelegate::EndCertValidation(ChipCertificateSet & certSet, ValidationContext & validCtx)
+{
+    CHIP_ERROR err;
+
+    SecMgr->mAuthDelegateLock.Lock();
+    err = Target->EndCertValidation(certSet, validCtx);
+    SecMgr->mAuthDelegateLock.Unlock();
+
+    return err;
+}
+
+#endif // CHIP_CONFIG_LEGACY_CASE_AUTH_DELEGATE
+
+#endif // CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER && (CHIP_CONFIG_ENABLE_CASE_INITIATOR || CHIP_CONFIG_ENABLE_CASE_RESPONDER)
+
 #if CHIP_CONFIG_ENABLE_TAKE_INITIATOR
 
 /**
@@ -1487,12 +1899,13 @@ CHIP_ERROR ChipSecurityManager::StartTAKESession(ChipConnection * con, ChipAuthM
     CHIP_ERROR err         = CHIP_NO_ERROR;
     bool useSessionKeyID   = encryptAuthPhase || encryptCommPhase;
     bool clearStateOnError = false;
+    SessionScope scope(this, AllocSession());
 
     // Verify security manager has been initialized.
     VerifyOrExit(State != kState_NotInitialized, err = CHIP_ERROR_INCORRECT_STATE);
 
-    // Verify there is no session in process.
-    VerifyOrExit(State == kState_Idle, err = CHIP_ERROR_SECURITY_MANAGER_BUSY);
+    // Verify another session establishment can be started.
+    VerifyOrExit(mSession != NULL, err = CHIP_ERROR_SECURITY_MANAGER_BUSY);
 
     CHIP_FAULT_INJECT(chip::FaultInjection::kFault_SecMgrBusy, {
         AsyncNotifySecurityManagerAvailable();
@@ -1505,14 +1918,14 @@ CHIP_ERROR ChipSecurityManager::StartTAKESession(ChipConnection * con, ChipAuthM
     // Reject the request if no connection has been specified.
     VerifyOrExit(con != NULL, err = CHIP_ERROR_INVALID_ARGUMENT);
 
-    State                          = kState_TAKEInProgress;
-    mRequestedAuthMode             = requestedAuthMode;
-    mEncType                       = kChipEncryptionType_AES128CTRSHA1;
-    mCon                           = con;
-    mStartSecureSession_OnComplete = onComplete;
-    mStartSecureSession_OnError    = onError;
-    mStartSecureSession_ReqState   = reqState;
-    mSessionKeyId                  = ChipKeyId::kNone;
+    mSession->State                          = kState_TAKEInProgress;
+    mSession->mRequestedAuthMode             = requestedAuthMode;
+    mSession->mEncType                       = kChipEncryptionType_AES128CTRSHA1;
+    mSession->mCon                           = con;
+    mSession->mStartSecureSession_OnComplete = onComplete;
+    mSession->mStartSecureSession_OnError    = onError;
+    mSession->mStartSecureSession_ReqState   = reqState;
+    mSession->mSessionKeyId                  = ChipKeyId::kNone;
 
     // Any error after this point requires call to the Reset() function.
     clearStateOnError = true;
@@ -1525,11 +1938,11 @@ CHIP_ERROR ChipSecurityManager::StartTAKESession(ChipConnection * con, ChipAuthM
         err = FabricState->AllocSessionKey(con->PeerNodeId, ChipKeyId::kNone, con, sessionKey);
         SuccessOrExit(err);
         sessionKey->SetLocallyInitiated(true);
-        mSessionKeyId = sessionKey->MsgEncKey.KeyId;
+        mSession->mSessionKeyId = sessionKey->MsgEncKey.KeyId;
     }
 
     // Create a new exchange context.
-    err = NewSessionExchange(mCon->PeerNodeId, mCon->PeerAddr, mCon->PeerPort);
+    err = NewSessionExchange(mSession->mCon->PeerNodeId, mSession->mCon->PeerAddr, mSession->mCon->PeerPort);
     SuccessOrExit(err);
 
     // Initialize CHIP platform memory.
@@ -1537,14 +1950,14 @@ CHIP_ERROR ChipSecurityManager::StartTAKESession(ChipConnection * con, ChipAuthM
     SuccessOrExit(err);
 
     // Allocate and initialize TAKE engine object.
-    mTAKEEngine = (ChipTAKEEngine *) chip::Platform::Security::MemoryAlloc(sizeof(ChipTAKEEngine), true);
-    VerifyOrExit(mTAKEEngine != NULL, err = CHIP_ERROR_NO_MEMORY);
-    mTAKEEngine->Init();
+    mSession->mTAKEEngine = (ChipTAKEEngine *) chip::Platform::Security::MemoryAlloc(sizeof(ChipTAKEEngine), true);
+    VerifyOrExit(mSession->mTAKEEngine != NULL, err = CHIP_ERROR_NO_MEMORY);
+    mSession->mTAKEEngine->Init();
 
     if (authDelegate == NULL)
         authDelegate = mDefaultTAKEChallengerAuthDelegate;
     VerifyOrExit(authDelegate != NULL, err = CHIP_ERROR_NO_TAKE_AUTH_DELEGATE);
-    mTAKEEngine->ChallengerAuthDelegate = authDelegate;
+    mSession->mTAKEEngine->ChallengerAuthDelegate = authDelegate;
 
     // Start TAKE session.
     StartTAKESession(encryptAuthPhase, encryptCommPhase, timeLimitedIK, sendChallengerId);
@@ -1552,7 +1965,7 @@ CHIP_ERROR ChipSecurityManager::StartTAKESession(ChipConnection * con, ChipAuthM
 exit:
     if (err != CHIP_NO_ERROR && clearStateOnError)
     {
-        FabricState->RemoveSessionKey(mSessionKeyId, con->PeerNodeId);
+        FabricState->RemoveSessionKey(mSession->mSessionKeyId, con->PeerNodeId);
 
         Reset();
     }
@@ -1567,10 +1980,10 @@ void ChipSecurityManager::StartTAKESession(bool encryptAuthPhase, bool encryptCo
     err = SendTAKEIdentifyToken(TAKE::kTAKEConfig_Config1, encryptAuthPhase, encryptCommPhase, timeLimitedIK, sendChallengerId);
     SuccessOrExit(err);
 
-    mEncType = mTAKEEngine->GetEncryptionType();
+    mSession->mEncType = mSession->mTAKEEngine->GetEncryptionType();
 
-    mEC->OnMessageReceived  = HandleTAKEMessageInitiator;
-    mEC->OnConnectionClosed = HandleConnectionClosed;
+    mSession->mEC->OnMessageReceived  = HandleTAKEMessageInitiator;
+    mSession->mEC->OnConnectionClosed = HandleConnectionClosed;
 
     // Using a smaller timeout may help prevent Relay Attack.
     // TODO: consider reducing the timeout, and using different values of timeout
@@ -1588,8 +2001,9 @@ void ChipSecurityManager::HandleTAKEMessageInitiator(ExchangeContext * ec, const
 {
     CHIP_ERROR err               = CHIP_NO_ERROR;
     ChipSecurityManager * secMgr = (ChipSecurityManager *) ec->AppState;
+    SessionScope scope(secMgr, secMgr->FindSession(ec));
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(secMgr->mSession != NULL);
 
     // Abort the TAKE interaction immediately if we receive a status report message from the responder.
     // This is a signal that the responder does not want to continue.
@@ -1611,7 +2025,7 @@ void ChipSecurityManager::HandleTAKEMessageInitiator(ExchangeContext * ec, const
         if (!doReauth)
             SuccessOrExit(err);
 
-        if (secMgr->mTAKEEngine->IsEncryptAuthPhase())
+        if (secMgr->mSession->mTAKEEngine->IsEncryptAuthPhase())
         {
             err = secMgr->CreateTAKESecureSession();
             SuccessOrExit(err);
@@ -1642,9 +2056,10 @@ void ChipSecurityManager::HandleTAKEMessageInitiator(ExchangeContext * ec, const
         PacketBuffer::Free(msgBuf);
         msgBuf = NULL;
 
-        err = secMgr->SendTAKEIdentifyToken(newConfig, secMgr->mTAKEEngine->IsEncryptAuthPhase(),
-                                            secMgr->mTAKEEngine->IsEncryptCommPhase(), secMgr->mTAKEEngine->IsTimeLimitedIK(),
-                                            secMgr->mTAKEEngine->HasSentChallengerId());
+        err = secMgr->SendTAKEIdentifyToken(newConfig, secMgr->mSession->mTAKEEngine->IsEncryptAuthPhase(),
+                                            secMgr->mSession->mTAKEEngine->IsEncryptCommPhase(),
+                                            secMgr->mSession->mTAKEEngine->IsTimeLimitedIK(),
+                                            secMgr->mSession->mTAKEEngine->HasSentChallengerId());
         SuccessOrExit(err);
         break;
 
@@ -1698,13 +2113,13 @@ CHIP_ERROR ChipSecurityManager::SendTAKEIdentifyToken(uint8_t takeConfig, bool e
     msgBuf = PacketBuffer::New();
     VerifyOrExit(msgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateIdentifyTokenMessage(mSessionKeyId, takeConfig, encryptAuthPhase, encryptCommPhase, timeLimitedIK,
-                                                    sendChallengerId, kChipEncryptionType_AES128CTRSHA1, FabricState->LocalNodeId,
-                                                    msgBuf);
+    err = mSession->mTAKEEngine->GenerateIdentifyTokenMessage(mSession->mSessionKeyId, takeConfig, encryptAuthPhase,
+                                                              encryptCommPhase, timeLimitedIK, sendChallengerId,
+                                                              kChipEncryptionType_AES128CTRSHA1, FabricState->LocalNodeId, msgBuf);
     SuccessOrExit(err);
 
     // Send the message.
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_TAKEIdentifyToken, msgBuf, 0);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_TAKEIdentifyToken, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -1718,7 +2133,7 @@ CHIP_ERROR ChipSecurityManager::ProcessTAKEIdentifyTokenResponse(const PacketBuf
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    err = mTAKEEngine->ProcessIdentifyTokenResponseMessage(msgBuf);
+    err = mSession->mTAKEEngine->ProcessIdentifyTokenResponseMessage(msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -1729,7 +2144,7 @@ CHIP_ERROR ChipSecurityManager::ProcessTAKETokenReconfigure(uint8_t & config, co
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    err = mTAKEEngine->ProcessTokenReconfigureMessage(config, msgBuf);
+    err = mSession->mTAKEEngine->ProcessTokenReconfigureMessage(config, msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -1745,11 +2160,11 @@ CHIP_ERROR ChipSecurityManager::SendTAKEAuthenticateToken(void)
     VerifyOrExit(msgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
 
     chip::Platform::Security::OnTimeConsumingCryptoStart();
-    err = mTAKEEngine->GenerateAuthenticateTokenMessage(msgBuf);
+    err = mSession->mTAKEEngine->GenerateAuthenticateTokenMessage(msgBuf);
     chip::Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_TAKEAuthenticateToken, msgBuf, 0);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_TAKEAuthenticateToken, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -1762,7 +2177,7 @@ CHIP_ERROR ChipSecurityManager::ProcessTAKEAuthenticateTokenResponse(const Packe
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     chip::Platform::Security::OnTimeConsumingCryptoStart();
-    err = mTAKEEngine->ProcessAuthenticateTokenResponseMessage(msgBuf);
+    err = mSession->mTAKEEngine->ProcessAuthenticateTokenResponseMessage(msgBuf);
     chip::Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -1778,10 +2193,10 @@ CHIP_ERROR ChipSecurityManager::SendTAKEReAuthenticateToken(void)
     msgBuf = PacketBuffer::New();
     VerifyOrExit(msgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateReAuthenticateTokenMessage(msgBuf);
+    err = mSession->mTAKEEngine->GenerateReAuthenticateTokenMessage(msgBuf);
     SuccessOrExit(err);
 
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_TAKEReAuthenticateToken, msgBuf, 0);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_TAKEReAuthenticateToken, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -1793,7 +2208,7 @@ CHIP_ERROR ChipSecurityManager::ProcessTAKEReAuthenticateTokenResponse(const Pac
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    err = mTAKEEngine->ProcessReAuthenticateTokenResponseMessage(msgBuf);
+    err = mSession->mTAKEEngine->ProcessReAuthenticateTokenResponseMessage(msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -1823,9 +2238,9 @@ void ChipSecurityManager::HandleTAKESessionStart(ExchangeContext * ec, const IPP
     VerifyOrExit(mDefaultTAKETokenAuthDelegate != NULL, err = CHIP_ERROR_NO_TAKE_AUTH_DELEGATE);
 
     // Setup state for the new TAKE exchange.
-    State = kState_TAKEInProgress;
-    mEC   = ec;
-    mCon  = ec->Con;
+    mSession->State = kState_TAKEInProgress;
+    mSession->mEC   = ec;
+    mSession->mCon  = ec->Con;
 
     ec->OnMessageReceived  = HandleTAKEMessageResponder;
     ec->OnConnectionClosed = HandleConnectionClosed;
@@ -1840,13 +2255,13 @@ void ChipSecurityManager::HandleTAKESessionStart(ExchangeContext * ec, const IPP
     SuccessOrExit(err);
 
     // Prepare TAKE engine and start session
-    mTAKEEngine = (ChipTAKEEngine *) chip::Platform::Security::MemoryAlloc(sizeof(ChipTAKEEngine), true);
-    VerifyOrExit(mTAKEEngine != NULL, err = CHIP_ERROR_NO_MEMORY);
-    mTAKEEngine->Init();
+    mSession->mTAKEEngine = (ChipTAKEEngine *) chip::Platform::Security::MemoryAlloc(sizeof(ChipTAKEEngine), true);
+    VerifyOrExit(mSession->mTAKEEngine != NULL, err = CHIP_ERROR_NO_MEMORY);
+    mSession->mTAKEEngine->Init();
 
-    mTAKEEngine->TokenAuthDelegate = mDefaultTAKETokenAuthDelegate;
+    mSession->mTAKEEngine->TokenAuthDelegate = mDefaultTAKETokenAuthDelegate;
 
-    err = mTAKEEngine->ProcessIdentifyTokenMessage(ec->PeerNodeId, msgBuf);
+    err = mSession->mTAKEEngine->ProcessIdentifyTokenMessage(ec->PeerNodeId, msgBuf);
     PacketBuffer::Free(msgBuf);
     msgBuf = NULL;
 
@@ -1863,28 +2278,28 @@ void ChipSecurityManager::HandleTAKESessionStart(ExchangeContext * ec, const IPP
 
     SuccessOrExit(err);
 
-    if (mTAKEEngine->UseSessionKey())
+    if (mSession->mTAKEEngine->UseSessionKey())
     {
         ChipSessionKey * sessionKey;
-        err = FabricState->AllocSessionKey(ec->PeerNodeId, mTAKEEngine->SessionKeyId, ec->Con, sessionKey);
+        err = FabricState->AllocSessionKey(ec->PeerNodeId, mSession->mTAKEEngine->SessionKeyId, ec->Con, sessionKey);
         SuccessOrExit(err);
         sessionKey->SetLocallyInitiated(false);
         sessionKey->SetRemoveOnIdle(true);
-        mSessionKeyId = mTAKEEngine->SessionKeyId;
-        mEncType      = mTAKEEngine->GetEncryptionType();
+        mSession->mSessionKeyId = mSession->mTAKEEngine->SessionKeyId;
+        mSession->mEncType      = mSession->mTAKEEngine->GetEncryptionType();
     }
 
     respMsgBuf = PacketBuffer::New();
     VerifyOrExit(respMsgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateIdentifyTokenResponseMessage(respMsgBuf);
+    err = mSession->mTAKEEngine->GenerateIdentifyTokenResponseMessage(respMsgBuf);
     SuccessOrExit(err);
 
     err        = ec->SendMessage(kChipProfile_Security, kMsgType_TAKEIdentifyTokenResponse, respMsgBuf);
     respMsgBuf = NULL;
     SuccessOrExit(err);
 
-    if (mTAKEEngine->IsEncryptAuthPhase())
+    if (mSession->mTAKEEngine->IsEncryptAuthPhase())
     {
         err = CreateTAKESecureSession();
         SuccessOrExit(err);
@@ -1905,8 +2320,9 @@ void ChipSecurityManager::HandleTAKEMessageResponder(ExchangeContext * ec, const
 {
     CHIP_ERROR err               = CHIP_NO_ERROR;
     ChipSecurityManager * secMgr = (ChipSecurityManager *) ec->AppState;
+    SessionScope scope(secMgr, secMgr->FindSession(ec));
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(secMgr->mSession != NULL);
 
     // Abort the TAKE interaction immediately if we receive a status report message from the initiator.
     // This is a signal that the initiator does not want to continue.
@@ -1971,7 +2387,7 @@ CHIP_ERROR ChipSecurityManager::ProcessTAKEAuthenticateToken(const PacketBuffer
     CHIP_ERROR err = CHIP_NO_ERROR;
 
     chip::Platform::Security::OnTimeConsumingCryptoStart();
-    err = mTAKEEngine->ProcessAuthenticateTokenMessage(msgBuf);
+    err = mSession->mTAKEEngine->ProcessAuthenticateTokenMessage(msgBuf);
     chip::Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -1988,10 +2404,10 @@ CHIP_ERROR ChipSecurityManager::SendTAKETokenReconfigure(void)
     msgBuf = PacketBuffer::New();
     VerifyOrExit(msgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateTokenReconfigureMessage(msgBuf);
+    err = mSession->mTAKEEngine->GenerateTokenReconfigureMessage(msgBuf);
     SuccessOrExit(err);
 
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_TAKETokenReconfigure, msgBuf, 0);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_TAKETokenReconfigure, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2010,11 +2426,11 @@ CHIP_ERROR ChipSecurityManager::SendTAKEAuthenticateTokenResponse(void)
     VerifyOrExit(msgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
 
     chip::Platform::Security::OnTimeConsumingCryptoStart();
-    err = mTAKEEngine->GenerateAuthenticateTokenResponseMessage(msgBuf);
+    err = mSession->mTAKEEngine->GenerateAuthenticateTokenResponseMessage(msgBuf);
     chip::Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_TAKEAuthenticateTokenResponse, msgBuf, 0);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_TAKEAuthenticateTokenResponse, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2028,7 +2444,7 @@ CHIP_ERROR ChipSecurityManager::ProcessTAKEReAuthenticateToken(const PacketBuffe
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    err = mTAKEEngine->ProcessReAuthenticateTokenMessage(msgBuf);
+    err = mSession->mTAKEEngine->ProcessReAuthenticateTokenMessage(msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -2043,10 +2459,10 @@ CHIP_ERROR ChipSecurityManager::SendTAKEReAuthenticateTokenResponse(void)
     msgBuf = PacketBuffer::New();
     VerifyOrExit(msgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateReAuthenticateTokenResponseMessage(msgBuf);
+    err = mSession->mTAKEEngine->GenerateReAuthenticateTokenResponseMessage(msgBuf);
     SuccessOrExit(err);
 
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_TAKEReAuthenticateTokenResponse, msgBuf, 0);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_TAKEReAuthenticateTokenResponse, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2067,14 +2483,14 @@ CHIP_ERROR ChipSecurityManager::CreateTAKESecureSession(void)
     err = HandleSessionEstablished();
     SuccessOrExit(err);
 
-    mEC->KeyId          = mSessionKeyId;
-    mEC->EncryptionType = mEncType;
+    mSession->mEC->KeyId          = mSession->mSessionKeyId;
+    mSession->mEC->EncryptionType = mSession->mEncType;
 
     // Add a reservation for the new session key and configure the ExchangeContext to automatically release
     // the key when the context is freed.  This will ensure the key is not removed until rest of the TAKE
     // exchange completes.
-    ReserveKey(mEC->PeerNodeId, mEC->KeyId);
-    mEC->SetAutoReleaseKey(true);
+    ReserveKey(mSession->mEC->PeerNodeId, mSession->mEC->KeyId);
+    mSession->mEC->SetAutoReleaseKey(true);
 
 exit:
     return err;
@@ -2084,20 +2500,20 @@ CHIP_ERROR ChipSecurityManager::FinishTAKESetUp(void)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    if (mTAKEEngine->IsEncryptCommPhase())
+    if (mSession->mTAKEEngine->IsEncryptCommPhase())
     {
         err = HandleSessionEstablished();
         SuccessOrExit(err);
     }
     else
     {
-        if (mTAKEEngine->IsEncryptAuthPhase())
+        if (mSession->mTAKEEngine->IsEncryptAuthPhase())
         {
-            err = FabricState->RemoveSessionKey(mSessionKeyId, mEC->PeerNodeId);
+            err = FabricState->RemoveSessionKey(mSession->mSessionKeyId, mSession->mEC->PeerNodeId);
             SuccessOrExit(err);
         }
-        mEncType      = kChipEncryptionType_None;
-        mSessionKeyId = ChipKeyId::kNone;
+        mSession->mEncType      = kChipEncryptionType_None;
+        mSession->mSessionKeyId = ChipKeyId::kNone;
     }
 
 exit:
@@ -2114,16 +2530,17 @@ CHIP_ERROR ChipSecurityManager::StartKeyExport(ChipConnection * con, uint64_t pe
                                                ChipKeyExportDelegate * keyExportDelegate)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
+    SessionScope scope(this, AllocSession());
 
-    // Verify we've been initialized and that we don't already have a session in process.
+    // Verify we've been initialized and that another session establishment can be started.
     if (State == kState_NotInitialized)
         return CHIP_ERROR_INCORRECT_STATE;
-    if (State != kState_Idle)
+    if (mSession == NULL)
         return CHIP_ERROR_SECURITY_MANAGER_BUSY;
 
-    State = kState_KeyExportInProgress;
+    mSession->State = kState_KeyExportInProgress;
 
-    mCon = con;
+    mSession->mCon = con;
 
     // Create a new exchange context.
     err = NewSessionExchange(peerNodeId, peerAddr, peerPort);
@@ -2138,23 +2555,23 @@ CHIP_ERROR ChipSecurityManager::StartKeyExport(ChipConnection * con, uint64_t pe
     SuccessOrExit(err);
 
     // Allocate and initialize KeyExport object.
-    mKeyExport = (ChipKeyExport *) chip::Platform::Security::MemoryAlloc(sizeof(ChipKeyExport), true);
-    VerifyOrExit(mKeyExport != NULL, err = CHIP_ERROR_NO_MEMORY);
-    mKeyExport->Init(keyExportDelegate);
+    mSession->mKeyExport = (ChipKeyExport *) chip::Platform::Security::MemoryAlloc(sizeof(ChipKeyExport), true);
+    VerifyOrExit(mSession->mKeyExport != NULL, err = CHIP_ERROR_NO_MEMORY);
+    mSession->mKeyExport->Init(keyExportDelegate);
 
     // Set the allowed key export protocol configurations.
-    mKeyExport->SetAllowedConfigs(InitiatorAllowedKeyExportConfigs);
+    mSession->mKeyExport->SetAllowedConfigs(InitiatorAllowedKeyExportConfigs);
 
     // Send key export request message.
     err = SendKeyExportRequest(InitiatorKeyExportConfig, keyId, signMessage);
     SuccessOrExit(err);
 
-    mStartKeyExport_OnComplete = onComplete;
-    mStartKeyExport_OnError    = onError;
-    mStartKeyExport_ReqState   = reqState;
+    mSession->mStartKeyExport_OnComplete = onComplete;
+    mSession->mStartKeyExport_OnError    = onError;
+    mSession->mStartKeyExport_ReqState   = reqState;
 
-    mEC->OnMessageReceived  = HandleKeyExportMessageInitiator;
-    mEC->OnConnectionClosed = HandleConnectionClosed;
+    mSession->mEC->OnMessageReceived  = HandleKeyExportMessageInitiator;
+    mSession->mEC->OnConnectionClosed = HandleConnectionClosed;
 
     // Time limit overall Key Export duration.
     StartSessionTimer();
@@ -2172,8 +2589,9 @@ void ChipSecurityManager::HandleKeyExportMessageInitiator(ExchangeContext * ec,
 {
     CHIP_ERROR err               = CHIP_NO_ERROR;
     ChipSecurityManager * secMgr = (ChipSecurityManager *) ec->AppState;
+    SessionScope scope(secMgr, secMgr->FindSession(ec));
 
-    VerifyOrDie(ec == secMgr->mEC);
+    VerifyOrDie(secMgr->mSession != NULL);
 
     // Abort the key export interaction immediately if we receive a status report message from the responder.
     // This is a signal that the responder does not want to continue.
@@ -2188,7 +2606,7 @@ void ChipSecurityManager::HandleKeyExportMessageInitiator(ExchangeContext * ec,
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
     // Flush any pending WRM ACKs before we begin the long crypto operation,
     // to prevent the peer from re-transmitting message.
-    err = secMgr->mEC->WRMPFlushAcks();
+    err = secMgr->mSession->mEC->WRMPFlushAcks();
     SuccessOrExit(err);
 #endif
 
@@ -2198,14 +2616,15 @@ void ChipSecurityManager::HandleKeyExportMessageInitiator(ExchangeContext * ec,
     case kMsgType_KeyExportReconfigure:
         uint8_t newConfig;
 
-        err = secMgr->mKeyExport->ProcessKeyExportReconfigure(msgBuf->Start(), msgBuf->DataLength(), newConfig);
+        err = secMgr->mSession->mKeyExport->ProcessKeyExportReconfigure(msgBuf->Start(), msgBuf->DataLength(), newConfig);
         SuccessOrExit(err);
 
         // Free the received message buffer so that it can be reused to send the outgoing message.
         PacketBuffer::Free(msgBuf);
         msgBuf = NULL;
 
-        err = secMgr->SendKeyExportRequest(newConfig, secMgr->mKeyExport->KeyId(), secMgr->mKeyExport->SignMessages());
+        err = secMgr->SendKeyExportRequest(newConfig, secMgr->mSession->mKeyExport->KeyId(),
+                                           secMgr->mSession->mKeyExport->SignMessages());
         SuccessOrExit(err);
 
         break;
@@ -2215,15 +2634,15 @@ void ChipSecurityManager::HandleKeyExportMessageInitiator(ExchangeContext * ec,
         uint16_t exportedKeyLen;
         uint8_t exportedKey[kChipFabricSecretSize];
 
-        err = secMgr->mKeyExport->ProcessKeyExportResponse(msgBuf->Start(), msgBuf->DataLength(), msgInfo, exportedKey,
-                                                           sizeof(exportedKey), exportedKeyLen, exportedKeyId);
+        err = secMgr->mSession->mKeyExport->ProcessKeyExportResponse(msgBuf->Start(), msgBuf->DataLength(), msgInfo, exportedKey,
+                                                                     sizeof(exportedKey), exportedKeyLen, exportedKeyId);
         SuccessOrExit(err);
 
         // Call the user's completion function.
-        if (secMgr->mStartKeyExport_OnComplete != NULL)
+        if (secMgr->mSession->mStartKeyExport_OnComplete != NULL)
         {
-            secMgr->mStartKeyExport_OnComplete(secMgr, secMgr->mCon, secMgr->mStartKeyExport_ReqState, exportedKeyId, exportedKey,
-                                               exportedKeyLen);
+            secMgr->mSession->mStartKeyExport_OnComplete(secMgr, secMgr->mSession->mCon, secMgr->mSession->mStartKeyExport_ReqState,
+                                                         exportedKeyId, exportedKey, exportedKeyLen);
         }
 
         // Reset state.
@@ -2256,11 +2675,11 @@ void ChipSecurityManager::HandleKeyExportError(CHIP_ERROR err, PacketBuffer * st
     // Then when SendMessage() returns, the function that called it will also call this
     // function with the error returned by SendMessage().
     //
-    if (State != kState_Idle)
+    if (mSession->State != kState_Idle)
     {
-        ChipConnection * con            = mCon;
-        KeyExportErrorFunct userOnError = mStartKeyExport_OnError;
-        void * reqState                 = mStartKeyExport_ReqState;
+        ChipConnection * con            = mSession->mCon;
+        KeyExportErrorFunct userOnError = mSession->mStartKeyExport_OnError;
+        void * reqState                 = mSession->mStartKeyExport_ReqState;
         StatusReport rcvdStatusReport;
         StatusReport * statusReportPtr = NULL;
 
@@ -2297,22 +2716,22 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::SendKeyExportRequest(u
     VerifyOrExit(msgBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
 
     // Generate key export request.
-    err = mKeyExport->GenerateKeyExportRequest(msgBuf->Start(), msgBuf->AvailableDataLength(), dataLen, keyExportConfig, keyId,
-                                               signMessage);
+    err = mSession->mKeyExport->GenerateKeyExportRequest(msgBuf->Start(), msgBuf->AvailableDataLength(), dataLen,
+                                                         keyExportConfig, keyId, signMessage);
     SuccessOrExit(err);
 
     // Set message length.
     msgBuf->SetDataLength(dataLen);
 
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (mSession->mCon == NULL)
     {
         sendFlags = ExchangeContext::kSendFlag_RequestAck;
     }
 #endif
 
     // Send key export request message.
-    err    = mEC->SendMessage(kChipProfile_Security, kMsgType_KeyExportRequest, msgBuf, sendFlags);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, kMsgType_KeyExportRequest, msgBuf, sendFlags);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2333,15 +2752,15 @@ void ChipSecurityManager::HandleKeyExportRequest(ExchangeContext * ec, const IPP
     CHIP_ERROR err;
     ChipKeyExport keyExport;
 
-    State = kState_KeyExportInProgress;
-    mEC   = ec;
-    mCon  = ec->Con;
+    mSession->State = kState_KeyExportInProgress;
+    mSession->mEC   = ec;
+    mSession->mCon  = ec->Con;
 
     // Ensure the exchange context stays around until we're done with it.
     ec->AddRef();
 
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (mSession->mCon == NULL)
     {
         // Do nothing on the Ack received from the requestor.
         // mEC->OnAckRcvd is not initialized.
@@ -2350,7 +2769,7 @@ void ChipSecurityManager::HandleKeyExportRequest(ExchangeContext * ec, const IPP
 
         // Flush any pending WRM ACKs before we begin the long crypto operation,
         // to prevent the peer from re-transmitting the Key Export request.
-        err = mEC->WRMPFlushAcks();
+        err = mSession->mEC->WRMPFlushAcks();
         SuccessOrExit(err);
     }
 #endif
@@ -2423,14 +2842,14 @@ __attribute__((noinline)) CHIP_ERROR ChipSecurityManager::SendKeyExportResponse(
     msgBuf->SetDataLength(dataLen);
 
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (mSession->mCon == NULL)
     {
         sendFlags = ExchangeContext::kSendFlag_RequestAck;
     }
 #endif
 
     // Send key export response message.
-    err    = mEC->SendMessage(kChipProfile_Security, msgType, msgBuf, sendFlags);
+    err    = mSession->mEC->SendMessage(kChipProfile_Security, msgType, msgBuf, sendFlags);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2689,28 +3108,28 @@ CHIP_ERROR ChipSecurityManager::NewSessionExchange(uint64_t peerNodeId, IPAddres
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    if (mEC != NULL)
+    if (mSession->mEC != NULL)
     {
-        mEC->Close();
-        mEC = NULL;
+        mSession->mEC->Close();
+        mSession->mEC = NULL;
     }
 
     // Create a new exchange context.
-    if (mCon)
+    if (mSession->mCon)
     {
-        mEC = ExchangeManager->NewContext(mCon, this);
-        VerifyOrExit(mEC != NULL, err = CHIP_ERROR_NO_MEMORY);
+        mSession->mEC = ExchangeManager->NewContext(mSession->mCon, this);
+        VerifyOrExit(mSession->mEC != NULL, err = CHIP_ERROR_NO_MEMORY);
     }
     else
     {
 #if CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
         VerifyOrExit(peerNodeId != kNodeIdNotSpecified && peerNodeId != kAnyNodeId, err = CHIP_ERROR_INVALID_ARGUMENT);
 
-        mEC = ExchangeManager->NewContext(peerNodeId, peerAddr, peerPort, INET_NULL_INTERFACEID, this);
-        VerifyOrExit(mEC != NULL, err = CHIP_ERROR_NO_MEMORY);
+        mSession->mEC = ExchangeManager->NewContext(peerNodeId, peerAddr, peerPort, INET_NULL_INTERFACEID, this);
+        VerifyOrExit(mSession->mEC != NULL, err = CHIP_ERROR_NO_MEMORY);
 
-        mEC->OnAckRcvd   = WRMPHandleAckRcvd;
-        mEC->OnSendError = WRMPHandleSendError;
+        mSession->mEC->OnAckRcvd   = WRMPHandleAckRcvd;
+        mSession->mEC->OnSendError = WRMPHandleSendError;
 #else
         // Reject the request if no connection has been specified.
         ExitNow(err = CHIP_ERROR_INVALID_ARGUMENT);
@@ -2870,9 +3289,9 @@ void ChipSecurityManager::UpdatePASERateLimiter(CHIP_ERROR err)
     // Update PASE rate limiter parameters in the following cases:
     //   -- PASE with key confirmation: count only PASE attempts that fail with key confirmation error.
     //   -- PASE without key confirmation: every PASE attempt counts as failure.
-    if (State == kState_PASEInProgress && mPASEEngine->IsResponder() &&
-        ((mPASEEngine->PerformKeyConfirmation && err == CHIP_ERROR_KEY_CONFIRMATION_FAILED) ||
-         (!mPASEEngine->PerformKeyConfirmation && err == CHIP_NO_ERROR)))
+    if (mSession->State == kState_PASEInProgress && mSession->mPASEEngine->IsResponder() &&
+        ((mSession->mPASEEngine->PerformKeyConfirmation && err == CHIP_ERROR_KEY_CONFIRMATION_FAILED) ||
+         (!mSession->mPASEEngine->PerformKeyConfirmation && err == CHIP_NO_ERROR)))
     {
         uint64_t nowTimeMS = System::Layer::GetClock_MonotonicMS();
 
@@ -2894,19 +3313,19 @@ void ChipSecurityManager::UpdatePASERateLimiter(CHIP_ERROR err)
 CHIP_ERROR ChipSecurityManager::HandleSessionEstablished(void)
 {
     CHIP_ERROR err        = CHIP_NO_ERROR;
-    uint64_t peerNodeId   = mEC->PeerNodeId;
-    uint16_t sessionKeyId = mSessionKeyId;
-    uint8_t encType       = mEncType;
+    uint64_t peerNodeId   = mSession->mEC->PeerNodeId;
+    uint16_t sessionKeyId = mSession->mSessionKeyId;
+    uint8_t encType       = mSession->mEncType;
     const ChipEncryptionKey * sessionKey;
     ChipAuthMode authMode;
 
-    switch (State)
+    switch (mSession->State)
     {
 #if CHIP_CONFIG_ENABLE_CASE_INITIATOR || CHIP_CONFIG_ENABLE_CASE_RESPONDER
     case kState_CASEInProgress:
 
         // Get the derived session key.
-        err = mCASEEngine->GetSessionKey(sessionKey);
+        err = mSession->mCASEEngine->GetSessionKey(sessionKey);
         SuccessOrExit(err);
 
         // Form the key auth mode based on the type of certificate that was used by the peer.
@@ -2915,7 +3334,7 @@ CHIP_ERROR ChipSecurityManager::HandleSessionEstablished(void)
         // was requested by the application.  For example, if the app requested kChipAuthMode_CASE_AnyCert
         // then the final key auth mode will reflect the actual certificate type used by the peer.
         //
-        authMode = CASEAuthMode(mCASEEngine->CertType());
+        authMode = CASEAuthMode(mSession->mCASEEngine->CertType());
 
         break;
 #endif
@@ -2924,11 +3343,11 @@ CHIP_ERROR ChipSecurityManager::HandleSessionEstablished(void)
     case kState_PASEInProgress:
 
         // Get the derived session key.
-        err = mPASEEngine->GetSessionKey(sessionKey);
+        err = mSession->mPASEEngine->GetSessionKey(sessionKey);
         SuccessOrExit(err);
 
         // Form the key auth mode based on the password source.
-        authMode = PASEAuthMode(mPASEEngine->PwSource);
+        authMode = PASEAuthMode(mSession->mPASEEngine->PwSource);
 
 #if CHIP_CONFIG_ENABLE_PASE_RESPONDER
         UpdatePASERateLimiter(CHIP_NO_ERROR);
@@ -2941,7 +3360,7 @@ CHIP_ERROR ChipSecurityManager::HandleSessionEstablished(void)
     case kState_TAKEInProgress:
 
         // Get the derived session key.
-        err = mTAKEEngine->GetSessionKey(sessionKey);
+        err = mSession->mTAKEEngine->GetSessionKey(sessionKey);
         SuccessOrExit(err);
 
         // Currently only one key auth mode is supported for TAKE.
@@ -2964,12 +3383,12 @@ exit:
 
 void ChipSecurityManager::HandleSessionComplete(void)
 {
-    ChipConnection * con                   = mCon;
-    uint64_t peerNodeId                    = mEC->PeerNodeId;
-    uint16_t sessionKeyId                  = mSessionKeyId;
-    uint8_t encType                        = mEncType;
-    SessionEstablishedFunct userOnComplete = mStartSecureSession_OnComplete;
-    void * reqState                        = mStartSecureSession_ReqState;
+    ChipConnection * con                   = mSession->mCon;
+    uint64_t peerNodeId                    = mSession->mEC->PeerNodeId;
+    uint16_t sessionKeyId                  = mSession->mSessionKeyId;
+    uint8_t encType                        = mSession->mEncType;
+    SessionEstablishedFunct userOnComplete = mSession->mStartSecureSession_OnComplete;
+    void * reqState                        = mSession->mStartSecureSession_ReqState;
 
     // Reset state.
     Reset();
@@ -3012,13 +3431,13 @@ void ChipSecurityManager::HandleSessionError(CHIP_ERROR err, PacketBuffer * stat
     // Then when SendMessage() returns, the function that called it will also call this
     // function with the error returned by SendMessage().
     //
-    if (State != kState_Idle)
+    if (mSession->State != kState_Idle)
     {
-        ChipConnection * con          = mCon;
-        uint64_t peerNodeId           = mEC->PeerNodeId;
-        uint16_t sessionKeyId         = mSessionKeyId;
-        SessionErrorFunct userOnError = mStartSecureSession_OnError;
-        void * reqState               = mStartSecureSession_ReqState;
+        ChipConnection * con          = mSession->mCon;
+        uint64_t peerNodeId           = mSession->mEC->PeerNodeId;
+        uint16_t sessionKeyId         = mSession->mSessionKeyId;
+        SessionErrorFunct userOnError = mSession->mStartSecureSession_OnError;
+        void * reqState               = mSession->mStartSecureSession_ReqState;
         StatusReport rcvdStatusReport;
         StatusReport * statusReportPtr = NULL;
 
@@ -3039,7 +3458,7 @@ void ChipSecurityManager::HandleSessionError(CHIP_ERROR err, PacketBuffer * stat
 
         // Otherwise, send a status report to the peer with our reason for the failure.
         else
-            SendStatusReport(err, mEC);
+            SendStatusReport(err, mSession->mEC);
 
         // Remove the session key from the key table.
         FabricState->RemoveSessionKey(sessionKeyId, peerNodeId);
@@ -3064,17 +3483,23 @@ void ChipSecurityManager::HandleSessionError(CHIP_ERROR err, PacketBuffer * stat
 void ChipSecurityManager::HandleConnectionClosed(ExchangeContext * ec, ChipConnection * con, CHIP_ERROR conErr)
 {
     ChipSecurityManager * secMgr = (ChipSecurityManager *) ec->AppState;
+    SessionScope scope(secMgr, secMgr->FindSession(ec));
+
+    VerifyOrExit(secMgr->mSession != NULL, );
 
     if (conErr == CHIP_NO_ERROR)
         conErr = CHIP_ERROR_CONNECTION_CLOSED_UNEXPECTEDLY;
 
         // Clean-up the local state and invoke the appropriate callbacks.
 #if CHIP_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
-    if (secMgr->State == kState_KeyExportInProgress)
+    if (secMgr->mSession->State == kState_KeyExportInProgress)
         secMgr->HandleKeyExportError(conErr, NULL);
     else
 #endif
         secMgr->HandleSessionError(conErr, NULL);
+
+exit:
+    return;
 }
 
 CHIP_ERROR ChipSecurityManager::SendStatusReport(CHIP_ERROR localErr, ExchangeContext * ec)
@@ -3199,51 +3624,62 @@ exit:
 
 void ChipSecurityManager::Reset(void)
 {
-    if (mEC != NULL)
+    if (mSession->mEC != NULL)
     {
-        mEC->Abort();
-        mEC = NULL;
+        mSession->mEC->Abort();
+        mSession->mEC = NULL;
     }
 
-    switch (State)
+    switch (mSession->State)
     {
 #if CHIP_CONFIG_ENABLE_PASE_INITIATOR || CHIP_CONFIG_ENABLE_PASE_RESPONDER
     case kState_PASEInProgress:
-        if (mPASEEngine != NULL)
+        if (mSession->mPASEEngine != NULL)
         {
-            mPASEEngine->Shutdown();
-            chip::Platform::Security::MemoryFree(mPASEEngine);
-            mPASEEngine = NULL;
+            mSession->mPASEEngine->Shutdown();
+            chip::Platform::Security::MemoryFree(mSession->mPASEEngine);
+            mSession->mPASEEngine = NULL;
         }
         break;
 #endif
 #if CHIP_CONFIG_ENABLE_TAKE_INITIATOR || CHIP_CONFIG_ENABLE_TAKE_RESPONDER
     case kState_TAKEInProgress:
-        if (mTAKEEngine != NULL)
+        if (mSession->mTAKEEngine != NULL)
         {
-            mTAKEEngine->Shutdown();
-            chip::Platform::Security::MemoryFree(mTAKEEngine);
-            mTAKEEngine = NULL;
+            mSession->mTAKEEngine->Shutdown();
+            chip::Platform::Security::MemoryFree(mSession->mTAKEEngine);
+            mSession->mTAKEEngine = NULL;
         }
         break;
 #endif
 #if CHIP_CONFIG_ENABLE_CASE_INITIATOR || CHIP_CONFIG_ENABLE_CASE_RESPONDER
     case kState_CASEInProgress:
-        if (mCASEEngine != NULL)
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+        // A step still running on the crypto worker uses the engine, which is freed once the step is done.
+        // A step that is done, but whose hand-back has not run, is freed here.
+        if (mSession->mCryptoStep != NULL)
         {
-            mCASEEngine->Shutdown();
-            chip::Platform::Security::MemoryFree(mCASEEngine);
-            mCASEEngine = NULL;
+            if (CryptoWorker::IsDone(*mSession->mCryptoStep))
+                FreeCASEResponderStep(*mSession, false);
+            else
+                mSession->mCASEEngine = NULL;
+        }
+#endif
+        if (mSession->mCASEEngine != NULL)
+        {
+            mSession->mCASEEngine->Shutdown();
+            chip::Platform::Security::MemoryFree(mSession->mCASEEngine);
+            mSession->mCASEEngine = NULL;
         }
         break;
 #endif
 #if CHIP_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
     case kState_KeyExportInProgress:
-        if (mKeyExport != NULL)
+        if (mSession->mKeyExport != NULL)
         {
-            mKeyExport->Shutdown();
-            chip::Platform::Security::MemoryFree(mKeyExport);
-            mKeyExport = NULL;
+            mSession->mKeyExport->Shutdown();
+            chip::Platform::Security::MemoryFree(mSession->mKeyExport);
+            mSession->mKeyExport = NULL;
         }
         break;
 #endif
@@ -3251,18 +3687,117 @@ void ChipSecurityManager::Reset(void)
         break;
     }
 
-    chip::Platform::Security::MemoryShutdown();
-
     CancelSessionTimer();
 
-    State                          = kState_Idle;
-    mCon                           = NULL;
-    mRequestedAuthMode             = kChipAuthMode_NotSpecified;
-    mSessionKeyId                  = ChipKeyId::kNone;
-    mEncType                       = kChipEncryptionType_None;
+    mSession->State                          = kState_Idle;
+    mSession->mCon                           = NULL;
+    mSession->mRequestedAuthMode             = kChipAuthMode_NotSpecified;
+    mSession->mSessionKeyId                  = ChipKeyId::kNone;
+    mSession->mEncType                       = kChipEncryptionType_None;
+    mSession->mStartSecureSession_OnComplete = NULL;
+    mSession->mStartSecureSession_OnError    = NULL;
+    mSession->mStartSecureSession_ReqState   = NULL;
+
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    ReclaimCryptoSteps();
+#endif
+
+    // Platform memory is shared by all session establishments.
+    if (ActiveSessionCount() == 0)
+        chip::Platform::Security::MemoryShutdown();
+}
+
+void ChipSecurityManager::SessionEstablishment::Init(ChipSecurityManager * secMgr)
+{
+    SecMgr = secMgr;
+    State  = kState_Idle;
+    mEC    = NULL;
+    mCon   = NULL;
+#if CHIP_CONFIG_ENABLE_PASE_INITIATOR || CHIP_CONFIG_ENABLE_PASE_RESPONDER
+    mPASEEngine = NULL;
+#endif
+#if CHIP_CONFIG_ENABLE_CASE_INITIATOR || CHIP_CONFIG_ENABLE_CASE_RESPONDER
+    mCASEEngine = NULL;
+#endif
+#if CHIP_CONFIG_ENABLE_TAKE_INITIATOR || CHIP_CONFIG_ENABLE_TAKE_RESPONDER
+    mTAKEEngine = NULL;
+#endif
+#if CHIP_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
+    mKeyExport = NULL;
+#endif
     mStartSecureSession_OnComplete = NULL;
     mStartSecureSession_OnError    = NULL;
     mStartSecureSession_ReqState   = NULL;
+    mSessionKeyId                  = ChipKeyId::kNone;
+    mRequestedAuthMode             = kChipAuthMode_NotSpecified;
+    mEncType                       = kChipEncryptionType_None;
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    mCryptoStep = NULL;
+#if CHIP_CONFIG_ENABLE_CASE_INITIATOR || CHIP_CONFIG_ENABLE_CASE_RESPONDER
+    mCASEAuthDelegate.SecMgr = secMgr;
+    mCASEAuthDelegate.Target = NULL;
+#endif
+#endif
+}
+
+bool ChipSecurityManager::SessionEstablishment::IsFree(void) const
+{
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    if (mCryptoStep != NULL)
+        return false;
+#endif
+    return State == kState_Idle;
+}
+
+/**
+ * Find a free entry for a new session establishment, unless MaxConcurrentSessionEstablishments
+ * are already in progress.
+ *
+ * The entry remains free until its State is set, so nothing needs to be undone if the
+ * establishment does not start.
+ *
+ * @return A pointer to the free entry, or NULL if no further session establishment can be started.
+ */
+ChipSecurityManager::SessionEstablishment * ChipSecurityManager::AllocSession(void)
+{
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    ReclaimCryptoSteps();
+#endif
+
+    return mSessionPool.Alloc(MaxConcurrentSessionEstablishments);
+}
+
+/**
+ * Find the session establishment taking place over an exchange.
+ */
+ChipSecurityManager::SessionEstablishment * ChipSecurityManager::FindSession(const ExchangeContext * ec)
+{
+    return mSessionPool.Find(
+        [ec](const SessionEstablishment & session) { return session.State != kState_Idle && session.mEC == ec; });
+}
+
+/**
+ * Find the CASE session establishment, if any, that is establishing a given session key with a peer.
+ */
+ChipSecurityManager::SessionEstablishment * ChipSecurityManager::FindCASESession(uint64_t peerNodeId, uint16_t sessionKeyId)
+{
+    return mSessionPool.Find([peerNodeId, sessionKeyId](const SessionEstablishment & session) {
+        return session.State == kState_CASEInProgress && session.mSessionKeyId == sessionKeyId && session.mEC != NULL &&
+            session.mEC->PeerNodeId == peerNodeId;
+    });
+}
+
+size_t ChipSecurityManager::ActiveSessionCount(void) const
+{
+    return mSessionPool.ActiveCount();
+}
+
+/**
+ * Whether no further session establishment can be started until one in progress completes.
+ */
+bool ChipSecurityManager::IsBusy(void) const
+{
+    return State != kState_Idle || ActiveSessionCount() >= MaxConcurrentSessionEstablishments;
 }
 
 void ChipSecurityManager::StartSessionTimer(void)
@@ -3271,24 +3806,25 @@ void ChipSecurityManager::StartSessionTimer(void)
 
     if (SessionEstablishTimeout != 0)
     {
-        mSystemLayer->StartTimer(SessionEstablishTimeout, HandleSessionTimeout, this);
+        mSystemLayer->StartTimer(SessionEstablishTimeout, HandleSessionTimeout, mSession);
     }
 }
 
 void ChipSecurityManager::CancelSessionTimer(void)
 {
     ChipLogProgress(SecurityManager, "%s", __FUNCTION__);
-    mSystemLayer->CancelTimer(HandleSessionTimeout, this);
+    mSystemLayer->CancelTimer(HandleSessionTimeout, mSession);
 }
 
 void ChipSecurityManager::HandleSessionTimeout(System::Layer * aSystemLayer, void * aAppState, System::Error aError)
 {
     ChipLogProgress(SecurityManager, "%s", __FUNCTION__);
 
-    ChipSecurityManager * securityMgr = reinterpret_cast<ChipSecurityManager *>(aAppState);
-    if (securityMgr)
+    SessionEstablishment * session = reinterpret_cast<SessionEstablishment *>(aAppState);
+    if (session)
     {
-        securityMgr->HandleSessionError(CHIP_ERROR_TIMEOUT, NULL);
+        SessionScope scope(session->SecMgr, session);
+        session->SecMgr->HandleSessionError(CHIP_ERROR_TIMEOUT, NULL);
     }
 }
 
@@ -3336,8 +3872,10 @@ void ChipSecurityManager::OnEncryptedMsgRcvd(uint16_t sessionKeyId, uint64_t pee
     // is received before the Ack for the last message on the session establishment exchange.
     // In that case there is no need to wait for the Ack and the session can be completed.
 #if CHIP_CONFIG_ENABLE_CASE_INITIATOR || CHIP_CONFIG_ENABLE_CASE_RESPONDER
-    if (State == kState_CASEInProgress && mCASEEngine->State == ChipCASEEngine::kState_Complete && mSessionKeyId == sessionKeyId &&
-        mEC->PeerNodeId == peerNodeId && mEncType == encType)
+    SessionScope scope(this, FindCASESession(peerNodeId, sessionKeyId));
+
+    if (mSession != NULL && mSession->mCASEEngine != NULL && mSession->mCASEEngine->State == ChipCASEEngine::kState_Complete &&
+        mSession->mEncType == encType)
     {
         HandleSessionComplete();
     }
@@ -3350,8 +3888,10 @@ void ChipSecurityManager::WRMPHandleAckRcvd(ExchangeContext * ec, void * msgCtxt
 {
     ChipLogProgress(SecurityManager, "%s", __FUNCTION__);
     ChipSecurityManager * secMgr = (ChipSecurityManager *) ec->AppState;
+    SessionScope scope(secMgr, secMgr->FindSession(ec));
 
-    if (secMgr->State == kState_CASEInProgress && secMgr->mCASEEngine->State == ChipCASEEngine::kState_Complete)
+    if (secMgr->mSession != NULL && secMgr->mSession->State == kState_CASEInProgress &&
+        secMgr->mSession->mCASEEngine->State == ChipCASEEngine::kState_Complete)
     {
         secMgr->HandleSessionComplete();
     }
@@ -3361,9 +3901,12 @@ void ChipSecurityManager::WRMPHandleSendError(ExchangeContext * ec, CHIP_ERROR e
 {
     ChipLogProgress(SecurityManager, "%s", __FUNCTION__);
     ChipSecurityManager * secMgr = (ChipSecurityManager *) ec->AppState;
+    SessionScope scope(secMgr, secMgr->FindSession(ec));
+
+    VerifyOrExit(secMgr->mSession != NULL, );
 
 #if CHIP_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
-    if (secMgr->State == kState_KeyExportInProgress)
+    if (secMgr->mSession->State == kState_KeyExportInProgress)
     {
         secMgr->HandleKeyExportError(err, NULL);
     }
@@ -3372,6 +3915,9 @@ void ChipSecurityManager::WRMPHandleSendError(ExchangeContext * ec, CHIP_ERROR e
     {
         secMgr->HandleSessionError(err, NULL);
     }
+
+exit:
+    return;
 }
 
 #endif // CHIP_CONFIG_ENABLE_RELIABLE_MESSAGING
@@ -3384,7 +3930,7 @@ void ChipSecurityManager::AsyncNotifySecurityManagerAvailable()
 void ChipSecurityManager::DoNotifySecurityManagerAvailable(System::Layer * systemLayer, void * appState, System::Error err)
 {
     ChipSecurityManager * _this = (ChipSecurityManager *) appState;
-    if (_this->State == kState_Idle)
+    if (!_this->IsBusy())
     {
         _this->ExchangeManager->NotifySecurityManagerAvailable();
     }
@@ -3403,25 +3949,30 @@ void ChipSecurityManager::DoNotifySecurityManagerAvailable(System::Layer * syste
  */
 CHIP_ERROR ChipSecurityManager::CancelSessionEstablishment(void * reqState)
 {
-    // If a session establishment is in progress and the supplied request state matches what was provided
-    // when the session was started...
-    if ((State == kState_CASEInProgress || State == kState_PASEInProgress || State == kState_TAKEInProgress) &&
-        reqState == mStartSecureSession_ReqState)
+    for (size_t i = 0; i < CHIP_CONFIG_MAX_SESSION_ESTABLISHMENTS; i++)
     {
-        // Clear the application's OnError handler to prevent a callback.
-        mStartSecureSession_OnError = NULL;
+        SessionEstablishment & session = mSessionPool[i];
+
+        // If a session establishment is in progress and the supplied request state matches what was provided
+        // when the session was started...
+        if ((session.State == kState_CASEInProgress || session.State == kState_PASEInProgress ||
+             session.State == kState_TAKEInProgress) &&
+            reqState == session.mStartSecureSession_ReqState)
+        {
+            SessionScope scope(this, &session);
+
+            // Clear the application's OnError handler to prevent a callback.
+            mSession->mStartSecureSession_OnError = NULL;
 
-        // Fail the session with a canceled error.
-        HandleSessionError(CHIP_ERROR_TRANSACTION_CANCELED, NULL);
+            // Fail the session with a canceled error.
+            HandleSessionError(CHIP_ERROR_TRANSACTION_CANCELED, NULL);
 
-        return CHIP_NO_ERROR;
+            return CHIP_NO_ERROR;
+        }
     }
 
     // Otherwise, tell the caller there was no match.
-    else
-    {
-        return CHIP_ERROR_INCORRECT_STATE;
-    }
+    return CHIP_ERROR_INCORRECT_STATE;
 }
 
 /**
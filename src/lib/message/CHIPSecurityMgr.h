@@ -35,8 +35,15 @@
 #include <Profiles/security/CHIPTAKE.h>
 #include <Profiles/status-report/StatusReportProfile.h>
 #include <core/CHIPError.h>
+#include <message/CHIPCryptoWorker.h>
 #include <message/CHIPExchangeMgr.h>
+#include <message/CHIPSessionPool.h>
 #include <support/DLLUtil.h>
+#include <system/SystemMutex.h>
+
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER && !(CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS)
+#error "CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER requires CHIP_SYSTEM_CONFIG_POSIX_LOCKING and CHIP_SYSTEM_CONFIG_USE_SOCKETS"
+#endif
 
 /**
  *   @namespace chip::Platform::Security
@@ -190,7 +197,7 @@ public:
 
     ChipFabricState * FabricState;         // [READ ONLY] Associated Fabric State object.
     ChipExchangeManager * ExchangeManager; // [READ ONLY] Associated Exchange Manager object.
-    uint8_t State;                         // [READ ONLY] State of the CHIP Message Layer object
+    uint8_t State;                         // [READ ONLY] kState_NotInitialized or kState_Idle; see IsBusy()
 #if CHIP_CONFIG_ENABLE_CASE_INITIATOR
     uint32_t InitiatorCASEConfig;        // CASE configuration proposed when initiating a CASE session
     uint32_t InitiatorCASECurveId;       // ECDH curve proposed when initiating a CASE session
@@ -214,6 +221,9 @@ public:
 #endif
     uint32_t SessionEstablishTimeout; // The amount of time after which an in-progress session establishment will timeout.
     uint32_t IdleSessionTimeout;      // The amount of time after which an idle session will be removed.
+    uint8_t MaxConcurrentSessionEstablishments; // The number of session establishments that may be in progress at
+                                                // once, at most CHIP_CONFIG_MAX_SESSION_ESTABLISHMENTS. Defaults to
+                                                // 1 unless CHIP_CONFIG_MEMORY_MGMT_MALLOC is asserted.
 
     ChipSecurityManager(void);
 
@@ -357,54 +367,167 @@ public:
     void ReserveKey(uint64_t peerNodeId, uint16_t keyId);
     void ReleaseKey(uint64_t peerNodeId, uint16_t keyId);
 
+    // Whether no further session establishment can be started until one in progress completes.
+    bool IsBusy(void) const;
+
 private:
     enum Flags
     {
         kFlag_IdleSessionTimerRunning = 0x01
     };
 
-    ExchangeContext * mEC;
-    ChipConnection * mCon;
-    union
+    struct CASEResponderStep;
+
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER && (CHIP_CONFIG_ENABLE_CASE_INITIATOR || CHIP_CONFIG_ENABLE_CASE_RESPONDER)
+    /**
+     * Stands in for the auth delegate of a CASE engine, forwarding each call to it under mAuthDelegateLock.
+     * The auth delegate is shared by all CASE sessions, and the responder step of one may call it on the
+     * crypto worker while others call it on the CHIP thread. Only these calls are serialized; each session
+     * has an engine of its own, so the rest of its crypto runs unlocked.
+     */
+    class LockedCASEAuthDelegate : public ChipCASEAuthDelegate
     {
+    public:
+        typedef Profiles::Security::CASE::BeginSessionContext BeginSessionContext;
+        typedef Profiles::Security::CertificateKeyId CertificateKeyId;
+        typedef Profiles::Security::ChipCertificateData ChipCertificateData;
+        typedef Profiles::Security::ChipCertificateSet ChipCertificateSet;
+        typedef Profiles::Security::ChipDN ChipDN;
+        typedef Profiles::Security::ValidationContext ValidationContext;
+        typedef TLV::TLVWriter TLVWriter;
+
+        ChipSecurityManager * SecMgr;
+        ChipCASEAuthDelegate * Target;
+
+#if !CHIP_CONFIG_LEGACY_CASE_AUTH_DELEGATE
+        CHIP_ERROR EncodeNodeCertInfo(const BeginSessionContext & msgCtx, TLVWriter & writer);
+        CHIP_ERROR GenerateNodeSignature(const BeginSessionContext & msgCtx, const uint8_t * msgHash, uint8_t msgHashLen,
+                                         TLVWriter & writer, uint64_t tag);
+        CHIP_ERROR EncodeNodePayload(const BeginSessionContext & msgCtx, uint8_t * payloadBuf, uint16_t payloadBufSize,
+                                     uint16_t & payloadLen);
+        CHIP_ERROR BeginValidation(const BeginSessionContext & msgCtx, ValidationContext & validCtx,
+                                   ChipCertificateSet & certSet);
+        CHIP_ERROR OnPeerCertsLoaded(const BeginSessionContext & msgCtx, ChipDN & subjectDN, CertificateKeyId & subjectKeyId,
+                                     ValidationContext & validCtx, ChipCertificateSet & certSet);
+        CHIP_ERROR HandleValidationResult(const BeginSessionContext & msgCtx, ValidationContext & validCtx,
+                                          ChipCertificateSet & certSet, CHIP_ERROR & validRes);
+        void EndValidation(const BeginSessionContext & msgCtx, ValidationContext & validCtx,
+                           ChipCertificateSet & certSet);
+#else  // !CHIP_CONFIG_LEGACY_CASE_AUTH_DELEGATE
+        CHIP_ERROR GetNodeCertInfo(bool isInitiator, uint8_t * buf, uint16_t bufSize, uint16_t & certInfoLen);
+        CHIP_ERROR GetNodePrivateKey(bool isInitiator, const uint8_t *& weavePrivKey, uint16_t & weavePrivKeyLen);
+        CHIP_ERROR ReleaseNodePrivateKey(const uint8_t * weavePrivKey);
+        CHIP_ERROR GetNodePayload(bool isInitiator, uint8_t * buf, uint16_t bufSize, uint16_t & payloadLen);
+        CHIP_ERROR BeginCertValidation(bool isInitiator, ChipCertificateSet & certSet, ValidationContext & validCtx);
+        CHIP_ERROR HandleCertValidationResult(bool isInitiator, CHIP_ERROR & validRes, ChipCertificateData * peerCert,
+                                              uint64_t peerNodeId, ChipCertificateSet & certSet,
+                                              ValidationContext & validCtx);
+        CHIP_ERROR EndCertValidation(ChipCertificateSet & certSet, ValidationContext & validCtx);
+#endif // CHIP_CONFIG_LEGACY_CASE_AUTH_DELEGATE
+    };
+#endif // CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER && (CHIP_CONFIG_ENABLE_CASE_INITIATOR || CHIP_CONFIG_ENABLE_CASE_RESPONDER)
+
+    /**
+     * The state of one CASE, PASE, TAKE or key export interaction. The security manager
+     * keeps a pool of these, and an interaction holds one from the time it starts until
+     * it completes or fails.
+     */
+    class SessionEstablishment
+    {
+    public:
+        ChipSecurityManager * SecMgr; // The security manager that owns the pool.
+        uint8_t State;                // kState_Idle if the entry is free, otherwise the protocol in progress.
+        ExchangeContext * mEC;
+        ChipConnection * mCon;
+        union
+        {
 #if CHIP_CONFIG_ENABLE_PASE_INITIATOR || CHIP_CONFIG_ENABLE_PASE_RESPONDER
-        ChipPASEEngine * mPASEEngine;
+            ChipPASEEngine * mPASEEngine;
 #endif
 #if CHIP_CONFIG_ENABLE_CASE_INITIATOR || CHIP_CONFIG_ENABLE_CASE_RESPONDER
-        ChipCASEEngine * mCASEEngine;
+            ChipCASEEngine * mCASEEngine;
 #endif
 #if CHIP_CONFIG_ENABLE_TAKE_INITIATOR || CHIP_CONFIG_ENABLE_TAKE_RESPONDER
-        ChipTAKEEngine * mTAKEEngine;
+            ChipTAKEEngine * mTAKEEngine;
 #endif
 #if CHIP_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
-        ChipKeyExport * mKeyExport;
+            ChipKeyExport * mKeyExport;
+#endif
+        };
+        union
+        {
+            SessionEstablishedFunct mStartSecureSession_OnComplete;
+
+            /**
+             * The key export protocol complete callback function. This function is
+             * called when the secret key export process is complete.
+             */
+            KeyExportCompleteFunct mStartKeyExport_OnComplete;
+        };
+        union
+        {
+            SessionErrorFunct mStartSecureSession_OnError;
+
+            /**
+             * The key export protocol error callback function. This function is
+             * called when an error is encountered during key export process.
+             */
+            KeyExportErrorFunct mStartKeyExport_OnError;
+        };
+        union
+        {
+            void * mStartSecureSession_ReqState;
+            void * mStartKeyExport_ReqState;
+        };
+        uint16_t mSessionKeyId;
+        ChipAuthMode mRequestedAuthMode;
+        uint8_t mEncType;
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+        CASEResponderStep * mCryptoStep; // A step handed to the crypto worker; the entry stays in use until it is freed.
+#if CHIP_CONFIG_ENABLE_CASE_INITIATOR || CHIP_CONFIG_ENABLE_CASE_RESPONDER
+        LockedCASEAuthDelegate mCASEAuthDelegate; // The auth delegate given to mCASEEngine.
+#endif
 #endif
-    };
-    union
-    {
-        SessionEstablishedFunct mStartSecureSession_OnComplete;
 
-        /**
-         * The key export protocol complete callback function. This function is
-         * called when the secret key export process is complete.
-         */
-        KeyExportCompleteFunct mStartKeyExport_OnComplete;
+        void Init(ChipSecurityManager * secMgr);
+        bool IsFree(void) const;
     };
-    union
-    {
-        SessionErrorFunct mStartSecureSession_OnError;
 
-        /**
-         * The key export protocol error callback function. This function is
-         * called when an error is encountered during key export process.
-         */
-        KeyExportErrorFunct mStartKeyExport_OnError;
-    };
-    union
+    /**
+     * Makes a session establishment the one that the handshake methods work on, for as long
+     * as the scope lasts. Every entry point of the security manager that continues an
+     * interaction (message, timer and exchange callbacks) opens one, so that callbacks into
+     * the application that start or end other interactions cannot change it underneath.
+     */
+    class SessionScope
     {
-        void * mStartSecureSession_ReqState;
-        void * mStartKeyExport_ReqState;
+    public:
+        SessionScope(ChipSecurityManager * secMgr, SessionEstablishment * session) :
+            mSecMgr(secMgr), mSaved(secMgr->mSession)
+        {
+            secMgr->mSession = session;
+        }
+        ~SessionScope(void) { mSecMgr->mSession = mSaved; }
+
+    private:
+        ChipSecurityManager * mSecMgr;
+        SessionEstablishment * mSaved;
     };
+
+    SessionPool<SessionEstablishment, CHIP_CONFIG_MAX_SESSION_ESTABLISHMENTS> mSessionPool;
+    SessionEstablishment * mSession; // The session establishment being worked on; see SessionScope.
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    CryptoWorker mCryptoWorker;
+    System::Mutex mAuthDelegateLock; // Serializes the calls into the CASE auth delegate across threads.
+
+    void ReclaimCryptoSteps(void);
+#endif
+
+    SessionEstablishment * AllocSession(void);
+    SessionEstablishment * FindSession(const ExchangeContext * ec);
+    SessionEstablishment * FindCASESession(uint64_t peerNodeId, uint16_t sessionKeyId);
+    size_t ActiveSessionCount(void) const;
+
 #if CHIP_CONFIG_ENABLE_PASE_RESPONDER
     uint32_t mPASERateLimiterTimeout;
     uint8_t mPASERateLimiterCount;
@@ -423,9 +546,6 @@ private:
     ChipKeyExportDelegate * mDefaultKeyExportDelegate;
 #endif
 
-    uint16_t mSessionKeyId;
-    ChipAuthMode mRequestedAuthMode;
-    uint8_t mEncType;
     System::Layer * mSystemLayer;
     uint8_t mFlags;
 
@@ -463,6 +583,14 @@ private:
     void StartCASESession(uint32_t config, uint32_t curveId);
     void HandleCASESessionStart(ExchangeContext * ec, const IPPacketInfo * pktInfo, const ChipMessageInfo * msgInfo,
                                 PacketBuffer * msgBuf);
+    static void RunCASEResponderStep(CASEResponderStep & step);
+    void FinishCASEResponderStep(CASEResponderStep & step);
+#if CHIP_CONFIG_SECURITY_MGR_CRYPTO_WORKER
+    static void HandleCASEResponderStepWork(CryptoWorker::Step & step);
+    static void HandleCASEResponderStepDone(System::Layer * aSystemLayer, void * aAppState, System::Error aError);
+    static void DiscardCASEResponderStep(CASEResponderStep & step, bool freeEngine);
+    static void FreeCASEResponderStep(SessionEstablishment & session, bool freeEngine);
+#endif
     static void HandleCASEMessageInitiator(ExchangeContext * ec, const IPPacketInfo * pktInfo, const ChipMessageInfo * msgInfo,
                                            uint32_t profileId, uint8_t msgType, PacketBuffer * msgBuf);
     static void HandleCASEMessageResponder(ExchangeContext * ec, const IPPacketInfo * pktInfo, const ChipMessageInfo * msgInfo,
@@ -0,0 +1,106 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the pool of session establishments kept by the
+ *      CHIP security manager.
+ *
+ */
+
+#ifndef CHIPSESSIONPOOL_H_
+#define CHIPSESSIONPOOL_H_
+
+#include <stddef.h>
+
+namespace chip {
+
+/**
+ *  @class SessionPool
+ *
+ *  @brief
+ *    A fixed pool of session establishment entries, of which a configurable number may be in progress at once.
+ *
+ *    An entry is in use for as long as its IsFree() method returns false. Entries are handed out in pool order, so
+ *    that a lone establishment always uses the first one.
+ *
+ *  @tparam Entry  The entry type, which provides bool IsFree(void) const.
+ *  @tparam N      The number of entries.
+ */
+template <class Entry, size_t N>
+class SessionPool
+{
+public:
+    Entry & operator[](size_t i) { return mEntries[i]; }
+    const Entry & operator[](size_t i) const { return mEntries[i]; }
+
+    /**
+     * Find a free entry, unless @a maxActive entries are already in use.
+     *
+     * The entry remains free until the caller sets it up, so nothing needs to be undone if it is not used.
+     *
+     * @return A pointer to the free entry, or NULL.
+     */
+    Entry * Alloc(size_t maxActive)
+    {
+        if (ActiveCount() >= maxActive)
+            return NULL;
+
+        for (size_t i = 0; i < N; i++)
+        {
+            if (mEntries[i].IsFree())
+                return &mEntries[i];
+        }
+
+        return NULL;
+    }
+
+    /**
+     * Find the first entry for which @a match returns true.
+     */
+    template <typename MatchFunct>
+    Entry * Find(MatchFunct match)
+    {
+        for (size_t i = 0; i < N; i++)
+        {
+            if (match(mEntries[i]))
+                return &mEntries[i];
+        }
+
+        return NULL;
+    }
+
+    size_t ActiveCount(void) const
+    {
+        size_t count = 0;
+
+        for (size_t i = 0; i < N; i++)
+        {
+            if (!mEntries[i].IsFree())
+                count++;
+        }
+
+        return count;
+    }
+
+private:
+    Entry mEntries[N];
+};
+
+} // namespace chip
+
+#endif // CHIPSESSIONPOOL_H_
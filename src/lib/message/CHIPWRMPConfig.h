@@ -76,6 +76,79 @@ namespace chip {
 #define CHIP_CONFIG_WRMP_DEFAULT_INITIAL_RETRANS_TIMEOUT      (2000)
 #endif // CHIP_CONFIG_WRMP_DEFAULT_INITIAL_RETRANS_TIMEOUT
 
+/**
+ *  @def CHIP_CONFIG_WRMP_MIN_RETRANS_TIMEOUT
+ *
+ *  @brief
+ *    The lower bound in milliseconds for retransmission timeouts
+ *    derived from the measured round-trip time to a peer.
+ *
+ *    Should be at least one WRMP timer period, as shorter timeouts
+ *    are rounded down to whole periods.
+ *
+ */
+#ifndef CHIP_CONFIG_WRMP_MIN_RETRANS_TIMEOUT
+#define CHIP_CONFIG_WRMP_MIN_RETRANS_TIMEOUT               (2 * CHIP_CONFIG_WRMP_TIMER_DEFAULT_PERIOD)
+#endif // CHIP_CONFIG_WRMP_MIN_RETRANS_TIMEOUT
+
+/**
+ *  @def CHIP_CONFIG_WRMP_MAX_RETRANS_TIMEOUT
+ *
+ *  @brief
+ *    The upper bound in milliseconds for retransmission timeouts
+ *    derived from the measured round-trip time to a peer, including
+ *    the exponential backoff applied to each retransmission.
+ *
+ *    Defaults to the fixed timeout used before a round-trip time is
+ *    measured, so that a measured peer is never retried more slowly.
+ *
+ */
+#ifndef CHIP_CONFIG_WRMP_MAX_RETRANS_TIMEOUT
+#define CHIP_CONFIG_WRMP_MAX_RETRANS_TIMEOUT               (CHIP_CONFIG_WRMP_DEFAULT_INITIAL_RETRANS_TIMEOUT)
+#endif // CHIP_CONFIG_WRMP_MAX_RETRANS_TIMEOUT
+
+/**
+ *  @def CHIP_CONFIG_WRMP_PEER_RTT_TABLE_SIZE
+ *
+ *  @brief
+ *    The number of peer nodes for which a round-trip time estimate
+ *    is kept.  When the table is full, the estimate of the peer
+ *    least recently heard from is replaced.
+ *
+ */
+#ifndef CHIP_CONFIG_WRMP_PEER_RTT_TABLE_SIZE
+#define CHIP_CONFIG_WRMP_PEER_RTT_TABLE_SIZE               (8)
+#endif // CHIP_CONFIG_WRMP_PEER_RTT_TABLE_SIZE
+
+/**
+ *  @def CHIP_CONFIG_WRMP_MAX_COALESCED_ACKS
+ *
+ *  @brief
+ *    The maximum number of acknowledgments for other exchanges that
+ *    are carried in a single Common::WRMP_Multi_Ack message, at most
+ *    255.
+ *
+ *    When the acknowledgment of an exchange is due, the acknowledgments
+ *    pending on other exchanges with the same peer, sent over the same
+ *    connection with the same key, are sent along with it instead of in
+ *    Null messages of their own. Each one takes 7 bytes of payload.
+ *
+ *    Support for the message is not negotiated: a node that does not
+ *    understand it drops the acknowledgments in its payload, and so
+ *    retransmits the messages they acknowledge until its retries run
+ *    out. Only set this above 0 when every peer runs a version that
+ *    accepts Multi-Ack messages, which all nodes with this setting do
+ *    whatever its value. By default every acknowledgment is sent in its
+ *    own message.
+ *
+ *    GN builds set this with the chip_config_wrmp_max_coalesced_acks
+ *    argument.
+ *
+ */
+#ifndef CHIP_CONFIG_WRMP_MAX_COALESCED_ACKS
+#define CHIP_CONFIG_WRMP_MAX_COALESCED_ACKS                (0)
+#endif // CHIP_CONFIG_WRMP_MAX_COALESCED_ACKS
+
 /**
  *  @def CHIP_CONFIG_WRMP_DEFAULT_ACK_TIMEOUT
  *
@@ -102,6 +175,36 @@ namespace chip {
 #endif // PBUF_POOL_SIZE
 #endif // CHIP_CONFIG_WRMP_RETRANS_TABLE_SIZE
 
+/**
+ *  @def CHIP_CONFIG_WRMP_TIMER_WHEEL_SIZE
+ *
+ *  @brief
+ *    The number of slots in the timing wheel that buckets WRMP
+ *    retransmission table entries by the timer tick at which they
+ *    are next due.
+ *
+ *    Entries due more than this many ticks ahead share slots with
+ *    earlier ones, so the wheel should cover the usual
+ *    retransmission timeouts.  The default of 32 slots covers
+ *    6.4 seconds at the default timer period.
+ *
+ */
+#ifndef CHIP_CONFIG_WRMP_TIMER_WHEEL_SIZE
+#define CHIP_CONFIG_WRMP_TIMER_WHEEL_SIZE                  (32)
+#endif // CHIP_CONFIG_WRMP_TIMER_WHEEL_SIZE
+
+/**
+ *  @def CHIP_CONFIG_WRMP_PEER_HASH_BUCKETS
+ *
+ *  @brief
+ *    The number of hash buckets used to look up the WRMP
+ *    retransmission table entries addressed to a given peer node.
+ *
+ */
+#ifndef CHIP_CONFIG_WRMP_PEER_HASH_BUCKETS
+#define CHIP_CONFIG_WRMP_PEER_HASH_BUCKETS                 (8)
+#endif // CHIP_CONFIG_WRMP_PEER_HASH_BUCKETS
+
 /**
  *  @def CHIP_CONFIG_WRMP_DEFAULT_MAX_RETRANS
  *
@@ -0,0 +1,222 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the payload of the Common::WRMP_Multi_Ack message,
+ *      which carries the acknowledgments of several exchanges with a peer,
+ *      and the selection of the acknowledgments that are sent in it.
+ *
+ *      The payload is a version byte and a count byte, followed by count
+ *      entries of an exchange id (16 bits, little endian), flags (8 bits)
+ *      and an acknowledged message id (32 bits, little endian). The only
+ *      flag is set when the sender is the initiator of the exchange.
+ *
+ */
+#ifndef CHIP_WRMP_MULTI_ACK_H_
+#define CHIP_WRMP_MULTI_ACK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <core/CHIPEncoding.h>
+#include <core/CHIPError.h>
+#include <support/CodeUtils.h>
+
+namespace chip {
+
+enum
+{
+    kWRMPMultiAck_Version       = 1,    /**< The payload version this node sends and understands. */
+    kWRMPMultiAck_HeaderSize    = 2,    /**< Size of the version and count fields. */
+    kWRMPMultiAck_EntrySize     = 7,    /**< Size of one acknowledgment. */
+    kWRMPMultiAck_MaxEntries    = 255,  /**< Largest count the count field holds. */
+    kWRMPMultiAck_FlagInitiator = 0x01, /**< Set when the sender is the initiator of the exchange. */
+};
+
+/**
+ *  @class WRMPMultiAckReader
+ *
+ *  @brief
+ *    Decodes the acknowledgments in a Common::WRMP_Multi_Ack payload.
+ */
+class WRMPMultiAckReader
+{
+public:
+    WRMPMultiAckReader(void) : mPos(NULL), mRemaining(0) {}
+
+    /**
+     *  @brief Check the version and length of a payload, and start reading its acknowledgments.
+     *
+     *  @retval #CHIP_NO_ERROR                            On success.
+     *  @retval #CHIP_ERROR_UNSUPPORTED_MESSAGE_VERSION   If the payload is of a version this node does not understand.
+     *  @retval #CHIP_ERROR_INVALID_MESSAGE_LENGTH        If the length of the payload does not match its count.
+     */
+    CHIP_ERROR Init(const uint8_t * payload, size_t len)
+    {
+        const uint8_t * p = payload;
+        CHIP_ERROR err    = CHIP_NO_ERROR;
+        uint8_t count;
+
+        mPos       = NULL;
+        mRemaining = 0;
+
+        VerifyOrExit(len >= kWRMPMultiAck_HeaderSize, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+        VerifyOrExit(Encoding::Read8(p) == kWRMPMultiAck_Version, err = CHIP_ERROR_UNSUPPORTED_MESSAGE_VERSION);
+        count = Encoding::Read8(p);
+        VerifyOrExit(len == kWRMPMultiAck_HeaderSize + static_cast<size_t>(count) * kWRMPMultiAck_EntrySize,
+                     err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+        mPos       = p;
+        mRemaining = count;
+
+    exit:
+        return err;
+    }
+
+    /**
+     *  @brief Read the next acknowledgment.
+     *
+     *  @param[out]   exchangeId    The id of the acknowledged exchange.
+     *  @param[out]   isInitiator   Whether the sender is the initiator of the exchange.
+     *  @param[out]   ackMsgId      The id of the acknowledged message.
+     *
+     *  @return true if an acknowledgment was read, false at the end of the payload.
+     */
+    bool Next(uint16_t & exchangeId, bool & isInitiator, uint32_t & ackMsgId)
+    {
+        if (mRemaining == 0)
+        {
+            return false;
+        }
+
+        exchangeId  = Encoding::LittleEndian::Read16(mPos);
+        isInitiator = (Encoding::Read8(mPos) & kWRMPMultiAck_FlagInitiator) != 0;
+        ackMsgId    = Encoding::LittleEndian::Read32(mPos);
+        mRemaining--;
+
+        return true;
+    }
+
+private:
+    const uint8_t * mPos;
+    size_t mRemaining;
+};
+
+/**
+ *  @class WRMPAckCoalescer
+ *
+ *  @brief
+ *    Gathers up to kMaxAcks acknowledgments pending on other exchanges with
+ *    the peer of an exchange whose acknowledgment is due, to be sent in one
+ *    Common::WRMP_Multi_Ack message on that exchange.
+ *
+ *    An acknowledgment is taken only if it reaches the peer in the same way:
+ *    over the same connection, address, port and interface, with the same key.
+ *    ContextType must provide those as the public members of ExchangeContext,
+ *    along with IsInitiator(), IsAckPending(), SetAckPending() and
+ *    mPendingPeerAckId.
+ */
+template <class ContextType, size_t kMaxAcks>
+class WRMPAckCoalescer
+{
+public:
+    static_assert(kMaxAcks <= kWRMPMultiAck_MaxEntries, "A Multi-Ack message holds at most 255 acknowledgments");
+
+    explicit WRMPAckCoalescer(const ContextType & due) : mDue(due), mCount(0) {}
+
+    /**
+     *  @brief Take the acknowledgment pending on an exchange, if there is one and it can be sent along with
+     *         the one that is due.
+     *
+     *  @return true if the acknowledgment was taken.
+     */
+    bool Add(ContextType & other)
+    {
+        if (IsFull() || &other == &mDue || other.ExchangeMgr == NULL || !other.IsAckPending() || !IsSameAckRoute(other))
+        {
+            return false;
+        }
+
+        mOthers[mCount++] = &other;
+        return true;
+    }
+
+    size_t Count(void) const { return mCount; }
+
+    bool IsFull(void) const { return mCount >= kMaxAcks; }
+
+    /**
+     *  @brief Return the size of the payload that carries the acknowledgments taken.
+     */
+    size_t PayloadLength(void) const { return kWRMPMultiAck_HeaderSize + mCount * kWRMPMultiAck_EntrySize; }
+
+    /**
+     *  @brief Encode the acknowledgments taken into a payload.
+     *
+     *  @retval #CHIP_NO_ERROR                  On success.
+     *  @retval #CHIP_ERROR_BUFFER_TOO_SMALL    If the payload does not fit in bufSize bytes.
+     */
+    CHIP_ERROR Encode(uint8_t * buf, size_t bufSize) const
+    {
+        uint8_t * p = buf;
+
+        if (bufSize < PayloadLength())
+        {
+            return CHIP_ERROR_BUFFER_TOO_SMALL;
+        }
+
+        Encoding::Write8(p, kWRMPMultiAck_Version);
+        Encoding::Write8(p, static_cast<uint8_t>(mCount));
+        for (size_t i = 0; i < mCount; i++)
+        {
+            Encoding::LittleEndian::Write16(p, mOthers[i]->ExchangeId);
+            Encoding::Write8(p, mOthers[i]->IsInitiator() ? kWRMPMultiAck_FlagInitiator : 0);
+            Encoding::LittleEndian::Write32(p, mOthers[i]->mPendingPeerAckId);
+        }
+
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     *  @brief Mark the acknowledgments taken as no longer pending, once they have been sent.
+     */
+    void MarkSent(void)
+    {
+        for (size_t i = 0; i < mCount; i++)
+        {
+            mOthers[i]->SetAckPending(false);
+        }
+    }
+
+private:
+    const ContextType & mDue;
+    ContextType * mOthers[kMaxAcks > 0 ? kMaxAcks : 1];
+    size_t mCount;
+
+    bool IsSameAckRoute(const ContextType & other) const
+    {
+        return other.PeerNodeId == mDue.PeerNodeId && other.Con == mDue.Con && other.PeerAddr == mDue.PeerAddr &&
+            other.PeerPort == mDue.PeerPort && other.PeerIntf == mDue.PeerIntf && other.EncryptionType == mDue.EncryptionType &&
+            other.KeyId == mDue.KeyId;
+    }
+};
+
+} // namespace chip
+
+#endif // CHIP_WRMP_MULTI_ACK_H_
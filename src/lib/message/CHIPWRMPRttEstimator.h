@@ -0,0 +1,164 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a round-trip time estimator used to derive
+ *      retransmission timeouts for the CHIP Reliable Messaging Protocol.
+ *
+ */
+#ifndef CHIP_WRMP_RTT_ESTIMATOR_H_
+#define CHIP_WRMP_RTT_ESTIMATOR_H_
+
+#include <stdint.h>
+
+namespace chip {
+
+/**
+ *  @class WRMPRttEstimator
+ *
+ *  @brief
+ *    Keeps a smoothed round-trip time and round-trip time variance for a peer,
+ *    following RFC 6298: each sample moves the smoothed RTT by 1/8 and the
+ *    variance by 1/4 of their error, and the retransmission timeout is the
+ *    smoothed RTT plus four times the variance.
+ *
+ *    Following Karn's algorithm, no sample is taken from a retransmitted
+ *    message, as its acknowledgment cannot be matched to a particular
+ *    transmission.
+ */
+class WRMPRttEstimator
+{
+public:
+    WRMPRttEstimator(void) { Reset(); }
+
+    /**
+     *  Forget all samples.
+     */
+    void Reset(void)
+    {
+        mScaledSmoothedRtt = 0;
+        mScaledRttVariance = 0;
+        mHasSample         = false;
+    }
+
+    /**
+     *  Whether at least one sample has been added.
+     */
+    bool HasSample(void) const { return mHasSample; }
+
+    /**
+     *  Whether the acknowledgment of a message that was sent sendCount times gives a round-trip time sample.
+     */
+    static bool IsSampleValid(uint8_t sendCount) { return sendCount == 1; }
+
+    /**
+     *  Add a round-trip time sample, in milliseconds, measured on a message that was sent sendCount times.
+     *
+     *  @return true if the sample was added, false if it was ignored as the message was retransmitted.
+     */
+    bool AddSample(uint32_t rttMillis, uint8_t sendCount)
+    {
+        if (!IsSampleValid(sendCount))
+        {
+            return false;
+        }
+
+        if (!mHasSample)
+        {
+            // First measurement: SRTT = R, RTTVAR = R / 2
+            mScaledSmoothedRtt = rttMillis << kSmoothedRttShift;
+            mScaledRttVariance = (rttMillis / 2) << kRttVarianceShift;
+            mHasSample         = true;
+        }
+        else
+        {
+            // RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R|, then SRTT = 7/8 SRTT + 1/8 R
+            const uint32_t smoothedRtt = mScaledSmoothedRtt >> kSmoothedRttShift;
+            const uint32_t error       = (rttMillis > smoothedRtt) ? (rttMillis - smoothedRtt) : (smoothedRtt - rttMillis);
+
+            mScaledRttVariance = mScaledRttVariance - (mScaledRttVariance >> kRttVarianceShift) + error;
+            mScaledSmoothedRtt = mScaledSmoothedRtt - smoothedRtt + rttMillis;
+        }
+
+        return true;
+    }
+
+    /**
+     *  Return the smoothed round-trip time, in milliseconds.
+     */
+    uint32_t GetSmoothedRtt(void) const { return mScaledSmoothedRtt >> kSmoothedRttShift; }
+
+    /**
+     *  Return the retransmission timeout, SRTT + max(G, 4 * RTTVAR), in milliseconds.
+     *
+     *  @param[in] granularity   The resolution of the retransmission timer, in milliseconds.
+     */
+    uint32_t GetRetransTimeout(uint32_t granularity) const
+    {
+        // The variance is kept multiplied by 4, which is the factor RFC 6298 applies to it.
+        const uint32_t variance = mScaledRttVariance;
+
+        return GetSmoothedRtt() + ((variance > granularity) ? variance : granularity);
+    }
+
+    /**
+     *  Return the timeout after which a message that was sent sendCount times is retransmitted, in milliseconds.
+     *
+     *  The retransmission timeout is raised to at least minTimeout, then doubled for every retransmission as in
+     *  RFC 6298 section 5.5, and kept at most maxTimeout.
+     *
+     *  @param[in] granularity   The resolution of the retransmission timer, in milliseconds.
+     *  @param[in] minTimeout    The lower bound of the timeout, in milliseconds.
+     *  @param[in] maxTimeout    The upper bound of the timeout, in milliseconds.
+     *  @param[in] sendCount     The number of times the message has been sent so far.
+     */
+    uint32_t GetRetransTimeout(uint32_t granularity, uint32_t minTimeout, uint32_t maxTimeout, uint8_t sendCount) const
+    {
+        uint32_t timeout = GetRetransTimeout(granularity);
+
+        if (timeout < minTimeout)
+        {
+            timeout = minTimeout;
+        }
+
+        for (uint8_t i = 1; i < sendCount && timeout < maxTimeout; i++)
+        {
+            timeout *= 2;
+        }
+
+        if (timeout > maxTimeout)
+        {
+            timeout = maxTimeout;
+        }
+
+        return timeout;
+    }
+
+private:
+    static constexpr unsigned kSmoothedRttShift = 3; // SRTT is kept multiplied by 8
+    static constexpr unsigned kRttVarianceShift = 2; // RTTVAR is kept multiplied by 4
+
+    uint32_t mScaledSmoothedRtt;
+    uint32_t mScaledRttVariance;
+    bool mHasSample;
+};
+
+} // namespace chip
+
+#endif // CHIP_WRMP_RTT_ESTIMATOR_H_
@@ -0,0 +1,187 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the timing wheel that schedules the entries of
+ *      the CHIP Reliable Messaging Protocol retransmission table.
+ *
+ */
+#ifndef CHIP_WRMP_TIMING_WHEEL_H_
+#define CHIP_WRMP_TIMING_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <support/PoolHashIndex.h>
+
+namespace chip {
+
+/**
+ *  @class WRMPTimingWheel
+ *
+ *  @brief
+ *    A hashed timing wheel over the kEntryCount entries of a table, which
+ *    links each scheduled entry into the slot for the timer tick at which it
+ *    is due.
+ *
+ *    Entries due more than kSlotCount ticks ahead share a slot with earlier
+ *    ones, so every lookup compares the due tick of an entry with the current
+ *    tick. Ticks are compared so that the tick counter may wrap around. The
+ *    caller owns the current tick and passes it in; the wheel only remembers
+ *    up to which tick it has been walked, so that collecting the due entries
+ *    visits the slots of the ticks that passed since the previous collection.
+ */
+template <size_t kEntryCount, size_t kSlotCount>
+class WRMPTimingWheel
+{
+public:
+    typedef PoolHashIndex<kEntryCount, kSlotCount> Index;
+
+    /**
+     *  @brief Unschedule every entry, and start walking the wheel at tick now.
+     */
+    void Init(uint32_t now)
+    {
+        mIndex.Init();
+        mWalkedTick = now;
+    }
+
+    /**
+     *  @brief Schedule entry index to be due at tick, which must not be earlier than the current tick, replacing
+     *         any tick it was scheduled for.
+     */
+    void Schedule(uint16_t index, uint32_t tick)
+    {
+        mDueTick[index] = tick;
+        mIndex.Link(index, tick);
+    }
+
+    /**
+     *  @brief Unschedule an entry. Does nothing if the entry is not scheduled.
+     */
+    void Cancel(uint16_t index) { mIndex.Unlink(index); }
+
+    bool IsScheduled(uint16_t index) const { return mIndex.IsLinked(index); }
+
+    /**
+     *  @brief Return the tick at which a scheduled entry is due.
+     */
+    uint32_t DueTick(uint16_t index) const { return mDueTick[index]; }
+
+    /**
+     *  @brief Whether an entry is scheduled and due at tick now.
+     */
+    bool IsDue(uint16_t index, uint32_t now) const { return IsScheduled(index) && IsTickDue(mDueTick[index], now); }
+
+    /**
+     *  @brief Collect the entries that are due at tick now, and mark the wheel as walked up to it.
+     *
+     *  @param[in]    now      The current tick.
+     *
+     *  @param[out]   indices  Receives the indices of the due entries, in slot and then index order; must hold
+     *                         kEntryCount items.
+     *
+     *  @return The number of due entries.
+     */
+    size_t CollectDue(uint32_t now, uint16_t * indices)
+    {
+        size_t count   = 0;
+        uint32_t slots = now - mWalkedTick + 1;
+
+        if (slots > kSlotCount)
+        {
+            slots = kSlotCount;
+        }
+
+        for (uint32_t tick = mWalkedTick; slots > 0; tick++, slots--)
+        {
+            for (uint16_t i = mIndex.First(tick); i != Index::kInvalidIndex; i = mIndex.Next(i))
+            {
+                if (IsTickDue(mDueTick[i], now))
+                {
+                    indices[count++] = i;
+                }
+            }
+        }
+
+        // The current tick is walked again next time, as entries may still be scheduled for it
+        mWalkedTick = now;
+
+        return count;
+    }
+
+    /**
+     *  @brief Find how many ticks from tick now the earliest scheduled entry is due.
+     *
+     *  The wheel is walked from the oldest slot that may hold due entries. Every scheduled entry is due at or after
+     *  that slot's tick, so the walk stops at the first slot whose tick is not earlier than the earliest due tick
+     *  seen so far.
+     *
+     *  @param[in]    now      The current tick.
+     *
+     *  @param[out]   ticks    The number of ticks until the earliest entry is due; 0 if one is due already.
+     *
+     *  @return true if any entry is scheduled, false otherwise.
+     */
+    bool GetNextDueTicks(uint32_t now, uint32_t & ticks) const
+    {
+        bool found        = false;
+        uint32_t earliest = 0;
+
+        for (uint32_t n = 0; n < kSlotCount; n++)
+        {
+            const uint32_t tick = mWalkedTick + n;
+
+            if (found && IsTickDue(earliest, tick))
+            {
+                break;
+            }
+
+            for (uint16_t i = mIndex.First(tick); i != Index::kInvalidIndex; i = mIndex.Next(i))
+            {
+                if (!found || IsTickDue(mDueTick[i], earliest))
+                {
+                    earliest = mDueTick[i];
+                    found    = true;
+                }
+            }
+        }
+
+        if (found)
+        {
+            ticks = IsTickDue(earliest, now) ? 0 : earliest - now;
+        }
+
+        return found;
+    }
+
+    /**
+     *  @brief Whether tick has been reached at tick now, allowing for the tick counter wrapping around.
+     */
+    static bool IsTickDue(uint32_t tick, uint32_t now) { return static_cast<int32_t>(tick - now) <= 0; }
+
+private:
+    Index mIndex;
+    uint32_t mDueTick[kEntryCount];
+    uint32_t mWalkedTick;
+};
+
+} // namespace chip
+
+#endif // CHIP_WRMP_TIMING_WHEEL_H_
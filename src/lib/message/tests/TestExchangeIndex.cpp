@@ -0,0 +1,177 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the exchange index used
+ *      by the CHIP exchange manager to dispatch received messages.
+ *
+ */
+
+#include "TestMessageLayer.h"
+
+#include <message/CHIPExchangeIndex.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+
+namespace {
+
+// The node ids of ChipFabricState.h.
+const uint64_t kNodeIdNotSpecified = 0ULL;
+const uint64_t kPeerNodeId         = 0x18B4300000000001ULL;
+const uint64_t kOtherNodeId        = 0x18B4300000000002ULL;
+
+struct TestConnection
+{
+    int mUnused;
+};
+
+struct TestContext
+{
+    TestConnection * Con;
+    uint64_t PeerNodeId;
+    uint16_t ExchangeId;
+    bool mInitiator;
+
+    bool IsInitiator() const { return mInitiator; }
+};
+
+const size_t kPoolSize = 8;
+
+typedef ExchangeIndex<TestContext, kPoolSize, 4> TestIndex;
+
+// Looks a message up the way the exchange manager does: walk the candidates and confirm each one's keys.
+uint16_t Lookup(const TestIndex & index, const TestContext * pool, const TestConnection * con, uint64_t sourceNodeId,
+                uint16_t exchangeId, bool isInitiator)
+{
+    for (uint16_t i = index.First(con, sourceNodeId, exchangeId, isInitiator); i != index.kInvalidIndex; i = index.Next(i))
+    {
+        const TestContext & ec = pool[i];
+        if (ec.Con == con && (con != NULL || ec.PeerNodeId == sourceNodeId) && ec.ExchangeId == exchangeId &&
+            ec.IsInitiator() == isInitiator)
+            return i;
+    }
+    return index.kInvalidIndex;
+}
+
+} // namespace
+
+static void TestExchangeIndex_UDP(nlTestSuite * inSuite, void * inContext)
+{
+    TestIndex index;
+    TestContext pool[kPoolSize] = {};
+
+    pool[3] = { NULL, kPeerNodeId, 17, true };
+    index.Link(3, pool[3]);
+
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, NULL, kPeerNodeId, 17, true) == 3);
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, NULL, kOtherNodeId, 17, true) == index.kInvalidIndex);
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, NULL, kPeerNodeId, 18, true) == index.kInvalidIndex);
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, NULL, kPeerNodeId, 17, false) == index.kInvalidIndex);
+
+    index.Unlink(3);
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, NULL, kPeerNodeId, 17, true) == index.kInvalidIndex);
+}
+
+static void TestExchangeIndex_ConnectionWithoutPeerNodeId(nlTestSuite * inSuite, void * inContext)
+{
+    TestIndex index;
+    TestContext pool[kPoolSize] = {};
+    TestConnection con;
+    TestConnection otherCon;
+
+    // An exchange on an accepted connection, whose peer node id is not known yet.
+    pool[5] = { &con, kNodeIdNotSpecified, 42, false };
+    index.Link(5, pool[5]);
+
+    // A message over the connection finds it, whatever node it says it is from.
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, &con, kPeerNodeId, 42, false) == 5);
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, &con, kOtherNodeId, 42, false) == 5);
+
+    // The same exchange id over another connection or over UDP does not.
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, &otherCon, kPeerNodeId, 42, false) == index.kInvalidIndex);
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, NULL, kPeerNodeId, 42, false) == index.kInvalidIndex);
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, NULL, kNodeIdNotSpecified, 42, false) == index.kInvalidIndex);
+}
+
+static void TestExchangeIndex_Relink(nlTestSuite * inSuite, void * inContext)
+{
+    TestIndex index;
+    TestContext pool[kPoolSize] = {};
+    TestConnection con;
+
+    // NewContext(con) indexes the context before it is bound to the connection, then again after.
+    pool[1] = { NULL, kNodeIdNotSpecified, 7, true };
+    index.Link(1, pool[1]);
+    pool[1].Con = &con;
+    index.Link(1, pool[1]);
+
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, &con, kPeerNodeId, 7, true) == 1);
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, NULL, kNodeIdNotSpecified, 7, true) == index.kInvalidIndex);
+
+    // An exchange that outlives its connection is keyed on its peer node id again.
+    pool[1].Con        = NULL;
+    pool[1].PeerNodeId = kPeerNodeId;
+    index.Link(1, pool[1]);
+
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, &con, kPeerNodeId, 7, true) == index.kInvalidIndex);
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, NULL, kPeerNodeId, 7, true) == 1);
+}
+
+static void TestExchangeIndex_SharedExchangeId(nlTestSuite * inSuite, void * inContext)
+{
+    TestIndex index;
+    TestContext pool[kPoolSize] = {};
+    TestConnection con;
+
+    // Exchanges with the same id on different transports, and in both roles, are told apart.
+    pool[0] = { NULL, kPeerNodeId, 9, true };
+    pool[2] = { NULL, kPeerNodeId, 9, false };
+    pool[4] = { &con, kPeerNodeId, 9, true };
+    pool[6] = { NULL, kOtherNodeId, 9, true };
+    for (uint16_t i = 0; i < kPoolSize; i += 2)
+    {
+        index.Link(i, pool[i]);
+    }
+
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, NULL, kPeerNodeId, 9, true) == 0);
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, NULL, kPeerNodeId, 9, false) == 2);
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, &con, kPeerNodeId, 9, true) == 4);
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, NULL, kOtherNodeId, 9, true) == 6);
+    NL_TEST_ASSERT(inSuite, Lookup(index, pool, &con, kPeerNodeId, 9, false) == index.kInvalidIndex);
+}
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF_FN(TestExchangeIndex_UDP),
+                                 NL_TEST_DEF_FN(TestExchangeIndex_ConnectionWithoutPeerNodeId),
+                                 NL_TEST_DEF_FN(TestExchangeIndex_Relink),
+                                 NL_TEST_DEF_FN(TestExchangeIndex_SharedExchangeId),
+                                 NL_TEST_SENTINEL() };
+
+int TestExchangeIndex(void)
+{
+    nlTestSuite theSuite = { "CHIP ExchangeIndex tests", &sTests[0], NULL, NULL };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,412 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the session establishment
+ *      pool and the crypto worker used by the CHIP security manager to run
+ *      several session establishments at once.
+ *
+ */
+
+#include "TestMessageLayer.h"
+
+#include <message/CHIPCryptoWorker.h>
+#include <message/CHIPSessionPool.h>
+
+#include <nlunit-test.h>
+
+#include <stdint.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+#include <pthread.h>
+#include <sys/select.h>
+#include <time.h>
+#endif
+
+using namespace chip;
+
+namespace {
+
+enum
+{
+    kState_Idle = 0,
+    kState_InProgress,
+};
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+struct TestStep : public CryptoWorker::Step
+{
+    const bool * Gate; // The work waits for it to be set, if not NULL.
+    bool RanOffThread;
+    pthread_t TestThread;
+};
+#else
+struct TestStep
+{
+};
+#endif
+
+// A session establishment, tracked the way ChipSecurityManager tracks its own.
+struct TestSession
+{
+    uint8_t State;
+    const void * Exchange;
+    TestStep * Step;
+    unsigned HandBacks;
+
+    bool IsFree(void) const { return State == kState_Idle && Step == NULL; }
+};
+
+const size_t kPoolSize = 4;
+
+typedef SessionPool<TestSession, kPoolSize> TestPool;
+
+void InitPool(TestPool & pool)
+{
+    for (size_t i = 0; i < kPoolSize; i++)
+    {
+        pool[i].State     = kState_Idle;
+        pool[i].Exchange  = NULL;
+        pool[i].Step      = NULL;
+        pool[i].HandBacks = 0;
+    }
+}
+
+TestSession * StartSession(TestPool & pool, size_t maxActive, const void * exchange)
+{
+    TestSession * session = pool.Alloc(maxActive);
+
+    if (session != NULL)
+    {
+        session->State    = kState_InProgress;
+        session->Exchange = exchange;
+    }
+
+    return session;
+}
+
+TestSession * FindSession(TestPool & pool, const void * exchange)
+{
+    return pool.Find(
+        [exchange](const TestSession & session) { return session.State != kState_Idle && session.Exchange == exchange; });
+}
+
+} // namespace
+
+static void TestSessionPool_AllocFind(nlTestSuite * inSuite, void * inContext)
+{
+    TestPool pool;
+    int exchanges[kPoolSize];
+    TestSession * sessions[kPoolSize];
+
+    InitPool(pool);
+
+    // Several session establishments in progress at once each get an entry of their own.
+    for (size_t i = 0; i < 3; i++)
+    {
+        sessions[i] = StartSession(pool, kPoolSize, &exchanges[i]);
+        NL_TEST_ASSERT(inSuite, sessions[i] == &pool[i]);
+    }
+    NL_TEST_ASSERT(inSuite, pool.ActiveCount() == 3);
+
+    // and the messages of each are dispatched to it.
+    for (size_t i = 0; i < 3; i++)
+    {
+        NL_TEST_ASSERT(inSuite, FindSession(pool, &exchanges[i]) == sessions[i]);
+    }
+    NL_TEST_ASSERT(inSuite, FindSession(pool, &exchanges[3]) == NULL);
+
+    // Once one ends, it is no longer found, and its entry is the next one handed out.
+    sessions[1]->State = kState_Idle;
+    NL_TEST_ASSERT(inSuite, FindSession(pool, &exchanges[1]) == NULL);
+    NL_TEST_ASSERT(inSuite, FindSession(pool, &exchanges[0]) == sessions[0]);
+    NL_TEST_ASSERT(inSuite, FindSession(pool, &exchanges[2]) == sessions[2]);
+    NL_TEST_ASSERT(inSuite, pool.ActiveCount() == 2);
+
+    NL_TEST_ASSERT(inSuite, StartSession(pool, kPoolSize, &exchanges[3]) == &pool[1]);
+    NL_TEST_ASSERT(inSuite, FindSession(pool, &exchanges[3]) == &pool[1]);
+}
+
+static void TestSessionPool_MaxConcurrent(nlTestSuite * inSuite, void * inContext)
+{
+    TestPool pool;
+    int exchanges[kPoolSize];
+    TestStep step;
+
+    InitPool(pool);
+
+    // With a single session establishment allowed, as without CHIP_CONFIG_MEMORY_MGMT_MALLOC, a second one is refused.
+    NL_TEST_ASSERT(inSuite, StartSession(pool, 1, &exchanges[0]) == &pool[0]);
+    NL_TEST_ASSERT(inSuite, pool.Alloc(1) == NULL);
+
+    // Raising the cap admits more, up to the cap even though entries remain free.
+    NL_TEST_ASSERT(inSuite, StartSession(pool, 2, &exchanges[1]) == &pool[1]);
+    NL_TEST_ASSERT(inSuite, pool.Alloc(2) == NULL);
+
+    // An entry that ended while its step is still with the crypto worker counts against the cap.
+    pool[1].State = kState_Idle;
+    pool[1].Step  = &step;
+    NL_TEST_ASSERT(inSuite, pool.ActiveCount() == 2);
+    NL_TEST_ASSERT(inSuite, pool.Alloc(2) == NULL);
+
+    pool[1].Step = NULL;
+    NL_TEST_ASSERT(inSuite, StartSession(pool, 2, &exchanges[1]) == &pool[1]);
+
+    // The cap never lets more establishments start than there are entries.
+    NL_TEST_ASSERT(inSuite, StartSession(pool, kPoolSize + 1, &exchanges[2]) == &pool[2]);
+    NL_TEST_ASSERT(inSuite, StartSession(pool, kPoolSize + 1, &exchanges[3]) == &pool[3]);
+    NL_TEST_ASSERT(inSuite, pool.Alloc(kPoolSize + 1) == NULL);
+}
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+namespace {
+
+const unsigned kWaitTimeoutMs = 5000;
+
+void WorkStep(CryptoWorker::Step & aStep)
+{
+    TestStep & step = static_cast<TestStep &>(aStep);
+    const struct timespec kPollInterval = { 0, 1000000 };
+
+    for (unsigned i = 0; step.Gate != NULL && i < kWaitTimeoutMs && !__atomic_load_n(step.Gate, __ATOMIC_ACQUIRE); i++)
+    {
+        nanosleep(&kPollInterval, NULL);
+    }
+
+    step.RanOffThread = !pthread_equal(pthread_self(), step.TestThread);
+}
+
+// Free the step of a session, as ChipSecurityManager does once it is done.
+void FreeStep(TestSession & session)
+{
+    session.Step = NULL;
+}
+
+// As ChipSecurityManager::HandleCASEResponderStepDone(): finish the session with the step, if it is still there.
+void HandleStepDone(System::Layer * aLayer, void * aAppState, System::Error aError)
+{
+    TestSession & session = *static_cast<TestSession *>(aAppState);
+
+    session.HandBacks++;
+
+    if (session.Step != NULL && CryptoWorker::IsDone(*session.Step))
+    {
+        FreeStep(session);
+        session.State = kState_Idle;
+    }
+}
+
+// As ChipSecurityManager::Reset() on a session timeout: free the step if it is done, otherwise leave it to the worker.
+void TimeOutSession(TestSession & session)
+{
+    if (session.Step != NULL && CryptoWorker::IsDone(*session.Step))
+        FreeStep(session);
+    session.State = kState_Idle;
+}
+
+// As ChipSecurityManager::ReclaimCryptoSteps().
+void ReclaimSteps(TestPool & pool)
+{
+    for (size_t i = 0; i < kPoolSize; i++)
+    {
+        if (pool[i].State == kState_Idle && pool[i].Step != NULL && CryptoWorker::IsDone(*pool[i].Step))
+            FreeStep(pool[i]);
+    }
+}
+
+CHIP_ERROR RunStep(CryptoWorker & worker, TestSession & session, TestStep & step, const bool * gate)
+{
+    CHIP_ERROR err;
+
+    step.Gate         = gate;
+    step.RanOffThread = false;
+    step.TestThread   = pthread_self();
+
+    err = worker.Run(step, WorkStep, HandleStepDone, &session);
+    if (err == CHIP_NO_ERROR)
+        session.Step = &step;
+
+    return err;
+}
+
+bool WaitUntilDone(const TestStep & step)
+{
+    const struct timespec kPollInterval = { 0, 1000000 };
+
+    for (unsigned i = 0; i < kWaitTimeoutMs && !CryptoWorker::IsDone(step); i++)
+    {
+        nanosleep(&kPollInterval, NULL);
+    }
+
+    return CryptoWorker::IsDone(step);
+}
+
+// Service a system layer on the calling thread for up to kWaitTimeoutMs, until the pool has no session in use.
+bool ServiceUntilFree(System::Layer & aLayer, const TestPool & pool)
+{
+    for (unsigned i = 0; i < kWaitTimeoutMs / 10 && pool.ActiveCount() != 0; i++)
+    {
+        struct timeval sleepTime = { 0, 10000 };
+        fd_set readFDs, writeFDs, exceptFDs;
+        int numFDs = 0;
+        int selectRes;
+
+        FD_ZERO(&readFDs);
+        FD_ZERO(&writeFDs);
+        FD_ZERO(&exceptFDs);
+
+        aLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+        selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &sleepTime);
+        if (selectRes >= 0)
+        {
+            aLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+        }
+    }
+
+    return pool.ActiveCount() == 0;
+}
+
+} // namespace
+
+static void TestCryptoWorker_Completion(nlTestSuite * inSuite, void * inContext)
+{
+    System::Layer ownerLayer;
+    CryptoWorker worker;
+    TestPool pool;
+    TestStep steps[3];
+    int exchanges[3];
+
+    InitPool(pool);
+    NL_TEST_ASSERT(inSuite, ownerLayer.Init(NULL) == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, worker.Start(ownerLayer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, worker.Start(ownerLayer) == CHIP_ERROR_INCORRECT_STATE);
+
+    // Steps of several sessions run on the worker and are each handed back to their own session.
+    for (size_t i = 0; i < 3; i++)
+    {
+        NL_TEST_ASSERT(inSuite, StartSession(pool, kPoolSize, &exchanges[i]) == &pool[i]);
+        NL_TEST_ASSERT(inSuite, RunStep(worker, pool[i], steps[i], NULL) == CHIP_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(inSuite, ServiceUntilFree(ownerLayer, pool));
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        NL_TEST_ASSERT(inSuite, CryptoWorker::IsDone(steps[i]));
+        NL_TEST_ASSERT(inSuite, steps[i].RanOffThread);
+        NL_TEST_ASSERT(inSuite, pool[i].HandBacks == 1);
+    }
+
+    worker.Stop();
+    NL_TEST_ASSERT(inSuite, !worker.IsRunning());
+    ownerLayer.Shutdown();
+}
+
+static void TestCryptoWorker_Timeout(nlTestSuite * inSuite, void * inContext)
+{
+    System::Layer ownerLayer;
+    CryptoWorker worker;
+    TestPool pool;
+    TestStep step;
+    bool gate = false;
+    int exchange;
+
+    InitPool(pool);
+    NL_TEST_ASSERT(inSuite, ownerLayer.Init(NULL) == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, worker.Start(ownerLayer) == CHIP_NO_ERROR);
+
+    // The session times out while its step is still running: the entry stays in use until the step is handed back.
+    NL_TEST_ASSERT(inSuite, StartSession(pool, 1, &exchange) == &pool[0]);
+    NL_TEST_ASSERT(inSuite, RunStep(worker, pool[0], step, &gate) == CHIP_NO_ERROR);
+    TimeOutSession(pool[0]);
+    NL_TEST_ASSERT(inSuite, FindSession(pool, &exchange) == NULL);
+    NL_TEST_ASSERT(inSuite, pool[0].Step == &step);
+    NL_TEST_ASSERT(inSuite, pool.Alloc(1) == NULL);
+
+    __atomic_store_n(&gate, true, __ATOMIC_RELEASE);
+    NL_TEST_ASSERT(inSuite, ServiceUntilFree(ownerLayer, pool));
+    NL_TEST_ASSERT(inSuite, pool[0].HandBacks == 1);
+    NL_TEST_ASSERT(inSuite, StartSession(pool, 1, &exchange) == &pool[0]);
+
+    worker.Stop();
+    ownerLayer.Shutdown();
+}
+
+static void TestCryptoWorker_LostHandBack(nlTestSuite * inSuite, void * inContext)
+{
+    System::Layer ownerLayer;
+    CryptoWorker worker;
+    TestPool pool;
+    TestStep steps[2];
+    bool gate = false;
+    int exchanges[2];
+
+    InitPool(pool);
+
+    // An owner layer that is not initialized makes every hand-back fail.
+    NL_TEST_ASSERT(inSuite, worker.Start(ownerLayer) == CHIP_NO_ERROR);
+
+    // A session that times out after its step is done frees the step itself.
+    NL_TEST_ASSERT(inSuite, StartSession(pool, kPoolSize, &exchanges[0]) == &pool[0]);
+    NL_TEST_ASSERT(inSuite, RunStep(worker, pool[0], steps[0], NULL) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, WaitUntilDone(steps[0]));
+    TimeOutSession(pool[0]);
+    NL_TEST_ASSERT(inSuite, pool[0].IsFree());
+
+    // A session that timed out while its step was running has the step reclaimed once it is done.
+    NL_TEST_ASSERT(inSuite, StartSession(pool, 1, &exchanges[1]) == &pool[0]);
+    NL_TEST_ASSERT(inSuite, RunStep(worker, pool[0], steps[1], &gate) == CHIP_NO_ERROR);
+    TimeOutSession(pool[0]);
+    ReclaimSteps(pool);
+    NL_TEST_ASSERT(inSuite, pool[0].Step == &steps[1]);
+    NL_TEST_ASSERT(inSuite, pool.Alloc(1) == NULL);
+
+    __atomic_store_n(&gate, true, __ATOMIC_RELEASE);
+    NL_TEST_ASSERT(inSuite, WaitUntilDone(steps[1]));
+    ReclaimSteps(pool);
+    NL_TEST_ASSERT(inSuite, pool.Alloc(1) == &pool[0]);
+
+    NL_TEST_ASSERT(inSuite, pool[0].HandBacks == 0);
+
+    worker.Stop();
+}
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF_FN(TestSessionPool_AllocFind),
+                                 NL_TEST_DEF_FN(TestSessionPool_MaxConcurrent),
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+                                 NL_TEST_DEF_FN(TestCryptoWorker_Completion),
+                                 NL_TEST_DEF_FN(TestCryptoWorker_Timeout),
+                                 NL_TEST_DEF_FN(TestCryptoWorker_LostHandBack),
+#endif
+                                 NL_TEST_SENTINEL() };
+
+int TestSecurityMgrSessions(void)
+{
+    nlTestSuite theSuite = { "CHIP security manager session tests", &sTests[0], NULL, NULL };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
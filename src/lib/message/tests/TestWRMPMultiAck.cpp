@@ -0,0 +1,246 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the encoding, decoding
+ *      and selection of the acknowledgments in CHIP WRMP Multi-Ack messages.
+ *
+ */
+
+#include "TestMessageLayer.h"
+
+#include <message/CHIPWRMPMultiAck.h>
+
+#include <nlunit-test.h>
+
+#include <string.h>
+
+using namespace chip;
+
+namespace {
+
+// The members of ExchangeContext that acknowledgment coalescing uses.
+struct TestContext
+{
+    const void * ExchangeMgr;
+    uint64_t PeerNodeId;
+    const void * Con;
+    uint32_t PeerAddr;
+    int PeerIntf;
+    uint16_t PeerPort;
+    uint16_t ExchangeId;
+    uint8_t EncryptionType;
+    uint16_t KeyId;
+    uint32_t mPendingPeerAckId;
+    bool mInitiator;
+    bool mAckPending;
+
+    bool IsInitiator(void) const { return mInitiator; }
+    bool IsAckPending(void) const { return mAckPending; }
+    void SetAckPending(bool inAckPending) { mAckPending = inAckPending; }
+};
+
+int sExchangeMgr;
+
+TestContext MakeContext(uint16_t exchangeId, uint32_t ackMsgId, bool initiator)
+{
+    TestContext ec;
+
+    memset(&ec, 0, sizeof(ec));
+    ec.ExchangeMgr       = &sExchangeMgr;
+    ec.PeerNodeId        = 0x18B4300000000001ULL;
+    ec.PeerAddr          = 0x0A000001;
+    ec.PeerPort          = 11095;
+    ec.KeyId             = 0x4001;
+    ec.EncryptionType    = 1;
+    ec.ExchangeId        = exchangeId;
+    ec.mPendingPeerAckId = ackMsgId;
+    ec.mInitiator        = initiator;
+    ec.mAckPending       = true;
+    return ec;
+}
+
+typedef WRMPAckCoalescer<TestContext, 8> TestCoalescer;
+
+} // namespace
+
+static void TestWRMPMultiAck_RoundTrip(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext due      = MakeContext(1, 0x100, true);
+    TestContext others[] = { MakeContext(2, 0x200, true), MakeContext(0xFFFF, 0xFFFFFFFF, false), MakeContext(4, 0, true) };
+    TestCoalescer acks(due);
+    uint8_t buf[64];
+    WRMPMultiAckReader reader;
+    uint16_t exchangeId;
+    bool isInitiator;
+    uint32_t ackMsgId;
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        NL_TEST_ASSERT(inSuite, acks.Add(others[i]));
+    }
+    NL_TEST_ASSERT(inSuite, acks.Count() == 3);
+    NL_TEST_ASSERT(inSuite, acks.PayloadLength() == 2 + 3 * 7);
+    NL_TEST_ASSERT(inSuite, acks.Encode(buf, sizeof(buf)) == CHIP_NO_ERROR);
+
+    // Every acknowledgment taken comes out of the payload, in order
+    NL_TEST_ASSERT(inSuite, reader.Init(buf, acks.PayloadLength()) == CHIP_NO_ERROR);
+    for (size_t i = 0; i < 3; i++)
+    {
+        NL_TEST_ASSERT(inSuite, reader.Next(exchangeId, isInitiator, ackMsgId));
+        NL_TEST_ASSERT(inSuite, exchangeId == others[i].ExchangeId);
+        NL_TEST_ASSERT(inSuite, isInitiator == others[i].mInitiator);
+        NL_TEST_ASSERT(inSuite, ackMsgId == others[i].mPendingPeerAckId);
+    }
+    NL_TEST_ASSERT(inSuite, !reader.Next(exchangeId, isInitiator, ackMsgId));
+
+    // Once sent, the acknowledgments taken are no longer pending; the one that is due is left to the caller
+    acks.MarkSent();
+    for (size_t i = 0; i < 3; i++)
+    {
+        NL_TEST_ASSERT(inSuite, !others[i].IsAckPending());
+    }
+    NL_TEST_ASSERT(inSuite, due.IsAckPending());
+}
+
+static void TestWRMPMultiAck_Selection(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext due = MakeContext(1, 0x100, true);
+    TestContext other;
+    TestCoalescer acks(due);
+    int con;
+
+    NL_TEST_ASSERT(inSuite, !acks.Add(due));
+
+    other             = MakeContext(2, 0x200, false);
+    other.ExchangeMgr = NULL;
+    NL_TEST_ASSERT(inSuite, !acks.Add(other));
+
+    other             = MakeContext(2, 0x200, false);
+    other.mAckPending = false;
+    NL_TEST_ASSERT(inSuite, !acks.Add(other));
+
+    other            = MakeContext(2, 0x200, false);
+    other.PeerNodeId = 0x18B4300000000002ULL;
+    NL_TEST_ASSERT(inSuite, !acks.Add(other));
+
+    other     = MakeContext(2, 0x200, false);
+    other.Con = &con;
+    NL_TEST_ASSERT(inSuite, !acks.Add(other));
+
+    other          = MakeContext(2, 0x200, false);
+    other.PeerPort = 11096;
+    NL_TEST_ASSERT(inSuite, !acks.Add(other));
+
+    other       = MakeContext(2, 0x200, false);
+    other.KeyId = 0x4002;
+    NL_TEST_ASSERT(inSuite, !acks.Add(other));
+
+    other                = MakeContext(2, 0x200, false);
+    other.EncryptionType = 0;
+    NL_TEST_ASSERT(inSuite, !acks.Add(other));
+
+    NL_TEST_ASSERT(inSuite, acks.Count() == 0);
+
+    other = MakeContext(2, 0x200, false);
+    NL_TEST_ASSERT(inSuite, acks.Add(other));
+    NL_TEST_ASSERT(inSuite, acks.Count() == 1);
+}
+
+static void TestWRMPMultiAck_Limits(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext due      = MakeContext(1, 0x100, true);
+    TestContext others[] = { MakeContext(2, 0x200, true), MakeContext(3, 0x300, true), MakeContext(4, 0x400, true) };
+    WRMPAckCoalescer<TestContext, 2> acks(due);
+    WRMPAckCoalescer<TestContext, 0> none(due);
+    uint8_t buf[2 + 2 * 7];
+
+    NL_TEST_ASSERT(inSuite, none.IsFull() && !none.Add(others[0]));
+
+    NL_TEST_ASSERT(inSuite, acks.Add(others[0]));
+    NL_TEST_ASSERT(inSuite, acks.Add(others[1]));
+    NL_TEST_ASSERT(inSuite, acks.IsFull());
+    NL_TEST_ASSERT(inSuite, !acks.Add(others[2]));
+
+    NL_TEST_ASSERT(inSuite, acks.Encode(buf, sizeof(buf) - 1) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(inSuite, acks.Encode(buf, sizeof(buf)) == CHIP_NO_ERROR);
+
+    // Nothing is marked sent but what was taken
+    acks.MarkSent();
+    NL_TEST_ASSERT(inSuite, !others[0].IsAckPending() && !others[1].IsAckPending() && others[2].IsAckPending());
+}
+
+static void TestWRMPMultiAck_Decode(nlTestSuite * inSuite, void * inContext)
+{
+    // Version 1, two acknowledgments: exchange 0x1234 sent by its initiator acking 0x89ABCDEF, then
+    // exchange 0x0001 sent by its responder acking 0x00000002
+    static const uint8_t kPayload[] = { 0x01, 0x02, 0x34, 0x12, 0x01, 0xEF, 0xCD, 0xAB, 0x89,
+                                        0x01, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00 };
+    WRMPMultiAckReader reader;
+    uint16_t exchangeId;
+    bool isInitiator;
+    uint32_t ackMsgId;
+
+    NL_TEST_ASSERT(inSuite, reader.Init(kPayload, sizeof(kPayload)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.Next(exchangeId, isInitiator, ackMsgId));
+    NL_TEST_ASSERT(inSuite, exchangeId == 0x1234 && isInitiator && ackMsgId == 0x89ABCDEF);
+    NL_TEST_ASSERT(inSuite, reader.Next(exchangeId, isInitiator, ackMsgId));
+    NL_TEST_ASSERT(inSuite, exchangeId == 0x0001 && !isInitiator && ackMsgId == 0x00000002);
+    NL_TEST_ASSERT(inSuite, !reader.Next(exchangeId, isInitiator, ackMsgId));
+}
+
+static void TestWRMPMultiAck_DecodeErrors(nlTestSuite * inSuite, void * inContext)
+{
+    static const uint8_t kEmpty[]     = { 0x01, 0x00 };
+    static const uint8_t kVersion2[]  = { 0x02, 0x01, 0x34, 0x12, 0x01, 0xEF, 0xCD, 0xAB, 0x89 };
+    static const uint8_t kTruncated[] = { 0x01, 0x02, 0x34, 0x12, 0x01, 0xEF, 0xCD, 0xAB, 0x89 };
+    static const uint8_t kTrailing[]  = { 0x01, 0x01, 0x34, 0x12, 0x01, 0xEF, 0xCD, 0xAB, 0x89, 0x00 };
+    WRMPMultiAckReader reader;
+    uint16_t exchangeId;
+    bool isInitiator;
+    uint32_t ackMsgId;
+
+    NL_TEST_ASSERT(inSuite, reader.Init(kEmpty, sizeof(kEmpty)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !reader.Next(exchangeId, isInitiator, ackMsgId));
+
+    NL_TEST_ASSERT(inSuite, reader.Init(kEmpty, 0) == CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    NL_TEST_ASSERT(inSuite, reader.Init(kEmpty, 1) == CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    NL_TEST_ASSERT(inSuite, reader.Init(kVersion2, sizeof(kVersion2)) == CHIP_ERROR_UNSUPPORTED_MESSAGE_VERSION);
+    NL_TEST_ASSERT(inSuite, reader.Init(kTruncated, sizeof(kTruncated)) == CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    NL_TEST_ASSERT(inSuite, reader.Init(kTrailing, sizeof(kTrailing)) == CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+    // A rejected payload yields no acknowledgments
+    NL_TEST_ASSERT(inSuite, !reader.Next(exchangeId, isInitiator, ackMsgId));
+}
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF_FN(TestWRMPMultiAck_RoundTrip),    NL_TEST_DEF_FN(TestWRMPMultiAck_Selection),
+                                 NL_TEST_DEF_FN(TestWRMPMultiAck_Limits),       NL_TEST_DEF_FN(TestWRMPMultiAck_Decode),
+                                 NL_TEST_DEF_FN(TestWRMPMultiAck_DecodeErrors), NL_TEST_SENTINEL() };
+
+int TestWRMPMultiAck(void)
+{
+    nlTestSuite theSuite = { "CHIP WRMPMultiAck tests", &sTests[0], NULL, NULL };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,128 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the round-trip time
+ *      estimator of the CHIP Reliable Messaging Protocol.
+ *
+ */
+
+#include "TestMessageLayer.h"
+
+#include <message/CHIPWRMPRttEstimator.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+
+static void TestWRMPRttEstimator_FirstSample(nlTestSuite * inSuite, void * inContext)
+{
+    WRMPRttEstimator estimator;
+
+    NL_TEST_ASSERT(inSuite, !estimator.HasSample());
+
+    // SRTT = R, RTTVAR = R / 2, RTO = SRTT + 4 * RTTVAR
+    NL_TEST_ASSERT(inSuite, estimator.AddSample(100, 1));
+    NL_TEST_ASSERT(inSuite, estimator.HasSample());
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() == 100);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout(10) == 300);
+
+    estimator.Reset();
+    NL_TEST_ASSERT(inSuite, !estimator.HasSample());
+}
+
+static void TestWRMPRttEstimator_Update(nlTestSuite * inSuite, void * inContext)
+{
+    WRMPRttEstimator estimator;
+
+    estimator.AddSample(100, 1);
+
+    // RTTVAR = 3/4 * 50 + 1/4 * |100 - 180| = 57.5, SRTT = 7/8 * 100 + 1/8 * 180 = 110
+    estimator.AddSample(180, 1);
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() == 110);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout(10) == 110 + 230);
+
+    // RTTVAR = 3/4 * 57.5 + 1/4 * |110 - 30| = 63.125, kept in quarters as 253 / 4; SRTT = 7/8 * 110 + 1/8 * 30 = 100
+    estimator.AddSample(30, 1);
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() == 100);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout(10) == 100 + 253);
+
+    // Steady samples shrink the variance until the timer granularity dominates
+    for (int i = 0; i < 100; i++)
+    {
+        estimator.AddSample(100, 1);
+    }
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() == 100);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout(10) == 110);
+}
+
+static void TestWRMPRttEstimator_KarnsRule(nlTestSuite * inSuite, void * inContext)
+{
+    WRMPRttEstimator estimator;
+
+    NL_TEST_ASSERT(inSuite, WRMPRttEstimator::IsSampleValid(1));
+    NL_TEST_ASSERT(inSuite, !WRMPRttEstimator::IsSampleValid(0));
+    NL_TEST_ASSERT(inSuite, !WRMPRttEstimator::IsSampleValid(2));
+
+    // A retransmitted message gives no first sample
+    NL_TEST_ASSERT(inSuite, !estimator.AddSample(100, 2));
+    NL_TEST_ASSERT(inSuite, !estimator.HasSample());
+
+    // nor changes an existing estimate
+    estimator.AddSample(100, 1);
+    NL_TEST_ASSERT(inSuite, !estimator.AddSample(5000, 3));
+    NL_TEST_ASSERT(inSuite, estimator.GetSmoothedRtt() == 100);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout(10) == 300);
+}
+
+static void TestWRMPRttEstimator_Clamp(nlTestSuite * inSuite, void * inContext)
+{
+    WRMPRttEstimator estimator;
+
+    // RTO 30 ms is raised to the minimum, then doubled per retransmission up to the maximum
+    estimator.AddSample(10, 1);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout(10) == 30);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout(10, 200, 1000, 0) == 200);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout(10, 200, 1000, 1) == 200);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout(10, 200, 1000, 2) == 400);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout(10, 200, 1000, 3) == 800);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout(10, 200, 1000, 4) == 1000);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout(10, 200, 1000, 255) == 1000);
+
+    // RTO 3000 ms is lowered to the maximum
+    estimator.Reset();
+    estimator.AddSample(1000, 1);
+    NL_TEST_ASSERT(inSuite, estimator.GetRetransTimeout(10, 200, 1000, 1) == 1000);
+}
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF_FN(TestWRMPRttEstimator_FirstSample), NL_TEST_DEF_FN(TestWRMPRttEstimator_Update),
+                                 NL_TEST_DEF_FN(TestWRMPRttEstimator_KarnsRule), NL_TEST_DEF_FN(TestWRMPRttEstimator_Clamp),
+                                 NL_TEST_SENTINEL() };
+
+int TestWRMPRttEstimator(void)
+{
+    nlTestSuite theSuite = { "CHIP WRMPRttEstimator tests", &sTests[0], NULL, NULL };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
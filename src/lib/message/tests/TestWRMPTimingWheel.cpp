@@ -0,0 +1,191 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the timing wheel that
+ *      schedules CHIP WRMP retransmissions.
+ *
+ */
+
+#include "TestMessageLayer.h"
+
+#include <message/CHIPWRMPTimingWheel.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+
+namespace {
+
+const size_t kEntryCount = 8;
+
+typedef WRMPTimingWheel<kEntryCount, 8> TestWheel;
+
+// Collects the due entries as a bit mask of their indices.
+uint32_t CollectDue(TestWheel & wheel, uint32_t now)
+{
+    uint16_t indices[kEntryCount];
+    uint32_t mask = 0;
+    size_t count  = wheel.CollectDue(now, indices);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        mask |= 1u << indices[i];
+    }
+    return mask;
+}
+
+} // namespace
+
+static void TestWRMPTimingWheel_CollectDue(nlTestSuite * inSuite, void * inContext)
+{
+    TestWheel wheel;
+
+    wheel.Init(0);
+    wheel.Schedule(0, 3);
+    wheel.Schedule(1, 5);
+    wheel.Schedule(2, 5);
+    // Shares the slot of tick 3, one turn of the wheel later
+    wheel.Schedule(3, 11);
+
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 2) == 0);
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 3) == 0x1);
+
+    // Due entries stay scheduled until the caller reschedules or cancels them
+    wheel.Cancel(0);
+    NL_TEST_ASSERT(inSuite, !wheel.IsScheduled(0));
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 6) == 0x6);
+    NL_TEST_ASSERT(inSuite, wheel.IsDue(1, 6) && wheel.IsDue(2, 6) && !wheel.IsDue(3, 6));
+
+    wheel.Cancel(1);
+    wheel.Cancel(2);
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 10) == 0);
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 11) == 0x8);
+}
+
+static void TestWRMPTimingWheel_LongGap(nlTestSuite * inSuite, void * inContext)
+{
+    TestWheel wheel;
+
+    // More ticks than the wheel has slots pass between two collections; every slot is walked once.
+    wheel.Init(0);
+    wheel.Schedule(0, 2);
+    wheel.Schedule(1, 7);
+    wheel.Schedule(2, 12);
+    wheel.Schedule(3, 30);
+
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 20) == 0x7);
+    NL_TEST_ASSERT(inSuite, !wheel.IsDue(3, 20));
+}
+
+static void TestWRMPTimingWheel_CurrentTickWalkedAgain(nlTestSuite * inSuite, void * inContext)
+{
+    TestWheel wheel;
+
+    wheel.Init(0);
+    wheel.Schedule(0, 4);
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 4) == 0x1);
+
+    // An entry scheduled for the current tick after a collection, e.g. on a throttle, is collected next time.
+    wheel.Cancel(0);
+    wheel.Schedule(5, 4);
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 4) == 0x20);
+}
+
+static void TestWRMPTimingWheel_Reschedule(nlTestSuite * inSuite, void * inContext)
+{
+    TestWheel wheel;
+
+    wheel.Init(0);
+    wheel.Schedule(4, 2);
+    wheel.Schedule(4, 9);
+
+    NL_TEST_ASSERT(inSuite, wheel.DueTick(4) == 9);
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 2) == 0);
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 9) == 0x10);
+}
+
+static void TestWRMPTimingWheel_NextDue(nlTestSuite * inSuite, void * inContext)
+{
+    TestWheel wheel;
+    uint32_t ticks = 0;
+
+    wheel.Init(0);
+    NL_TEST_ASSERT(inSuite, !wheel.GetNextDueTicks(0, ticks));
+
+    wheel.Schedule(0, 10);
+    wheel.Schedule(1, 4);
+    NL_TEST_ASSERT(inSuite, wheel.GetNextDueTicks(0, ticks) && ticks == 4);
+    NL_TEST_ASSERT(inSuite, wheel.GetNextDueTicks(1, ticks) && ticks == 3);
+
+    // An entry that is already due
+    NL_TEST_ASSERT(inSuite, wheel.GetNextDueTicks(6, ticks) && ticks == 0);
+
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 6) == 0x2);
+    wheel.Cancel(1);
+    NL_TEST_ASSERT(inSuite, wheel.GetNextDueTicks(6, ticks) && ticks == 4);
+
+    // An entry more than one turn of the wheel ahead, sharing a slot with nothing earlier
+    wheel.Cancel(0);
+    wheel.Schedule(2, 100);
+    NL_TEST_ASSERT(inSuite, wheel.GetNextDueTicks(6, ticks) && ticks == 94);
+
+    // An earlier entry in a later slot than a far one is still found
+    wheel.Schedule(3, 9);
+    NL_TEST_ASSERT(inSuite, wheel.GetNextDueTicks(6, ticks) && ticks == 3);
+}
+
+static void TestWRMPTimingWheel_Wrap(nlTestSuite * inSuite, void * inContext)
+{
+    TestWheel wheel;
+    uint32_t ticks = 0;
+
+    // The tick counter wraps around between the two deadlines
+    wheel.Init(0xFFFFFFF0);
+    wheel.Schedule(0, 0xFFFFFFFE);
+    wheel.Schedule(1, 0x00000003);
+
+    NL_TEST_ASSERT(inSuite, wheel.GetNextDueTicks(0xFFFFFFF0, ticks) && ticks == 14);
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 0xFFFFFFFF) == 0x1);
+
+    wheel.Cancel(0);
+    NL_TEST_ASSERT(inSuite, wheel.GetNextDueTicks(0xFFFFFFFF, ticks) && ticks == 4);
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 0x00000002) == 0);
+    NL_TEST_ASSERT(inSuite, CollectDue(wheel, 0x00000003) == 0x2);
+}
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF_FN(TestWRMPTimingWheel_CollectDue),
+                                 NL_TEST_DEF_FN(TestWRMPTimingWheel_LongGap),
+                                 NL_TEST_DEF_FN(TestWRMPTimingWheel_CurrentTickWalkedAgain),
+                                 NL_TEST_DEF_FN(TestWRMPTimingWheel_Reschedule),
+                                 NL_TEST_DEF_FN(TestWRMPTimingWheel_NextDue),
+                                 NL_TEST_DEF_FN(TestWRMPTimingWheel_Wrap),
+                                 NL_TEST_SENTINEL() };
+
+int TestWRMPTimingWheel(void)
+{
+    nlTestSuite theSuite = { "CHIP WRMPTimingWheel tests", &sTests[0], NULL, NULL };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,54 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *  @file
+ *    Timing helpers for the benchmarks in the unit tests. They only
+ *    read a monotonic clock; the code under test is timed in place.
+ */
+
+#ifndef CHIP_BENCHMARK_UTILS_H
+#define CHIP_BENCHMARK_UTILS_H
+
+#include <chrono>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Benchmark {
+
+/**
+ *  @return the current time of a monotonic clock, in nanoseconds from an unspecified start.
+ */
+inline uint64_t NowNs()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ *  @return the mean time, in nanoseconds, taken by each of ops operations run since startNs.
+ */
+inline uint64_t NanosecondsPerOp(uint64_t startNs, size_t ops)
+{
+    return (NowNs() - startNs) / ops;
+}
+
+} // namespace Benchmark
+} // namespace chip
+
+#endif // CHIP_BENCHMARK_UTILS_H
@@ -0,0 +1,152 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the CHIP memory arena allocator.
+ *
+ */
+
+#include <support/CHIPMemArena.h>
+
+#include <support/CHIPMem.h>
+#include <support/CodeUtils.h>
+
+#include <string.h>
+
+namespace chip {
+namespace Platform {
+
+namespace {
+
+// The most strictly aligned types an allocation may hold.
+union MaxAlign
+{
+    long long mLongLong;
+    long double mLongDouble;
+    void * mPointer;
+    void (*mFunction)(void);
+};
+
+enum
+{
+    kAlignment = alignof(MaxAlign)
+};
+
+} // namespace
+
+MemoryArena::MemoryArena(void) : mBuf(NULL), mSize(0), mUsed(0), mHighWatermark(0), mOwnedBlock(NULL) {}
+
+MemoryArena::~MemoryArena(void)
+{
+    Shutdown();
+}
+
+CHIP_ERROR MemoryArena::Init(void * buf, size_t bufSize)
+{
+    CHIP_ERROR err  = CHIP_NO_ERROR;
+    size_t lPadding = 0;
+
+    VerifyOrExit(mBuf == NULL, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(buf != NULL, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Start and end the arena on aligned addresses, so that every allocation is aligned.
+    lPadding = (kAlignment - reinterpret_cast<uintptr_t>(buf) % kAlignment) % kAlignment;
+    if (bufSize < lPadding)
+        bufSize = lPadding;
+
+    mBuf           = static_cast<uint8_t *>(buf) + lPadding;
+    mSize          = (bufSize - lPadding) - (bufSize - lPadding) % kAlignment;
+    mUsed          = 0;
+    mHighWatermark = 0;
+
+exit:
+    return err;
+}
+
+CHIP_ERROR MemoryArena::Init(size_t size)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    void * lBuf    = NULL;
+
+    VerifyOrExit(mBuf == NULL, err = CHIP_ERROR_INCORRECT_STATE);
+
+    lBuf = MemoryAlloc(size > 0 ? size : 1);
+    VerifyOrExit(lBuf != NULL, err = CHIP_ERROR_NO_MEMORY);
+
+    err = Init(lBuf, size);
+    SuccessOrExit(err);
+
+    mOwnedBlock = lBuf;
+
+exit:
+    if (err != CHIP_NO_ERROR && lBuf != NULL)
+        MemoryFree(lBuf);
+    return err;
+}
+
+void MemoryArena::Shutdown(void)
+{
+    if (mOwnedBlock != NULL)
+        MemoryFree(mOwnedBlock);
+
+    mBuf        = NULL;
+    mSize       = 0;
+    mUsed       = 0;
+    mOwnedBlock = NULL;
+}
+
+void * MemoryArena::Alloc(size_t size)
+{
+    void * lReturn = NULL;
+
+    // mSize and mUsed are multiples of kAlignment, so rounding up a size that fits still fits.
+    VerifyOrExit(size <= mSize - mUsed, );
+
+    lReturn = mBuf + mUsed;
+    mUsed += (size + kAlignment - 1) - (size + kAlignment - 1) % kAlignment;
+
+    if (mUsed > mHighWatermark)
+        mHighWatermark = mUsed;
+
+exit:
+    return lReturn;
+}
+
+void * MemoryArena::Calloc(size_t num, size_t size)
+{
+    void * lReturn = NULL;
+
+    VerifyOrExit(size == 0 || num <= SIZE_MAX / size, );
+
+    lReturn = Alloc(num * size);
+    if (lReturn != NULL)
+        memset(lReturn, 0, num * size);
+
+exit:
+    return lReturn;
+}
+
+void MemoryArena::Rewind(size_t mark)
+{
+    if (mark < mUsed)
+        mUsed = mark;
+}
+
+} // namespace Platform
+} // namespace chip
@@ -0,0 +1,164 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines an arena allocator for short-lived CHIP allocations,
+ *      such as those made while processing one message or one handshake.
+ *
+ */
+
+#ifndef CHIP_MEM_ARENA_H
+#define CHIP_MEM_ARENA_H
+
+#include <core/CHIPError.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace Platform {
+
+/**
+ * @class MemoryArena
+ *
+ * @brief
+ *   A bump-pointer allocator over one block of memory. Allocations are not
+ *   freed individually: Rewind() releases everything allocated after a
+ *   mark, and Reset() releases everything at once.
+ *
+ * The block is either a buffer supplied by the caller or a single block
+ * obtained with MemoryAlloc(), so the memory used by the work drawing from
+ * the arena is bounded by its size. HighWatermark() reports the most that
+ * was ever in use, which helps size the arena.
+ *
+ * An arena is not thread-safe.
+ */
+class MemoryArena
+{
+public:
+    MemoryArena(void);
+    ~MemoryArena(void);
+
+    /**
+     *  @brief
+     *    Initialize the arena over a buffer owned by the caller.
+     *
+     *  @param[in] buf      The buffer to allocate from.
+     *  @param[in] bufSize  The size of the buffer in bytes.
+     *
+     *  @return CHIP_ERROR_INCORRECT_STATE if the arena is already initialized.
+     *          CHIP_ERROR_INVALID_ARGUMENT if buf is NULL.
+     *          CHIP_NO_ERROR otherwise.
+     */
+    CHIP_ERROR Init(void * buf, size_t bufSize);
+
+    /**
+     *  @brief
+     *    Initialize the arena over a block of \c size bytes obtained with
+     *    MemoryAlloc(), which is released by Shutdown().
+     *
+     *  @return CHIP_ERROR_INCORRECT_STATE if the arena is already initialized.
+     *          CHIP_ERROR_NO_MEMORY if the block could not be allocated.
+     *          CHIP_NO_ERROR otherwise.
+     */
+    CHIP_ERROR Init(size_t size);
+
+    /**
+     *  @brief
+     *    Release all allocations, and the arena's block if it owns one.
+     */
+    void Shutdown(void);
+
+    /**
+     *  @brief
+     *    Allocate \c size bytes, suitably aligned for any type.
+     *
+     *  @return A pointer to the memory, or NULL if the arena does not have
+     *          enough space left.
+     */
+    void * Alloc(size_t size);
+
+    /**
+     *  @brief
+     *    Allocate \c num elements of \c size bytes each, initialized to zero.
+     *
+     *  @return A pointer to the memory, or NULL if the arena does not have
+     *          enough space left.
+     */
+    void * Calloc(size_t num, size_t size);
+
+    /**
+     *  @brief
+     *    Return a mark of the current allocation point, to pass to Rewind().
+     */
+    size_t Mark(void) const { return mUsed; }
+
+    /**
+     *  @brief
+     *    Release all allocations made since \c mark was taken with Mark().
+     */
+    void Rewind(size_t mark);
+
+    /**
+     *  @brief
+     *    Release all allocations.
+     */
+    void Reset(void) { mUsed = 0; }
+
+    size_t Capacity(void) const { return mSize; }
+    size_t Used(void) const { return mUsed; }
+    size_t HighWatermark(void) const { return mHighWatermark; }
+
+private:
+    uint8_t * mBuf;
+    size_t mSize;
+    size_t mUsed;
+    size_t mHighWatermark;
+    void * mOwnedBlock; // The block from MemoryAlloc(), which mBuf may point past for alignment.
+
+    // Not defined
+    MemoryArena(const MemoryArena &);
+    MemoryArena & operator=(const MemoryArena &);
+};
+
+/**
+ * @class MemoryArenaScope
+ *
+ * @brief
+ *   Releases everything allocated from an arena during its lifetime when it
+ *   goes out of scope, e.g. at the end of handling one message.
+ */
+class MemoryArenaScope
+{
+public:
+    explicit MemoryArenaScope(MemoryArena & arena) : mArena(arena), mMark(arena.Mark()) {}
+    ~MemoryArenaScope(void) { mArena.Rewind(mMark); }
+
+private:
+    MemoryArena & mArena;
+    size_t mMark;
+
+    // Not defined
+    MemoryArenaScope(const MemoryArenaScope &);
+    MemoryArenaScope & operator=(const MemoryArenaScope &);
+};
+
+} // namespace Platform
+} // namespace chip
+
+#endif // CHIP_MEM_ARENA_H
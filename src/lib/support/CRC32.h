@@ -0,0 +1,46 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a function for computing the CRC-32 of a
+ *      buffer, as used by IEEE 802.3 and zlib.
+ *
+ */
+
+#ifndef CRC32_H_
+#define CRC32_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+
+/**
+ *  Compute the CRC-32 (reflected polynomial 0xEDB88320) of a buffer.
+ *
+ *  @param[in]  data  The data to checksum.
+ *  @param[in]  len   The length of data, in bytes.
+ *
+ *  @return  The 32-bit checksum.
+ *
+ */
+extern uint32_t CRC32(const uint8_t * data, size_t len);
+
+} // namespace chip
+
+#endif /* CRC32_H_ */
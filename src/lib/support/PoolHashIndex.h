@@ -0,0 +1,146 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *  @file
+ *    A fixed-size hash index over the slots of a statically allocated
+ *    object pool, intended to be embedded as a member next to the pool.
+ */
+
+#ifndef CHIP_POOL_HASH_INDEX_H
+#define CHIP_POOL_HASH_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+
+/**
+ *  @class PoolHashIndex
+ *
+ *  @brief
+ *    Chains the slots of a pool of kPoolSize objects into kBucketCount
+ *    hash buckets, so that an object can be found by key without walking
+ *    the whole pool.
+ *
+ *    The index only stores slot numbers; it knows nothing about the keys.
+ *    Different keys may share a bucket, so callers compare the key of
+ *    every slot in a chain. Chains are kept in slot order, which makes
+ *    walking a chain visit matching objects in the same order as walking
+ *    the pool would. No memory is allocated.
+ */
+template <size_t kPoolSize, size_t kBucketCount>
+class PoolHashIndex
+{
+public:
+    static constexpr uint16_t kInvalidIndex = UINT16_MAX;
+
+    static_assert(kPoolSize < kInvalidIndex, "pool too large for PoolHashIndex");
+    static_assert(kBucketCount > 0, "PoolHashIndex needs at least one bucket");
+
+    PoolHashIndex() { Init(); }
+
+    /**
+     *  @brief Remove every slot from the index.
+     */
+    void Init()
+    {
+        for (size_t i = 0; i < kBucketCount; i++)
+        {
+            mHeads[i] = kInvalidIndex;
+        }
+        for (size_t i = 0; i < kPoolSize; i++)
+        {
+            mNext[i]   = kInvalidIndex;
+            mBucket[i] = kInvalidIndex;
+        }
+    }
+
+    /**
+     *  @brief Add a slot to the bucket for a hash, removing it from any bucket it was in.
+     */
+    void Link(uint16_t index, uint32_t hash)
+    {
+        const uint16_t bucket = static_cast<uint16_t>(hash % kBucketCount);
+        uint16_t * link       = &mHeads[bucket];
+
+        Unlink(index);
+
+        while (*link != kInvalidIndex && *link < index)
+        {
+            link = &mNext[*link];
+        }
+
+        mNext[index]   = *link;
+        mBucket[index] = bucket;
+        *link          = index;
+    }
+
+    /**
+     *  @brief Remove a slot from the index. Does nothing if the slot is not linked.
+     */
+    void Unlink(uint16_t index)
+    {
+        uint16_t * link;
+
+        if (mBucket[index] == kInvalidIndex)
+        {
+            return;
+        }
+
+        link = &mHeads[mBucket[index]];
+        while (*link != index)
+        {
+            link = &mNext[*link];
+        }
+
+        *link          = mNext[index];
+        mNext[index]   = kInvalidIndex;
+        mBucket[index] = kInvalidIndex;
+    }
+
+    bool IsLinked(uint16_t index) const { return mBucket[index] != kInvalidIndex; }
+
+    /**
+     *  @brief Return the first slot in the bucket for a hash, or kInvalidIndex if the bucket is empty.
+     */
+    uint16_t First(uint32_t hash) const { return mHeads[hash % kBucketCount]; }
+
+    /**
+     *  @brief Return the slot after index in its bucket, or kInvalidIndex at the end of the chain.
+     */
+    uint16_t Next(uint16_t index) const { return mNext[index]; }
+
+    /**
+     *  @brief Fold a value into a running hash.
+     */
+    static uint32_t Combine(uint32_t hash, uint64_t value)
+    {
+        hash ^= static_cast<uint32_t>(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= static_cast<uint32_t>(value >> 32) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+private:
+    uint16_t mHeads[kBucketCount];
+    uint16_t mNext[kPoolSize];
+    uint16_t mBucket[kPoolSize];
+};
+
+} // namespace chip
+
+#endif // CHIP_POOL_HASH_INDEX_H
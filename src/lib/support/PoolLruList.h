@@ -0,0 +1,153 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *  @file
+ *    A recency list over the slots of a statically allocated object pool,
+ *    intended to be embedded as a member next to the pool.
+ */
+
+#ifndef CHIP_POOL_LRU_LIST_H
+#define CHIP_POOL_LRU_LIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+
+/**
+ *  @class PoolLruList
+ *
+ *  @brief
+ *    Orders the slots of a pool of kPoolSize objects from most to least
+ *    recently used, as a doubly linked list of slot numbers, so that a slot
+ *    can be marked as used and the least recently used slot can be found in
+ *    constant time. Slots that are not in the list are unused. No memory is
+ *    allocated.
+ */
+template <size_t kPoolSize>
+class PoolLruList
+{
+public:
+    static constexpr uint16_t kInvalidIndex = UINT16_MAX;
+
+    static_assert(kPoolSize < kInvalidIndex, "pool too large for PoolLruList");
+
+    PoolLruList() { Init(); }
+
+    /**
+     *  @brief Remove every slot from the list.
+     */
+    void Init()
+    {
+        mHead = kInvalidIndex;
+        mTail = kInvalidIndex;
+        for (size_t i = 0; i < kPoolSize; i++)
+        {
+            mPrev[i] = kInvalidIndex;
+            mNext[i] = kInvalidIndex;
+        }
+    }
+
+    /**
+     *  @brief Make a slot the most recently used one, adding it to the list if it is not in it.
+     */
+    void Touch(uint16_t index)
+    {
+        if (mHead == index)
+        {
+            return;
+        }
+
+        Remove(index);
+
+        mNext[index] = mHead;
+        if (mHead != kInvalidIndex)
+        {
+            mPrev[mHead] = index;
+        }
+        else
+        {
+            mTail = index;
+        }
+        mHead = index;
+    }
+
+    /**
+     *  @brief Remove a slot from the list. Does nothing if the slot is not in the list.
+     */
+    void Remove(uint16_t index)
+    {
+        if (!Contains(index))
+        {
+            return;
+        }
+
+        if (mPrev[index] != kInvalidIndex)
+        {
+            mNext[mPrev[index]] = mNext[index];
+        }
+        else
+        {
+            mHead = mNext[index];
+        }
+
+        if (mNext[index] != kInvalidIndex)
+        {
+            mPrev[mNext[index]] = mPrev[index];
+        }
+        else
+        {
+            mTail = mPrev[index];
+        }
+
+        mPrev[index] = kInvalidIndex;
+        mNext[index] = kInvalidIndex;
+    }
+
+    bool Contains(uint16_t index) const { return mHead == index || mPrev[index] != kInvalidIndex; }
+
+    /**
+     *  @brief Return the most recently used slot, or kInvalidIndex if the list is empty.
+     */
+    uint16_t MostRecent() const { return mHead; }
+
+    /**
+     *  @brief Return the least recently used slot, or kInvalidIndex if the list is empty.
+     */
+    uint16_t LeastRecent() const { return mTail; }
+
+    /**
+     *  @brief Return the slot used just before index, or kInvalidIndex if index is the least recently used slot.
+     */
+    uint16_t Older(uint16_t index) const { return mNext[index]; }
+
+    /**
+     *  @brief Return the slot used just after index, or kInvalidIndex if index is the most recently used slot.
+     */
+    uint16_t Newer(uint16_t index) const { return mPrev[index]; }
+
+private:
+    uint16_t mHead;
+    uint16_t mTail;
+    uint16_t mPrev[kPoolSize];
+    uint16_t mNext[kPoolSize];
+};
+
+} // namespace chip
+
+#endif // CHIP_POOL_LRU_LIST_H
@@ -0,0 +1,158 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *  @file
+ *    A fixed-size open addressing hash index, intended to be embedded as
+ *    a member next to the objects it indexes.
+ */
+
+#ifndef CHIP_PROBE_HASH_INDEX_H
+#define CHIP_PROBE_HASH_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <support/CodeUtils.h>
+
+namespace chip {
+
+/**
+ *  @brief Mix the bits of a value with the 64-bit finalizer of MurmurHash3, so that nearby keys (consecutive ids,
+ *  neighbouring pointers) spread across buckets.
+ */
+inline size_t MixHash(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return static_cast<size_t>(value);
+}
+
+/**
+ *  @return the smallest power of two no less than count.
+ */
+constexpr size_t ProbeHashIndexSize(size_t count, size_t size = 1)
+{
+    return (size >= count) ? size : ProbeHashIndexSize(count, size << 1);
+}
+
+/**
+ *  @class ProbeHashIndex
+ *
+ *  @brief
+ *    Indexes up to kMaxEntries entries (slot numbers, pointers) by a
+ *    hash of their key, using linear probing in a table kept at most half
+ *    full. kEmpty is a value no entry ever takes.
+ *
+ *    The index only stores entries; it knows nothing about the keys.
+ *    Different keys may share a bucket, so lookups compare the key of
+ *    every entry they visit. Removal shifts the entries that follow back
+ *    instead of leaving tombstones, which needs the hash of each entry, so
+ *    the key of an entry must not change while it is indexed. No memory
+ *    is allocated.
+ */
+template <typename Entry, size_t kMaxEntries, Entry kEmpty>
+class ProbeHashIndex
+{
+public:
+    static constexpr size_t kSize = ProbeHashIndexSize(2 * kMaxEntries);
+
+    ProbeHashIndex() { Clear(); }
+
+    /**
+     *  @brief Remove every entry from the index.
+     */
+    void Clear()
+    {
+        for (size_t i = 0; i < kSize; i++)
+        {
+            mBuckets[i] = kEmpty;
+        }
+    }
+
+    /**
+     *  @brief Add an entry with the given hash. The index must not already hold kMaxEntries entries.
+     */
+    void Insert(size_t hash, Entry entry)
+    {
+        size_t bucket = hash & kMask;
+
+        while (mBuckets[bucket] != kEmpty)
+        {
+            bucket = (bucket + 1) & kMask;
+        }
+        mBuckets[bucket] = entry;
+    }
+
+    /**
+     *  @brief Return the first entry with the given hash for which match(entry) is true, or kEmpty if there is none.
+     */
+    template <typename MatchFunct>
+    Entry Find(size_t hash, MatchFunct match) const
+    {
+        for (size_t bucket = hash & kMask; mBuckets[bucket] != kEmpty; bucket = (bucket + 1) & kMask)
+        {
+            if (match(mBuckets[bucket]))
+            {
+                return mBuckets[bucket];
+            }
+        }
+        return kEmpty;
+    }
+
+    /**
+     *  @brief Remove an entry that was inserted with the given hash. hashOf(entry) must return the hash each indexed
+     *  entry was inserted with.
+     */
+    template <typename HashFunct>
+    void Remove(size_t hash, Entry entry, HashFunct hashOf)
+    {
+        size_t hole = hash & kMask;
+
+        while (mBuckets[hole] != entry)
+        {
+            VerifyOrDie(mBuckets[hole] != kEmpty);
+            hole = (hole + 1) & kMask;
+        }
+
+        for (size_t next = (hole + 1) & kMask; mBuckets[next] != kEmpty; next = (next + 1) & kMask)
+        {
+            const size_t home = hashOf(mBuckets[next]) & kMask;
+
+            // The entry at 'next' may move into the hole only if its home bucket is not
+            // located (cyclically) in the range (hole, next].
+            if (((next - home) & kMask) >= ((next - hole) & kMask))
+            {
+                mBuckets[hole] = mBuckets[next];
+                hole           = next;
+            }
+        }
+        mBuckets[hole] = kEmpty;
+    }
+
+private:
+    static constexpr size_t kMask = kSize - 1;
+
+    Entry mBuckets[kSize];
+};
+
+} // namespace chip
+
+#endif // CHIP_PROBE_HASH_INDEX_H
@@ -33,6 +33,7 @@
 
 #include <nlunit-test.h>
 #include <support/CHIPMem.h>
+#include <support/CHIPMemArena.h>
 #include <support/CodeUtils.h>
 
 using namespace chip;
@@ -96,12 +97,80 @@ static void TestMemAlloc_Realloc(nlTestSuite * inSuite, void * inContext)
     chip::Platform::MemoryFree(pb);
 }
 
+static void TestMemArena_Alloc(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t buf[256 + 1];
+    MemoryArena arena;
+
+    // Allocations are aligned even when the buffer is not
+    NL_TEST_ASSERT(inSuite, arena.Init(buf + 1, sizeof(buf) - 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, arena.Init(buf, sizeof(buf)) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(inSuite, arena.Capacity() <= 256 && arena.Capacity() >= 256 - 2 * sizeof(long double));
+
+    char * p1 = (char *) arena.Alloc(3);
+    char * p2 = (char *) arena.Alloc(5);
+    NL_TEST_ASSERT(inSuite, p1 != NULL && p2 != NULL && p2 > p1);
+    NL_TEST_ASSERT(inSuite, reinterpret_cast<uintptr_t>(p1) % sizeof(void *) == 0);
+    NL_TEST_ASSERT(inSuite, reinterpret_cast<uintptr_t>(p2) % sizeof(void *) == 0);
+    NL_TEST_ASSERT(inSuite, p1 >= (char *) buf && p2 + 5 <= (char *) buf + sizeof(buf));
+
+    // Rewinding releases only what was allocated after the mark
+    size_t mark = arena.Mark();
+    NL_TEST_ASSERT(inSuite, arena.Alloc(16) != NULL);
+    size_t highWatermark = arena.HighWatermark();
+    arena.Rewind(mark);
+    NL_TEST_ASSERT(inSuite, arena.Used() == mark);
+    NL_TEST_ASSERT(inSuite, arena.HighWatermark() == highWatermark);
+
+    {
+        MemoryArenaScope scope(arena);
+        NL_TEST_ASSERT(inSuite, arena.Alloc(32) != NULL);
+        NL_TEST_ASSERT(inSuite, arena.Used() > mark);
+    }
+    NL_TEST_ASSERT(inSuite, arena.Used() == mark);
+
+    // Allocations past the capacity fail without changing the arena
+    NL_TEST_ASSERT(inSuite, arena.Alloc(arena.Capacity()) == NULL);
+    NL_TEST_ASSERT(inSuite, arena.Calloc(SIZE_MAX / 2, 4) == NULL);
+    NL_TEST_ASSERT(inSuite, arena.Used() == mark);
+
+    char * p3 = (char *) arena.Calloc(4, 8);
+    NL_TEST_ASSERT(inSuite, p3 != NULL);
+    for (int i = 0; p3 != NULL && i < 32; i++)
+        NL_TEST_ASSERT(inSuite, p3[i] == 0);
+
+    arena.Reset();
+    NL_TEST_ASSERT(inSuite, arena.Used() == 0);
+    NL_TEST_ASSERT(inSuite, arena.Alloc(arena.Capacity()) == p1);
+    NL_TEST_ASSERT(inSuite, arena.Alloc(1) == NULL);
+    NL_TEST_ASSERT(inSuite, arena.HighWatermark() == arena.Capacity());
+
+    arena.Shutdown();
+    NL_TEST_ASSERT(inSuite, arena.Alloc(1) == NULL);
+}
+
+static void TestMemArena_Owned(nlTestSuite * inSuite, void * inContext)
+{
+    MemoryArena arena;
+
+    NL_TEST_ASSERT(inSuite, arena.Init(128) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, arena.Capacity() == 128);
+    NL_TEST_ASSERT(inSuite, arena.Alloc(100) != NULL);
+
+    // The block is released by Shutdown(), after which the arena can be initialized again
+    arena.Shutdown();
+    NL_TEST_ASSERT(inSuite, arena.Init(64) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, arena.Alloc(64) != NULL);
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
 static const nlTest sTests[] = { NL_TEST_DEF("Test MemAlloc::Malloc", TestMemAlloc_Malloc),
                                  NL_TEST_DEF("Test MemAlloc::Calloc", TestMemAlloc_Calloc),
-                                 NL_TEST_DEF("Test MemAlloc::Realloc", TestMemAlloc_Realloc), NL_TEST_SENTINEL() };
+                                 NL_TEST_DEF("Test MemAlloc::Realloc", TestMemAlloc_Realloc),
+                                 NL_TEST_DEF("Test MemArena::Alloc", TestMemArena_Alloc),
+                                 NL_TEST_DEF("Test MemArena::Owned", TestMemArena_Owned), NL_TEST_SENTINEL() };
 
 int TestMemAlloc(void)
 {
@@ -0,0 +1,80 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for CHIP CRC32
+ *
+ */
+
+#include "TestSupport.h"
+
+#include <support/CRC32.h>
+
+#include <string.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+
+static void TestCRC32_KnownValues(nlTestSuite * inSuite, void * inContext)
+{
+    const char * check     = "123456789";
+    const uint8_t zeros[4] = { 0 };
+
+    NL_TEST_ASSERT(inSuite, CRC32(NULL, 0) == 0);
+    NL_TEST_ASSERT(inSuite, CRC32(reinterpret_cast<const uint8_t *>(check), strlen(check)) == 0xCBF43926);
+    NL_TEST_ASSERT(inSuite, CRC32(zeros, sizeof(zeros)) == 0x2144DF1C);
+}
+
+static void TestCRC32_DetectsChange(nlTestSuite * inSuite, void * inContext)
+{
+    uint8_t data[64];
+
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+
+    const uint32_t crc = CRC32(data, sizeof(data));
+
+    // Any single flipped bit changes the checksum
+    for (size_t i = 0; i < sizeof(data) * 8; i++)
+    {
+        data[i / 8] ^= static_cast<uint8_t>(1 << (i % 8));
+        NL_TEST_ASSERT(inSuite, CRC32(data, sizeof(data)) != crc);
+        data[i / 8] ^= static_cast<uint8_t>(1 << (i % 8));
+    }
+
+    NL_TEST_ASSERT(inSuite, CRC32(data, sizeof(data)) == crc);
+}
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF_FN(TestCRC32_KnownValues), NL_TEST_DEF_FN(TestCRC32_DetectsChange),
+                                 NL_TEST_SENTINEL() };
+
+int TestCRC32(void)
+{
+    nlTestSuite theSuite = { "CHIP CRC32 tests", &sTests[0], NULL, NULL };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
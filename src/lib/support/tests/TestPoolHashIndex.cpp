@@ -0,0 +1,130 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for CHIP PoolHashIndex
+ *
+ */
+
+#include "TestSupport.h"
+
+#include <support/PoolHashIndex.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+
+typedef PoolHashIndex<8, 4> TestIndex;
+
+// Collects the chain of a bucket into out, returning its length.
+static size_t Chain(const TestIndex & index, uint32_t hash, uint16_t * out, size_t maxLen)
+{
+    size_t len = 0;
+    for (uint16_t i = index.First(hash); i != index.kInvalidIndex && len < maxLen; i = index.Next(i))
+    {
+        out[len++] = i;
+    }
+    return len;
+}
+
+static void TestPoolHashIndex_Empty(nlTestSuite * inSuite, void * inContext)
+{
+    TestIndex index;
+
+    for (uint32_t hash = 0; hash < 4; hash++)
+    {
+        NL_TEST_ASSERT(inSuite, index.First(hash) == index.kInvalidIndex);
+    }
+    for (uint16_t i = 0; i < 8; i++)
+    {
+        NL_TEST_ASSERT(inSuite, !index.IsLinked(i));
+    }
+}
+
+static void TestPoolHashIndex_LinkOrder(nlTestSuite * inSuite, void * inContext)
+{
+    TestIndex index;
+    uint16_t chain[8];
+
+    // Slots linked out of order come back in slot order
+    index.Link(5, 1);
+    index.Link(2, 1);
+    index.Link(7, 5);
+    index.Link(0, 1);
+
+    NL_TEST_ASSERT(inSuite, Chain(index, 1, chain, 8) == 4);
+    NL_TEST_ASSERT(inSuite, chain[0] == 0 && chain[1] == 2 && chain[2] == 5 && chain[3] == 7);
+    NL_TEST_ASSERT(inSuite, Chain(index, 0, chain, 8) == 0);
+
+    // Linking again moves the slot to its new bucket
+    index.Link(2, 3);
+    NL_TEST_ASSERT(inSuite, Chain(index, 1, chain, 8) == 3);
+    NL_TEST_ASSERT(inSuite, chain[0] == 0 && chain[1] == 5 && chain[2] == 7);
+    NL_TEST_ASSERT(inSuite, Chain(index, 3, chain, 8) == 1);
+    NL_TEST_ASSERT(inSuite, chain[0] == 2);
+}
+
+static void TestPoolHashIndex_Unlink(nlTestSuite * inSuite, void * inContext)
+{
+    TestIndex index;
+    uint16_t chain[8];
+
+    for (uint16_t i = 0; i < 8; i++)
+    {
+        index.Link(i, 2);
+    }
+
+    index.Unlink(0);
+    index.Unlink(4);
+    index.Unlink(7);
+    index.Unlink(7);
+    NL_TEST_ASSERT(inSuite, !index.IsLinked(4));
+    NL_TEST_ASSERT(inSuite, index.IsLinked(3));
+    NL_TEST_ASSERT(inSuite, Chain(index, 2, chain, 8) == 5);
+    NL_TEST_ASSERT(inSuite, chain[0] == 1 && chain[1] == 2 && chain[2] == 3 && chain[3] == 5 && chain[4] == 6);
+
+    index.Init();
+    NL_TEST_ASSERT(inSuite, index.First(2) == index.kInvalidIndex);
+    NL_TEST_ASSERT(inSuite, !index.IsLinked(1));
+}
+
+static void TestPoolHashIndex_Combine(nlTestSuite * inSuite, void * inContext)
+{
+    // Keys that differ in either half of a 64-bit value hash differently
+    NL_TEST_ASSERT(inSuite, TestIndex::Combine(0, 1) != TestIndex::Combine(0, 2));
+    NL_TEST_ASSERT(inSuite, TestIndex::Combine(0, 1) != TestIndex::Combine(0, 1ULL << 32));
+    NL_TEST_ASSERT(inSuite, TestIndex::Combine(0, 1) != TestIndex::Combine(1, 1));
+    NL_TEST_ASSERT(inSuite, TestIndex::Combine(7, 0x123456789ULL) == TestIndex::Combine(7, 0x123456789ULL));
+}
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF_FN(TestPoolHashIndex_Empty), NL_TEST_DEF_FN(TestPoolHashIndex_LinkOrder),
+                                 NL_TEST_DEF_FN(TestPoolHashIndex_Unlink), NL_TEST_DEF_FN(TestPoolHashIndex_Combine),
+                                 NL_TEST_SENTINEL() };
+
+int TestPoolHashIndex(void)
+{
+    nlTestSuite theSuite = { "CHIP PoolHashIndex tests", &sTests[0], NULL, NULL };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
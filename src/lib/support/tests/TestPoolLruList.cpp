@@ -0,0 +1,128 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for CHIP PoolLruList
+ *
+ */
+
+#include "TestSupport.h"
+
+#include <support/PoolLruList.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+
+typedef PoolLruList<8> TestList;
+
+// Collects the list from most to least recently used into out, returning its length.
+static size_t Order(const TestList & list, uint16_t * out, size_t maxLen)
+{
+    size_t len = 0;
+    for (uint16_t i = list.MostRecent(); i != list.kInvalidIndex && len < maxLen; i = list.Older(i))
+    {
+        out[len++] = i;
+    }
+    return len;
+}
+
+static void TestPoolLruList_Empty(nlTestSuite * inSuite, void * inContext)
+{
+    TestList list;
+
+    NL_TEST_ASSERT(inSuite, list.MostRecent() == list.kInvalidIndex);
+    NL_TEST_ASSERT(inSuite, list.LeastRecent() == list.kInvalidIndex);
+    for (uint16_t i = 0; i < 8; i++)
+    {
+        NL_TEST_ASSERT(inSuite, !list.Contains(i));
+    }
+}
+
+static void TestPoolLruList_Touch(nlTestSuite * inSuite, void * inContext)
+{
+    TestList list;
+    uint16_t order[8];
+
+    list.Touch(3);
+    NL_TEST_ASSERT(inSuite, list.MostRecent() == 3 && list.LeastRecent() == 3);
+    NL_TEST_ASSERT(inSuite, list.Contains(3));
+
+    list.Touch(5);
+    list.Touch(0);
+    NL_TEST_ASSERT(inSuite, Order(list, order, 8) == 3);
+    NL_TEST_ASSERT(inSuite, order[0] == 0 && order[1] == 5 && order[2] == 3);
+    NL_TEST_ASSERT(inSuite, list.LeastRecent() == 3);
+
+    // Touching a slot in the middle or at the tail moves it to the front
+    list.Touch(5);
+    NL_TEST_ASSERT(inSuite, Order(list, order, 8) == 3);
+    NL_TEST_ASSERT(inSuite, order[0] == 5 && order[1] == 0 && order[2] == 3);
+    list.Touch(3);
+    NL_TEST_ASSERT(inSuite, Order(list, order, 8) == 3);
+    NL_TEST_ASSERT(inSuite, order[0] == 3 && order[1] == 5 && order[2] == 0);
+    NL_TEST_ASSERT(inSuite, list.LeastRecent() == 0);
+    NL_TEST_ASSERT(inSuite, list.Newer(0) == 5 && list.Newer(3) == list.kInvalidIndex);
+
+    // Touching the front does nothing
+    list.Touch(3);
+    NL_TEST_ASSERT(inSuite, Order(list, order, 8) == 3);
+    NL_TEST_ASSERT(inSuite, order[0] == 3 && order[1] == 5 && order[2] == 0);
+}
+
+static void TestPoolLruList_Remove(nlTestSuite * inSuite, void * inContext)
+{
+    TestList list;
+    uint16_t order[8];
+
+    for (uint16_t i = 0; i < 8; i++)
+    {
+        list.Touch(i);
+    }
+
+    list.Remove(7);
+    list.Remove(0);
+    list.Remove(4);
+    list.Remove(4);
+    NL_TEST_ASSERT(inSuite, !list.Contains(4));
+    NL_TEST_ASSERT(inSuite, !list.Contains(0));
+    NL_TEST_ASSERT(inSuite, list.Contains(3));
+    NL_TEST_ASSERT(inSuite, Order(list, order, 8) == 5);
+    NL_TEST_ASSERT(inSuite, order[0] == 6 && order[1] == 5 && order[2] == 3 && order[3] == 2 && order[4] == 1);
+    NL_TEST_ASSERT(inSuite, list.MostRecent() == 6 && list.LeastRecent() == 1);
+
+    list.Init();
+    NL_TEST_ASSERT(inSuite, list.MostRecent() == list.kInvalidIndex);
+    NL_TEST_ASSERT(inSuite, !list.Contains(6));
+}
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF_FN(TestPoolLruList_Empty), NL_TEST_DEF_FN(TestPoolLruList_Touch),
+                                 NL_TEST_DEF_FN(TestPoolLruList_Remove), NL_TEST_SENTINEL() };
+
+int TestPoolLruList(void)
+{
+    nlTestSuite theSuite = { "CHIP PoolLruList tests", &sTests[0], NULL, NULL };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,113 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for CHIP ProbeHashIndex
+ *
+ */
+
+#include "TestSupport.h"
+
+#include <support/ProbeHashIndex.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+
+typedef ProbeHashIndex<uint16_t, 4, UINT16_MAX> TestIndex;
+
+// The hash each entry is inserted with; entries 1 to 3 collide, and their probe sequence wraps around the table.
+static const size_t sHashes[] = { 0, TestIndex::kSize - 1, TestIndex::kSize - 1, 2 * TestIndex::kSize - 1, 0 };
+
+static size_t HashOf(uint16_t entry)
+{
+    return sHashes[entry];
+}
+
+static uint16_t Find(const TestIndex & index, uint16_t entry)
+{
+    return index.Find(HashOf(entry), [entry](uint16_t indexed) { return indexed == entry; });
+}
+
+static void TestProbeHashIndex_Empty(nlTestSuite * inSuite, void * inContext)
+{
+    TestIndex index;
+
+    NL_TEST_ASSERT(inSuite, TestIndex::kSize == 8);
+    for (uint16_t i = 0; i < 5; i++)
+    {
+        NL_TEST_ASSERT(inSuite, Find(index, i) == UINT16_MAX);
+    }
+}
+
+static void TestProbeHashIndex_Collisions(nlTestSuite * inSuite, void * inContext)
+{
+    TestIndex index;
+
+    for (uint16_t i = 1; i <= 4; i++)
+    {
+        index.Insert(HashOf(i), i);
+    }
+    for (uint16_t i = 1; i <= 4; i++)
+    {
+        NL_TEST_ASSERT(inSuite, Find(index, i) == i);
+    }
+    NL_TEST_ASSERT(inSuite, Find(index, 0) == UINT16_MAX);
+
+    // Entries after a removed one are shifted back, across the end of the table, and stay reachable
+    index.Remove(HashOf(1), 1, HashOf);
+    NL_TEST_ASSERT(inSuite, Find(index, 1) == UINT16_MAX);
+    NL_TEST_ASSERT(inSuite, Find(index, 2) == 2 && Find(index, 3) == 3 && Find(index, 4) == 4);
+
+    index.Remove(HashOf(3), 3, HashOf);
+    NL_TEST_ASSERT(inSuite, Find(index, 3) == UINT16_MAX);
+    NL_TEST_ASSERT(inSuite, Find(index, 2) == 2 && Find(index, 4) == 4);
+
+    index.Insert(HashOf(1), 1);
+    NL_TEST_ASSERT(inSuite, Find(index, 1) == 1 && Find(index, 2) == 2 && Find(index, 4) == 4);
+
+    index.Clear();
+    for (uint16_t i = 1; i <= 4; i++)
+    {
+        NL_TEST_ASSERT(inSuite, Find(index, i) == UINT16_MAX);
+    }
+}
+
+static void TestProbeHashIndex_MixHash(nlTestSuite * inSuite, void * inContext)
+{
+    // Keys that differ in a single bit, in either half, hash differently
+    NL_TEST_ASSERT(inSuite, MixHash(1) != MixHash(3));
+    NL_TEST_ASSERT(inSuite, MixHash(1) != MixHash(1ULL << 32));
+    NL_TEST_ASSERT(inSuite, MixHash(0x123456789ULL) == MixHash(0x123456789ULL));
+}
+
+#define NL_TEST_DEF_FN(fn) NL_TEST_DEF("Test " #fn, fn)
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = { NL_TEST_DEF_FN(TestProbeHashIndex_Empty), NL_TEST_DEF_FN(TestProbeHashIndex_Collisions),
+                                 NL_TEST_DEF_FN(TestProbeHashIndex_MixHash), NL_TEST_SENTINEL() };
+
+int TestProbeHashIndex(void)
+{
+    nlTestSuite theSuite = { "CHIP ProbeHashIndex tests", &sTests[0], NULL, NULL };
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
@@ -30,10 +30,14 @@ extern "C" {
 #endif
 
 int TestCHIPArgParser(void);
+int TestCRC32(void);
 int TestErrorStr(void);
 int TestTimeUtils(void);
 int TestMemAlloc(void);
 int TestBufBound(void);
+int TestPoolHashIndex(void);
+int TestPoolLruList(void);
+int TestProbeHashIndex(void);
 
 #ifdef __cplusplus
 }
@@ -68,6 +68,65 @@
 #define CHIP_DEVICE_LAYER_BLE_CONN_CFG_TAG 1
 #endif // CHIP_DEVICE_LAYER_BLE_CONN_CFG_TAG
 
+/**
+ * @def CHIP_DEVICE_CONFIG_LINUX_STORAGE_SYNC_INTERVAL_MS
+ *
+ * The minimum time between two syncs of a storage write-ahead log to disk.
+ * With 0, every commit is synced before it returns and survives a power loss.
+ * With a larger value, a commit made less than the interval after the last
+ * sync is not synced itself; it is synced by the first commit made once the
+ * interval has passed, by a compaction, or when the storage is closed. There
+ * is no timer, so until then it may be lost on power loss however long ago
+ * it was made. Commits survive a crash of the process either way.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_STORAGE_SYNC_INTERVAL_MS
+#define CHIP_DEVICE_CONFIG_LINUX_STORAGE_SYNC_INTERVAL_MS 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_STORAGE_SYNC_INTERVAL_MS
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LINUX_STORAGE_COMPACT_THRESHOLD
+ *
+ * The size, in bytes, a storage write-ahead log may reach before it is
+ * folded into the INI file and emptied.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_STORAGE_COMPACT_THRESHOLD
+#define CHIP_DEVICE_CONFIG_LINUX_STORAGE_COMPACT_THRESHOLD 16384
+#endif // CHIP_DEVICE_CONFIG_LINUX_STORAGE_COMPACT_THRESHOLD
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
+ *
+ * Keep the device configuration in memory-mapped binary files
+ * (ChipLinuxStorageMmap) instead of INI files (ChipLinuxStorage). Opening
+ * them needs no parsing, and values are read without allocating or
+ * decoding. The factory values are imported from the factory INI file,
+ * as written by manufacturing tools, when its binary file is first
+ * created; other existing INI files are not converted.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
+#define CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP 0
+#endif // CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_NUM_ENTRIES
+ *
+ * The number of values each memory-mapped configuration file can hold.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_NUM_ENTRIES
+#define CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_NUM_ENTRIES 64
+#endif // CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_NUM_ENTRIES
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_ENTRY_SIZE
+ *
+ * The size, in bytes, of each copy of a value in a memory-mapped
+ * configuration file, including a 64-byte header that holds its key.
+ * Keeping it at the page size lets each update touch a single page.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_ENTRY_SIZE
+#define CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_ENTRY_SIZE 4096
+#endif // CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_ENTRY_SIZE
+
 // ========== Platform-specific Configuration Overrides =========
 
 #ifndef CHIP_DEVICE_CONFIG_CHIP_TASK_STACK_SIZE
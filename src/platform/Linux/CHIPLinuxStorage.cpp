@@ -24,16 +24,21 @@
  */
 
 #include <errno.h>
+#include <fcntl.h>
 #include <fstream>
 #include <inttypes.h>
 #include <libgen.h>
+#include <string.h>
 #include <string>
+#include <sys/stat.h>
 #include <unistd.h>
 
+#include <core/CHIPEncoding.h>
 #include <platform/Linux/CHIPLinuxStorage.h>
 #include <platform/internal/CHIPDeviceLayerInternal.h>
 #include <support/Base64.h>
 #include <support/CHIPMem.h>
+#include <support/CRC32.h>
 #include <support/CodeUtils.h>
 #include <support/logging/CHIPLogging.h>
 
@@ -41,18 +46,59 @@ namespace chip {
 namespace DeviceLayer {
 namespace Internal {
 
+// Write-ahead log records are laid out as:
+//
+//   checksum (4 bytes, little-endian)   CRC-32 of the rest of the record
+//   length   (4 bytes, little-endian)   number of bytes that follow
+//   op       (1 byte)                   kLogOp_Set, kLogOp_Remove or kLogOp_ClearAll
+//   key length (2 bytes, little-endian) 0 for kLogOp_ClearAll
+//   key
+//   value    (the remaining bytes, kLogOp_Set only)
+//
+// A record that is cut short or fails its checksum marks the end of the log; it is the remainder of a write that was
+// interrupted by a crash and is discarded.
+enum
+{
+    kLogOp_Set      = 1,
+    kLogOp_Remove   = 2,
+    kLogOp_ClearAll = 3,
+
+    kLogRecordHeaderSize = 8,
+    kLogRecordMinLength  = 3,
+};
+
+// Whether a change fits in the length fields of a log record.
+static bool IsLoggable(const char * key, const char * value)
+{
+    size_t keyLen   = strlen(key);
+    size_t valueLen = (value != NULL) ? strlen(value) : 0;
+
+    return keyLen <= UINT16_MAX && valueLen <= UINT32_MAX - kLogRecordMinLength - keyLen;
+}
+
 ChipLinuxStorage::ChipLinuxStorage()
 {
-    mDirty = false;
+    mLogFd          = -1;
+    mLogSize        = 0;
+    mLogSynced      = true;
+    mSyncIntervalMs = CHIP_DEVICE_CONFIG_LINUX_STORAGE_SYNC_INTERVAL_MS;
+    mLastSyncMs     = 0;
 }
 
-ChipLinuxStorage::~ChipLinuxStorage() {}
+ChipLinuxStorage::~ChipLinuxStorage()
+{
+    CloseLog();
+}
 
 CHIP_ERROR ChipLinuxStorage::Init(const char * configFile)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
 
+    CloseLog();
+    mPendingRecords.clear();
+
     mConfigPath.assign(configFile);
+    mLogPath.assign(mConfigPath).append(".log");
     retval = ChipLinuxStorageIni::Init();
 
     if (retval == CHIP_NO_ERROR)
@@ -64,9 +110,7 @@ CHIP_ERROR ChipLinuxStorage::Init(const char * configFile)
         // Create default setting file if not exist.
         if (!ifs.good())
         {
-            mDirty = true;
-            retval = Commit();
-            mDirty = false;
+            retval = ChipLinuxStorageIni::CommitConfig(mConfigPath);
         }
     }
 
@@ -75,9 +119,27 @@ CHIP_ERROR ChipLinuxStorage::Init(const char * configFile)
         retval = ChipLinuxStorageIni::AddConfig(mConfigPath);
     }
 
+    // Apply the changes logged since the INI file was last written.
+    if (retval == CHIP_NO_ERROR)
+    {
+        retval = OpenLog();
+    }
+
     return retval;
 }
 
+/**
+ *  Set the minimum time between two syncs of the write-ahead log. See CHIP_DEVICE_CONFIG_LINUX_STORAGE_SYNC_INTERVAL_MS.
+ */
+void ChipLinuxStorage::SetSyncInterval(uint32_t syncIntervalMs)
+{
+    mLock.lock();
+
+    mSyncIntervalMs = syncIntervalMs;
+
+    mLock.unlock();
+}
+
 CHIP_ERROR ChipLinuxStorage::ReadValue(const char * key, bool & val)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
@@ -183,11 +245,19 @@ CHIP_ERROR ChipLinuxStorage::WriteValueStr(const char * key, const char * val)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
 
+    if (!IsLoggable(key, val))
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
     mLock.lock();
 
     retval = ChipLinuxStorageIni::AddEntry(key, val);
 
-    mDirty = true;
+    if (retval == CHIP_NO_ERROR)
+    {
+        QueueLogRecord(kLogOp_Set, key, val);
+    }
 
     mLock.unlock();
 
@@ -246,13 +316,18 @@ CHIP_ERROR ChipLinuxStorage::ClearValue(const char * key)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
 
+    if (!IsLoggable(key, NULL))
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
     mLock.lock();
 
     retval = ChipLinuxStorageIni::RemoveEntry(key);
 
     if (retval == CHIP_NO_ERROR)
     {
-        mDirty = true;
+        QueueLogRecord(kLogOp_Remove, key, NULL);
     }
     else
     {
@@ -264,25 +339,33 @@ CHIP_ERROR ChipLinuxStorage::ClearValue(const char * key)
     return retval;
 }
 
+/**
+ *  Remove all values and commit the removal. A record of it is appended to the write-ahead log, and synced, before the
+ *  empty INI file replaces the old one, so that a crash before the log is emptied cannot bring the old values back.
+ */
 CHIP_ERROR ChipLinuxStorage::ClearAll(void)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
 
     mLock.lock();
 
-    retval = ChipLinuxStorageIni::RemoveAll();
+    VerifyOrExit(ChipLinuxStorageIni::RemoveAll() == CHIP_NO_ERROR, retval = CHIP_ERROR_WRITE_FAILED);
+    VerifyOrExit(!mConfigPath.empty() && mLogFd >= 0, retval = CHIP_ERROR_WRITE_FAILED);
 
-    mLock.unlock();
+    // The changes not committed yet are removed as well.
+    mPendingRecords.clear();
+    QueueLogRecord(kLogOp_ClearAll, "", NULL);
 
-    if (retval == CHIP_NO_ERROR)
-    {
-        mDirty = true;
-        retval = Commit();
-    }
-    else
-    {
-        retval = CHIP_ERROR_WRITE_FAILED;
-    }
+    retval = AppendPendingRecords();
+    SuccessOrExit(retval);
+
+    retval = SyncLog();
+    SuccessOrExit(retval);
+
+    retval = Compact();
+
+exit:
+    mLock.unlock();
 
     return retval;
 }
@@ -300,26 +383,227 @@ bool ChipLinuxStorage::HasValue(const char * key)
     return retval;
 }
 
+/**
+ *  Append the changes made since the last call to the write-ahead log, with a single write, and sync the log as
+ *  allowed by the sync interval. Folds the log into the INI file once it has grown past
+ *  CHIP_DEVICE_CONFIG_LINUX_STORAGE_COMPACT_THRESHOLD bytes.
+ */
 CHIP_ERROR ChipLinuxStorage::Commit(void)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
 
-    if (mDirty && !mConfigPath.empty())
+    mLock.lock();
+
+    VerifyOrExit(!mConfigPath.empty() && mLogFd >= 0, retval = CHIP_ERROR_WRITE_FAILED);
+    VerifyOrExit(!mPendingRecords.empty(), );
+
+    retval = AppendPendingRecords();
+    SuccessOrExit(retval);
+
+    if (mLogSize >= CHIP_DEVICE_CONFIG_LINUX_STORAGE_COMPACT_THRESHOLD)
+    {
+        retval = Compact();
+    }
+    else if (mSyncIntervalMs == 0 || System::Layer::GetClock_MonotonicMS() - mLastSyncMs >= mSyncIntervalMs)
+    {
+        retval = SyncLog();
+    }
+
+exit:
+    mLock.unlock();
+
+    return retval;
+}
+
+// Append the queued records to the write-ahead log, with a single write, without syncing it.
+CHIP_ERROR ChipLinuxStorage::AppendPendingRecords(void)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+    size_t written    = 0;
+
+    while (written < mPendingRecords.size())
     {
-        mLock.lock();
+        ssize_t res = write(mLogFd, mPendingRecords.data() + written, mPendingRecords.size() - written);
+        if (res < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (res <= 0)
+        {
+            ChipLogError(DeviceLayer, "failed to append to log (%s), %s (%d)", mLogPath.c_str(), strerror(errno), errno);
+
+            // Drop the partial record so that it does not hide the records appended after it.
+            if (ftruncate(mLogFd, static_cast<off_t>(mLogSize)) != 0)
+            {
+                CloseLog();
+            }
+            ExitNow(retval = CHIP_ERROR_WRITE_FAILED);
+        }
+        written += static_cast<size_t>(res);
+    }
+
+    mLogSize += mPendingRecords.size();
+    mLogSynced = false;
+    mPendingRecords.clear();
 
-        retval = ChipLinuxStorageIni::CommitConfig(mConfigPath);
+exit:
+    return retval;
+}
 
-        mLock.unlock();
+void ChipLinuxStorage::QueueLogRecord(uint8_t op, const char * key, const char * value)
+{
+    size_t keyLen     = strlen(key);
+    size_t valueLen   = (value != NULL) ? strlen(value) : 0;
+    size_t recordSize = kLogRecordHeaderSize + kLogRecordMinLength + keyLen + valueLen;
+    size_t start      = mPendingRecords.size();
+    uint8_t * p;
+
+    mPendingRecords.resize(start + recordSize);
+    p = reinterpret_cast<uint8_t *>(&mPendingRecords[start]);
+
+    Encoding::LittleEndian::Put32(p + 4, static_cast<uint32_t>(recordSize - kLogRecordHeaderSize));
+    p[kLogRecordHeaderSize] = op;
+    Encoding::LittleEndian::Put16(p + kLogRecordHeaderSize + 1, static_cast<uint16_t>(keyLen));
+    memcpy(p + kLogRecordHeaderSize + kLogRecordMinLength, key, keyLen);
+    if (valueLen != 0)
+    {
+        memcpy(p + kLogRecordHeaderSize + kLogRecordMinLength + keyLen, value, valueLen);
     }
-    else
+    Encoding::LittleEndian::Put32(p, CRC32(p + 4, recordSize - 4));
+}
+
+// Open the write-ahead log, apply its records on top of the INI file just loaded and drop any torn record at its end.
+CHIP_ERROR ChipLinuxStorage::OpenLog(void)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+    std::string contents;
+    size_t offset = 0;
+    struct stat st;
+
+    mLogFd = open(mLogPath.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    if (mLogFd < 0)
+    {
+        ChipLogError(DeviceLayer, "failed to open log (%s), %s (%d)", mLogPath.c_str(), strerror(errno), errno);
+        ExitNow(retval = CHIP_ERROR_OPEN_FAILED);
+    }
+
+    VerifyOrExit(fstat(mLogFd, &st) == 0, retval = CHIP_ERROR_OPEN_FAILED);
+    contents.resize(static_cast<size_t>(st.st_size));
+    VerifyOrExit(pread(mLogFd, &contents[0], contents.size(), 0) == static_cast<ssize_t>(contents.size()),
+                 retval = CHIP_ERROR_OPEN_FAILED);
+
+    while (contents.size() - offset >= kLogRecordHeaderSize)
+    {
+        const uint8_t * p = reinterpret_cast<const uint8_t *>(contents.data()) + offset;
+        uint32_t length   = Encoding::LittleEndian::Get32(p + 4);
+        uint16_t keyLen;
+
+        if (length < kLogRecordMinLength || length > contents.size() - offset - kLogRecordHeaderSize ||
+            Encoding::LittleEndian::Get32(p) != CRC32(p + 4, length + 4))
+        {
+            break;
+        }
+
+        keyLen = Encoding::LittleEndian::Get16(p + kLogRecordHeaderSize + 1);
+        if (keyLen > length - kLogRecordMinLength)
+        {
+            break;
+        }
+
+        {
+            const char * entry = reinterpret_cast<const char *>(p + kLogRecordHeaderSize + kLogRecordMinLength);
+            std::string key(entry, keyLen);
+
+            if (p[kLogRecordHeaderSize] == kLogOp_Set)
+            {
+                std::string value(entry + keyLen, length - kLogRecordMinLength - keyLen);
+                ChipLinuxStorageIni::AddEntry(key.c_str(), value.c_str());
+            }
+            else if (p[kLogRecordHeaderSize] == kLogOp_ClearAll)
+            {
+                ChipLinuxStorageIni::RemoveAll();
+            }
+            else
+            {
+                ChipLinuxStorageIni::RemoveEntry(key.c_str());
+            }
+        }
+
+        offset += kLogRecordHeaderSize + length;
+    }
+
+    if (offset != contents.size())
+    {
+        ChipLogError(DeviceLayer, "discarding %u bytes at the end of log (%s)", static_cast<unsigned>(contents.size() - offset),
+                     mLogPath.c_str());
+        VerifyOrExit(ftruncate(mLogFd, static_cast<off_t>(offset)) == 0, retval = CHIP_ERROR_WRITE_FAILED);
+    }
+
+    mLogSize   = offset;
+    mLogSynced = true;
+
+exit:
+    if (retval != CHIP_NO_ERROR)
+    {
+        CloseLog();
+    }
+    return retval;
+}
+
+CHIP_ERROR ChipLinuxStorage::SyncLog(void)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+
+    VerifyOrExit(!mLogSynced, );
+
+    if (fdatasync(mLogFd) != 0)
+    {
+        ChipLogError(DeviceLayer, "failed to sync log (%s), %s (%d)", mLogPath.c_str(), strerror(errno), errno);
+        ExitNow(retval = CHIP_ERROR_WRITE_FAILED);
+    }
+
+    mLogSynced  = true;
+    mLastSyncMs = System::Layer::GetClock_MonotonicMS();
+
+exit:
+    return retval;
+}
+
+// Write the current values to the INI file and empty the log. CommitConfig() syncs the new INI file and the directory
+// entry that makes it replace the old one, so the log is only emptied once everything it holds is safely in the INI file.
+CHIP_ERROR ChipLinuxStorage::Compact(void)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+
+    retval = ChipLinuxStorageIni::CommitConfig(mConfigPath);
+    SuccessOrExit(retval);
+
+    VerifyOrExit(mLogFd >= 0, );
+
+    if (ftruncate(mLogFd, 0) != 0)
     {
-        retval = CHIP_ERROR_WRITE_FAILED;
+        ChipLogError(DeviceLayer, "failed to truncate log (%s), %s (%d)", mLogPath.c_str(), strerror(errno), errno);
+        ExitNow(retval = CHIP_ERROR_WRITE_FAILED);
     }
 
+    mLogSize   = 0;
+    mLogSynced = false;
+    retval     = SyncLog();
+
+exit:
     return retval;
 }
 
+void ChipLinuxStorage::CloseLog(void)
+{
+    if (mLogFd >= 0)
+    {
+        SyncLog();
+        close(mLogFd);
+        mLogFd = -1;
+    }
+}
+
 } // namespace Internal
 } // namespace DeviceLayer
 } // namespace chip
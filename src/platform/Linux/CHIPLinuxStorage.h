@@ -29,6 +29,12 @@
  *
  *         ChipLinuxStorage wraps the storage class ChipLinuxStorageIni with mutex.
  *
+ *         Changes are not written to the INI file directly. Each change is
+ *         appended as a checksummed record to a write-ahead log next to it
+ *         (<config file>.log) when Commit() is called, and the log is folded
+ *         back into the INI file once it grows past
+ *         CHIP_DEVICE_CONFIG_LINUX_STORAGE_COMPACT_THRESHOLD bytes.
+ *
  */
 
 #ifndef CHIP_LINUX_STORAGE_H
@@ -36,6 +42,7 @@
 
 #include <mutex>
 #include <platform/Linux/CHIPLinuxStorageIni.h>
+#include <string>
 
 #ifndef FATCONFDIR
 #define FATCONFDIR "/tmp"
@@ -84,11 +91,25 @@ public:
     CHIP_ERROR ClearAll(void);
     CHIP_ERROR Commit(void);
     bool HasValue(const char * key);
+    void SetSyncInterval(uint32_t syncIntervalMs);
 
 private:
+    void QueueLogRecord(uint8_t op, const char * key, const char * value);
+    CHIP_ERROR AppendPendingRecords(void);
+    CHIP_ERROR OpenLog(void);
+    CHIP_ERROR SyncLog(void);
+    CHIP_ERROR Compact(void);
+    void CloseLog(void);
+
     std::mutex mLock;
-    bool mDirty;
     std::string mConfigPath;
+    std::string mLogPath;
+    std::string mPendingRecords; // Records of the changes made since the last Commit().
+    int mLogFd;
+    size_t mLogSize;
+    bool mLogSynced;
+    uint32_t mSyncIntervalMs;
+    uint64_t mLastSyncMs;
 };
 
 } // namespace Internal
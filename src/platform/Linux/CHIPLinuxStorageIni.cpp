@@ -23,7 +23,10 @@
  *
  */
 
+#include <errno.h>
+#include <fcntl.h>
 #include <fstream>
+#include <string.h>
 #include <string>
 #include <unistd.h>
 
@@ -82,15 +85,39 @@ CHIP_ERROR ChipLinuxStorageIni::AddConfig(const std::string & configFile)
     return retval;
 }
 
+// Sync the directory that holds a file, so that the file's latest rename() survives a power loss.
+static CHIP_ERROR SyncParentDirectory(const std::string & path)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+    size_t slash      = path.rfind('/');
+    std::string dir   = (slash == std::string::npos) ? "." : path.substr(0, slash == 0 ? 1 : slash);
+    int dirFd;
+
+    dirFd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0 || fsync(dirFd) != 0)
+    {
+        ChipLogError(DeviceLayer, "failed to sync directory (%s), %s (%d)", dir.c_str(), strerror(errno), errno);
+        retval = CHIP_ERROR_WRITE_FAILED;
+    }
+    if (dirFd >= 0)
+    {
+        close(dirFd);
+    }
+
+    return retval;
+}
+
 // Updating a file atomically and durably on Linux requires:
 // 1. Writing to a temporary file
 // 2. Sync'ing the temp file to commit updated data
 // 3. Using rename() to overwrite the existing file
+// 4. Sync'ing the directory to commit the rename
 CHIP_ERROR ChipLinuxStorageIni::CommitConfig(const std::string & configFile)
 {
     CHIP_ERROR retval = CHIP_NO_ERROR;
     std::ofstream ofs;
     std::string tmpPath = configFile;
+    int tmpFd;
 
     tmpPath.append(".tmp");
 
@@ -103,14 +130,30 @@ CHIP_ERROR ChipLinuxStorageIni::CommitConfig(const std::string & configFile)
         mConfigStore.generate(ofs);
         ofs.close();
 
-        if (rename(tmpPath.c_str(), configFile.c_str()) == 0)
+        // std::ofstream cannot sync, so sync the temp file through a descriptor of its own.
+        tmpFd = open(tmpPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (tmpFd < 0 || fsync(tmpFd) != 0)
         {
-            ChipLogError(DeviceLayer, "renamed tmp file to file (%s)", configFile.c_str());
+            ChipLogError(DeviceLayer, "failed to sync (%s), %s (%d)", tmpPath.c_str(), strerror(errno), errno);
+            retval = CHIP_ERROR_WRITE_FAILED;
         }
-        else
+        if (tmpFd >= 0)
         {
-            ChipLogError(DeviceLayer, "failed to rename (%s), %s (%d)", tmpPath.c_str(), strerror(errno), errno);
-            retval = CHIP_ERROR_WRITE_FAILED;
+            close(tmpFd);
+        }
+
+        if (retval == CHIP_NO_ERROR)
+        {
+            if (rename(tmpPath.c_str(), configFile.c_str()) == 0)
+            {
+                ChipLogError(DeviceLayer, "renamed tmp file to file (%s)", configFile.c_str());
+                retval = SyncParentDirectory(configFile);
+            }
+            else
+            {
+                ChipLogError(DeviceLayer, "failed to rename (%s), %s (%d)", tmpPath.c_str(), strerror(errno), errno);
+                retval = CHIP_ERROR_WRITE_FAILED;
+            }
         }
     }
     else
@@ -0,0 +1,600 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file implements a key-value store kept in a memory-mapped,
+ *         fixed-layout binary file on Linux platform.
+ *
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <core/CHIPEncoding.h>
+#include <platform/Linux/CHIPLinuxStorageMmap.h>
+#include <platform/internal/CHIPDeviceLayerInternal.h>
+#include <support/CRC32.h>
+#include <support/CodeUtils.h>
+#include <support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+using namespace chip::Encoding;
+
+// All multi-byte fields are little-endian.
+enum
+{
+    // File header, at offset 0.
+    kHeader_Magic      = 0,
+    kHeader_Version    = 4,
+    kHeader_EntrySize  = 8,
+    kHeader_NumEntries = 12,
+    kHeader_Generation = 16, // Advanced by ClearAll(); copies written under another generation are not valid.
+
+    kMagic   = 0x4D504843, // "CHPM"
+    kVersion = 2,
+
+    // Each copy of an entry.
+    kCopy_Checksum = 0, // CRC-32 of the rest of the copy, up to the end of the value.
+    kCopy_Sequence = 4, // Incremented by each write to the slot; the valid copy with the highest one is current.
+    kCopy_State    = 8,
+    kCopy_Type     = 9,
+    kCopy_KeyLen   = 10,
+    kCopy_ValueLen   = 12,
+    kCopy_Generation = 16,
+    kCopy_Key        = 20,
+    kCopy_Value      = 64,
+
+    kMaxKeyLen = kCopy_Value - kCopy_Key,
+
+    kState_Value   = 1,
+    kState_Removed = 2,
+
+    kType_Integer = 1,
+    kType_String  = 2,
+    kType_Binary  = 3,
+};
+
+static_assert(CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_ENTRY_SIZE > kCopy_Value, "entry size too small");
+
+// Hash a key with FNV-1a, mixing the result so that keys differing in their last characters spread across buckets.
+static size_t HashKey(const uint8_t * key, size_t keyLen)
+{
+    uint64_t value = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < keyLen; i++)
+    {
+        value = (value ^ key[i]) * 0x100000001b3ULL;
+    }
+    return MixHash(value);
+}
+
+ChipLinuxStorageMmap::ChipLinuxStorageMmap()
+{
+    mFd         = -1;
+    mMap        = NULL;
+    mMapSize    = 0;
+    mGeneration = 0;
+    memset(mCurrentCopy, kNoCopy, sizeof(mCurrentCopy));
+    memset(mDirtyCopies, 0, sizeof(mDirtyCopies));
+}
+
+ChipLinuxStorageMmap::~ChipLinuxStorageMmap()
+{
+    Close();
+}
+
+/**
+ *  Open the store kept in <configFile>.bin, creating it if it does not exist.
+ */
+CHIP_ERROR ChipLinuxStorageMmap::Init(const char * configFile)
+{
+    CHIP_ERROR retval     = CHIP_NO_ERROR;
+    std::string path      = std::string(configFile).append(".bin");
+    const size_t fileSize = static_cast<size_t>(kEntrySize) * (1 + 2 * kNumEntries);
+    struct stat st;
+
+    Close();
+
+    mFd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (mFd < 0)
+    {
+        ChipLogError(DeviceLayer, "failed to open file (%s), %s (%d)", path.c_str(), strerror(errno), errno);
+        ExitNow(retval = CHIP_ERROR_OPEN_FAILED);
+    }
+
+    VerifyOrExit(fstat(mFd, &st) == 0, retval = CHIP_ERROR_OPEN_FAILED);
+    if (st.st_size == 0)
+    {
+        VerifyOrExit(ftruncate(mFd, static_cast<off_t>(fileSize)) == 0, retval = CHIP_ERROR_WRITE_FAILED);
+    }
+    else if (static_cast<size_t>(st.st_size) != fileSize)
+    {
+        ChipLogError(DeviceLayer, "file (%s) has an incompatible layout", path.c_str());
+        ExitNow(retval = CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    }
+
+    mMap = static_cast<uint8_t *>(mmap(NULL, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0));
+    if (mMap == MAP_FAILED)
+    {
+        mMap = NULL;
+        ChipLogError(DeviceLayer, "failed to map file (%s), %s (%d)", path.c_str(), strerror(errno), errno);
+        ExitNow(retval = CHIP_ERROR_OPEN_FAILED);
+    }
+    mMapSize = fileSize;
+
+    if (st.st_size == 0)
+    {
+        LittleEndian::Put32(mMap + kHeader_Magic, kMagic);
+        LittleEndian::Put32(mMap + kHeader_Version, kVersion);
+        LittleEndian::Put32(mMap + kHeader_EntrySize, kEntrySize);
+        LittleEndian::Put32(mMap + kHeader_NumEntries, kNumEntries);
+        LittleEndian::Put32(mMap + kHeader_Generation, 1);
+        VerifyOrExit(msync(mMap, mMapSize, MS_SYNC) == 0, retval = CHIP_ERROR_WRITE_FAILED);
+    }
+    else if (LittleEndian::Get32(mMap + kHeader_Magic) != kMagic || LittleEndian::Get32(mMap + kHeader_Version) != kVersion ||
+             LittleEndian::Get32(mMap + kHeader_EntrySize) != kEntrySize ||
+             LittleEndian::Get32(mMap + kHeader_NumEntries) != kNumEntries)
+    {
+        ChipLogError(DeviceLayer, "file (%s) has an incompatible layout", path.c_str());
+        ExitNow(retval = CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+    }
+
+    mGeneration = LittleEndian::Get32(mMap + kHeader_Generation);
+
+    // Pick the current copy of each slot and index the slots holding a value by key. Nothing else is read until a
+    // value is asked for.
+    for (size_t slot = 0; slot < kNumEntries; slot++)
+    {
+        const uint8_t * copy0 = CopyAt(slot, 0);
+        const uint8_t * copy1 = CopyAt(slot, 1);
+        const bool valid0     = IsCopyValid(copy0);
+        const bool valid1     = IsCopyValid(copy1);
+
+        if (valid0 && valid1)
+        {
+            int32_t diff = static_cast<int32_t>(LittleEndian::Get32(copy1 + kCopy_Sequence) -
+                                                LittleEndian::Get32(copy0 + kCopy_Sequence));
+            mCurrentCopy[slot] = (diff > 0) ? 1 : 0;
+        }
+        else if (valid0 || valid1)
+        {
+            mCurrentCopy[slot] = valid0 ? 0 : 1;
+        }
+        else
+        {
+            mCurrentCopy[slot] = kNoCopy;
+        }
+
+        if (IsSlotInUse(slot))
+        {
+            mIndex.Insert(HashSlotKey(slot), static_cast<SlotIndex>(slot));
+        }
+    }
+
+exit:
+    if (retval != CHIP_NO_ERROR)
+    {
+        Close();
+    }
+    return retval;
+}
+
+CHIP_ERROR ChipLinuxStorageMmap::ReadValue(const char * key, bool & val)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+    uint32_t result;
+
+    retval = ReadValue(key, result);
+    val    = (result == 0 ? false : true);
+
+    return retval;
+}
+
+CHIP_ERROR ChipLinuxStorageMmap::ReadValue(const char * key, uint32_t & val)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+    uint64_t result;
+
+    retval = ReadValue(key, result);
+    if (retval == CHIP_NO_ERROR)
+    {
+        VerifyOrExit(result <= UINT32_MAX, retval = CHIP_ERROR_INVALID_ARGUMENT);
+        val = static_cast<uint32_t>(result);
+    }
+
+exit:
+    return retval;
+}
+
+CHIP_ERROR ChipLinuxStorageMmap::ReadValue(const char * key, uint64_t & val)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+    const uint8_t * value;
+    size_t valueLen;
+
+    mLock.lock();
+
+    retval = ReadEntry(key, kType_Integer, value, valueLen);
+    if (retval == CHIP_NO_ERROR)
+    {
+        VerifyOrExit(valueLen == sizeof(uint64_t), retval = CHIP_ERROR_INVALID_ARGUMENT);
+        val = LittleEndian::Get64(value);
+    }
+
+exit:
+    mLock.unlock();
+
+    return retval;
+}
+
+CHIP_ERROR ChipLinuxStorageMmap::ReadValueStr(const char * key, char * buf, size_t bufSize, size_t & outLen)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+    const uint8_t * value;
+    size_t valueLen;
+
+    mLock.lock();
+
+    retval = ReadEntry(key, kType_String, value, valueLen);
+    if (retval == CHIP_NO_ERROR)
+    {
+        if (bufSize == 0 || valueLen > bufSize - 1)
+        {
+            outLen = valueLen;
+            ExitNow(retval = CHIP_ERROR_BUFFER_TOO_SMALL);
+        }
+
+        memcpy(buf, value, valueLen);
+        buf[valueLen] = '\0';
+        outLen        = valueLen;
+    }
+
+exit:
+    mLock.unlock();
+
+    return retval;
+}
+
+CHIP_ERROR ChipLinuxStorageMmap::ReadValueBin(const char * key, uint8_t * buf, size_t bufSize, size_t & outLen)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+    const uint8_t * value;
+    size_t valueLen;
+
+    mLock.lock();
+
+    retval = ReadEntry(key, kType_Binary, value, valueLen);
+    if (retval == CHIP_NO_ERROR)
+    {
+        outLen = valueLen;
+        VerifyOrExit(valueLen <= bufSize, retval = CHIP_ERROR_BUFFER_TOO_SMALL);
+
+        memcpy(buf, value, valueLen);
+    }
+
+exit:
+    mLock.unlock();
+
+    return retval;
+}
+
+CHIP_ERROR ChipLinuxStorageMmap::WriteValue(const char * key, bool val)
+{
+    return WriteValue(key, static_cast<uint32_t>(val ? 1 : 0));
+}
+
+CHIP_ERROR ChipLinuxStorageMmap::WriteValue(const char * key, uint32_t val)
+{
+    return WriteValue(key, static_cast<uint64_t>(val));
+}
+
+CHIP_ERROR ChipLinuxStorageMmap::WriteValue(const char * key, uint64_t val)
+{
+    uint8_t buf[sizeof(uint64_t)];
+
+    LittleEndian::Put64(buf, val);
+
+    return WriteValueTyped(key, kType_Integer, buf, sizeof(buf));
+}
+
+CHIP_ERROR ChipLinuxStorageMmap::WriteValueStr(const char * key, const char * val)
+{
+    if (val == NULL)
+    {
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    return WriteValueTyped(key, kType_String, reinterpret_cast<const uint8_t *>(val), strlen(val));
+}
+
+CHIP_ERROR ChipLinuxStorageMmap::WriteValueBin(const char * key, const uint8_t * data, size_t dataLen)
+{
+    return WriteValueTyped(key, kType_Binary, data, dataLen);
+}
+
+CHIP_ERROR ChipLinuxStorageMmap::ClearValue(const char * key)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+    size_t slot;
+
+    mLock.lock();
+
+    VerifyOrExit(mMap != NULL, retval = CHIP_ERROR_INCORRECT_STATE);
+
+    slot = FindSlot(key);
+    VerifyOrExit(slot < kNumEntries, retval = CHIP_ERROR_KEY_NOT_FOUND);
+
+    mIndex.Remove(HashSlotKey(slot), static_cast<SlotIndex>(slot), [this](SlotIndex other) { return HashSlotKey(other); });
+    WriteEntry(slot, kState_Removed, key, 0, NULL, 0);
+
+exit:
+    mLock.unlock();
+
+    return retval;
+}
+
+/**
+ *  Remove all values. The generation number in the header is advanced and synced first, which invalidates every copy
+ *  at once, so a crash cannot leave some of the values in place; the slots are only zeroed after that.
+ */
+CHIP_ERROR ChipLinuxStorageMmap::ClearAll(void)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+
+    mLock.lock();
+
+    VerifyOrExit(mMap != NULL, retval = CHIP_ERROR_WRITE_FAILED);
+
+    mGeneration++;
+    LittleEndian::Put32(mMap + kHeader_Generation, mGeneration);
+    VerifyOrExit(msync(mMap, kEntrySize, MS_SYNC) == 0, retval = CHIP_ERROR_WRITE_FAILED);
+
+    memset(mMap + kEntrySize, 0, mMapSize - kEntrySize);
+    memset(mCurrentCopy, kNoCopy, sizeof(mCurrentCopy));
+    memset(mDirtyCopies, 0, sizeof(mDirtyCopies));
+    mIndex.Clear();
+
+    VerifyOrExit(msync(mMap, mMapSize, MS_SYNC) == 0, retval = CHIP_ERROR_WRITE_FAILED);
+
+exit:
+    mLock.unlock();
+
+    return retval;
+}
+
+/**
+ *  Flush the copies written since the last call to disk.
+ */
+CHIP_ERROR ChipLinuxStorageMmap::Commit(void)
+{
+    CHIP_ERROR retval        = CHIP_NO_ERROR;
+    const uintptr_t pageMask = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE)) - 1;
+
+    mLock.lock();
+
+    VerifyOrExit(mMap != NULL, retval = CHIP_ERROR_WRITE_FAILED);
+
+    for (size_t i = 0; i < kNumEntries * 2; i++)
+    {
+        if (mDirtyCopies[i])
+        {
+            // msync() wants a page-aligned address; the entry size need not be a multiple of the page size.
+            uint8_t * copy  = CopyAt(i / 2, static_cast<uint8_t>(i % 2));
+            uint8_t * start = reinterpret_cast<uint8_t *>(reinterpret_cast<uintptr_t>(copy) & ~pageMask);
+
+            if (msync(start, static_cast<size_t>(copy + kEntrySize - start), MS_SYNC) != 0)
+            {
+                ChipLogError(DeviceLayer, "failed to sync storage, %s (%d)", strerror(errno), errno);
+                ExitNow(retval = CHIP_ERROR_WRITE_FAILED);
+            }
+            mDirtyCopies[i] = false;
+        }
+    }
+
+exit:
+    mLock.unlock();
+
+    return retval;
+}
+
+bool ChipLinuxStorageMmap::HasValue(const char * key)
+{
+    bool retval;
+
+    mLock.lock();
+
+    retval = (mMap != NULL && FindSlot(key) < kNumEntries);
+
+    mLock.unlock();
+
+    return retval;
+}
+
+uint8_t * ChipLinuxStorageMmap::CopyAt(size_t slot, uint8_t copy) const
+{
+    return mMap + kEntrySize * (1 + 2 * slot + copy);
+}
+
+bool ChipLinuxStorageMmap::IsCopyValid(const uint8_t * copy) const
+{
+    const uint8_t state     = copy[kCopy_State];
+    const uint32_t valueLen = LittleEndian::Get32(copy + kCopy_ValueLen);
+
+    if ((state != kState_Value && state != kState_Removed) || copy[kCopy_KeyLen] > kMaxKeyLen ||
+        valueLen > kEntrySize - kCopy_Value || LittleEndian::Get32(copy + kCopy_Generation) != mGeneration)
+    {
+        return false;
+    }
+
+    return LittleEndian::Get32(copy + kCopy_Checksum) == CRC32(copy + kCopy_Sequence, kCopy_Value - kCopy_Sequence + valueLen);
+}
+
+bool ChipLinuxStorageMmap::IsSlotInUse(size_t slot) const
+{
+    return mCurrentCopy[slot] != kNoCopy && CopyAt(slot, mCurrentCopy[slot])[kCopy_State] == kState_Value;
+}
+
+// Hash the key of a slot that holds a value.
+size_t ChipLinuxStorageMmap::HashSlotKey(size_t slot) const
+{
+    const uint8_t * copy = CopyAt(slot, mCurrentCopy[slot]);
+
+    return HashKey(copy + kCopy_Key, copy[kCopy_KeyLen]);
+}
+
+// Return the slot holding the value of key, or kNumEntries if there is none.
+size_t ChipLinuxStorageMmap::FindSlot(const char * key) const
+{
+    const size_t keyLen = strlen(key);
+    SlotIndex slot;
+
+    slot = mIndex.Find(HashKey(reinterpret_cast<const uint8_t *>(key), keyLen), [this, key, keyLen](SlotIndex candidate) {
+        const uint8_t * copy = CopyAt(candidate, mCurrentCopy[candidate]);
+
+        return copy[kCopy_KeyLen] == keyLen && memcmp(copy + kCopy_Key, key, keyLen) == 0;
+    });
+
+    return (slot == kInvalidSlot) ? static_cast<size_t>(kNumEntries) : slot;
+}
+
+// Find the value of key in the mapping. Must be called with mLock held; value is only valid until it is released.
+CHIP_ERROR ChipLinuxStorageMmap::ReadEntry(const char * key, uint8_t type, const uint8_t *& value, size_t & valueLen) const
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+    const uint8_t * copy;
+    size_t slot;
+
+    VerifyOrExit(mMap != NULL, retval = CHIP_ERROR_INCORRECT_STATE);
+
+    slot = FindSlot(key);
+    VerifyOrExit(slot < kNumEntries, retval = CHIP_ERROR_KEY_NOT_FOUND);
+
+    copy = CopyAt(slot, mCurrentCopy[slot]);
+    VerifyOrExit(copy[kCopy_Type] == type, retval = CHIP_ERROR_INVALID_ARGUMENT);
+
+    value    = copy + kCopy_Value;
+    valueLen = LittleEndian::Get32(copy + kCopy_ValueLen);
+
+exit:
+    return retval;
+}
+
+CHIP_ERROR ChipLinuxStorageMmap::WriteValueTyped(const char * key, uint8_t type, const uint8_t * value, size_t valueLen)
+{
+    CHIP_ERROR retval = CHIP_NO_ERROR;
+    bool newSlot      = false;
+    size_t slot;
+
+    mLock.lock();
+
+    VerifyOrExit(mMap != NULL, retval = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(key != NULL && strlen(key) <= kMaxKeyLen, retval = CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(valueLen <= kEntrySize - kCopy_Value, retval = CHIP_ERROR_INVALID_ARGUMENT);
+
+    slot = FindSlot(key);
+    if (slot == kNumEntries)
+    {
+        for (slot = 0; slot < kNumEntries && IsSlotInUse(slot); slot++)
+        {
+        }
+        VerifyOrExit(slot < kNumEntries, retval = CHIP_ERROR_NO_MEMORY);
+        newSlot = true;
+    }
+
+    WriteEntry(slot, kState_Value, key, type, value, valueLen);
+
+    if (newSlot)
+    {
+        mIndex.Insert(HashSlotKey(slot), static_cast<SlotIndex>(slot));
+    }
+
+exit:
+    mLock.unlock();
+
+    return retval;
+}
+
+// Write the copy of a slot that is not current, then make it current. The checksum is written last, so the copy only
+// becomes valid once everything else is in place; until then the previous copy is still the one that is found on Init.
+void ChipLinuxStorageMmap::WriteEntry(size_t slot, uint8_t state, const char * key, uint8_t type, const uint8_t * value,
+                                      size_t valueLen)
+{
+    const uint8_t current = mCurrentCopy[slot];
+    const uint8_t target  = (current == kNoCopy) ? 0 : static_cast<uint8_t>(current ^ 1);
+    const size_t keyLen   = strlen(key);
+    uint32_t sequence     = 1;
+    uint8_t * copy        = CopyAt(slot, target);
+
+    if (current != kNoCopy)
+    {
+        sequence = LittleEndian::Get32(CopyAt(slot, current) + kCopy_Sequence) + 1;
+    }
+
+    LittleEndian::Put32(copy + kCopy_Checksum, 0);
+    LittleEndian::Put32(copy + kCopy_Sequence, sequence);
+    copy[kCopy_State]  = state;
+    copy[kCopy_Type]   = type;
+    copy[kCopy_KeyLen] = static_cast<uint8_t>(keyLen);
+    LittleEndian::Put32(copy + kCopy_ValueLen, static_cast<uint32_t>(valueLen));
+    LittleEndian::Put32(copy + kCopy_Generation, mGeneration);
+    memset(copy + kCopy_Key, 0, kMaxKeyLen);
+    memcpy(copy + kCopy_Key, key, keyLen);
+    if (valueLen != 0)
+    {
+        memcpy(copy + kCopy_Value, value, valueLen);
+    }
+    LittleEndian::Put32(copy + kCopy_Checksum, CRC32(copy + kCopy_Sequence, kCopy_Value - kCopy_Sequence + valueLen));
+
+    mCurrentCopy[slot]              = target;
+    mDirtyCopies[slot * 2 + target] = true;
+}
+
+void ChipLinuxStorageMmap::Close(void)
+{
+    if (mMap != NULL)
+    {
+        msync(mMap, mMapSize, MS_SYNC);
+        munmap(mMap, mMapSize);
+        mMap     = NULL;
+        mMapSize = 0;
+    }
+
+    if (mFd >= 0)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+
+    memset(mCurrentCopy, kNoCopy, sizeof(mCurrentCopy));
+    memset(mDirtyCopies, 0, sizeof(mDirtyCopies));
+    mIndex.Clear();
+    mGeneration = 0;
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -0,0 +1,116 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *         This file defines a key-value store kept in a fixed-layout binary
+ *         file that is mapped into memory. It offers the same interface as
+ *         ChipLinuxStorage and is used in its place by PosixConfig when
+ *         CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP is enabled.
+ *
+ *         The file starts with a header of one entry size, followed by
+ *         CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_NUM_ENTRIES slots. Each slot
+ *         holds two copies of one value, each copy being one entry size long
+ *         and carrying a sequence number and a checksum. An update writes the
+ *         copy that is not current, so a crash in the middle of it leaves the
+ *         previous value in place. The header also holds a generation number
+ *         that copies must carry to be valid; ClearAll() advances it, which
+ *         removes every value with a single write.
+ *
+ *         Values are opened without parsing and read straight from the
+ *         mapping, without allocating. Binary values are stored as is. The
+ *         slots holding a value are indexed by a hash of their key, built on
+ *         Init().
+ *
+ */
+
+#ifndef CHIP_LINUX_STORAGE_MMAP_H
+#define CHIP_LINUX_STORAGE_MMAP_H
+
+#include <core/CHIPError.h>
+#include <mutex>
+#include <platform/CHIPDeviceConfig.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <support/ProbeHashIndex.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class ChipLinuxStorageMmap
+{
+public:
+    ChipLinuxStorageMmap();
+    ~ChipLinuxStorageMmap();
+
+    CHIP_ERROR Init(const char * configFile);
+    CHIP_ERROR ReadValue(const char * key, bool & val);
+    CHIP_ERROR ReadValue(const char * key, uint32_t & val);
+    CHIP_ERROR ReadValue(const char * key, uint64_t & val);
+    CHIP_ERROR ReadValueStr(const char * key, char * buf, size_t bufSize, size_t & outLen);
+    CHIP_ERROR ReadValueBin(const char * key, uint8_t * buf, size_t bufSize, size_t & outLen);
+    CHIP_ERROR WriteValue(const char * key, bool val);
+    CHIP_ERROR WriteValue(const char * key, uint32_t val);
+    CHIP_ERROR WriteValue(const char * key, uint64_t val);
+    CHIP_ERROR WriteValueStr(const char * key, const char * val);
+    CHIP_ERROR WriteValueBin(const char * key, const uint8_t * data, size_t dataLen);
+    CHIP_ERROR ClearValue(const char * key);
+    CHIP_ERROR ClearAll(void);
+    CHIP_ERROR Commit(void);
+    bool HasValue(const char * key);
+
+private:
+    enum
+    {
+        kNumEntries = CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_NUM_ENTRIES,
+        kEntrySize  = CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_ENTRY_SIZE,
+        kNoCopy     = 0xFF,
+    };
+
+    typedef uint16_t SlotIndex;
+
+    static constexpr SlotIndex kInvalidSlot = UINT16_MAX;
+
+    static_assert(kNumEntries < kInvalidSlot, "too many entries for the slot index");
+
+    uint8_t * CopyAt(size_t slot, uint8_t copy) const;
+    size_t HashSlotKey(size_t slot) const;
+    size_t FindSlot(const char * key) const;
+    CHIP_ERROR ReadEntry(const char * key, uint8_t type, const uint8_t *& value, size_t & valueLen) const;
+    void WriteEntry(size_t slot, uint8_t state, const char * key, uint8_t type, const uint8_t * value, size_t valueLen);
+    CHIP_ERROR WriteValueTyped(const char * key, uint8_t type, const uint8_t * value, size_t valueLen);
+    bool IsCopyValid(const uint8_t * copy) const;
+    bool IsSlotInUse(size_t slot) const;
+    void Close(void);
+
+    std::mutex mLock;
+    int mFd;
+    uint8_t * mMap;
+    size_t mMapSize;
+    uint8_t mCurrentCopy[kNumEntries];  // Which copy of each slot holds its value, or kNoCopy.
+    bool mDirtyCopies[kNumEntries * 2]; // Copies written since the last Commit().
+    uint32_t mGeneration;
+    ProbeHashIndex<SlotIndex, kNumEntries, kInvalidSlot> mIndex; // Slots holding a value, by key.
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
+
+#endif // CHIP_LINUX_STORAGE_MMAP_H
@@ -29,16 +29,26 @@
 
 #include <core/CHIPEncoding.h>
 #include <platform/Linux/CHIPLinuxStorage.h>
+#if CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
+#include <platform/Linux/CHIPLinuxStorageMmap.h>
+#endif // CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
 #include <platform/Linux/PosixConfig.h>
 #include <support/CodeUtils.h>
 
+#include <unistd.h>
+
 namespace chip {
 namespace DeviceLayer {
 namespace Internal {
 
-static ChipLinuxStorage gChipLinuxFactoryStorage;
-static ChipLinuxStorage gChipLinuxConfigStorage;
-static ChipLinuxStorage gChipLinuxCountersStorage;
+static PosixConfigStorage gChipLinuxFactoryStorage;
+static PosixConfigStorage gChipLinuxConfigStorage;
+static PosixConfigStorage gChipLinuxCountersStorage;
+
+#if CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
+// Written to the binary factory store once the factory INI file has been imported into it.
+static const char kFactoryIniImportedKey[] = "ini-imported";
+#endif // CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
 
 // *** CAUTION ***: Changing the names or namespaces of these values will *break* existing devices.
 
@@ -76,7 +86,7 @@ const PosixConfig::Key PosixConfig::kConfigKey_OperationalDevicePrivateKey = { k
 // Prefix used for NVS keys that contain Chip group encryption keys.
 const char PosixConfig::kGroupKeyNamePrefix[] = "gk-";
 
-ChipLinuxStorage * PosixConfig::GetStorageForNamespace(Key key)
+PosixConfigStorage * PosixConfig::GetStorageForNamespace(Key key)
 {
     if (strcmp(key.Namespace, kConfigNamespace_ChipFactory) == 0)
         return &gChipLinuxFactoryStorage;
@@ -99,7 +109,7 @@ CHIP_ERROR PosixConfig::Init()
 CHIP_ERROR PosixConfig::ReadConfigValue(Key key, bool & val)
 {
     CHIP_ERROR err;
-    ChipLinuxStorage * storage;
+    PosixConfigStorage * storage;
     uint32_t intVal;
 
     storage = GetStorageForNamespace(key);
@@ -121,7 +131,7 @@ exit:
 CHIP_ERROR PosixConfig::ReadConfigValue(Key key, uint32_t & val)
 {
     CHIP_ERROR err;
-    ChipLinuxStorage * storage;
+    PosixConfigStorage * storage;
 
     storage = GetStorageForNamespace(key);
     VerifyOrExit(storage != NULL, err = CHIP_DEVICE_ERROR_CONFIG_NOT_FOUND);
@@ -140,7 +150,7 @@ exit:
 CHIP_ERROR PosixConfig::ReadConfigValue(Key key, uint64_t & val)
 {
     CHIP_ERROR err;
-    ChipLinuxStorage * storage;
+    PosixConfigStorage * storage;
 
     storage = GetStorageForNamespace(key);
     VerifyOrExit(storage != NULL, err = CHIP_DEVICE_ERROR_CONFIG_NOT_FOUND);
@@ -175,7 +185,7 @@ exit:
 CHIP_ERROR PosixConfig::ReadConfigValueStr(Key key, char * buf, size_t bufSize, size_t & outLen)
 {
     CHIP_ERROR err;
-    ChipLinuxStorage * storage;
+    PosixConfigStorage * storage;
 
     storage = GetStorageForNamespace(key);
     VerifyOrExit(storage != NULL, err = CHIP_DEVICE_ERROR_CONFIG_NOT_FOUND);
@@ -199,7 +209,7 @@ exit:
 CHIP_ERROR PosixConfig::ReadConfigValueBin(Key key, uint8_t * buf, size_t bufSize, size_t & outLen)
 {
     CHIP_ERROR err;
-    ChipLinuxStorage * storage;
+    PosixConfigStorage * storage;
 
     storage = GetStorageForNamespace(key);
     VerifyOrExit(storage != NULL, err = CHIP_DEVICE_ERROR_CONFIG_NOT_FOUND);
@@ -223,7 +233,7 @@ exit:
 CHIP_ERROR PosixConfig::WriteConfigValue(Key key, bool val)
 {
     CHIP_ERROR err;
-    ChipLinuxStorage * storage;
+    PosixConfigStorage * storage;
 
     storage = GetStorageForNamespace(key);
     VerifyOrExit(storage != NULL, err = CHIP_DEVICE_ERROR_CONFIG_NOT_FOUND);
@@ -244,7 +254,7 @@ exit:
 CHIP_ERROR PosixConfig::WriteConfigValue(Key key, uint32_t val)
 {
     CHIP_ERROR err;
-    ChipLinuxStorage * storage;
+    PosixConfigStorage * storage;
 
     storage = GetStorageForNamespace(key);
     VerifyOrExit(storage != NULL, err = CHIP_DEVICE_ERROR_CONFIG_NOT_FOUND);
@@ -265,7 +275,7 @@ exit:
 CHIP_ERROR PosixConfig::WriteConfigValue(Key key, uint64_t val)
 {
     CHIP_ERROR err;
-    ChipLinuxStorage * storage;
+    PosixConfigStorage * storage;
 
     storage = GetStorageForNamespace(key);
     VerifyOrExit(storage != NULL, err = CHIP_DEVICE_ERROR_CONFIG_NOT_FOUND);
@@ -286,7 +296,7 @@ exit:
 CHIP_ERROR PosixConfig::WriteConfigValueStr(Key key, const char * str)
 {
     CHIP_ERROR err;
-    ChipLinuxStorage * storage;
+    PosixConfigStorage * storage;
 
     if (str != NULL)
     {
@@ -337,7 +347,7 @@ exit:
 CHIP_ERROR PosixConfig::WriteConfigValueBin(Key key, const uint8_t * data, size_t dataLen)
 {
     CHIP_ERROR err;
-    ChipLinuxStorage * storage;
+    PosixConfigStorage * storage;
 
     if (data != NULL)
     {
@@ -366,7 +376,7 @@ exit:
 CHIP_ERROR PosixConfig::ClearConfigValue(Key key)
 {
     CHIP_ERROR err;
-    ChipLinuxStorage * storage;
+    PosixConfigStorage * storage;
 
     storage = GetStorageForNamespace(key);
     VerifyOrExit(storage != NULL, err = CHIP_DEVICE_ERROR_CONFIG_NOT_FOUND);
@@ -390,7 +400,7 @@ exit:
 
 bool PosixConfig::ConfigValueExists(Key key)
 {
-    ChipLinuxStorage * storage;
+    PosixConfigStorage * storage;
 
     storage = GetStorageForNamespace(key);
     if (storage == NULL)
@@ -401,13 +411,19 @@ bool PosixConfig::ConfigValueExists(Key key)
 
 CHIP_ERROR PosixConfig::EnsureNamespace(const char * ns)
 {
-    CHIP_ERROR err             = CHIP_NO_ERROR;
-    ChipLinuxStorage * storage = NULL;
+    CHIP_ERROR err               = CHIP_NO_ERROR;
+    PosixConfigStorage * storage = NULL;
 
     if (strcmp(ns, kConfigNamespace_ChipFactory) == 0)
     {
         storage = &gChipLinuxFactoryStorage;
         err     = storage->Init(CHIP_DEFAULT_FACTORY_PATH);
+#if CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
+        if (err == CHIP_NO_ERROR && !storage->HasValue(kFactoryIniImportedKey))
+        {
+            err = ImportFactoryIni();
+        }
+#endif // CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
     }
     else if (strcmp(ns, kConfigNamespace_ChipConfig) == 0)
     {
@@ -426,10 +442,103 @@ exit:
     return err;
 }
 
+#if CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
+/**
+ * Copy the factory values that manufacturing tools wrote to the INI file into the binary factory store.
+ *
+ * This runs once, when the binary store is first opened; the marker written last makes an interrupted import
+ * start over on the next boot. The INI file does not record the type of a value, so the well-known factory keys
+ * are imported with the type they are read with.
+ */
+CHIP_ERROR PosixConfig::ImportFactoryIni(void)
+{
+    enum ValueType
+    {
+        kValueType_Integer,
+        kValueType_String,
+        kValueType_Binary,
+    };
+    static const struct
+    {
+        const Key * ConfigKey;
+        ValueType Type;
+    } kFactoryKeys[] = {
+        { &kConfigKey_SerialNum, kValueType_String },           { &kConfigKey_MfrDeviceId, kValueType_Integer },
+        { &kConfigKey_MfrDeviceCert, kValueType_Binary },       { &kConfigKey_MfrDeviceICACerts, kValueType_Binary },
+        { &kConfigKey_MfrDevicePrivateKey, kValueType_Binary }, { &kConfigKey_ProductRevision, kValueType_Integer },
+        { &kConfigKey_ManufacturingDate, kValueType_String },   { &kConfigKey_SetupPinCode, kValueType_Integer },
+        { &kConfigKey_SetupDiscriminator, kValueType_Integer },
+    };
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    ChipLinuxStorage ini;
+    uint8_t buf[CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_ENTRY_SIZE];
+    uint64_t intVal;
+    size_t len;
+
+    // A missing INI file leaves nothing to import.
+    if (access(CHIP_DEFAULT_FACTORY_PATH, F_OK) == 0)
+    {
+        err = ini.Init(CHIP_DEFAULT_FACTORY_PATH);
+        SuccessOrExit(err);
+
+        ChipLogProgress(DeviceLayer, "Importing factory configuration from %s", CHIP_DEFAULT_FACTORY_PATH);
+
+        for (size_t i = 0; i < sizeof(kFactoryKeys) / sizeof(kFactoryKeys[0]); i++)
+        {
+            const char * name = kFactoryKeys[i].ConfigKey->Name;
+
+            switch (kFactoryKeys[i].Type)
+            {
+            case kValueType_Integer:
+                err = ini.ReadValue(name, intVal);
+                if (err == CHIP_NO_ERROR)
+                {
+                    err = gChipLinuxFactoryStorage.WriteValue(name, intVal);
+                }
+                break;
+            case kValueType_String:
+                err = ini.ReadValueStr(name, reinterpret_cast<char *>(buf), sizeof(buf), len);
+                if (err == CHIP_NO_ERROR)
+                {
+                    err = gChipLinuxFactoryStorage.WriteValueStr(name, reinterpret_cast<char *>(buf));
+                }
+                break;
+            case kValueType_Binary:
+                err = ini.ReadValueBin(name, buf, sizeof(buf), len);
+                if (err == CHIP_NO_ERROR)
+                {
+                    err = gChipLinuxFactoryStorage.WriteValueBin(name, buf, len);
+                }
+                break;
+            }
+
+            if (err == CHIP_ERROR_KEY_NOT_FOUND)
+            {
+                err = CHIP_NO_ERROR;
+            }
+            else if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(DeviceLayer, "Failed to import factory value %s: %s", name, ErrorStr(err));
+                ExitNow();
+            }
+        }
+    }
+
+    err = gChipLinuxFactoryStorage.WriteValue(kFactoryIniImportedKey, true);
+    SuccessOrExit(err);
+
+    err = gChipLinuxFactoryStorage.Commit();
+
+exit:
+    return err;
+}
+#endif // CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
+
 CHIP_ERROR PosixConfig::ClearNamespace(const char * ns)
 {
-    CHIP_ERROR err             = CHIP_NO_ERROR;
-    ChipLinuxStorage * storage = NULL;
+    CHIP_ERROR err               = CHIP_NO_ERROR;
+    PosixConfigStorage * storage = NULL;
 
     if (strcmp(ns, kConfigNamespace_ChipConfig) == 0)
     {
@@ -462,7 +571,7 @@ exit:
 CHIP_ERROR PosixConfig::FactoryResetConfig(void)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
-    ChipLinuxStorage * storage;
+    PosixConfigStorage * storage;
 
     ChipLogProgress(DeviceLayer, "Performing factory reset");
 
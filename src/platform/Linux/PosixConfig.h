@@ -33,7 +33,13 @@ namespace chip {
 namespace DeviceLayer {
 namespace Internal {
 
+#if CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
+class ChipLinuxStorageMmap;
+typedef ChipLinuxStorageMmap PosixConfigStorage;
+#else
 class ChipLinuxStorage;
+typedef ChipLinuxStorage PosixConfigStorage;
+#endif // CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
 
 /**
  * Provides functions and definitions for accessing device configuration information on the Posix.
@@ -106,7 +112,10 @@ protected:
     static CHIP_ERROR ClearNamespace(const char * ns);
 
 private:
-    static ChipLinuxStorage * GetStorageForNamespace(Key key);
+    static PosixConfigStorage * GetStorageForNamespace(Key key);
+#if CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
+    static CHIP_ERROR ImportFactoryIni(void);
+#endif // CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP
 };
 
 struct PosixConfig::Key
@@ -0,0 +1,362 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the write-ahead log of
+ *      the Linux configuration storage (ChipLinuxStorage).
+ *
+ */
+
+#include "TestLinuxStorage.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <nlunit-test.h>
+#include <support/CodeUtils.h>
+
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/Linux/CHIPLinuxStorage.h>
+
+using namespace chip;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+struct TestContext
+{
+    char Dir[32];
+    std::string ConfigPath;
+    std::string LogPath;
+};
+
+// Point the context at a configuration file of its own for a test.
+void UseConfigFile(TestContext & ctx, const char * name)
+{
+    ctx.ConfigPath.assign(ctx.Dir).append("/").append(name).append(".ini");
+    ctx.LogPath.assign(ctx.ConfigPath).append(".log");
+}
+
+long FileSize(const std::string & path)
+{
+    struct stat st;
+
+    return stat(path.c_str(), &st) == 0 ? static_cast<long>(st.st_size) : -1;
+}
+
+bool FileContains(const std::string & path, const char * text)
+{
+    std::string contents;
+    char buf[512];
+    size_t len;
+    FILE * file = fopen(path.c_str(), "r");
+
+    if (file == NULL)
+    {
+        return false;
+    }
+    while ((len = fread(buf, 1, sizeof(buf), file)) > 0)
+    {
+        contents.append(buf, len);
+    }
+    fclose(file);
+
+    return contents.find(text) != std::string::npos;
+}
+
+bool ValueIs(ChipLinuxStorage & storage, const char * key, const char * expected)
+{
+    char buf[64];
+    size_t len = 0;
+
+    return storage.ReadValueStr(key, buf, sizeof(buf), len) == CHIP_NO_ERROR && strcmp(buf, expected) == 0;
+}
+
+} // namespace
+
+// =================================
+//      Unit tests
+// =================================
+
+static void TestLinuxStorage_Replay(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+
+    UseConfigFile(ctx, "replay");
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("kept", "one") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("removed", "two") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("kept", "three") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.ClearValue("removed") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+
+        // Uncommitted changes are not logged
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("uncommitted", "four") == CHIP_NO_ERROR);
+    }
+
+    // The changes are in the log only, and are applied on top of the INI file when it is loaded
+    NL_TEST_ASSERT(inSuite, FileSize(ctx.LogPath) > 0);
+    NL_TEST_ASSERT(inSuite, !FileContains(ctx.ConfigPath, "kept"));
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "kept", "three"));
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("removed"));
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("uncommitted"));
+    }
+}
+
+static void TestLinuxStorage_TornTail(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    long intactSize;
+
+    UseConfigFile(ctx, "torntail");
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("first", "one") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+        intactSize = FileSize(ctx.LogPath);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("torn", "two") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    }
+
+    // Cut the last record short, as a crash in the middle of appending it would
+    NL_TEST_ASSERT(inSuite, truncate(ctx.LogPath.c_str(), FileSize(ctx.LogPath) - 2) == 0);
+
+    {
+        ChipLinuxStorage storage;
+
+        // The torn record is discarded, and cut off so that later records are not hidden behind it
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "first", "one"));
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("torn"));
+        NL_TEST_ASSERT(inSuite, FileSize(ctx.LogPath) == intactSize);
+
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("after", "three") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    }
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "first", "one"));
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "after", "three"));
+    }
+}
+
+static void TestLinuxStorage_Compaction(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    std::string value(1000, 'v');
+    int commits = 0;
+
+    UseConfigFile(ctx, "compaction");
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("removed", "one") == CHIP_NO_ERROR);
+
+        // Commit until the log is folded into the INI file and emptied
+        do
+        {
+            NL_TEST_ASSERT(inSuite, storage.WriteValueStr("large", value.c_str()) == CHIP_NO_ERROR);
+            if (commits == 0)
+            {
+                NL_TEST_ASSERT(inSuite, storage.ClearValue("removed") == CHIP_NO_ERROR);
+            }
+            NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+            commits++;
+        } while (FileSize(ctx.LogPath) > 0 && commits * value.size() < 2 * CHIP_DEVICE_CONFIG_LINUX_STORAGE_COMPACT_THRESHOLD);
+
+        NL_TEST_ASSERT(inSuite, FileSize(ctx.LogPath) == 0);
+        NL_TEST_ASSERT(inSuite, FileContains(ctx.ConfigPath, value.c_str()));
+        NL_TEST_ASSERT(inSuite, !FileContains(ctx.ConfigPath, "removed"));
+
+        // The log is used again after compaction
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("small", "two") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, FileSize(ctx.LogPath) > 0);
+    }
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.HasValue("large"));
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("removed"));
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "small", "two"));
+    }
+}
+
+static void TestLinuxStorage_ClearAllCrash(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    std::string tmpPath;
+
+    UseConfigFile(ctx, "clearall");
+    tmpPath.assign(ctx.ConfigPath).append(".tmp");
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("first", "one") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("second", "two") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+
+        // Stop ClearAll() where a crash could: the temp file of the new INI file cannot be created, so the INI file is
+        // not replaced and the log is not emptied
+        NL_TEST_ASSERT(inSuite, mkdir(tmpPath.c_str(), 0700) == 0);
+        NL_TEST_ASSERT(inSuite, storage.ClearAll() != CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, rmdir(tmpPath.c_str()) == 0);
+    }
+
+    // The old values are still in the log, but so is the removal
+    NL_TEST_ASSERT(inSuite, FileContains(ctx.LogPath, "first"));
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("first"));
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("second"));
+    }
+
+    // Crash after the empty INI file has replaced the old one but before the log is emptied
+    NL_TEST_ASSERT(inSuite, truncate(ctx.ConfigPath.c_str(), 0) == 0);
+    NL_TEST_ASSERT(inSuite, FileContains(ctx.LogPath, "first"));
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("first"));
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("second"));
+
+        // A ClearAll() that completes empties the log
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("third", "three") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.ClearAll() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, FileSize(ctx.LogPath) == 0);
+    }
+
+    {
+        ChipLinuxStorage storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("third"));
+    }
+}
+
+static void TestLinuxStorage_KeyTooLong(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    std::string key(UINT16_MAX + 1, 'k');
+    ChipLinuxStorage storage;
+
+    UseConfigFile(ctx, "keytoolong");
+
+    // The key would not fit the key length field of a log record
+    NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.WriteValueStr(key.c_str(), "one") == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, storage.ClearValue(key.c_str()) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, !storage.HasValue(key.c_str()));
+}
+
+/**
+ *   Set up and tear down a directory for the configuration files of the tests.
+ */
+static int TestSetup(void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+
+    strcpy(ctx.Dir, "/tmp/chip-storage-XXXXXX");
+    if (mkdtemp(ctx.Dir) == NULL)
+    {
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+static int TestTeardown(void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+
+    DIR * dir = opendir(ctx.Dir);
+    struct dirent * entry;
+
+    while (dir != NULL && (entry = readdir(dir)) != NULL)
+    {
+        if (entry->d_name[0] != '.')
+        {
+            unlinkat(dirfd(dir), entry->d_name, 0);
+        }
+    }
+    if (dir != NULL)
+    {
+        closedir(dir);
+    }
+    rmdir(ctx.Dir);
+
+    return SUCCESS;
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+
+    NL_TEST_DEF("Test ChipLinuxStorage::Replay", TestLinuxStorage_Replay),
+    NL_TEST_DEF("Test ChipLinuxStorage::TornTail", TestLinuxStorage_TornTail),
+    NL_TEST_DEF("Test ChipLinuxStorage::Compaction", TestLinuxStorage_Compaction),
+    NL_TEST_DEF("Test ChipLinuxStorage::ClearAllCrash", TestLinuxStorage_ClearAllCrash),
+    NL_TEST_DEF("Test ChipLinuxStorage::KeyTooLong", TestLinuxStorage_KeyTooLong),
+
+    NL_TEST_SENTINEL()
+};
+
+int TestLinuxStorage(void)
+{
+    nlTestSuite theSuite = { "CHIP DeviceLayer Linux storage tests", &sTests[0], TestSetup, TestTeardown };
+    TestContext context;
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, &context);
+    return nlTestRunnerStats(&theSuite);
+}
@@ -0,0 +1,512 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the memory-mapped Linux
+ *      configuration storage (ChipLinuxStorageMmap).
+ *
+ */
+
+#include "TestLinuxStorageMmap.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <nlunit-test.h>
+#include <support/CRC32.h>
+#include <support/CodeUtils.h>
+
+#include <core/CHIPEncoding.h>
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/Linux/CHIPLinuxStorageMmap.h>
+
+using namespace chip;
+using namespace chip::Encoding;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+// Layout of the file, as documented in CHIPLinuxStorageMmap.cpp.
+enum
+{
+    kEntrySize  = CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_ENTRY_SIZE,
+    kNumEntries = CHIP_DEVICE_CONFIG_LINUX_STORAGE_MMAP_NUM_ENTRIES,
+
+    kCopy_Checksum = 0,
+    kCopy_Sequence = 4,
+    kCopy_ValueLen = 12,
+    kCopy_Value    = 64,
+};
+
+struct TestContext
+{
+    char Dir[32];
+    std::string ConfigPath;
+    std::string BinPath;
+};
+
+// Point the context at a configuration file of its own for a test.
+void UseConfigFile(TestContext & ctx, const char * name)
+{
+    ctx.ConfigPath.assign(ctx.Dir).append("/").append(name).append(".ini");
+    ctx.BinPath.assign(ctx.ConfigPath).append(".bin");
+}
+
+// Read or rewrite the header of one copy of a slot in the file, bypassing the store.
+bool ReadCopy(const TestContext & ctx, size_t slot, uint8_t copy, uint8_t * buf)
+{
+    int fd      = open(ctx.BinPath.c_str(), O_RDONLY);
+    off_t pos   = static_cast<off_t>(kEntrySize) * static_cast<off_t>(1 + 2 * slot + copy);
+    bool result = (fd >= 0 && pread(fd, buf, kEntrySize, pos) == kEntrySize);
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    return result;
+}
+
+bool WriteCopy(const TestContext & ctx, size_t slot, uint8_t copy, const uint8_t * buf)
+{
+    int fd      = open(ctx.BinPath.c_str(), O_WRONLY);
+    off_t pos   = static_cast<off_t>(kEntrySize) * static_cast<off_t>(1 + 2 * slot + copy);
+    bool result = (fd >= 0 && pwrite(fd, buf, kEntrySize, pos) == kEntrySize);
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    return result;
+}
+
+// Read or rewrite the whole file, bypassing the store.
+bool ReadFile(const TestContext & ctx, std::string & contents)
+{
+    const size_t fileSize = static_cast<size_t>(kEntrySize) * (1 + 2 * kNumEntries);
+    int fd                = open(ctx.BinPath.c_str(), O_RDONLY);
+    bool result;
+
+    contents.resize(fileSize);
+    result = (fd >= 0 && pread(fd, &contents[0], fileSize, 0) == static_cast<ssize_t>(fileSize));
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    return result;
+}
+
+bool WriteFile(const TestContext & ctx, const std::string & contents)
+{
+    int fd      = open(ctx.BinPath.c_str(), O_WRONLY);
+    bool result = (fd >= 0 && pwrite(fd, contents.data(), contents.size(), 0) == static_cast<ssize_t>(contents.size()));
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    return result;
+}
+
+uint32_t CopySequence(const TestContext & ctx, size_t slot, uint8_t copy)
+{
+    uint8_t buf[kEntrySize];
+
+    return ReadCopy(ctx, slot, copy, buf) ? LittleEndian::Get32(buf + kCopy_Sequence) : 0;
+}
+
+// Give a copy another sequence number, with a checksum that matches it.
+bool SetCopySequence(const TestContext & ctx, size_t slot, uint8_t copy, uint32_t sequence)
+{
+    uint8_t buf[kEntrySize];
+
+    if (!ReadCopy(ctx, slot, copy, buf))
+    {
+        return false;
+    }
+    LittleEndian::Put32(buf + kCopy_Sequence, sequence);
+    LittleEndian::Put32(buf + kCopy_Checksum,
+                        CRC32(buf + kCopy_Sequence, kCopy_Value - kCopy_Sequence + LittleEndian::Get32(buf + kCopy_ValueLen)));
+    return WriteCopy(ctx, slot, copy, buf);
+}
+
+bool ValueIs(ChipLinuxStorageMmap & storage, const char * key, const char * expected)
+{
+    char buf[64];
+    size_t len = 0;
+
+    return storage.ReadValueStr(key, buf, sizeof(buf), len) == CHIP_NO_ERROR && strcmp(buf, expected) == 0;
+}
+
+} // namespace
+
+// =================================
+//      Unit tests
+// =================================
+
+static void TestLinuxStorageMmap_SlotSelection(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+
+    UseConfigFile(ctx, "selection");
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("key", "one") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("key", "two") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    }
+
+    // Each write goes to the other copy of the slot, with the next sequence number
+    NL_TEST_ASSERT(inSuite, CopySequence(ctx, 0, 0) == 1);
+    NL_TEST_ASSERT(inSuite, CopySequence(ctx, 0, 1) == 2);
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        // The copy with the higher sequence number is current
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "key", "two"));
+
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("key", "three") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(inSuite, CopySequence(ctx, 0, 0) == 3);
+    NL_TEST_ASSERT(inSuite, CopySequence(ctx, 0, 1) == 2);
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "key", "three"));
+    }
+}
+
+static void TestLinuxStorageMmap_TornCopy(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    uint8_t buf[kEntrySize];
+
+    UseConfigFile(ctx, "torncopy");
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("key", "one") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("key", "two") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    }
+
+    // Damage the value of the current copy, as a crash in the middle of writing it would
+    NL_TEST_ASSERT(inSuite, ReadCopy(ctx, 0, 1, buf));
+    buf[kCopy_Value] ^= 0xFF;
+    NL_TEST_ASSERT(inSuite, WriteCopy(ctx, 0, 1, buf));
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        // The previous copy is used instead, and the next write goes over the damaged one
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "key", "one"));
+
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("key", "three") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, CopySequence(ctx, 0, 1) == 2);
+    }
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "key", "three"));
+    }
+
+    // With both copies damaged, the value is gone
+    NL_TEST_ASSERT(inSuite, ReadCopy(ctx, 0, 0, buf));
+    buf[kCopy_Value] ^= 0xFF;
+    NL_TEST_ASSERT(inSuite, WriteCopy(ctx, 0, 0, buf));
+    NL_TEST_ASSERT(inSuite, ReadCopy(ctx, 0, 1, buf));
+    buf[kCopy_Value] ^= 0xFF;
+    NL_TEST_ASSERT(inSuite, WriteCopy(ctx, 0, 1, buf));
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("key"));
+    }
+}
+
+static void TestLinuxStorageMmap_SequenceWrap(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+
+    UseConfigFile(ctx, "sequencewrap");
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("key", "one") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    }
+
+    // Bring the slot to the last sequence number before it wraps
+    NL_TEST_ASSERT(inSuite, SetCopySequence(ctx, 0, 0, UINT32_MAX));
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "key", "one"));
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("key", "two") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(inSuite, CopySequence(ctx, 0, 1) == 0);
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        // The wrapped sequence number is still newer than the one before it
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "key", "two"));
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("key", "three") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(inSuite, CopySequence(ctx, 0, 0) == 1);
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "key", "three"));
+    }
+}
+
+static void TestLinuxStorageMmap_Capacity(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    std::string large(kEntrySize - kCopy_Value + 1, 'v');
+    std::string longKey(kCopy_Value, 'k');
+    char key[16];
+
+    UseConfigFile(ctx, "capacity");
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+
+        for (int i = 0; i < kNumEntries; i++)
+        {
+            snprintf(key, sizeof(key), "key-%d", i);
+            NL_TEST_ASSERT(inSuite, storage.WriteValue(key, static_cast<uint32_t>(i)) == CHIP_NO_ERROR);
+        }
+
+        // Every slot is taken, but existing values can still be updated
+        NL_TEST_ASSERT(inSuite, storage.WriteValue("one-too-many", true) == CHIP_ERROR_NO_MEMORY);
+        NL_TEST_ASSERT(inSuite, storage.WriteValue("key-0", static_cast<uint32_t>(100)) == CHIP_NO_ERROR);
+
+        // Removing a value frees its slot
+        NL_TEST_ASSERT(inSuite, storage.ClearValue("key-1") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValue("one-too-many", true) == CHIP_NO_ERROR);
+
+        // Keys and values that do not fit an entry are refused
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("key-2", large.c_str()) == CHIP_ERROR_INVALID_ARGUMENT);
+        NL_TEST_ASSERT(inSuite, storage.WriteValue(longKey.c_str(), true) == CHIP_ERROR_INVALID_ARGUMENT);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    }
+
+    {
+        ChipLinuxStorageMmap storage;
+        uint32_t val = 0;
+        bool flag    = false;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.ReadValue("key-0", val) == CHIP_NO_ERROR && val == 100);
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("key-1"));
+        NL_TEST_ASSERT(inSuite, storage.ReadValue("key-2", val) == CHIP_NO_ERROR && val == 2);
+        NL_TEST_ASSERT(inSuite, storage.ReadValue("one-too-many", flag) == CHIP_NO_ERROR && flag);
+
+        snprintf(key, sizeof(key), "key-%d", kNumEntries - 1);
+        NL_TEST_ASSERT(inSuite, storage.ReadValue(key, val) == CHIP_NO_ERROR && val == kNumEntries - 1);
+    }
+}
+
+static void TestLinuxStorageMmap_ClearAll(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+
+    UseConfigFile(ctx, "clearall");
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("first", "one") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("second", "two") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, storage.ClearAll() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("first"));
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("second"));
+    }
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        // The values stay cleared, and the store can be written again
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("first"));
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("second"));
+
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("second", "three") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    }
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "second", "three"));
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("first"));
+    }
+}
+
+static void TestLinuxStorageMmap_ClearAllCrash(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+    std::string before;
+    std::string after;
+
+    UseConfigFile(ctx, "clearallcrash");
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("first", "one") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("second", "two") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ReadFile(ctx, before));
+
+        NL_TEST_ASSERT(inSuite, storage.ClearAll() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ReadFile(ctx, after));
+    }
+
+    // Crash once the new header is on disk, but before any slot has been zeroed
+    before.replace(0, kEntrySize, after, 0, kEntrySize);
+    NL_TEST_ASSERT(inSuite, WriteFile(ctx, before));
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        // None of the old values is found, and the slots they are in can be written again
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("first"));
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("second"));
+
+        NL_TEST_ASSERT(inSuite, storage.WriteValueStr("second", "three") == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storage.Commit() == CHIP_NO_ERROR);
+    }
+
+    {
+        ChipLinuxStorageMmap storage;
+
+        NL_TEST_ASSERT(inSuite, storage.Init(ctx.ConfigPath.c_str()) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ValueIs(storage, "second", "three"));
+        NL_TEST_ASSERT(inSuite, !storage.HasValue("first"));
+    }
+}
+
+/**
+ *   Set up and tear down a directory for the configuration files of the tests.
+ */
+static int TestSetup(void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+
+    strcpy(ctx.Dir, "/tmp/chip-storage-XXXXXX");
+    if (mkdtemp(ctx.Dir) == NULL)
+    {
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+static int TestTeardown(void * inContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(inContext);
+
+    DIR * dir = opendir(ctx.Dir);
+    struct dirent * entry;
+
+    while (dir != NULL && (entry = readdir(dir)) != NULL)
+    {
+        if (entry->d_name[0] != '.')
+        {
+            unlinkat(dirfd(dir), entry->d_name, 0);
+        }
+    }
+    if (dir != NULL)
+    {
+        closedir(dir);
+    }
+    rmdir(ctx.Dir);
+
+    return SUCCESS;
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+
+    NL_TEST_DEF("Test ChipLinuxStorageMmap::SlotSelection", TestLinuxStorageMmap_SlotSelection),
+    NL_TEST_DEF("Test ChipLinuxStorageMmap::TornCopy", TestLinuxStorageMmap_TornCopy),
+    NL_TEST_DEF("Test ChipLinuxStorageMmap::SequenceWrap", TestLinuxStorageMmap_SequenceWrap),
+    NL_TEST_DEF("Test ChipLinuxStorageMmap::Capacity", TestLinuxStorageMmap_Capacity),
+    NL_TEST_DEF("Test ChipLinuxStorageMmap::ClearAll", TestLinuxStorageMmap_ClearAll),
+    NL_TEST_DEF("Test ChipLinuxStorageMmap::ClearAllCrash", TestLinuxStorageMmap_ClearAllCrash),
+
+    NL_TEST_SENTINEL()
+};
+
+int TestLinuxStorageMmap(void)
+{
+    nlTestSuite theSuite = { "CHIP DeviceLayer Linux memory-mapped storage tests", &sTests[0], TestSetup, TestTeardown };
+    TestContext context;
+
+    // Run test suit againt one context.
+    nlTestRunner(&theSuite, &context);
+    return nlTestRunnerStats(&theSuite);
+}
@@ -25,10 +25,15 @@
 #include "TestPlatformMgr.h"
 
 #include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+#include <atomic>
 
 #include <nlunit-test.h>
 #include <support/CodeUtils.h>
@@ -87,6 +92,94 @@ static void TestPlatformMgr_AddEventHandler(nlTestSuite * inSuite, void * inCont
 #endif
 }
 
+static std::atomic<int> sWorkCount(0);
+
+static void CountWork(intptr_t arg)
+{
+    sWorkCount.fetch_add(1);
+}
+
+// Wait up to 5 seconds for the CHIP task to have run count work items.
+static bool WaitForWorkCount(int count)
+{
+    const struct timespec pollInterval = { 0, 1000000 };
+
+    for (int i = 0; i < 5000 && sWorkCount.load() < count; i++)
+    {
+        nanosleep(&pollInterval, NULL);
+    }
+
+    return sWorkCount.load() >= count;
+}
+
+static const int kProducerCount   = 4;
+static const int kWorkPerProducer = 1000;
+static std::atomic<int> sPostedCount(0);
+
+static void * PostWorkMain(void * arg)
+{
+    for (int i = 0; i < kWorkPerProducer; i++)
+    {
+        // Keep the queue from filling up, so that no event is dropped.
+        while (sPostedCount.load() - sWorkCount.load() >= CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE / 2)
+        {
+            sched_yield();
+        }
+
+        sPostedCount.fetch_add(1);
+        PlatformMgr().ScheduleWork(CountWork);
+    }
+
+    return NULL;
+}
+
+static void TestPlatformMgr_PostEventMultipleProducers(nlTestSuite * inSuite, void * inContext)
+{
+    pthread_t producers[kProducerCount];
+
+    sWorkCount.store(0);
+    sPostedCount.store(0);
+
+    for (int i = 0; i < kProducerCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, pthread_create(&producers[i], NULL, PostWorkMain, NULL) == 0);
+    }
+
+    for (int i = 0; i < kProducerCount; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+
+    // Every event posted while the queue had room is delivered, once.
+    NL_TEST_ASSERT(inSuite, WaitForWorkCount(kProducerCount * kWorkPerProducer));
+    NL_TEST_ASSERT(inSuite, sWorkCount.load() == kProducerCount * kWorkPerProducer);
+}
+
+static void TestPlatformMgr_PostEventQueueFull(nlTestSuite * inSuite, void * inContext)
+{
+    const int kExtraWork = 5;
+
+    sWorkCount.store(0);
+
+    // Holding the stack lock keeps the CHIP task from draining the queue, so it fills up.
+    PlatformMgr().LockChipStack();
+    for (int i = 0; i < CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE + kExtraWork; i++)
+    {
+        PlatformMgr().ScheduleWork(CountWork);
+    }
+    PlatformMgr().UnlockChipStack();
+
+    // The events that did not fit are dropped; the others are still delivered.
+    WaitForWorkCount(CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE);
+    NL_TEST_ASSERT(inSuite, sWorkCount.load() > 0);
+    NL_TEST_ASSERT(inSuite, sWorkCount.load() <= CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE);
+
+    // The queue accepts events again once drained.
+    sWorkCount.store(0);
+    PlatformMgr().ScheduleWork(CountWork);
+    NL_TEST_ASSERT(inSuite, WaitForWorkCount(1));
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -96,6 +189,8 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test PlatformMgr::StartEventLoopTask", TestPlatformMgr_StartEventLoopTask),
     NL_TEST_DEF("Test PlatformMgr::TryLockChipStack", TestPlatformMgr_TryLockChipStack),
     NL_TEST_DEF("Test PlatformMgr::AddEventHandler", TestPlatformMgr_AddEventHandler),
+    NL_TEST_DEF("Test PlatformMgr::PostEventMultipleProducers", TestPlatformMgr_PostEventMultipleProducers),
+    NL_TEST_DEF("Test PlatformMgr::PostEventQueueFull", TestPlatformMgr_PostEventQueueFull),
 
     NL_TEST_SENTINEL()
 };
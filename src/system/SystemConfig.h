@@ -378,6 +378,72 @@
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX */
 #endif /* !CHIP_SYSTEM_CONFIG_USE_LWIP */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+ *
+ *  @brief
+ *      The number of small packet buffers, of #CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY bytes, pooled in addition to the
+ *      #CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC full-size ones in the BSD sockets configuration.
+ *
+ *      An allocation is served by the smallest pool whose buffers fit it and that still has a free buffer, so that standalone
+ *      acknowledgments and other short messages do not take up full-size buffers.
+ *
+ *      This may be set to zero (0) to not pool small buffers.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+ *
+ *  @brief
+ *      The capacity, including reserved header space, of the buffers in the small packet buffer pool.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY 128
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+ *
+ *  @brief
+ *      The number of medium packet buffers, of #CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY bytes, pooled in addition to the
+ *      #CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC full-size ones in the BSD sockets configuration.
+ *
+ *      This may be set to zero (0) to not pool medium buffers.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+ *
+ *  @brief
+ *      The capacity, including reserved header space, of the buffers in the medium packet buffer pool. It must lie between
+ *      #CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY and #CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY 512
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY */
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+ *
+ *  @brief
+ *      The number of free buffers of each pool that every thread may keep for itself in the pooled BSD sockets configuration.
+ *
+ *      Buffers are then allocated from and freed to the calling thread's cache without taking the pool lock, which is only taken
+ *      to move half a cache of buffers at a time between a cache and its pool. Buffers kept by one thread cannot be allocated by
+ *      another, so this should stay well below the size of each pool divided by the number of threads using packet buffers.
+ *
+ *      This requires support for \c thread_local. It may be set to zero (0) to disable the caches.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE */
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 
 /**
@@ -499,6 +565,18 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* CHIP_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) armed timers are kept in a binary min-heap, indexed by completion function and
+ *      application state, instead of being located by walking a sorted list (LwIP) or the whole timer pool (sockets). Arming and
+ *      cancelling a timer then take O(log n) time, at the cost of a few pointers per timer in each System Layer object.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+#define CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP 0
+#endif /* CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
@@ -609,6 +687,44 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_VALID_REAL_TIME_THRESHOLD 946684800
 #endif // CHIP_SYSTEM_CONFIG_VALID_REAL_TIME_THRESHOLD
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_USE_EPOLL
+ *
+ *  @brief
+ *      Use an epoll instance, rather than select(), to wait for socket I/O and timers.
+ *
+ *  When enabled, the system layer owns an epoll instance with its wake event and a timerfd registered in it, and the
+ *  event loop waits with epoll_wait() through Layer::PrepareEpoll() and Layer::HandleEpollResult(), then passes the
+ *  ready events to InetLayer::HandleEpollResult(). Each endpoint registers its socket in the same instance and updates
+ *  the events it waits for as its state changes (listening, connecting, queuing data to send, enabling or disabling
+ *  receive, closing) and after each of its I/O callbacks. This lifts the FD_SETSIZE limit on open sockets and makes
+ *  the cost of each loop iteration depend on the number of ready sockets. The select() interface remains available.
+ *
+ *  An endpoint's receive and connection handlers must therefore be set before the call that starts the I/O (Listen(),
+ *  Connect(), EnableReceive()) or from within one of its callbacks; a handler set at any other time takes effect at
+ *  the next such change.
+ *
+ *  Only supported on Linux with sockets. Defaults to disabled.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_USE_EPOLL
+#define CHIP_SYSTEM_CONFIG_USE_EPOLL 0
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL && !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__))
+#error "FORBIDDEN: CHIP_SYSTEM_CONFIG_USE_EPOLL without CHIP_SYSTEM_CONFIG_USE_SOCKETS on Linux"
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL && !(CHIP_SYSTEM_CONFIG_USE_SOCKETS && defined(__linux__))
+
+/**
+ *  @def CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+ *
+ *  @brief
+ *      The maximum number of ready file descriptors the event loop collects from one epoll_wait() call when
+ *      #CHIP_SYSTEM_CONFIG_USE_EPOLL is enabled. Further ready descriptors are reported by the next call.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+#define CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS 64
+#endif // CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_USE_POSIX_PIPE
  *
@@ -617,10 +733,11 @@ struct LwIPEvent;
  *
  *  Use the POSIX pipe() function to create an anonymous data stream.
  *
- *  Defaults to enabled if the system is using sockets (except for Zephyr RTOS).
+ *  Defaults to enabled if the system is using sockets (except for Zephyr RTOS, and when #CHIP_SYSTEM_CONFIG_USE_EPOLL
+ *  is enabled, where the wake event is an eventfd).
  */
 #ifndef CHIP_SYSTEM_CONFIG_USE_POSIX_PIPE
-#if (CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK) && !__ZEPHYR__
+#if (CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK) && !__ZEPHYR__ && !CHIP_SYSTEM_CONFIG_USE_EPOLL
 #define CHIP_SYSTEM_CONFIG_USE_POSIX_PIPE 1
 #endif
 #endif // CHIP_SYSTEM_CONFIG_USE_POSIX_PIPE
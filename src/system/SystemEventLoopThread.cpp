@@ -0,0 +1,167 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements an event loop that runs a system layer of its
+ *      own on a dedicated POSIX thread.
+ */
+
+#include <system/SystemEventLoopThread.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+// Include additional CHIP headers
+#include <support/CodeUtils.h>
+#include <support/ErrorStr.h>
+#include <support/logging/CHIPLogging.h>
+
+// Include system and language headers
+#include <errno.h>
+#include <sys/select.h>
+
+namespace chip {
+namespace System {
+
+EventLoopThread::EventLoopThread(void) : mShouldRun(false), mRunning(false) {}
+
+/**
+ *  Initialize the system layer of the event loop and start the thread that runs it.
+ *
+ *  @retval #CHIP_SYSTEM_ERROR_UNEXPECTED_STATE  If the event loop is already running.
+ *  @retval #CHIP_SYSTEM_NO_ERROR                On success.
+ *  @retval other                                Errors from initializing the system layer or creating the thread.
+ */
+Error EventLoopThread::Start(void)
+{
+    Error err = CHIP_SYSTEM_NO_ERROR;
+    int res;
+
+    VerifyOrExit(!mRunning, err = CHIP_SYSTEM_ERROR_UNEXPECTED_STATE);
+
+    err = mLayer.Init(NULL);
+    SuccessOrExit(err);
+
+    mShouldRun.store(true, std::memory_order_relaxed);
+
+    res = pthread_create(&mThread, NULL, ThreadMain, this);
+    if (res != 0)
+    {
+        mLayer.Shutdown();
+        ExitNow(err = MapErrorPOSIX(res));
+    }
+
+    mRunning = true;
+
+exit:
+    return err;
+}
+
+/**
+ *  Stop the event loop, waiting for the work in progress to finish, and shut down its system layer. Work and timers
+ *  that have not run yet are dropped without being called. Does nothing if the event loop is not running.
+ *
+ *  Must not be called from the thread of the event loop.
+ */
+Error EventLoopThread::Stop(void)
+{
+    VerifyOrExit(mRunning, );
+
+    mShouldRun.store(false, std::memory_order_relaxed);
+    mLayer.WakeSelect();
+    pthread_join(mThread, NULL);
+
+    mLayer.Shutdown();
+    mRunning = false;
+
+exit:
+    return CHIP_SYSTEM_NO_ERROR;
+}
+
+/**
+ *  Run a function on the thread of the event loop. May be called from any thread.
+ *
+ *  @param[in]  aWork      The function to run. It is passed the system layer of the event loop.
+ *  @param[in]  aAppState  The argument passed to the function.
+ *
+ *  @retval #CHIP_SYSTEM_ERROR_UNEXPECTED_STATE  If the event loop is not running.
+ *  @retval other                                Errors from Layer::ScheduleWork().
+ */
+Error EventLoopThread::ScheduleWork(Layer::TimerCompleteFunct aWork, void * aAppState)
+{
+    return mLayer.ScheduleWork(aWork, aAppState);
+}
+
+void * EventLoopThread::ThreadMain(void * aArg)
+{
+    static_cast<EventLoopThread *>(aArg)->Run();
+    return NULL;
+}
+
+void EventLoopThread::Run(void)
+{
+    while (mShouldRun.load(std::memory_order_relaxed))
+    {
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+        int eventCount;
+
+        mLayer.PrepareEpoll();
+        eventCount = epoll_wait(mLayer.GetEpollFD(), mEpollEvents, CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS, -1);
+        if (eventCount < 0)
+        {
+            if (errno != EINTR)
+            {
+                ChipLogError(chipSystemLayer, "epoll_wait failed: %s", ErrorStr(MapErrorPOSIX(errno)));
+            }
+            continue;
+        }
+        mLayer.HandleEpollResult(mEpollEvents, eventCount);
+#else  // CHIP_SYSTEM_CONFIG_USE_EPOLL
+        int maxFd = 0;
+        fd_set readSet;
+        fd_set writeSet;
+        fd_set errorSet;
+        struct timeval sleepTime;
+        int selectRes;
+
+        FD_ZERO(&readSet);
+        FD_ZERO(&writeSet);
+        FD_ZERO(&errorSet);
+
+        // Sleep until the next timer, which PrepareSelect() brings forward from this bound.
+        sleepTime.tv_sec  = 60 * 60;
+        sleepTime.tv_usec = 0;
+
+        mLayer.PrepareSelect(maxFd, &readSet, &writeSet, &errorSet, sleepTime);
+        selectRes = select(maxFd, &readSet, &writeSet, &errorSet, &sleepTime);
+        if (selectRes < 0)
+        {
+            if (errno != EINTR)
+            {
+                ChipLogError(chipSystemLayer, "select failed: %s", ErrorStr(MapErrorPOSIX(errno)));
+            }
+            continue;
+        }
+        mLayer.HandleSelectResult(selectRes, &readSet, &writeSet, &errorSet);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+    }
+}
+
+} // namespace System
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
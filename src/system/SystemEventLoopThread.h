@@ -0,0 +1,102 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares an event loop that runs a system layer of its
+ *      own on a dedicated POSIX thread.
+ */
+
+#ifndef SYSTEMEVENTLOOPTHREAD_H
+#define SYSTEMEVENTLOOPTHREAD_H
+
+// Include configuration headers
+#include <system/SystemConfig.h>
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+// Include dependent headers
+#include <system/SystemError.h>
+#include <system/SystemLayer.h>
+
+#include <support/DLLUtil.h>
+
+#include <atomic>
+#include <pthread.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+namespace chip {
+namespace System {
+
+/**
+ *  @class EventLoopThread
+ *
+ *  @brief
+ *      This class runs a system layer of its own on a dedicated thread, so that work can be moved off the thread of the
+ *      CHIP stack. Any thread may hand work to it with ScheduleWork(); the work runs on the dedicated thread, in the
+ *      order it was scheduled, and may start timers on GetLayer(). Work that must go back to the CHIP stack schedules it
+ *      on the system layer of the stack, which is also safe from any thread.
+ *
+ *      Each instance is started and stopped on its own. Work must not touch state used by other threads without
+ *      locking it.
+ *
+ */
+class DLL_EXPORT EventLoopThread
+{
+public:
+    EventLoopThread(void);
+
+    Error Start(void);
+    Error Stop(void);
+
+    bool IsRunning(void) const { return mRunning; }
+
+    Layer & GetLayer(void) { return mLayer; }
+
+    /**
+     *  Return the POSIX thread on which the event loop runs, e.g. to set its CPU affinity. Only valid while running.
+     */
+    pthread_t GetThread(void) const { return mThread; }
+
+    Error ScheduleWork(Layer::TimerCompleteFunct aWork, void * aAppState);
+
+private:
+    Layer mLayer;
+    pthread_t mThread;
+    std::atomic<bool> mShouldRun;
+    bool mRunning;
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    struct epoll_event mEpollEvents[CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS];
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+    static void * ThreadMain(void * aArg);
+    void Run(void);
+
+    // Not defined
+    EventLoopThread(const EventLoopThread &) = delete;
+    EventLoopThread & operator=(const EventLoopThread &) = delete;
+};
+
+} // namespace System
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#endif // SYSTEMEVENTLOOPTHREAD_H
@@ -46,6 +46,12 @@
 #include <unistd.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #if !CHIP_SYSTEM_CONFIG_PLATFORM_PROVIDES_EVENT_FUNCTIONS
 #include <lwip/err.h>
@@ -93,8 +99,10 @@ Layer::Layer() : mLayerState(kLayerState_NotInitialized), mContext(NULL), mPlatf
         sSystemEventHandlerDelegate.Init(HandleSystemLayerEvent);
 
     this->mEventDelegateList = NULL;
-    this->mTimerList         = NULL;
-    this->mTimerComplete     = false;
+#if !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    this->mTimerList = NULL;
+#endif // !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    this->mTimerComplete = false;
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -102,6 +110,13 @@ Layer::Layer() : mLayerState(kLayerState_NotInitialized), mContext(NULL), mPlatf
     this->mHandleSelectThread = PTHREAD_NULL;
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    this->mEpollFD      = -1;
+    this->mTimerFD      = -1;
+    this->mTimerFDArmed = false;
+    this->mTimerFDEpoch = 0;
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 Error Layer::Init(void * aContext)
@@ -122,6 +137,11 @@ Error Layer::Init(void * aContext)
     lReturn = Platform::Layer::WillInit(*this, aContext);
     SuccessOrExit(lReturn);
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    lReturn = this->mTimerQueue.Init();
+    SuccessOrExit(lReturn);
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     this->AddEventHandlerDelegate(sSystemEventHandlerDelegate);
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -132,6 +152,16 @@ Error Layer::Init(void * aContext)
     SuccessOrExit(lReturn);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    lReturn = this->OpenEpoll();
+    if (lReturn != CHIP_SYSTEM_NO_ERROR)
+    {
+        this->CloseEpoll();
+        this->mWakeEvent.Close();
+        ExitNow();
+    }
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
     this->mLayerState = kLayerState_Initialized;
     this->mContext    = aContext;
 
@@ -152,6 +182,10 @@ Error Layer::Shutdown()
     lReturn  = Platform::Layer::WillShutdown(*this, lContext);
     SuccessOrExit(lReturn);
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    this->CloseEpoll();
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
     mWakeEvent.Close();
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -320,6 +354,14 @@ void Layer::CancelTimer(Layer::TimerCompleteFunct aOnComplete, void * aAppState)
     if (this->State() != kLayerState_Initialized)
         return;
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    Timer * lTimer = mTimerQueue.Find(aOnComplete, aAppState);
+
+    if (lTimer != NULL)
+    {
+        lTimer->Cancel();
+    }
+#else  // !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
     for (size_t i = 0; i < Timer::sPool.Size(); ++i)
     {
         Timer * lTimer = Timer::sPool.Get(*this, i);
@@ -330,6 +372,7 @@ void Layer::CancelTimer(Layer::TimerCompleteFunct aOnComplete, void * aAppState)
             break;
         }
     }
+#endif // !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
 }
 
 /**
@@ -600,32 +643,7 @@ void Layer::PrepareSelect(int & aSetSize, fd_set * aReadSet, fd_set * aWriteSet,
     const Timer::Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
     Timer::Epoch lAwakenEpoch = kCurrentEpoch + static_cast<Timer::Epoch>(aSleepTime.tv_sec) * 1000 + aSleepTime.tv_usec / 1000;
 
-    for (size_t i = 0; i < Timer::sPool.Size(); i++)
-    {
-        Timer * lTimer = Timer::sPool.Get(*this, i);
-
-        if (lTimer != NULL)
-        {
-            if (!Timer::IsEarlierEpoch(kCurrentEpoch, lTimer->mAwakenEpoch))
-            {
-                lAwakenEpoch = kCurrentEpoch;
-                break;
-            }
-
-            if (Timer::IsEarlierEpoch(lTimer->mAwakenEpoch, lAwakenEpoch))
-                lAwakenEpoch = lTimer->mAwakenEpoch;
-        }
-    }
-
-    // check for an earlier callback timer, too
-    if (lAwakenEpoch != kCurrentEpoch)
-    {
-        Cancelable * ca = mTimerCallbacks.First();
-        if (ca != nullptr && !Timer::IsEarlierEpoch(kCurrentEpoch, ca->mInfoScalar))
-        {
-            lAwakenEpoch = ca->mInfoScalar;
-        }
-    }
+    this->GetAwakenEpoch(kCurrentEpoch, lAwakenEpoch);
 
     const Timer::Epoch kSleepTime = lAwakenEpoch - kCurrentEpoch;
     aSleepTime.tv_sec             = kSleepTime / 1000;
@@ -652,18 +670,12 @@ void Layer::PrepareSelect(int & aSetSize, fd_set * aReadSet, fd_set * aWriteSet,
  */
 void Layer::HandleSelectResult(int aSetSize, fd_set * aReadSet, fd_set * aWriteSet, fd_set * aExceptionSet)
 {
-    pthread_t lThreadSelf;
-
     if (this->State() != kLayerState_Initialized)
         return;
 
     if (aSetSize < 0)
         return;
 
-#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
-    lThreadSelf = pthread_self();
-#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
-
     if (aSetSize > 0)
     {
         // If we woke because of someone writing to the wake event, clear the event before returning.
@@ -671,12 +683,120 @@ void Layer::HandleSelectResult(int aSetSize, fd_set * aReadSet, fd_set * aWriteS
             this->mWakeEvent.Confirm();
     }
 
+    this->HandlePendingTimers();
+}
+
+/**
+ * Wake up the I/O thread that monitors the file descriptors using select() by writing a single byte to the wake pipe.
+ *
+ *  @note
+ *      If @p WakeSelect() is being called from within @p HandleSelectResult(), then writing to the wake pipe can be skipped,
+ * since the I/O thread is already awake.
+ *
+ *      Furthermore, we don't care if this write fails as the only reasonably likely failure is that the pipe is full, in which
+ *      case the select calling thread is going to wake up anyway.
+ */
+void Layer::WakeSelect()
+{
+    if (this->State() != kLayerState_Initialized)
+        return;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    if (pthread_equal(this->mHandleSelectThread, pthread_self()))
+    {
+        return;
+    }
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+    // Send notification to wake up the select call.
+    this->mWakeEvent.Notify();
+}
+
+/**
+ *  Lowers @p aAwakenEpoch to the time at which the earliest pending timer or timer callback is due, or to @p aCurrentEpoch if
+ *  one is already due.
+ *
+ *  @param[in]      aCurrentEpoch   The current time.
+ *  @param[inout]   aAwakenEpoch    The latest time to wake up at.
+ *
+ *  @return true if any timer or timer callback is pending, otherwise false.
+ */
+bool Layer::GetAwakenEpoch(Timer::Epoch aCurrentEpoch, Timer::Epoch & aAwakenEpoch)
+{
+    bool lPending = false;
+
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    Timer * lEarliest = mTimerQueue.Earliest();
+
+    if (lEarliest != NULL)
+    {
+        lPending = true;
+
+        if (!Timer::IsEarlierEpoch(aCurrentEpoch, lEarliest->mAwakenEpoch))
+            aAwakenEpoch = aCurrentEpoch;
+        else if (Timer::IsEarlierEpoch(lEarliest->mAwakenEpoch, aAwakenEpoch))
+            aAwakenEpoch = lEarliest->mAwakenEpoch;
+    }
+#else  // !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    for (size_t i = 0; i < Timer::sPool.Size(); i++)
+    {
+        Timer * lTimer = Timer::sPool.Get(*this, i);
+
+        if (lTimer != NULL)
+        {
+            lPending = true;
+
+            if (!Timer::IsEarlierEpoch(aCurrentEpoch, lTimer->mAwakenEpoch))
+            {
+                aAwakenEpoch = aCurrentEpoch;
+                break;
+            }
+
+            if (Timer::IsEarlierEpoch(lTimer->mAwakenEpoch, aAwakenEpoch))
+                aAwakenEpoch = lTimer->mAwakenEpoch;
+        }
+    }
+#endif // !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+
+    // check for an earlier callback timer, too
+    Cancelable * ca = mTimerCallbacks.First();
+    if (ca != nullptr)
+    {
+        lPending = true;
+
+        if (!Timer::IsEarlierEpoch(aCurrentEpoch, ca->mInfoScalar))
+            aAwakenEpoch = aCurrentEpoch;
+        else if (Timer::IsEarlierEpoch(ca->mInfoScalar, aAwakenEpoch))
+            aAwakenEpoch = ca->mInfoScalar;
+    }
+
+    return lPending;
+}
+
+/**
+ *  Run the timers and timer callbacks that are due.
+ */
+void Layer::HandlePendingTimers(void)
+{
     const Timer::Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
 
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
-    this->mHandleSelectThread = lThreadSelf;
+    this->mHandleSelectThread = pthread_self();
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    // Bound the number of timers handled in one pass, as the pool walk below does, so that timers re-armed by their own
+    // callbacks with a zero delay do not starve I/O.
+    for (size_t i = 0; i < Timer::sPool.Size(); i++)
+    {
+        Timer * lTimer = mTimerQueue.Earliest();
+
+        if (lTimer == NULL || Timer::IsEarlierEpoch(kCurrentEpoch, lTimer->mAwakenEpoch))
+            break;
+
+        lTimer->HandleComplete();
+    }
+#else  // !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
     for (size_t i = 0; i < Timer::sPool.Size(); i++)
     {
         Timer * lTimer = Timer::sPool.Get(*this, i);
@@ -686,6 +806,7 @@ void Layer::HandleSelectResult(int aSetSize, fd_set * aReadSet, fd_set * aWriteS
             lTimer->HandleComplete();
         }
     }
+#endif // !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
 
     DispatchTimerCallbacks(kCurrentEpoch);
 
@@ -694,32 +815,179 @@ void Layer::HandleSelectResult(int aSetSize, fd_set * aReadSet, fd_set * aWriteS
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+// epoll_data.u64 values of the file descriptors registered by the system layer.
+static const uint64_t kEpollToken_WakeEvent = 0;
+static const uint64_t kEpollToken_Timer     = 1;
+
+// The longest delay the timer file descriptor is armed for; an event loop pass re-arms it when it expires.
+static const Timer::Epoch kMaxTimerFDDelay = UINT32_MAX;
+
+Error Layer::OpenEpoll(void)
+{
+    Error lReturn;
+
+    this->mEpollFD = epoll_create1(EPOLL_CLOEXEC);
+    if (this->mEpollFD < 0)
+        return chip::System::MapErrorPOSIX(errno);
+
+    this->mTimerFD = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (this->mTimerFD < 0)
+        return chip::System::MapErrorPOSIX(errno);
+
+    this->mTimerFDArmed = false;
+
+    lReturn = this->WatchFD(this->mWakeEvent.GetNotifFD(), EPOLLIN, kEpollToken_WakeEvent, false);
+    SuccessOrExit(lReturn);
+
+    lReturn = this->WatchFD(this->mTimerFD, EPOLLIN, kEpollToken_Timer, false);
+    SuccessOrExit(lReturn);
+
+exit:
+    return lReturn;
+}
+
+void Layer::CloseEpoll(void)
+{
+    if (this->mTimerFD >= 0)
+        (void) ::close(this->mTimerFD);
+
+    if (this->mEpollFD >= 0)
+        (void) ::close(this->mEpollFD);
+
+    this->mTimerFD      = -1;
+    this->mEpollFD      = -1;
+    this->mTimerFDArmed = false;
+}
+
 /**
- * Wake up the I/O thread that monitors the file descriptors using select() by writing a single byte to the wake pipe.
+ *  Register a file descriptor with the epoll instance, or change the events it is watched for.
+ *
+ *  @param[in]  aFD         The file descriptor.
+ *  @param[in]  aEvents     The (level triggered) epoll events to watch for.
+ *  @param[in]  aToken      The value reported in epoll_data.u64 when the file descriptor is ready; must be greater than
+ *                          kEpollToken_MaxSystem.
+ *  @param[in]  aIsWatched  Whether the file descriptor is expected to be registered already.
  *
  *  @note
- *      If @p WakeSelect() is being called from within @p HandleSelectResult(), then writing to the wake pipe can be skipped,
- * since the I/O thread is already awake.
+ *      Closing a file descriptor removes it from the epoll instance.
+ */
+Error Layer::WatchFD(int aFD, uint32_t aEvents, uint64_t aToken, bool aIsWatched)
+{
+    struct epoll_event lEvent;
+
+    memset(&lEvent, 0, sizeof(lEvent));
+    lEvent.events   = aEvents;
+    lEvent.data.u64 = aToken;
+
+    if (epoll_ctl(this->mEpollFD, aIsWatched ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, aFD, &lEvent) == 0)
+        return CHIP_SYSTEM_NO_ERROR;
+
+    // The caller's view is stale, e.g. the descriptor was closed and its number reused; retry with the other operation.
+    if (errno != (aIsWatched ? ENOENT : EEXIST))
+        return chip::System::MapErrorPOSIX(errno);
+
+    if (epoll_ctl(this->mEpollFD, aIsWatched ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, aFD, &lEvent) != 0)
+        return chip::System::MapErrorPOSIX(errno);
+
+    return CHIP_SYSTEM_NO_ERROR;
+}
+
+/**
+ *  Remove a file descriptor from the epoll instance.
  *
- *      Furthermore, we don't care if this write fails as the only reasonably likely failure is that the pipe is full, in which
- *      case the select calling thread is going to wake up anyway.
+ *  @param[in]  aFD  The file descriptor.
  */
-void Layer::WakeSelect()
+Error Layer::UnwatchFD(int aFD)
+{
+    struct epoll_event lEvent;
+
+    // Kernels before 2.6.9 require a non-null event, even though it is ignored.
+    memset(&lEvent, 0, sizeof(lEvent));
+
+    if (epoll_ctl(this->mEpollFD, EPOLL_CTL_DEL, aFD, &lEvent) != 0 && errno != ENOENT)
+        return chip::System::MapErrorPOSIX(errno);
+
+    return CHIP_SYSTEM_NO_ERROR;
+}
+
+/**
+ *  Arm the timer file descriptor for the earliest pending timer. Call this before each epoll_wait() on GetEpollFD().
+ *
+ *  The timer file descriptor is only re-armed when the earliest timer changes.
+ */
+void Layer::PrepareEpoll(void)
 {
+    struct itimerspec lTimerSpec;
+
     if (this->State() != kLayerState_Initialized)
         return;
 
-#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
-    if (pthread_equal(this->mHandleSelectThread, pthread_self()))
+    const Timer::Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
+    Timer::Epoch lAwakenEpoch        = kCurrentEpoch + kMaxTimerFDDelay;
+    const bool kPending              = this->GetAwakenEpoch(kCurrentEpoch, lAwakenEpoch);
+
+    if (kPending == this->mTimerFDArmed && (!kPending || lAwakenEpoch == this->mTimerFDEpoch))
+        return;
+
+    memset(&lTimerSpec, 0, sizeof(lTimerSpec));
+
+    if (kPending)
+    {
+        const Timer::Epoch kDelay = lAwakenEpoch - kCurrentEpoch;
+
+        lTimerSpec.it_value.tv_sec  = static_cast<time_t>(kDelay / 1000);
+        lTimerSpec.it_value.tv_nsec = static_cast<long>((kDelay % 1000) * 1000000);
+
+        // An all zero value disarms the timer, so fire a timer that is already due after one nanosecond.
+        if (kDelay == 0)
+            lTimerSpec.it_value.tv_nsec = 1;
+    }
+
+    if (timerfd_settime(this->mTimerFD, 0, &lTimerSpec, NULL) == 0)
     {
+        this->mTimerFDArmed = kPending;
+        this->mTimerFDEpoch = lAwakenEpoch;
+    }
+}
+
+/**
+ *  Handle the events from an epoll_wait() call on GetEpollFD() that concern the system layer, then run the timers that are
+ *  due. Events for file descriptors registered by other layers are ignored.
+ *
+ *  @param[in]  aEvents      The events returned by epoll_wait().
+ *  @param[in]  aEventCount  The return value of epoll_wait().
+ */
+void Layer::HandleEpollResult(const struct epoll_event * aEvents, int aEventCount)
+{
+    if (this->State() != kLayerState_Initialized)
         return;
+
+    if (aEventCount < 0)
+        return;
+
+    for (int i = 0; i < aEventCount; i++)
+    {
+        if (aEvents[i].data.u64 == kEpollToken_WakeEvent)
+        {
+            // If we woke because of someone writing to the wake event, clear the event before returning.
+            this->mWakeEvent.Confirm();
+        }
+        else if (aEvents[i].data.u64 == kEpollToken_Timer)
+        {
+            uint64_t lExpirations;
+
+            (void) ::read(this->mTimerFD, &lExpirations, sizeof(lExpirations));
+            this->mTimerFDArmed = false;
+        }
     }
-#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 
-    // Send notification to wake up the select call.
-    this->mWakeEvent.Notify();
+    this->HandlePendingTimers();
 }
 
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
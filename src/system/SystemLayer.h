@@ -35,6 +35,7 @@
 #include <system/SystemError.h>
 #include <system/SystemEvent.h>
 #include <system/SystemObject.h>
+#include <system/SystemTimer.h>
 
 // Include dependent headers
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS
@@ -43,6 +44,10 @@
 #include <sys/select.h>
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+#include <sys/epoll.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 #include <pthread.h>
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
@@ -154,6 +159,20 @@ public:
     void WakeSelect(void);
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    /**
+     * Values of epoll_data.u64 up to this one identify file descriptors registered by the system layer itself; other
+     * layers registering descriptors in the epoll instance must use larger values.
+     */
+    static const uint64_t kEpollToken_MaxSystem = UINT32_MAX;
+
+    int GetEpollFD(void) const;
+    Error WatchFD(int aFD, uint32_t aEvents, uint64_t aToken, bool aIsWatched);
+    Error UnwatchFD(int aFD);
+    void PrepareEpoll(void);
+    void HandleEpollResult(const struct epoll_event * aEvents, int aEventCount);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     typedef Error (*EventHandler)(Object & aTarget, EventType aEventType, uintptr_t aArgument);
     Error AddEventHandlerDelegate(LwIPEventHandlerDelegate & aDelegate);
@@ -181,11 +200,17 @@ private:
     void * mPlatformData;
     chip::Callback::CallbackDeque mTimerCallbacks;
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    TimerQueue mTimerQueue;
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     static LwIPEventHandlerDelegate sSystemEventHandlerDelegate;
 
     const LwIPEventHandlerDelegate * mEventDelegateList;
+#if !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
     Timer * mTimerList;
+#endif // !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
     bool mTimerComplete;
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
@@ -196,6 +221,21 @@ private:
 #endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    int mEpollFD;
+    int mTimerFD;
+    bool mTimerFDArmed;
+    Timer::Epoch mTimerFDEpoch;
+
+    Error OpenEpoll(void);
+    void CloseEpoll(void);
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+    bool GetAwakenEpoch(Timer::Epoch aCurrentEpoch, Timer::Epoch & aAwakenEpoch);
+    void HandlePendingTimers(void);
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     static Error HandleSystemLayerEvent(Object & aTarget, EventType aEventType, uintptr_t aArgument);
 
@@ -223,6 +263,16 @@ inline LayerState Layer::State(void) const
     return this->mLayerState;
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+/**
+ * This returns the epoll instance to wait on, which is only valid while the layer is initialized.
+ */
+inline int Layer::GetEpollFD(void) const
+{
+    return this->mEpollFD;
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_EPOLL
+
 } // namespace System
 } // namespace chip
 
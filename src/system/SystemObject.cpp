@@ -53,6 +53,11 @@ DLL_EXPORT void Object::Release(void)
     {
         this->mSystemLayer = NULL;
         __sync_synchronize();
+
+        if (this->mPool != NULL)
+        {
+            this->mPool->ReleaseIndex(this->mPoolIndex);
+        }
     }
     else if (oldCount == 0)
     {
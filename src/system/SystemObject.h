@@ -22,6 +22,7 @@
  *      templates:
  *
  *        - class chip::System::Object
+ *        - class chip::System::ObjectPoolBase
  *        - template<typename ALIGN, size_t SIZE> union chip::System::ObjectArena
  *        - template<class T, unsigned int N> class chip::System::ObjectPool
  */
@@ -51,6 +52,7 @@ namespace System {
 
 // Forward class and class template declarations
 class Layer;
+class ObjectPoolBase;
 template <class T, unsigned int N>
 class ObjectPool;
 
@@ -96,6 +98,9 @@ protected:
     void DeferredRelease(ReleaseDeferralErrorTactic aTactic);
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+    /** The index of the object in the pool it was allocated from, which identifies it within that pool. */
+    unsigned int PoolIndex(void) const { return mPoolIndex; }
+
 private:
     Object(void);
     ~Object(void);
@@ -104,6 +109,8 @@ private:
 
     Layer * volatile mSystemLayer; /**< Pointer to the layer object that owns this object. */
     unsigned int mRefCount;        /**< Count of remaining calls to Release before object is dead. */
+    ObjectPoolBase * mPool;        /**< Pointer to the pool the object was allocated from. */
+    unsigned int mPoolIndex;       /**< Index of the object in its pool. */
 
     /** If not already retained, attempt initial retention of this object for \c aLayer and zero up to \c aOctets. */
     bool TryCreate(Layer & aLayer, size_t aOctets);
@@ -151,6 +158,107 @@ inline Object::Object(void) {}
 /** Deleted. */
 inline Object::~Object(void) {}
 
+/**
+ *  @brief
+ *      The part of ObjectPool<T, N> that does not depend on \c T or \c N: the bitmap of objects in use and the statistics
+ *      counters, which are updated without locking by ObjectPool<T, N>::TryCreate and by Object::Release.
+ *
+ *  @note
+ *      Like the rest of the pool, these members are valid when zero-initialized, so pools need no constructor.
+ */
+class ObjectPoolBase
+{
+protected:
+    typedef unsigned long BitmapWord;
+
+    enum
+    {
+        kBitsPerWord = sizeof(BitmapWord) * 8
+    };
+
+    int ClaimIndex(volatile BitmapWord * aInUse, unsigned int aSize);
+    void ReleaseIndex(unsigned int aIndex);
+
+    volatile BitmapWord * mInUse; /**< Bitmap of objects in use, published by the first allocation for Object::Release. */
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    void UpdateHighWatermark(const unsigned int & aCandidate);
+    volatile unsigned int mNumInUse;
+    volatile unsigned int mHighWatermark;
+#endif
+
+private:
+    friend class Object;
+};
+
+/**
+ *  @brief
+ *      Marks the first object not in use in a pool of \c aSize objects, whose bitmap is \c aInUse, as in use.
+ *
+ *  @return the index of the object, or -1 if all objects are in use.
+ */
+inline int ObjectPoolBase::ClaimIndex(volatile BitmapWord * aInUse, unsigned int aSize)
+{
+    for (unsigned int lWord = 0; lWord * kBitsPerWord < aSize; ++lWord)
+    {
+        const unsigned int lNumBits = aSize - lWord * kBitsPerWord;
+        BitmapWord lValid           = ~static_cast<BitmapWord>(0);
+        BitmapWord lInUse           = __atomic_load_n(&aInUse[lWord], __ATOMIC_RELAXED);
+
+        if (lNumBits < kBitsPerWord)
+            lValid = (static_cast<BitmapWord>(1) << lNumBits) - 1;
+
+        while ((~lInUse & lValid) != 0)
+        {
+            const unsigned int lBit = static_cast<unsigned int>(__builtin_ctzl(~lInUse & lValid));
+
+            if (__sync_bool_compare_and_swap(&aInUse[lWord], lInUse, lInUse | (static_cast<BitmapWord>(1) << lBit)))
+            {
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+                UpdateHighWatermark(__sync_add_and_fetch(&mNumInUse, 1));
+#endif
+                return static_cast<int>(lWord * kBitsPerWord + lBit);
+            }
+
+            lInUse = __atomic_load_n(&aInUse[lWord], __ATOMIC_RELAXED);
+        }
+    }
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    UpdateHighWatermark(aSize);
+#endif
+
+    return -1;
+}
+
+/**
+ *  @brief
+ *      Marks the object at \c aIndex as no longer in use.
+ */
+inline void ObjectPoolBase::ReleaseIndex(unsigned int aIndex)
+{
+    volatile BitmapWord * lInUse = __atomic_load_n(&mInUse, __ATOMIC_ACQUIRE);
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    __sync_fetch_and_sub(&mNumInUse, 1);
+#endif
+
+    __sync_fetch_and_and(&lInUse[aIndex / kBitsPerWord], ~(static_cast<BitmapWord>(1) << (aIndex % kBitsPerWord)));
+}
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+inline void ObjectPoolBase::UpdateHighWatermark(const unsigned int & aCandidate)
+{
+    unsigned int lTmp;
+
+    while (aCandidate > (lTmp = mHighWatermark))
+    {
+        SYSTEM_OBJECT_HWM_TEST_HOOK();
+        (void) __sync_bool_compare_and_swap(&mHighWatermark, lTmp, aCandidate);
+    }
+}
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
 /**
  *  @brief
  *      A union template used for representing a well-aligned block of memory.
@@ -173,7 +281,7 @@ union ObjectArena
  *  @tparam     N   a positive integer number of objects of class T to allocate from the arena.
  */
 template <class T, unsigned int N>
-class ObjectPool
+class ObjectPool : public ObjectPoolBase
 {
 public:
     static size_t Size(void);
@@ -186,12 +294,7 @@ private:
     friend class TestObject;
 
     ObjectArena<void *, N * sizeof(T)> mArena;
-
-#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
-    void GetNumObjectsInUse(unsigned int aStartIndex, unsigned int & aNumInUse);
-    void UpdateHighWatermark(const unsigned int & aCandidate);
-    volatile unsigned int mHighWatermark;
-#endif
+    volatile BitmapWord mInUseWords[(N + kBitsPerWord - 1) / kBitsPerWord];
 };
 
 /**
@@ -224,89 +327,38 @@ inline T * ObjectPool<T, N>::Get(const Layer & aLayer, size_t aIndex)
 /**
  *  @brief
  *      Tries to initially retain the first object in the pool that is not retained by any layer.
+ *
+ *  @note
+ *      Free objects are found through the pool's bitmap, one word of objects at a time, rather than by trying each object.
  */
 template <class T, unsigned int N>
 inline T * ObjectPool<T, N>::TryCreate(Layer & aLayer)
 {
     T * lReturn = NULL;
-    unsigned int lIndex;
-#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
-    unsigned int lNumInUse = 0;
-#endif
+    int lIndex;
 
-    for (lIndex = 0; lIndex < N; ++lIndex)
-    {
-        T & lObject = reinterpret_cast<T *>(mArena.uMemory)[lIndex];
+    // A zeroed pool has not yet told its base where the bitmap is. The first allocation publishes it for Object::Release,
+    // with atomic accesses only, as allocations may run on several threads at once.
+    if (__atomic_load_n(&mInUse, __ATOMIC_ACQUIRE) == NULL)
+        __atomic_store_n(&mInUse, &mInUseWords[0], __ATOMIC_RELEASE);
 
-        if (lObject.TryCreate(aLayer, sizeof(T)))
-        {
-            lReturn = &lObject;
-            break;
-        }
-    }
+    lIndex = ClaimIndex(mInUseWords, N);
 
-#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
-    if (lReturn != NULL)
-    {
-        lIndex++;
-        lNumInUse = lIndex;
-        GetNumObjectsInUse(lIndex, lNumInUse);
-    }
-    else
-    {
-        lNumInUse = N;
-    }
-
-    UpdateHighWatermark(lNumInUse);
-#endif
-
-    return lReturn;
-}
-
-#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
-template <class T, unsigned int N>
-inline void ObjectPool<T, N>::UpdateHighWatermark(const unsigned int & aCandidate)
-{
-    unsigned int lTmp;
-
-    while (aCandidate > (lTmp = mHighWatermark))
-    {
-        SYSTEM_OBJECT_HWM_TEST_HOOK();
-        (void) __sync_bool_compare_and_swap(&mHighWatermark, lTmp, aCandidate);
-    }
-}
-
-/**
- * Return the number of objects in use starting at a given index
- *
- * @param[in] aStartIndex      The index to start counting from; pass 0 to count over
- *                             the whole pool.
- * @param[in/out] aNumInUse    The number of objects in use. If aStartIndex is not 0,
- *                             the function adds to the counter without resetting it first.
- */
-template <class T, unsigned int N>
-inline void ObjectPool<T, N>::GetNumObjectsInUse(unsigned int aStartIndex, unsigned int & aNumInUse)
-{
-    unsigned int count = 0;
-
-    for (unsigned int lIndex = aStartIndex; lIndex < N; ++lIndex)
+    if (lIndex >= 0)
     {
         T & lObject = reinterpret_cast<T *>(mArena.uMemory)[lIndex];
 
-        if (lObject.mSystemLayer != NULL)
-        {
-            count++;
-        }
-    }
+        lObject.mPool      = this;
+        lObject.mPoolIndex = static_cast<unsigned int>(lIndex);
 
-    if (aStartIndex == 0)
-    {
-        aNumInUse = 0;
+        if (lObject.TryCreate(aLayer, sizeof(T)))
+            lReturn = &lObject;
+        else
+            ReleaseIndex(static_cast<unsigned int>(lIndex));
     }
 
-    aNumInUse += count;
+    return lReturn;
 }
-#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
 
 template <class T, unsigned int N>
 inline void ObjectPool<T, N>::GetStatistics(chip::System::Stats::count_t & aNumInUse, chip::System::Stats::count_t & aHighWatermark)
@@ -315,7 +367,7 @@ inline void ObjectPool<T, N>::GetStatistics(chip::System::Stats::count_t & aNumI
     unsigned int lNumInUse;
     unsigned int lHighWatermark;
 
-    GetNumObjectsInUse(0, lNumInUse);
+    lNumInUse      = mNumInUse;
     lHighWatermark = mHighWatermark;
 
     if (lNumInUse > CHIP_SYS_STATS_COUNT_MAX)
@@ -61,9 +61,67 @@ namespace System {
 #if !CHIP_SYSTEM_CONFIG_USE_LWIP
 #if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+static_assert(CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY < CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX,
+              "small packet buffers must be smaller than full-size ones");
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+static_assert(CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY < CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX,
+              "medium packet buffers must be smaller than full-size ones");
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+static_assert(CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY < CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY,
+              "small packet buffers must be smaller than medium ones");
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+
+template <size_t kCapacity>
+union SizedBufferPoolElement
+{
+    PacketBuffer Header;
+    uint8_t Block[CHIP_SYSTEM_PACKETBUFFER_HEADER_SIZE + kCapacity];
+};
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+static SizedBufferPoolElement<CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY>
+    sSmallBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC];
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+static SizedBufferPoolElement<CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY>
+    sMediumBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC];
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+
 static BufferPoolElement sBufferPool[CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC];
 
-PacketBuffer * PacketBuffer::sFreeList = PacketBuffer::BuildFreeList();
+/**
+ * A pool of packet buffers of one capacity, and the list of its free buffers.
+ */
+struct PacketBuffer::PoolClass
+{
+    uint8_t * Storage;
+    size_t ElementSize;
+    size_t NumElements;
+    size_t Capacity;
+    PacketBuffer * FreeList;
+};
+
+// The pools, by increasing capacity. A buffer is allocated from the first one that fits it and is not exhausted.
+PacketBuffer::PoolClass PacketBuffer::sPoolClasses[kNumPoolClasses] = {
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+    { sSmallBufferPool[0].Block, sizeof(sSmallBufferPool[0]), CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC,
+      CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY, NULL },
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    { sMediumBufferPool[0].Block, sizeof(sMediumBufferPool[0]), CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC,
+      CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY, NULL },
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+    { sBufferPool[0].Block, sizeof(sBufferPool[0]), CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC,
+      CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX, NULL },
+};
+
+bool PacketBuffer::sPoolsBuilt = PacketBuffer::BuildFreeList();
 
 #if !CHIP_SYSTEM_CONFIG_NO_LOCKING
 static Mutex sBufferPoolMutex;
@@ -430,9 +488,13 @@ void PacketBuffer::AddRef()
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
     pbuf_ref(this);
 #else  // !CHIP_SYSTEM_CONFIG_USE_LWIP
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC && CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+    __atomic_add_fetch(&this->ref, 1, __ATOMIC_RELAXED);
+#else  // !(CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC && CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE)
     LOCK_BUF_POOL();
     ++this->ref;
     UNLOCK_BUF_POOL();
+#endif // !(CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC && CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE)
 #endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
 }
 
@@ -471,17 +533,12 @@ PacketBuffer * PacketBuffer::NewWithAvailableSize(uint16_t aReservedSize, size_t
 
     static_cast<void>(lBlockSize);
 
-    LOCK_BUF_POOL();
-
-    lPacket = sFreeList;
+    lPacket = PacketBuffer::AllocFromPool(lAllocSize);
     if (lPacket != NULL)
     {
-        sFreeList = static_cast<PacketBuffer *>(lPacket->next);
         SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
     }
 
-    UNLOCK_BUF_POOL();
-
 #else // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
     lPacket = reinterpret_cast<PacketBuffer *>(malloc(lBlockSize));
@@ -581,7 +638,29 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
         SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS();
     }
 
-#else // !CHIP_SYSTEM_CONFIG_USE_LWIP
+#elif CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC && CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+
+    // Buffers go to the calling thread's cache, so the pool lock is not taken here, and reference counts are updated atomically.
+    while (aPacket != NULL)
+    {
+        PacketBuffer * lNextPacket = static_cast<PacketBuffer *>(aPacket->next);
+
+        VerifyOrDieWithMsg(aPacket->ref > 0, chipSystemLayer, "SystemPacketBuffer::Free: aPacket->ref = 0");
+
+        if (__atomic_sub_fetch(&aPacket->ref, 1, __ATOMIC_ACQ_REL) == 0)
+        {
+            SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
+            aPacket->Clear();
+            PacketBuffer::ReleaseToPool(aPacket);
+            aPacket = lNextPacket;
+        }
+        else
+        {
+            aPacket = NULL;
+        }
+    }
+
+#else  // !CHIP_SYSTEM_CONFIG_USE_LWIP
 
     LOCK_BUF_POOL();
 
@@ -597,12 +676,11 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
             aPacket->Clear();
 #if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
-            aPacket->next = sFreeList;
-            sFreeList     = aPacket;
+            PacketBuffer::ReleaseToPool(aPacket);
 #else  // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
             free(aPacket);
 #endif // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
-            aPacket       = lNextPacket;
+            aPacket = lNextPacket;
         }
         else
         {
@@ -672,21 +750,181 @@ PacketBuffer * PacketBuffer::RightSize(PacketBuffer * aPacket)
 
 #if !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
-PacketBuffer * PacketBuffer::BuildFreeList()
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+
+/**
+ * The free buffers of each pool kept by one thread. They are returned to the pools when the thread exits.
+ */
+struct PacketBuffer::ThreadCache
+{
+    enum
+    {
+        kSize = CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE,
+        // Buffers moved between a cache and its pool at a time, leaving room for both allocations and frees.
+        kBatchSize = (CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE + 1) / 2
+    };
+
+    ~ThreadCache(void);
+
+    PacketBuffer * Buffers[kNumPoolClasses][kSize];
+    size_t Count[kNumPoolClasses];
+};
+
+thread_local PacketBuffer::ThreadCache PacketBuffer::sThreadCache;
+
+PacketBuffer::ThreadCache::~ThreadCache(void)
 {
-    PacketBuffer * lHead = NULL;
+    LOCK_BUF_POOL();
 
-    for (int i = 0; i < CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC; i++)
+    for (size_t i = 0; i < kNumPoolClasses; i++)
     {
-        PacketBuffer * lCursor = &sBufferPool[i].Header;
-        lCursor->next          = lHead;
-        lCursor->ref           = 0;
-        lHead                  = lCursor;
+        while (Count[i] > 0)
+        {
+            PacketBuffer * lPacket   = Buffers[i][--Count[i]];
+            lPacket->next            = sPoolClasses[i].FreeList;
+            sPoolClasses[i].FreeList = lPacket;
+        }
+    }
+
+    UNLOCK_BUF_POOL();
+}
+
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+
+/**
+ * Take a free buffer from the smallest pool whose buffers can hold \c aAllocSize bytes and that is not exhausted.
+ *
+ *  @return a buffer, or \c NULL if every pool that fits is exhausted.
+ */
+PacketBuffer * PacketBuffer::AllocFromPool(size_t aAllocSize)
+{
+    PacketBuffer * lPacket = NULL;
+
+    for (size_t i = 0; i < kNumPoolClasses && lPacket == NULL; i++)
+    {
+        PoolClass & lClass = sPoolClasses[i];
+
+        if (lClass.Capacity < aAllocSize)
+            continue;
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+        ThreadCache & lCache = sThreadCache;
+
+        if (lCache.Count[i] == 0)
+        {
+            LOCK_BUF_POOL();
+
+            while (lCache.Count[i] < ThreadCache::kBatchSize && lClass.FreeList != NULL)
+            {
+                lCache.Buffers[i][lCache.Count[i]++] = lClass.FreeList;
+                lClass.FreeList                      = static_cast<PacketBuffer *>(lClass.FreeList->next);
+            }
+
+            UNLOCK_BUF_POOL();
+        }
+
+        if (lCache.Count[i] > 0)
+            lPacket = lCache.Buffers[i][--lCache.Count[i]];
+#else  // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+        LOCK_BUF_POOL();
+
+        lPacket = lClass.FreeList;
+        if (lPacket != NULL)
+            lClass.FreeList = static_cast<PacketBuffer *>(lPacket->next);
+
+        UNLOCK_BUF_POOL();
+#endif // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+    }
+
+    return lPacket;
+}
+
+/**
+ * Return a buffer whose reference count dropped to zero to its pool.
+ *
+ *  @note Without thread caches, this must be called with the pool lock held.
+ */
+void PacketBuffer::ReleaseToPool(PacketBuffer * aPacket)
+{
+    PoolClass * const lClass = PoolClassOf(aPacket);
+
+    VerifyOrDieWithMsg(lClass != NULL, chipSystemLayer, "buffer %p is not from a pool", aPacket);
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+    const size_t i       = static_cast<size_t>(lClass - sPoolClasses);
+    ThreadCache & lCache = sThreadCache;
+
+    if (lCache.Count[i] == ThreadCache::kSize)
+    {
+        LOCK_BUF_POOL();
+
+        while (lCache.Count[i] > ThreadCache::kSize - ThreadCache::kBatchSize)
+        {
+            PacketBuffer * lPacket = lCache.Buffers[i][--lCache.Count[i]];
+            lPacket->next          = lClass->FreeList;
+            lClass->FreeList       = lPacket;
+        }
+
+        UNLOCK_BUF_POOL();
+    }
+
+    lCache.Buffers[i][lCache.Count[i]++] = aPacket;
+#else  // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+    aPacket->next    = lClass->FreeList;
+    lClass->FreeList = aPacket;
+#endif // !CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+}
+
+/**
+ * Find the pool a buffer was allocated from.
+ *
+ *  @return the pool, or \c NULL if the buffer is not from any pool.
+ */
+PacketBuffer::PoolClass * PacketBuffer::PoolClassOf(const PacketBuffer * aPacket)
+{
+    const uintptr_t lAddress = reinterpret_cast<uintptr_t>(aPacket);
+
+    for (size_t i = 0; i < kNumPoolClasses; i++)
+    {
+        const uintptr_t lStart = reinterpret_cast<uintptr_t>(sPoolClasses[i].Storage);
+
+        if (lAddress >= lStart && lAddress < lStart + sPoolClasses[i].ElementSize * sPoolClasses[i].NumElements)
+            return &sPoolClasses[i];
+    }
+
+    return NULL;
+}
+
+size_t PacketBuffer::PoolAllocSize(void) const
+{
+    if (kNumPoolClasses == 1)
+        return CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX;
+
+    const PoolClass * const lClass = PoolClassOf(this);
+    return (lClass != NULL) ? lClass->Capacity : 0;
+}
+
+bool PacketBuffer::BuildFreeList()
+{
+    for (size_t i = 0; i < kNumPoolClasses; i++)
+    {
+        PoolClass & lClass   = sPoolClasses[i];
+        PacketBuffer * lHead = NULL;
+
+        for (size_t j = 0; j < lClass.NumElements; j++)
+        {
+            PacketBuffer * lCursor = reinterpret_cast<PacketBuffer *>(lClass.Storage + j * lClass.ElementSize);
+            lCursor->next          = lHead;
+            lCursor->ref           = 0;
+            lHead                  = lCursor;
+        }
+
+        lClass.FreeList = lHead;
     }
 
     Mutex::Init(sBufferPoolMutex);
 
-    return lHead;
+    return true;
 }
 
 #endif //  !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
@@ -133,9 +133,26 @@ public:
 
 private:
 #if !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
-    static PacketBuffer * sFreeList;
-
-    static PacketBuffer * BuildFreeList(void);
+    struct PoolClass;
+    struct ThreadCache;
+
+    enum
+    {
+        kNumPoolClasses =
+            1 + (CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC != 0) + (CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC != 0)
+    };
+
+    static PoolClass sPoolClasses[kNumPoolClasses];
+    static bool sPoolsBuilt;
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+    static thread_local ThreadCache sThreadCache;
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_THREAD_CACHE_SIZE
+
+    static bool BuildFreeList(void);
+    static PoolClass * PoolClassOf(const PacketBuffer * aPacket);
+    static PacketBuffer * AllocFromPool(size_t aAllocSize);
+    static void ReleaseToPool(PacketBuffer * aPacket);
+    size_t PoolAllocSize(void) const;
 #endif // !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
     void Clear(void);
@@ -223,8 +240,7 @@ inline size_t PacketBuffer::AllocSize(void) const
 #if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
     return static_cast<size_t>(this->alloc_size);
 #else  // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0
-    extern BufferPoolElement gDummyBufferPoolElement;
-    return sizeof(gDummyBufferPoolElement.Block) - CHIP_SYSTEM_PACKETBUFFER_HEADER_SIZE;
+    return this->PoolAllocSize();
 #endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0
 #endif // !CHIP_SYSTEM_CONFIG_USE_LWIP
 }
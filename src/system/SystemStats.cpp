@@ -55,6 +55,10 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #if INET_CONFIG_NUM_UDP_ENDPOINTS
     "InetLayer_NumUDPEpsInUse",
 #endif
+#if INET_CONFIG_NUM_UDP_ENDPOINTS && INET_CONFIG_ENABLE_UDP_BATCH_IO
+    "InetLayer_UDPRecvBatchSize",
+    "InetLayer_UDPSendBatchSize",
+#endif
 #if INET_CONFIG_NUM_TUN_ENDPOINTS
     "InetLayer_NumTunEpsInUse",
 #endif
@@ -66,6 +70,7 @@ static const Label sStatsStrings[chip::System::Stats::kNumEntries] = {
 #if CHIP_CONFIG_ENABLE_SERVICE_DIRECTORY
     "ServiceMgr_NumRequestsInUse",
 #endif
+    "PlatformMgr_NumDeviceEventsQueued",
 
 };
 
@@ -66,6 +66,10 @@ enum
 #if INET_CONFIG_NUM_UDP_ENDPOINTS
     kInetLayer_NumUDPEps,
 #endif
+#if INET_CONFIG_NUM_UDP_ENDPOINTS && INET_CONFIG_ENABLE_UDP_BATCH_IO
+    kInetLayer_UDPRecvBatchSize,
+    kInetLayer_UDPSendBatchSize,
+#endif
 #if INET_CONFIG_NUM_TUN_ENDPOINTS
     kInetLayer_NumTunEps,
 #endif
@@ -79,6 +83,7 @@ enum
 #if CHIP_CONFIG_ENABLE_SERVICE_DIRECTORY
     kServiceMgr_NumRequests,
 #endif
+    kPlatformMgr_NumDeviceEvents,
 
     kNumEntries
 };
@@ -171,6 +176,8 @@ const Label * GetStrings(void);
 
 #define SYSTEM_STATS_DECREMENT_BY_N(entry, count)
 
+#define SYSTEM_STATS_SET(entry, count)
+
 #define SYSTEM_STATS_RESET(entry)
 
 #define SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS()
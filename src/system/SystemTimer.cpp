@@ -135,7 +135,18 @@ Error Timer::Start(uint32_t aDelayMilliseconds, OnCompleteFunct aOnComplete, voi
         chipDie();
     }
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    lLayer.mTimerQueue.Insert(*this);
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
+    // this is the new earliest timer and so the timer needs (re-)starting provided that the system is not currently processing
+    // expired timers, in which case it is left to HandleExpiredTimers() to re-start the timer.
+    if (lLayer.mTimerQueue.Earliest() == this && !lLayer.mTimerComplete)
+    {
+        lLayer.StartPlatformTimer(aDelayMilliseconds);
+    }
+#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+#elif CHIP_SYSTEM_CONFIG_USE_LWIP
     // add to the sorted list of timers. Earliest timer appears first.
     if (lLayer.mTimerList == NULL || this->IsEarlierEpoch(this->mAwakenEpoch, lLayer.mTimerList->mAwakenEpoch))
     {
@@ -168,7 +179,7 @@ Error Timer::Start(uint32_t aDelayMilliseconds, OnCompleteFunct aOnComplete, voi
         this->mNextTimer   = lTimer->mNextTimer;
         lTimer->mNextTimer = this;
     }
-#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP / CHIP_SYSTEM_CONFIG_USE_LWIP
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
     lLayer.WakeSelect();
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
@@ -192,6 +203,9 @@ Error Timer::ScheduleWork(OnCompleteFunct aOnComplete, void * aAppState)
     err = lLayer.PostEvent(*this, chip::System::kEvent_ScheduleWork, 0);
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    lLayer.mTimerQueue.Insert(*this);
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
     lLayer.WakeSelect();
 #endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
 
@@ -205,9 +219,9 @@ Error Timer::ScheduleWork(OnCompleteFunct aOnComplete, void * aAppState)
  */
 Error Timer::Cancel()
 {
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
+#if CHIP_SYSTEM_CONFIG_USE_LWIP || CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
     Layer & lLayer = this->SystemLayer();
-#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+#endif // CHIP_SYSTEM_CONFIG_USE_LWIP || CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
     OnCompleteFunct lOnComplete = this->OnComplete;
 
     // Check if the timer is armed
@@ -218,7 +232,9 @@ Error Timer::Cancel()
     // Since this thread changed the state of OnComplete, release the timer.
     this->AppState = NULL;
 
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    lLayer.mTimerQueue.Remove(*this);
+#elif CHIP_SYSTEM_CONFIG_USE_LWIP
     if (lLayer.mTimerList)
     {
         if (this == lLayer.mTimerList)
@@ -243,7 +259,7 @@ Error Timer::Cancel()
 
         this->mNextTimer = NULL;
     }
-#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP / CHIP_SYSTEM_CONFIG_USE_LWIP
 
     this->Release();
 exit:
@@ -267,6 +283,9 @@ void Timer::HandleComplete()
 
     // Since this thread changed the state of OnComplete, release the timer.
     AppState = NULL;
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    lLayer.mTimerQueue.Remove(*this);
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
     this->Release();
 
     // Invoke the app's callback, if it's still valid.
@@ -300,18 +319,27 @@ Error Timer::HandleExpiredTimers(Layer & aLayer)
     // time outside the loop; that way timers set after the current tick will not be executed within this expiration window
     // regardless how long the processing of the currently expired timers took
     Epoch currentEpoch = Timer::GetCurrentEpoch();
+    Timer * lEarliest;
 
-    while (aLayer.mTimerList)
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    while ((lEarliest = aLayer.mTimerQueue.Earliest()) != NULL)
+#else  // !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    while ((lEarliest = aLayer.mTimerList) != NULL)
+#endif // !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
     {
         // limit the number of timers handled before the control is returned to the event queue.  The bound is similar to
         // (though not exactly same) as that on the sockets-based systems.
 
         // The platform timer API has MSEC resolution so expire any timer with less than 1 msec remaining.
-        if ((timersHandled < Timer::sPool.Size()) && Timer::IsEarlierEpoch(aLayer.mTimerList->mAwakenEpoch, currentEpoch + 1))
+        if ((timersHandled < Timer::sPool.Size()) && Timer::IsEarlierEpoch(lEarliest->mAwakenEpoch, currentEpoch + 1))
         {
-            Timer & lTimer    = *aLayer.mTimerList;
+            Timer & lTimer = *lEarliest;
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+            aLayer.mTimerQueue.Remove(lTimer);
+#else  // !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
             aLayer.mTimerList = lTimer.mNextTimer;
             lTimer.mNextTimer = NULL;
+#endif // !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
 
             aLayer.mTimerComplete = true;
             lTimer.HandleComplete();
@@ -327,9 +355,9 @@ Error Timer::HandleExpiredTimers(Layer & aLayer)
             currentEpoch = Timer::GetCurrentEpoch();
 
             // the next timer expires in the future, so set the delayMilliseconds to a non-zero value
-            if (currentEpoch < aLayer.mTimerList->mAwakenEpoch)
+            if (currentEpoch < lEarliest->mAwakenEpoch)
             {
-                delayMilliseconds = aLayer.mTimerList->mAwakenEpoch - currentEpoch;
+                delayMilliseconds = lEarliest->mAwakenEpoch - currentEpoch;
             }
             /*
              * StartPlatformTimer() accepts a 32bit value in milliseconds.  Epochs are 64bit numbers.  The only way in which this
@@ -348,5 +376,169 @@ Error Timer::HandleExpiredTimers(Layer & aLayer)
 }
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+/**
+ *  Initialize an empty timer queue.
+ *
+ *  @return CHIP_SYSTEM_NO_ERROR on success, or the error initializing the queue lock.
+ */
+Error TimerQueue::Init(void)
+{
+    mSize      = 0;
+    mNextOrder = 0;
+    mIndex.Clear();
+
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    return Mutex::Init(mLock);
+#else  // CHIP_SYSTEM_CONFIG_NO_LOCKING
+    return CHIP_SYSTEM_NO_ERROR;
+#endif // CHIP_SYSTEM_CONFIG_NO_LOCKING
+}
+
+/**
+ *  Add an armed timer to the queue. The timer's OnComplete, AppState and awaken epoch must already be set.
+ */
+void TimerQueue::Insert(Timer & aTimer)
+{
+    Lock();
+
+    // The queue has room for every timer in the pool, so this only fails on a double insertion.
+    VerifyOrDie(aTimer.mQueuePosition == 0 && mSize < kCapacity);
+
+    aTimer.mQueueHash  = Hash(aTimer.OnComplete, aTimer.AppState);
+    aTimer.mQueueOrder = mNextOrder++;
+    mIndex.Insert(aTimer.mQueueHash, &aTimer);
+
+    Place(aTimer, mSize++);
+    SiftUp(mSize - 1);
+
+    Unlock();
+}
+
+/**
+ *  Remove a timer from the queue, if it is queued.
+ */
+void TimerQueue::Remove(Timer & aTimer)
+{
+    Lock();
+
+    if (aTimer.mQueuePosition != 0)
+    {
+        const size_t lPosition = aTimer.mQueuePosition - 1;
+
+        mIndex.Remove(aTimer.mQueueHash, &aTimer, [](const Timer * aIndexed) { return aIndexed->mQueueHash; });
+        aTimer.mQueuePosition = 0;
+
+        if (lPosition != --mSize)
+        {
+            // Move the last timer into the hole, then restore the heap property in whichever direction it is violated.
+            Place(*mHeap[mSize], lPosition);
+            SiftDown(lPosition);
+            SiftUp(lPosition);
+        }
+    }
+
+    Unlock();
+}
+
+/**
+ *  @return the queued timer with the earliest awaken epoch, or NULL when the queue is empty.
+ */
+Timer * TimerQueue::Earliest(void)
+{
+    Timer * lTimer;
+
+    Lock();
+    lTimer = (mSize > 0) ? mHeap[0] : NULL;
+    Unlock();
+
+    return lTimer;
+}
+
+/**
+ *  @return a queued timer armed with the given completion function and application state, or NULL if there is none.
+ */
+Timer * TimerQueue::Find(Timer::OnCompleteFunct aOnComplete, void * aAppState)
+{
+    Timer * lTimer;
+
+    Lock();
+    lTimer = mIndex.Find(Hash(aOnComplete, aAppState), [aOnComplete, aAppState](const Timer * aIndexed) {
+        return aIndexed->OnComplete == aOnComplete && aIndexed->AppState == aAppState;
+    });
+    Unlock();
+
+    return lTimer;
+}
+
+size_t TimerQueue::Hash(Timer::OnCompleteFunct aOnComplete, void * aAppState)
+{
+    return MixHash(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(aOnComplete)) * 31 + reinterpret_cast<uintptr_t>(aAppState));
+}
+
+// Timers due at the same epoch fire in the order they were queued, as they do without the heap, so that work scheduled
+// with ScheduleWork() runs first-in first-out.
+bool TimerQueue::IsBefore(const Timer & aFirst, const Timer & aSecond)
+{
+    if (aFirst.mAwakenEpoch != aSecond.mAwakenEpoch)
+    {
+        return Timer::IsEarlierEpoch(aFirst.mAwakenEpoch, aSecond.mAwakenEpoch);
+    }
+
+    return static_cast<int32_t>(aFirst.mQueueOrder - aSecond.mQueueOrder) < 0;
+}
+
+void TimerQueue::Place(Timer & aTimer, size_t aPosition)
+{
+    mHeap[aPosition]      = &aTimer;
+    aTimer.mQueuePosition = aPosition + 1;
+}
+
+void TimerQueue::SiftUp(size_t aPosition)
+{
+    Timer & lTimer = *mHeap[aPosition];
+
+    while (aPosition > 0)
+    {
+        const size_t lParent = (aPosition - 1) / 2;
+
+        if (!IsBefore(lTimer, *mHeap[lParent]))
+        {
+            break;
+        }
+
+        Place(*mHeap[lParent], aPosition);
+        aPosition = lParent;
+    }
+
+    Place(lTimer, aPosition);
+}
+
+void TimerQueue::SiftDown(size_t aPosition)
+{
+    Timer & lTimer = *mHeap[aPosition];
+
+    while (2 * aPosition + 1 < mSize)
+    {
+        size_t lChild = 2 * aPosition + 1;
+
+        if (lChild + 1 < mSize && IsBefore(*mHeap[lChild + 1], *mHeap[lChild]))
+        {
+            lChild++;
+        }
+
+        if (!IsBefore(*mHeap[lChild], lTimer))
+        {
+            break;
+        }
+
+        Place(*mHeap[lChild], aPosition);
+        aPosition = lChild;
+    }
+
+    Place(lTimer, aPosition);
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+
 } // namespace System
 } // namespace chip
@@ -37,6 +37,13 @@
 #include <system/SystemObject.h>
 #include <system/SystemStats.h>
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+#include <support/ProbeHashIndex.h>
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+#include <system/SystemMutex.h>
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+
 namespace chip {
 namespace System {
 
@@ -54,6 +61,9 @@ class Layer;
 class DLL_EXPORT Timer : public Object
 {
     friend class Layer;
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    friend class TimerQueue;
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
 
 public:
     /**
@@ -83,8 +93,16 @@ private:
 
     Error ScheduleWork(OnCompleteFunct aOnComplete, void * aAppState);
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+    size_t mQueuePosition; /**< One-based position in the TimerQueue heap, zero when not queued. */
+    size_t mQueueHash;     /**< Hash of OnComplete and AppState when the timer was queued. */
+    uint32_t mQueueOrder;  /**< Order in which the timer was queued, to fire timers with equal epochs first-in first-out. */
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
+#if !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
     Timer * mNextTimer;
+#endif // !CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
 
     static Error HandleExpiredTimers(Layer & aLayer);
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
@@ -99,6 +117,66 @@ inline void Timer::GetStatistics(chip::System::Stats::count_t & aNumInUse, chip:
     sPool.GetStatistics(aNumInUse, aHighWatermark);
 }
 
+#if CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+/**
+ * @class TimerQueue
+ *
+ * @brief
+ *  This is an internal class to CHIP System Layer, used to hold the armed timers of a System Layer object. Timers are kept in a
+ *  binary min-heap ordered by awaken epoch, and in an open addressing hash index keyed by completion function and application
+ *  state. Each timer records its own heap position so that it can be removed without a search. Storage is sized for the whole
+ *  timer pool and no memory is allocated.
+ */
+class TimerQueue
+{
+public:
+    Error Init(void);
+
+    void Insert(Timer & aTimer);
+    void Remove(Timer & aTimer);
+
+    Timer * Earliest(void);
+    Timer * Find(Timer::OnCompleteFunct aOnComplete, void * aAppState);
+
+private:
+    static constexpr size_t kCapacity = CHIP_SYSTEM_CONFIG_NUM_TIMERS;
+
+    static size_t Hash(Timer::OnCompleteFunct aOnComplete, void * aAppState);
+    static bool IsBefore(const Timer & aFirst, const Timer & aSecond);
+
+    void Lock(void);
+    void Unlock(void);
+
+    void SiftUp(size_t aPosition);
+    void SiftDown(size_t aPosition);
+    void Place(Timer & aTimer, size_t aPosition);
+
+    Timer * mHeap[kCapacity];
+    size_t mSize;
+    uint32_t mNextOrder;
+    ProbeHashIndex<Timer *, kCapacity, nullptr> mIndex;
+
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    // ScheduleWork() may be called from any thread.
+    Mutex mLock;
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+};
+
+inline void TimerQueue::Lock(void)
+{
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    mLock.Lock();
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+}
+
+inline void TimerQueue::Unlock(void)
+{
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    mLock.Unlock();
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+}
+#endif // CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP
+
 } // namespace System
 } // namespace chip
 
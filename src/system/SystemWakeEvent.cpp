@@ -91,7 +91,7 @@ void SystemWakeEvent::Notify()
 
 Error SystemWakeEvent::Open()
 {
-    mFD = eventfd(0, 0);
+    mFD = eventfd(0, EFD_NONBLOCK);
 
     if (mFD == -1)
     {
@@ -0,0 +1,377 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for <tt>chip::System::EventLoopThread</tt>,
+ *      which runs a system layer on a dedicated thread.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+// config
+#include <system/SystemConfig.h>
+
+// module header
+#include "TestSystemLayer.h"
+
+#include <nlunit-test.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+#include <system/SystemError.h>
+#include <system/SystemEventLoopThread.h>
+#include <system/SystemLayer.h>
+
+using namespace chip::System;
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+#include <atomic>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/select.h>
+#include <time.h>
+
+namespace {
+
+const unsigned kWaitTimeoutMs = 5000;
+
+// Wait up to kWaitTimeoutMs for a counter to reach a value.
+bool WaitFor(const std::atomic<unsigned> & aCounter, unsigned aValue)
+{
+    const struct timespec kPollInterval = { 0, 1000000 };
+
+    for (unsigned i = 0; i < kWaitTimeoutMs && aCounter.load() < aValue; i++)
+    {
+        nanosleep(&kPollInterval, NULL);
+    }
+
+    return aCounter.load() >= aValue;
+}
+
+// Service a system layer on the calling thread for up to kWaitTimeoutMs, until a counter reaches a value.
+bool ServiceUntil(Layer & aLayer, const std::atomic<unsigned> & aCounter, unsigned aValue)
+{
+    for (unsigned i = 0; i < kWaitTimeoutMs / 10 && aCounter.load() < aValue; i++)
+    {
+        struct timeval sleepTime = { 0, 10000 };
+        fd_set readFDs, writeFDs, exceptFDs;
+        int numFDs = 0;
+        int selectRes;
+
+        FD_ZERO(&readFDs);
+        FD_ZERO(&writeFDs);
+        FD_ZERO(&exceptFDs);
+
+        aLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+        selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &sleepTime);
+        if (selectRes >= 0)
+        {
+            aLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+        }
+    }
+
+    return aCounter.load() >= aValue;
+}
+
+// Work that records the thread and the order in which it ran.
+struct WorkRecord
+{
+    EventLoopThread * mThread;
+    std::atomic<unsigned> * mCounter;
+    unsigned mOrder;
+    bool mOnThread;
+};
+
+void RecordWork(Layer * aLayer, void * aAppState, Error aError)
+{
+    WorkRecord & record = *static_cast<WorkRecord *>(aAppState);
+
+    record.mOnThread = pthread_equal(pthread_self(), record.mThread->GetThread()) && aLayer == &record.mThread->GetLayer() &&
+        aError == CHIP_SYSTEM_NO_ERROR;
+    record.mOrder = record.mCounter->fetch_add(1);
+}
+
+void CountWork(Layer * aLayer, void * aAppState, Error aError)
+{
+    static_cast<std::atomic<unsigned> *>(aAppState)->fetch_add(1);
+}
+
+// Schedule work, retrying while the timers that carry scheduled work are all in use.
+Error ScheduleWorkRetrying(EventLoopThread & aThread, Layer::TimerCompleteFunct aWork, void * aAppState)
+{
+    Error err;
+
+    while ((err = aThread.ScheduleWork(aWork, aAppState)) == CHIP_SYSTEM_ERROR_NO_MEMORY)
+    {
+        sched_yield();
+    }
+
+    return err;
+}
+
+} // namespace
+
+static void CheckStartStop(nlTestSuite * inSuite, void * aContext)
+{
+    EventLoopThread thread;
+    std::atomic<unsigned> counter(0);
+
+    NL_TEST_ASSERT(inSuite, !thread.IsRunning());
+    NL_TEST_ASSERT(inSuite, thread.Stop() == CHIP_SYSTEM_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, thread.Start() == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, thread.IsRunning());
+    NL_TEST_ASSERT(inSuite, thread.Start() == CHIP_SYSTEM_ERROR_UNEXPECTED_STATE);
+
+    // Stopping an idle event loop must wake it rather than wait for work
+    NL_TEST_ASSERT(inSuite, thread.Stop() == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !thread.IsRunning());
+    NL_TEST_ASSERT(inSuite, thread.ScheduleWork(CountWork, &counter) != CHIP_SYSTEM_NO_ERROR);
+
+    // and it can be started again
+    NL_TEST_ASSERT(inSuite, thread.Start() == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, thread.ScheduleWork(CountWork, &counter) == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, WaitFor(counter, 1));
+    NL_TEST_ASSERT(inSuite, thread.Stop() == CHIP_SYSTEM_NO_ERROR);
+}
+
+static void CheckScheduleWork(nlTestSuite * inSuite, void * aContext)
+{
+    const unsigned kWorkCount = 100;
+    EventLoopThread thread;
+    std::atomic<unsigned> counter(0);
+    WorkRecord records[kWorkCount];
+    bool ordered = true;
+
+    NL_TEST_ASSERT(inSuite, thread.Start() == CHIP_SYSTEM_NO_ERROR);
+
+    for (unsigned i = 0; i < kWorkCount; i++)
+    {
+        records[i].mThread   = &thread;
+        records[i].mCounter  = &counter;
+        records[i].mOnThread = false;
+        NL_TEST_ASSERT(inSuite, ScheduleWorkRetrying(thread, RecordWork, &records[i]) == CHIP_SYSTEM_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(inSuite, WaitFor(counter, kWorkCount));
+    NL_TEST_ASSERT(inSuite, thread.Stop() == CHIP_SYSTEM_NO_ERROR);
+
+    for (unsigned i = 0; i < kWorkCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, records[i].mOnThread);
+        ordered = ordered && records[i].mOrder == i;
+    }
+    NL_TEST_ASSERT(inSuite, ordered);
+}
+
+namespace {
+
+struct Producer
+{
+    EventLoopThread * mThread;
+    std::atomic<unsigned> * mCounter;
+    unsigned mWorkCount;
+    unsigned mFailures;
+};
+
+void * ProducerMain(void * aArg)
+{
+    Producer & producer = *static_cast<Producer *>(aArg);
+
+    for (unsigned i = 0; i < producer.mWorkCount; i++)
+    {
+        if (ScheduleWorkRetrying(*producer.mThread, CountWork, producer.mCounter) != CHIP_SYSTEM_NO_ERROR)
+        {
+            producer.mFailures++;
+        }
+    }
+
+    return NULL;
+}
+
+} // namespace
+
+static void CheckMultipleProducers(nlTestSuite * inSuite, void * aContext)
+{
+    const unsigned kProducerCount = 4;
+    EventLoopThread thread;
+    std::atomic<unsigned> counter(0);
+    Producer producers[kProducerCount];
+    pthread_t producerThreads[kProducerCount];
+
+    NL_TEST_ASSERT(inSuite, thread.Start() == CHIP_SYSTEM_NO_ERROR);
+
+    for (unsigned i = 0; i < kProducerCount; i++)
+    {
+        producers[i].mThread    = &thread;
+        producers[i].mCounter   = &counter;
+        producers[i].mWorkCount = 250;
+        producers[i].mFailures  = 0;
+        NL_TEST_ASSERT(inSuite, pthread_create(&producerThreads[i], NULL, ProducerMain, &producers[i]) == 0);
+    }
+
+    for (unsigned i = 0; i < kProducerCount; i++)
+    {
+        pthread_join(producerThreads[i], NULL);
+        NL_TEST_ASSERT(inSuite, producers[i].mFailures == 0);
+    }
+
+    NL_TEST_ASSERT(inSuite, WaitFor(counter, kProducerCount * 250));
+    NL_TEST_ASSERT(inSuite, thread.Stop() == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter.load() == kProducerCount * 250);
+}
+
+namespace {
+
+void StartTimerWork(Layer * aLayer, void * aAppState, Error aError)
+{
+    WorkRecord & record = *static_cast<WorkRecord *>(aAppState);
+
+    if (aLayer->StartTimer(20, RecordWork, aAppState) != CHIP_SYSTEM_NO_ERROR)
+    {
+        record.mCounter->fetch_add(1);
+    }
+}
+
+} // namespace
+
+static void CheckTimer(nlTestSuite * inSuite, void * aContext)
+{
+    EventLoopThread thread;
+    std::atomic<unsigned> counter(0);
+    WorkRecord record;
+
+    record.mThread   = &thread;
+    record.mCounter  = &counter;
+    record.mOnThread = false;
+
+    // Work may start timers on the event loop, which fire on its thread
+    NL_TEST_ASSERT(inSuite, thread.Start() == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, thread.ScheduleWork(StartTimerWork, &record) == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, WaitFor(counter, 1));
+    NL_TEST_ASSERT(inSuite, thread.Stop() == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, record.mOnThread);
+}
+
+namespace {
+
+// Work handed to an event loop thread, whose result is handed back to the thread servicing mHomeLayer.
+struct RoundTrip
+{
+    Layer * mHomeLayer;
+    pthread_t mHomeThread;
+    std::atomic<unsigned> mStage;
+    bool mDoneAtHome;
+};
+
+void RoundTripDone(Layer * aLayer, void * aAppState, Error aError)
+{
+    RoundTrip & roundTrip = *static_cast<RoundTrip *>(aAppState);
+
+    roundTrip.mDoneAtHome = pthread_equal(pthread_self(), roundTrip.mHomeThread) && aLayer == roundTrip.mHomeLayer;
+    roundTrip.mStage.fetch_add(1);
+}
+
+void RoundTripWork(Layer * aLayer, void * aAppState, Error aError)
+{
+    RoundTrip & roundTrip = *static_cast<RoundTrip *>(aAppState);
+
+    roundTrip.mStage.fetch_add(1);
+    roundTrip.mHomeLayer->ScheduleWork(RoundTripDone, aAppState);
+}
+
+} // namespace
+
+static void CheckRoundTrip(nlTestSuite * inSuite, void * aContext)
+{
+    Layer homeLayer;
+    EventLoopThread thread;
+    RoundTrip roundTrip;
+
+    NL_TEST_ASSERT(inSuite, homeLayer.Init(NULL) == CHIP_SYSTEM_NO_ERROR);
+
+    roundTrip.mHomeLayer  = &homeLayer;
+    roundTrip.mHomeThread = pthread_self();
+    roundTrip.mStage.store(0);
+    roundTrip.mDoneAtHome = false;
+
+    NL_TEST_ASSERT(inSuite, thread.Start() == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, thread.ScheduleWork(RoundTripWork, &roundTrip) == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, ServiceUntil(homeLayer, roundTrip.mStage, 2));
+    NL_TEST_ASSERT(inSuite, roundTrip.mDoneAtHome);
+    NL_TEST_ASSERT(inSuite, thread.Stop() == CHIP_SYSTEM_NO_ERROR);
+
+    homeLayer.Shutdown();
+}
+
+static void CheckIndependentStop(nlTestSuite * inSuite, void * aContext)
+{
+    EventLoopThread threads[2];
+    std::atomic<unsigned> counter(0);
+
+    NL_TEST_ASSERT(inSuite, threads[0].Start() == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, threads[1].Start() == CHIP_SYSTEM_NO_ERROR);
+
+    // Stopping one event loop leaves the other running
+    NL_TEST_ASSERT(inSuite, threads[0].Stop() == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, threads[1].ScheduleWork(CountWork, &counter) == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, WaitFor(counter, 1));
+    NL_TEST_ASSERT(inSuite, threads[1].Stop() == CHIP_SYSTEM_NO_ERROR);
+}
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("EventLoopThread::CheckStartStop",          CheckStartStop),
+    NL_TEST_DEF("EventLoopThread::CheckScheduleWork",       CheckScheduleWork),
+    NL_TEST_DEF("EventLoopThread::CheckMultipleProducers",  CheckMultipleProducers),
+    NL_TEST_DEF("EventLoopThread::CheckTimer",              CheckTimer),
+    NL_TEST_DEF("EventLoopThread::CheckRoundTrip",          CheckRoundTrip),
+    NL_TEST_DEF("EventLoopThread::CheckIndependentStop",    CheckIndependentStop),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+// clang-format off
+static nlTestSuite kTheSuite =
+{
+    "chip-system-event-loop-thread",
+    sTests
+};
+// clang-format on
+
+int TestSystemEventLoopThread(void)
+{
+    // Run test suit againt one context.
+    nlTestRunner(&kTheSuite, NULL);
+
+    return nlTestRunnerStats(&kTheSuite);
+}
+#else  // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+int TestSystemEventLoopThread(void)
+{
+    return SUCCESS;
+}
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING && CHIP_SYSTEM_CONFIG_USE_SOCKETS
+
+static void __attribute__((constructor)) TestSystemEventLoopThreadCtor(void)
+{
+    VerifyOrDie(chip::RegisterUnitTests(&TestSystemEventLoopThread) == CHIP_NO_ERROR);
+}
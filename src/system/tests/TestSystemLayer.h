@@ -30,9 +30,11 @@ extern "C" {
 #endif
 
 int TestSystemErrorStr(void);
+int TestSystemEventLoopThread(void);
 int TestSystemObject(void);
 int TestSystemPacketBuffer(void);
 int TestSystemTimer(void);
+int TestSystemTimerBenchmark(void);
 int TestSystemWakeEvent(void);
 int TestTimeSource(void);
 
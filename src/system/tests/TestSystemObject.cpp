@@ -77,6 +77,7 @@ public:
     Error Init(void);
 
     static void CheckRetention(nlTestSuite * inSuite, void * aContext);
+    static void CheckReuse(nlTestSuite * inSuite, void * aContext);
     static void CheckConcurrency(nlTestSuite * inSuite, void * aContext);
     static void CheckHighWatermark(nlTestSuite * inSuite, void * aContext);
     static void CheckHighWatermarkConcurrency(nlTestSuite * inSuite, void * aContext);
@@ -201,6 +202,48 @@ void TestObject::CheckRetention(nlTestSuite * inSuite, void * aContext)
     lLayer.Shutdown();
 }
 
+// Test that released objects are reused, lowest index first
+
+void TestObject::CheckReuse(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & lContext      = *static_cast<TestContext *>(aContext);
+    const unsigned int kFreed[] = { 5, 70, kPoolSize - 1 };
+    Layer lLayer;
+    unsigned int i;
+
+    lLayer.Init(lContext.mLayerContext);
+    memset(&sPool, 0, sizeof(sPool));
+
+    for (i = 0; i < kPoolSize; ++i)
+    {
+        NL_TEST_ASSERT(lContext.mTestSuite, sPool.TryCreate(lLayer) == sPool.Get(lLayer, i));
+    }
+
+    NL_TEST_ASSERT(lContext.mTestSuite, sPool.TryCreate(lLayer) == NULL);
+
+    for (i = sizeof(kFreed) / sizeof(kFreed[0]); i-- > 0;)
+    {
+        sPool.Get(lLayer, kFreed[i])->Release();
+        NL_TEST_ASSERT(lContext.mTestSuite, sPool.Get(lLayer, kFreed[i]) == NULL);
+    }
+
+    for (i = 0; i < sizeof(kFreed) / sizeof(kFreed[0]); ++i)
+    {
+        TestObject * lCreated = sPool.TryCreate(lLayer);
+
+        NL_TEST_ASSERT(lContext.mTestSuite, lCreated != NULL && lCreated == sPool.Get(lLayer, kFreed[i]));
+    }
+
+    NL_TEST_ASSERT(lContext.mTestSuite, sPool.TryCreate(lLayer) == NULL);
+
+    for (i = 0; i < kPoolSize; ++i)
+    {
+        sPool.Get(lLayer, i)->Release();
+    }
+
+    lLayer.Shutdown();
+}
+
 // Test Object concurrency
 
 #if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
@@ -472,6 +515,7 @@ void TestObject::CheckHighWatermark(nlTestSuite * inSuite, void * aContext)
 static const nlTest sTests[] =
 {
     NL_TEST_DEF("Retention",                TestObject::CheckRetention),
+    NL_TEST_DEF("Reuse",                    TestObject::CheckReuse),
     NL_TEST_DEF("Concurrency",              TestObject::CheckConcurrency),
     NL_TEST_DEF("HighWatermark",            TestObject::CheckHighWatermark),
     NL_TEST_DEF("HighWatermarkConcurrency", TestObject::CheckHighWatermarkConcurrency),
@@ -991,6 +991,80 @@ void CheckNewWithAvailableSizeAndFree(nlTestSuite * inSuite, void * inContext)
     } while (buffer != NULL);
 }
 
+/**
+ *  Test PacketBuffer::NewWithAvailableSize() with pooled buffers of several sizes.
+ *
+ *  Description: Allocate buffers of increasing sizes and verify that each one
+ *               comes from the smallest pool that fits it. Then, exhaust the
+ *               small pool and verify that allocations fall back to larger
+ *               buffers. Finally, free all the buffers.
+ */
+void CheckNewWithAvailableSizePools(nlTestSuite * inSuite, void * inContext)
+{
+#if !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+    // clang-format off
+    static const size_t sizes[] =
+    {
+        0,
+        16,
+        CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY,
+        CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY + 1,
+        CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY,
+        CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY + 1,
+        CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX
+    };
+    // clang-format on
+
+    for (size_t ith = 0; ith < sizeof(sizes) / sizeof(sizes[0]); ith++)
+    {
+        size_t expected = CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX;
+
+        if (sizes[ith] > CHIP_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX)
+            continue;
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+        if (sizes[ith] <= CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY)
+            expected = CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY;
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+        if (sizes[ith] <= CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY)
+            expected = CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY;
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+
+        PacketBuffer * buffer = PacketBuffer::NewWithAvailableSize(0, sizes[ith]);
+
+        NL_TEST_ASSERT(inSuite, buffer != NULL);
+        if (buffer != NULL)
+        {
+            NL_TEST_ASSERT(inSuite, buffer->AllocSize() == expected);
+            NL_TEST_ASSERT(inSuite, buffer->MaxDataLength() == expected);
+            PacketBuffer::Free(buffer);
+        }
+    }
+
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+    static PacketBuffer * buffers[CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC + 1];
+
+    for (size_t ith = 0; ith < CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC + 1; ith++)
+    {
+        buffers[ith] = PacketBuffer::NewWithAvailableSize(0, 1);
+        NL_TEST_ASSERT(inSuite, buffers[ith] != NULL);
+    }
+
+    NL_TEST_ASSERT(inSuite, buffers[0]->AllocSize() == CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY);
+    NL_TEST_ASSERT(inSuite, buffers[CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC]->AllocSize() >
+                       CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY);
+
+    for (size_t ith = 0; ith < CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC + 1; ith++)
+    {
+        PacketBuffer::Free(buffers[ith]);
+    }
+#endif // CHIP_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+#endif // !CHIP_SYSTEM_CONFIG_USE_LWIP && CHIP_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+
+    (void) inSuite;
+    (void) inContext;
+}
+
 /**
  *  Test PacketBuffer::Free() function.
  *
@@ -1131,6 +1205,7 @@ void CheckBuildFreeList(nlTestSuite * inSuite, void * inContext)
 // clang-format off
 const nlTest sTests[] =
 {
+    NL_TEST_DEF("PacketBuffer::NewWithAvailableSize pools",      CheckNewWithAvailableSizePools),
     NL_TEST_DEF("PacketBuffer::NewWithAvailableSize&PacketBuffer::Free", CheckNewWithAvailableSizeAndFree),
     NL_TEST_DEF("PacketBuffer::Start",                          CheckStart),
     NL_TEST_DEF("PacketBuffer::SetStart",                       CheckSetStart),
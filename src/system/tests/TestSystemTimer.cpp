@@ -59,6 +59,23 @@ using namespace chip::System;
 
 static void ServiceEvents(Layer & aLayer, ::timeval & aSleepTime)
 {
+#if CHIP_SYSTEM_CONFIG_USE_EPOLL
+    struct epoll_event events[CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS];
+
+    if (aLayer.State() == kLayerState_Initialized)
+        aLayer.PrepareEpoll();
+
+    int eventCount = epoll_wait(aLayer.GetEpollFD(), events, CHIP_SYSTEM_CONFIG_EPOLL_MAX_EVENTS,
+                                static_cast<int>(aSleepTime.tv_sec * 1000 + aSleepTime.tv_usec / 1000));
+    if (eventCount < 0)
+    {
+        printf("epoll_wait failed: %s\n", ErrorStr(MapErrorPOSIX(errno)));
+        return;
+    }
+
+    if (aLayer.State() == kLayerState_Initialized)
+        aLayer.HandleEpollResult(events, eventCount);
+#else // !CHIP_SYSTEM_CONFIG_USE_EPOLL
 #if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
     fd_set readFDs, writeFDs, exceptFDs;
     int numFDs = 0;
@@ -93,6 +110,7 @@ static void ServiceEvents(Layer & aLayer, ::timeval & aSleepTime)
         }
 #endif // CHIP_SYSTEM_CONFIG_USE_LWIP
     }
+#endif // !CHIP_SYSTEM_CONFIG_USE_EPOLL
 }
 
 // Test input vector format.
@@ -209,6 +227,49 @@ static void CheckStarvation(nlTestSuite * inSuite, void * aContext)
     ServiceEvents(lSys, sleepTime);
 }
 
+struct OrderedWork
+{
+    TestContext * mContext;
+    uint32_t mExpected;
+};
+
+static uint32_t sNumOrderedWorkHandled;
+
+void HandleOrderedWork(Layer * aLayer, void * aState, Error aError)
+{
+    OrderedWork & lWork = *static_cast<OrderedWork *>(aState);
+
+    NL_TEST_ASSERT(lWork.mContext->mTestSuite, lWork.mExpected == sNumOrderedWorkHandled);
+    sNumOrderedWorkHandled++;
+}
+
+static void CheckScheduleWorkOrder(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+    Layer & lSys           = *lContext.mLayer;
+    OrderedWork lWork[8];
+
+    sNumOrderedWorkHandled = 0;
+
+    // Work items are due at the same time, and run in the order they were scheduled
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        lWork[i].mContext  = &lContext;
+        lWork[i].mExpected = i;
+        NL_TEST_ASSERT(inSuite, lSys.ScheduleWork(HandleOrderedWork, &lWork[i]) == CHIP_SYSTEM_NO_ERROR);
+    }
+
+    for (int i = 0; i < 100 && sNumOrderedWorkHandled < 8; i++)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec  = 0;
+        sleepTime.tv_usec = 1000; // 1 ms tick
+        ServiceEvents(lSys, sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sNumOrderedWorkHandled == 8);
+}
+
 // Test Suite
 
 /**
@@ -219,6 +280,7 @@ static const nlTest sTests[] =
 {
     NL_TEST_DEF("Timer::TestOverflow",             CheckOverflow),
     NL_TEST_DEF("Timer::TestTimerStarvation",      CheckStarvation),
+    NL_TEST_DEF("Timer::TestScheduleWorkOrder",    CheckScheduleWorkOrder),
     NL_TEST_SENTINEL()
 };
 // clang-format on
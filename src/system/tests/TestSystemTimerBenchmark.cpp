@@ -0,0 +1,345 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a microbenchmark for arming, cancelling and
+ *      firing <tt>chip::System::Timer</tt> objects, used to compare the
+ *      timer list and timer heap (CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP)
+ *      backends.
+ *
+ *      Timings are only reported; the assertions verify that exactly the
+ *      expected timers complete.
+ */
+
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+// config
+#include <system/SystemConfig.h>
+
+// module header
+#include "TestSystemLayer.h"
+
+#include <nlunit-test.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+#include <support/logging/CHIPLogging.h>
+#include <system/SystemError.h>
+#include <system/SystemLayer.h>
+
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+#include <lwip/init.h>
+#include <lwip/sys.h>
+#include <lwip/tcpip.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+#include <sys/select.h>
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+
+using namespace chip::System;
+
+// Total number of timers armed in each benchmark.
+static const size_t kNumTimers = 10000;
+
+// Timers are armed in batches that fit in the timer pool, leaving one timer spare.
+static const size_t kBatchSize = CHIP_SYSTEM_CONFIG_NUM_TIMERS - 1;
+
+// Delay of the timers that are cancelled before they expire; long enough that none of them fires during the benchmark.
+static const uint32_t kCancelledTimerDelayMilliseconds = 60 * 1000;
+
+class TestContext
+{
+public:
+    Layer * mLayer;
+    nlTestSuite * mTestSuite;
+    uint8_t mFired[kBatchSize];
+    size_t mNumFired;
+
+    void Reset()
+    {
+        memset(mFired, 0, sizeof(mFired));
+        mNumFired = 0;
+    }
+};
+
+static TestContext * sContext;
+
+static void HandleTimerFired(Layer * aLayer, void * aAppState, Error aError)
+{
+    // Each timer is armed with a distinct application state: a pointer into mFired.
+    uint8_t * lFired = static_cast<uint8_t *>(aAppState);
+
+    NL_TEST_ASSERT(sContext->mTestSuite, aError == CHIP_SYSTEM_NO_ERROR);
+    NL_TEST_ASSERT(sContext->mTestSuite, *lFired == 0);
+
+    (*lFired)++;
+    sContext->mNumFired++;
+}
+
+static void HandleTimerUnexpected(Layer * aLayer, void * aAppState, Error aError)
+{
+    NL_TEST_ASSERT(sContext->mTestSuite, false);
+}
+
+static void ServiceEvents(Layer & aLayer)
+{
+#if CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+    fd_set readFDs, writeFDs, exceptFDs;
+    struct timeval sleepTime;
+    int numFDs = 0;
+
+    FD_ZERO(&readFDs);
+    FD_ZERO(&writeFDs);
+    FD_ZERO(&exceptFDs);
+
+    sleepTime.tv_sec  = 0;
+    sleepTime.tv_usec = 0;
+
+    aLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+
+    int selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &sleepTime);
+    aLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+#endif // CHIP_SYSTEM_CONFIG_USE_SOCKETS || CHIP_SYSTEM_CONFIG_USE_NETWORK_FRAMEWORK
+
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+    aLayer.HandlePlatformTimer();
+#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+}
+
+static uint64_t NanosecondsPerTimer(uint64_t aElapsedMicroseconds)
+{
+    return (aElapsedMicroseconds * 1000) / kNumTimers;
+}
+
+static void ReportTiming(const char * aOperation, uint64_t aElapsedMicroseconds)
+{
+    ChipLogProgress(chipSystemLayer, "%u timers (%s backend): %s %" PRIu64 " ns per timer", static_cast<unsigned>(kNumTimers),
+                    CHIP_SYSTEM_CONFIG_USE_TIMER_HEAP ? "heap" : "list", aOperation, NanosecondsPerTimer(aElapsedMicroseconds));
+}
+
+/**
+ *  Arm timers with spread-out delays, then cancel them in arming order.
+ *  This is the pattern of retransmission and response timeouts, which are almost always cancelled.
+ */
+static void CheckArmCancel(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+    Layer & lSys           = *lContext.mLayer;
+    uint64_t lArmTime      = 0;
+    uint64_t lCancelTime   = 0;
+    size_t lNumArmed       = 0;
+    uint64_t lStart;
+    Error lError;
+
+    lContext.Reset();
+
+    while (lNumArmed < kNumTimers)
+    {
+        const size_t lCount = (kNumTimers - lNumArmed < kBatchSize) ? kNumTimers - lNumArmed : kBatchSize;
+
+        lStart = Layer::GetClock_MonotonicHiRes();
+        for (size_t i = 0; i < lCount; i++)
+        {
+            // Interleave the delays so that timers are not armed in expiry order.
+            const uint32_t lDelay = kCancelledTimerDelayMilliseconds + static_cast<uint32_t>((i * 7919) % kBatchSize);
+
+            lError = lSys.StartTimer(lDelay, HandleTimerUnexpected, &lContext.mFired[i]);
+            NL_TEST_ASSERT(inSuite, lError == CHIP_SYSTEM_NO_ERROR);
+        }
+        lArmTime += Layer::GetClock_MonotonicHiRes() - lStart;
+
+        lStart = Layer::GetClock_MonotonicHiRes();
+        for (size_t i = 0; i < lCount; i++)
+        {
+            lSys.CancelTimer(HandleTimerUnexpected, &lContext.mFired[i]);
+        }
+        lCancelTime += Layer::GetClock_MonotonicHiRes() - lStart;
+
+        lNumArmed += lCount;
+    }
+
+    // Every timer was returned to the pool, so a full batch can be armed again.
+    for (size_t i = 0; i < kBatchSize; i++)
+    {
+        lError = lSys.StartTimer(kCancelledTimerDelayMilliseconds, HandleTimerUnexpected, &lContext.mFired[i]);
+        NL_TEST_ASSERT(inSuite, lError == CHIP_SYSTEM_NO_ERROR);
+    }
+    for (size_t i = 0; i < kBatchSize; i++)
+    {
+        lSys.CancelTimer(HandleTimerUnexpected, &lContext.mFired[i]);
+    }
+
+    ReportTiming("arm", lArmTime);
+    ReportTiming("cancel", lCancelTime);
+}
+
+/**
+ *  Arm expired timers alongside pending ones, cancel every other pending timer, and let the layer fire the expired ones.
+ */
+static void CheckArmFire(nlTestSuite * inSuite, void * aContext)
+{
+    TestContext & lContext = *static_cast<TestContext *>(aContext);
+    Layer & lSys           = *lContext.mLayer;
+    const size_t lNumDue   = kBatchSize / 2;
+    uint64_t lFireTime     = 0;
+    size_t lNumCompleted   = 0;
+    uint64_t lStart;
+    Error lError;
+
+    while (lNumCompleted < kNumTimers)
+    {
+        const size_t lCount = (kNumTimers - lNumCompleted < lNumDue) ? kNumTimers - lNumCompleted : lNumDue;
+
+        lContext.Reset();
+
+        // Odd slots hold pending timers that must not fire.
+        for (size_t i = 1; i < kBatchSize; i += 2)
+        {
+            lError = lSys.StartTimer(kCancelledTimerDelayMilliseconds, HandleTimerUnexpected, &lContext.mFired[i]);
+            NL_TEST_ASSERT(inSuite, lError == CHIP_SYSTEM_NO_ERROR);
+        }
+
+        for (size_t i = 0; i < lCount; i++)
+        {
+            lError = lSys.StartTimer(0, HandleTimerFired, &lContext.mFired[2 * i]);
+            NL_TEST_ASSERT(inSuite, lError == CHIP_SYSTEM_NO_ERROR);
+        }
+
+        for (size_t i = 1; i < kBatchSize; i += 4)
+        {
+            lSys.CancelTimer(HandleTimerUnexpected, &lContext.mFired[i]);
+        }
+
+        lStart = Layer::GetClock_MonotonicHiRes();
+        for (size_t lPass = 0; lPass < kBatchSize && lContext.mNumFired < lCount; lPass++)
+        {
+            ServiceEvents(lSys);
+        }
+        lFireTime += Layer::GetClock_MonotonicHiRes() - lStart;
+
+        NL_TEST_ASSERT(inSuite, lContext.mNumFired == lCount);
+        for (size_t i = 0; i < lCount; i++)
+        {
+            NL_TEST_ASSERT(inSuite, lContext.mFired[2 * i] == 1);
+        }
+
+        for (size_t i = 1; i < kBatchSize; i += 2)
+        {
+            lSys.CancelTimer(HandleTimerUnexpected, &lContext.mFired[i]);
+        }
+
+        lNumCompleted += lCount;
+    }
+
+    ReportTiming("fire", lFireTime);
+}
+
+// Test Suite
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Timer::BenchmarkArmCancel",       CheckArmCancel),
+    NL_TEST_DEF("Timer::BenchmarkArmFire",         CheckArmFire),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+static int TestSetup(void * aContext);
+static int TestTeardown(void * aContext);
+
+// clang-format off
+static nlTestSuite kTheSuite =
+{
+    "chip-system-timer-benchmark",
+    &sTests[0],
+    TestSetup,
+    TestTeardown
+};
+// clang-format on
+
+static Layer sLayer;
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void * aContext)
+{
+    TestContext & lContext = *reinterpret_cast<TestContext *>(aContext);
+    void * lLayerContext   = NULL;
+
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+#if LWIP_VERSION_MAJOR <= 2 && LWIP_VERSION_MINOR < 1
+    static sys_mbox_t * sLwIPEventQueue = NULL;
+
+    sys_mbox_new(sLwIPEventQueue, 100);
+    lLayerContext = &sLwIPEventQueue;
+    tcpip_init(NULL, NULL);
+#endif
+#endif // CHIP_SYSTEM_CONFIG_USE_LWIP
+
+    if (sLayer.Init(lLayerContext) != CHIP_SYSTEM_NO_ERROR)
+        return (FAILURE);
+
+    lContext.mLayer     = &sLayer;
+    lContext.mTestSuite = &kTheSuite;
+    sContext            = &lContext;
+
+    return (SUCCESS);
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void * aContext)
+{
+    TestContext & lContext = *reinterpret_cast<TestContext *>(aContext);
+
+    lContext.mLayer->Shutdown();
+    sContext = NULL;
+
+#if CHIP_SYSTEM_CONFIG_USE_LWIP
+#if !(LWIP_VERSION_MAJOR >= 2 && LWIP_VERSION_MINOR >= 1)
+    tcpip_finish(NULL, NULL);
+#endif
+#endif
+
+    return (SUCCESS);
+}
+
+int TestSystemTimerBenchmark(void)
+{
+    TestContext context;
+
+    nlTestRunner(&kTheSuite, &context);
+
+    return nlTestRunnerStats(&kTheSuite);
+}
+
+static void __attribute__((constructor)) TestSystemTimerBenchmarkCtor(void)
+{
+    VerifyOrDie(chip::RegisterUnitTests(&TestSystemTimerBenchmark) == CHIP_NO_ERROR);
+}
@@ -0,0 +1,167 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @brief Defines a sliding window of received message counters, used to reject
+ *        replayed messages.
+ */
+
+#ifndef MESSAGE_COUNTER_WINDOW_H_
+#define MESSAGE_COUNTER_WINDOW_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <core/CHIPCore.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ * Tracks which message counters were recently received from a peer.
+ *
+ * The window covers the highest counter received so far and the
+ * CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE - 1 counters below it, with one bit per
+ * counter. A counter that is inside the window and already marked, or that is older
+ * than the window, is rejected. Counters are compared modulo 2^32, so the window keeps
+ * working when the peer's counter wraps around.
+ *
+ * Check is cheap and meant to run before a message is decrypted; Commit must only be
+ * called once the message has been authenticated, so that forged messages cannot move
+ * the window.
+ */
+class MessageCounterWindow
+{
+public:
+    static constexpr uint32_t kWindowSize = CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE;
+
+    MessageCounterWindow() { Reset(); }
+
+    /**
+     * Returns whether a message counter may be accepted.
+     *
+     * @return CHIP_NO_ERROR if the counter was not received yet, or
+     *         CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED if it was received already or is too old to tell.
+     */
+    CHIP_ERROR Check(uint32_t counter) const
+    {
+        const uint32_t behind = mMaxCounter - counter;
+
+        if (!mSynchronized || IsAhead(counter))
+        {
+            return CHIP_NO_ERROR;
+        }
+
+        if (behind >= kWindowSize || IsBitSet(behind))
+        {
+            return CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED;
+        }
+
+        return CHIP_NO_ERROR;
+    }
+
+    /**
+     * Marks a message counter as received, sliding the window forward if the counter is
+     * newer than any received so far. The counter must have passed Check.
+     */
+    void Commit(uint32_t counter)
+    {
+        if (!mSynchronized)
+        {
+            // The first authenticated message sets where the window starts
+            mSynchronized = true;
+            mMaxCounter   = counter;
+            SetBit(0);
+        }
+        else if (IsAhead(counter))
+        {
+            Slide(counter - mMaxCounter);
+            mMaxCounter = counter;
+            SetBit(0);
+        }
+        else if (mMaxCounter - counter < kWindowSize)
+        {
+            SetBit(mMaxCounter - counter);
+        }
+    }
+
+    /**
+     * Forgets all received counters. The next committed counter starts a new window.
+     */
+    void Reset()
+    {
+        mSynchronized = false;
+        mMaxCounter   = 0;
+        memset(mBitmap, 0, sizeof(mBitmap));
+    }
+
+private:
+    static constexpr uint32_t kBitsPerWord = 32;
+    static constexpr uint32_t kWordCount   = kWindowSize / kBitsPerWord;
+
+    static_assert(kWindowSize >= kBitsPerWord && kWindowSize % kBitsPerWord == 0,
+                  "CHIP_CONFIG_MESSAGE_COUNTER_WINDOW_SIZE must be a multiple of 32");
+
+    // Whether counter is newer than mMaxCounter, allowing for wrap around
+    bool IsAhead(uint32_t counter) const
+    {
+        const uint32_t ahead = counter - mMaxCounter;
+        return ahead != 0 && ahead < 0x80000000;
+    }
+
+    // Bit n of the bitmap stands for counter mMaxCounter - n
+    bool IsBitSet(uint32_t n) const { return (mBitmap[n / kBitsPerWord] & (1u << (n % kBitsPerWord))) != 0; }
+    void SetBit(uint32_t n) { mBitmap[n / kBitsPerWord] |= (1u << (n % kBitsPerWord)); }
+
+    // Moves every bit n positions towards older counters, dropping those that fall out of the window
+    void Slide(uint32_t n)
+    {
+        if (n >= kWindowSize)
+        {
+            memset(mBitmap, 0, sizeof(mBitmap));
+            return;
+        }
+
+        const uint32_t wordShift = n / kBitsPerWord;
+        const uint32_t bitShift  = n % kBitsPerWord;
+
+        for (uint32_t i = kWordCount; i-- > 0;)
+        {
+            uint32_t word = 0;
+
+            if (i >= wordShift)
+            {
+                word = mBitmap[i - wordShift] << bitShift;
+                if (bitShift != 0 && i > wordShift)
+                {
+                    word |= mBitmap[i - wordShift - 1] >> (kBitsPerWord - bitShift);
+                }
+            }
+
+            mBitmap[i] = word;
+        }
+    }
+
+    bool mSynchronized;
+    uint32_t mMaxCounter;
+    uint32_t mBitmap[kWordCount];
+};
+
+} // namespace Transport
+} // namespace chip
+
+#endif // MESSAGE_COUNTER_WINDOW_H_
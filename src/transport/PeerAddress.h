@@ -87,7 +87,7 @@ public:
 
     bool IsInitialized() const { return mTransportType != Type::kUndefined; }
 
-    bool operator==(const PeerAddress & other)
+    bool operator==(const PeerAddress & other) const
     {
         return (mTransportType == other.mTransportType) && (mIPAddress == other.mIPAddress) && (mPort == other.mPort);
     }
@@ -22,6 +22,8 @@
 #ifndef PEER_CONNCTION_STATE_H_
 #define PEER_CONNCTION_STATE_H_
 
+#include <system/TimeSource.h>
+#include <transport/MessageCounterWindow.h>
 #include <transport/MessageHeader.h>
 #include <transport/PeerAddress.h>
 #include <transport/SecureSession.h>
@@ -29,6 +31,9 @@
 namespace chip {
 namespace Transport {
 
+template <size_t kMaxConnectionCount, Time::Source kTimeSource>
+class PeerConnections;
+
 /**
  * Defines state of a peer connection at a transport layer.
  *
@@ -36,6 +41,7 @@ namespace Transport {
  *   - PeerAddress represents how to talk to the peer
  *   - PeerNodeId is the unique ID of the peer
  *   - SendMessageIndex is an ever increasing index for sending messages
+ *   - ReceiveWindow tracks recently received message ids to reject replays
  *   - LastActivityTimeMs is a monotonic timestamp of when this connection was
  *     last used. Inactive connections can expire.
  *   - SecureSession contains the encryption context of a connection
@@ -56,14 +62,15 @@ public:
 
     const PeerAddress & GetPeerAddress() const { return mPeerAddress; }
     PeerAddress & GetPeerAddress() { return mPeerAddress; }
-    void SetPeerAddress(const PeerAddress & address) { mPeerAddress = address; }
 
     NodeId GetPeerNodeId() const { return mPeerNodeId; }
-    void SetPeerNodeId(NodeId peerNodeId) { mPeerNodeId = peerNodeId; }
 
     uint32_t GetSendMessageIndex() const { return mSendMessageIndex; }
     void IncrementSendMessageIndex() { mSendMessageIndex++; }
 
+    MessageCounterWindow & GetReceiveWindow() { return mReceiveWindow; }
+    const MessageCounterWindow & GetReceiveWindow() const { return mReceiveWindow; }
+
     uint64_t GetLastActivityTimeMs() const { return mLastActityTimeMs; }
     void SetLastActivityTimeMs(uint64_t value) { mLastActityTimeMs = value; }
 
@@ -78,14 +85,24 @@ public:
         mPeerAddress      = PeerAddress::Uninitialized();
         mPeerNodeId       = kUndefinedNodeId;
         mSendMessageIndex = 0;
+        mReceiveWindow.Reset();
         mLastActityTimeMs = 0;
         mSecureSession.Reset();
     }
 
 private:
+    // Address and node id are lookup keys of PeerConnections, which has to keep
+    // its indexes in sync with them.
+    template <size_t kMaxConnectionCount, Time::Source kTimeSource>
+    friend class PeerConnections;
+
+    void SetPeerAddress(const PeerAddress & address) { mPeerAddress = address; }
+    void SetPeerNodeId(NodeId peerNodeId) { mPeerNodeId = peerNodeId; }
+
     PeerAddress mPeerAddress;
     NodeId mPeerNodeId         = kUndefinedNodeId;
     uint32_t mSendMessageIndex = 0;
+    MessageCounterWindow mReceiveWindow;
     uint64_t mLastActityTimeMs = 0;
     SecureSession mSecureSession;
 };
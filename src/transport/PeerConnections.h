@@ -17,8 +17,13 @@
 #ifndef PEER_CONNECTIONS_H_
 #define PEER_CONNECTIONS_H_
 
+#include <limits>
+#include <stdint.h>
+#include <type_traits>
+
 #include <core/CHIPError.h>
 #include <support/CodeUtils.h>
+#include <support/ProbeHashIndex.h>
 #include <system/TimeSource.h>
 #include <transport/PeerConnectionState.h>
 
@@ -31,11 +36,21 @@ namespace Transport {
  * Intended for:
  *   - handle connection active time and expiration
  *   - allocate and free space for connection states.
+ *
+ * Connection states are located through two fixed-size open addressing
+ * indexes (one keyed by peer address, one keyed by peer node id) so that
+ * lookups do not depend on the number of connections in use. Slots are
+ * threaded either on a free list or, when in use, on an idle list ordered
+ * from least to most recently active, so that marking a connection active
+ * is O(1) and expiry only visits connections that are due. No memory is
+ * allocated outside of the object itself.
  */
 template <size_t kMaxConnectionCount, Time::Source kTimeSource = Time::Source::kSystem>
 class PeerConnections
 {
 public:
+    PeerConnections() { ResetIndexes(); }
+
     /**
      * Allocates a new peer connection state state object out of the internal resource pool.
      *
@@ -50,30 +65,29 @@ public:
     CHECK_RETURN_VALUE
     CHIP_ERROR CreateNewPeerConnectionState(const PeerAddress & address, PeerConnectionState ** state)
     {
-        CHIP_ERROR err = CHIP_ERROR_NO_MEMORY;
+        CHIP_ERROR err = CHIP_NO_ERROR;
+        SlotIndex slot = mFreeListHead;
 
         if (state)
         {
             *state = nullptr;
         }
 
-        for (size_t i = 0; i < kMaxConnectionCount; i++)
-        {
-            if (!mStates[i].GetPeerAddress().IsInitialized())
-            {
-                mStates[i] = PeerConnectionState(address);
-                mStates[i].SetLastActivityTimeMs(mTimeSource.GetCurrentMonotonicTimeMs());
+        VerifyOrExit(slot != kInvalidSlot, err = CHIP_ERROR_NO_MEMORY);
 
-                if (state)
-                {
-                    *state = &mStates[i];
-                }
+        mFreeListHead = mNext[slot];
 
-                err = CHIP_NO_ERROR;
-                break;
-            }
+        mStates[slot] = PeerConnectionState(address);
+        mStates[slot].SetLastActivityTimeMs(mTimeSource.GetCurrentMonotonicTimeMs());
+        mAddressIndex.Insert(HashAddress(address), slot);
+        IdleListAppend(slot);
+
+        if (state)
+        {
+            *state = &mStates[slot];
         }
 
+    exit:
         return err;
     }
 
@@ -89,13 +103,18 @@ public:
     bool FindPeerConnectionState(const PeerAddress & address, PeerConnectionState ** state)
     {
         *state = nullptr;
-        for (size_t i = 0; i < kMaxConnectionCount; i++)
+
+        if (!address.IsInitialized())
         {
-            if (mStates[i].GetPeerAddress() == address)
-            {
-                *state = &mStates[i];
-                break;
-            }
+            return false;
+        }
+
+        const SlotIndex slot =
+            mAddressIndex.Find(HashAddress(address), [&](SlotIndex s) { return mStates[s].GetPeerAddress() == address; });
+
+        if (slot != kInvalidSlot)
+        {
+            *state = &mStates[slot];
         }
         return *state != nullptr;
     }
@@ -113,41 +132,103 @@ public:
     bool FindPeerConnectionState(NodeId nodeId, PeerConnectionState ** state)
     {
         *state = nullptr;
-        for (size_t i = 0; i < kMaxConnectionCount; i++)
+
+        if (nodeId == kUndefinedNodeId)
         {
-            if (!mStates[i].GetPeerAddress().IsInitialized())
-            {
-                continue;
-            }
-            if (mStates[i].GetPeerNodeId() == nodeId)
-            {
-                *state = &mStates[i];
-                break;
-            }
+            return false;
+        }
+
+        const SlotIndex slot =
+            mNodeIdIndex.Find(HashNodeId(nodeId), [&](SlotIndex s) { return mStates[s].GetPeerNodeId() == nodeId; });
+
+        if (slot != kInvalidSlot)
+        {
+            *state = &mStates[slot];
         }
         return *state != nullptr;
     }
 
+    /**
+     * Sets the node id of a peer connection state and keeps the node id index up to date.
+     *
+     * Node ids of states owned by this object MUST be updated through this method, otherwise
+     * FindPeerConnectionState(NodeId, ...) will not be able to locate them.
+     *
+     * @param state  a connection state previously returned by this object
+     * @param nodeId the new peer node id, kUndefinedNodeId to clear it
+     */
+    void SetPeerNodeId(PeerConnectionState * state, NodeId nodeId)
+    {
+        const SlotIndex slot = SlotOf(state);
+
+        if (state->GetPeerNodeId() != kUndefinedNodeId)
+        {
+            NodeIdIndexRemove(slot);
+        }
+
+        state->SetPeerNodeId(nodeId);
+
+        if (nodeId != kUndefinedNodeId)
+        {
+            mNodeIdIndex.Insert(HashNodeId(nodeId), slot);
+        }
+    }
+
+    /**
+     * Get the least recently active connection, which is the next one to expire.
+     *
+     * @param state [out] the connection if any is in use, null otherwise. MUST not be null.
+     *
+     * @return true if at least one connection is in use.
+     */
+    CHECK_RETURN_VALUE
+    bool FindLeastRecentlyActiveConnection(PeerConnectionState ** state)
+    {
+        *state = (mIdleHead != kInvalidSlot) ? &mStates[mIdleHead] : nullptr;
+        return *state != nullptr;
+    }
+
     /// Convenience method to mark a peer connection state as active
     void MarkConnectionActive(PeerConnectionState * state)
     {
+        const SlotIndex slot = SlotOf(state);
+
         state->SetLastActivityTimeMs(mTimeSource.GetCurrentMonotonicTimeMs());
+
+        // The time source is monotonic, so the most recently active connection is always last.
+        IdleListRemove(slot);
+        IdleListAppend(slot);
     }
 
     /// Convenience method to expired a peer connection state and fired the related callback
     void MarkConnectionExpired(PeerConnectionState * state)
     {
+        const SlotIndex slot = SlotOf(state);
+
         if (OnConnectionExpired)
         {
             OnConnectionExpired(*state, mConnectionExpiredArgument);
         }
 
+        if (state->GetPeerNodeId() != kUndefinedNodeId)
+        {
+            NodeIdIndexRemove(slot);
+        }
+        AddressIndexRemove(slot);
+
+        IdleListRemove(slot);
+
         *state = PeerConnectionState(PeerAddress::Uninitialized());
+
+        mNext[slot]   = mFreeListHead;
+        mFreeListHead = slot;
     }
 
     /**
-     * Iterates through all active connections and expires any connection with an idle time
-     * larger than the given amount.
+     * Expires any connection with an idle time larger than the given amount.
+     *
+     * Connections are visited from least to most recently active, stopping at the first one
+     * that has not expired.
      *
      * Expiring a connection involves callback execution and then clearing the internal state.
      */
@@ -155,20 +236,15 @@ public:
     {
         const uint64_t currentTime = mTimeSource.GetCurrentMonotonicTimeMs();
 
-        for (size_t i = 0; i < kMaxConnectionCount; i++)
+        while (mIdleHead != kInvalidSlot)
         {
-            if (!mStates[i].GetPeerAddress().IsInitialized())
-            {
-                continue; // not an active connection
-            }
-
-            uint64_t connectionActiveTime = mStates[i].GetLastActivityTimeMs();
+            uint64_t connectionActiveTime = mStates[mIdleHead].GetLastActivityTimeMs();
             if (connectionActiveTime + maxIdleTimeMs >= currentTime)
             {
-                continue; // not expired
+                break; // not expired, and neither is any connection after it
             }
 
-            MarkConnectionExpired(&mStates[i]);
+            MarkConnectionExpired(&mStates[mIdleHead]);
         }
     }
 
@@ -190,8 +266,106 @@ public:
     }
 
 private:
+    /// Smallest integer type able to address every slot, plus one reserved 'invalid' value.
+    typedef typename std::conditional<(kMaxConnectionCount < UINT16_MAX), uint16_t, uint32_t>::type SlotIndex;
+
+    static constexpr SlotIndex kInvalidSlot = std::numeric_limits<SlotIndex>::max();
+
+    typedef ProbeHashIndex<SlotIndex, kMaxConnectionCount, kInvalidSlot> SlotHashIndex;
+
+    static size_t HashNodeId(NodeId nodeId) { return MixHash(nodeId); }
+
+    static size_t HashAddress(const PeerAddress & address)
+    {
+        const Inet::IPAddress & ip = address.GetIPAddress();
+        uint64_t value             = (static_cast<uint64_t>(address.GetTransportType()) << 16) | address.GetPort();
+
+        for (size_t i = 0; i < sizeof(ip.Addr) / sizeof(ip.Addr[0]); i++)
+        {
+            value = MixHash(value ^ ip.Addr[i]);
+        }
+        return MixHash(value);
+    }
+
+    // Index removal rehashes the entries it moves, so a slot must still hold the key it was indexed by when it is removed.
+    void NodeIdIndexRemove(SlotIndex slot)
+    {
+        mNodeIdIndex.Remove(HashNodeId(mStates[slot].GetPeerNodeId()), slot,
+                            [this](SlotIndex s) { return HashNodeId(mStates[s].GetPeerNodeId()); });
+    }
+
+    void AddressIndexRemove(SlotIndex slot)
+    {
+        mAddressIndex.Remove(HashAddress(mStates[slot].GetPeerAddress()), slot,
+                             [this](SlotIndex s) { return HashAddress(mStates[s].GetPeerAddress()); });
+    }
+
+    SlotIndex SlotOf(const PeerConnectionState * state) const { return static_cast<SlotIndex>(state - &mStates[0]); }
+
+    void ResetIndexes()
+    {
+        mAddressIndex.Clear();
+        mNodeIdIndex.Clear();
+
+        for (size_t i = 0; i < kMaxConnectionCount; i++)
+        {
+            mNext[i] = static_cast<SlotIndex>(i + 1 < kMaxConnectionCount ? i + 1 : kInvalidSlot);
+            mPrev[i] = kInvalidSlot;
+        }
+        mFreeListHead = 0;
+        mIdleHead     = kInvalidSlot;
+        mIdleTail     = kInvalidSlot;
+    }
+
+    void IdleListAppend(SlotIndex slot)
+    {
+        mPrev[slot] = mIdleTail;
+        mNext[slot] = kInvalidSlot;
+
+        if (mIdleTail != kInvalidSlot)
+        {
+            mNext[mIdleTail] = slot;
+        }
+        else
+        {
+            mIdleHead = slot;
+        }
+        mIdleTail = slot;
+    }
+
+    void IdleListRemove(SlotIndex slot)
+    {
+        if (mPrev[slot] != kInvalidSlot)
+        {
+            mNext[mPrev[slot]] = mNext[slot];
+        }
+        else
+        {
+            mIdleHead = mNext[slot];
+        }
+
+        if (mNext[slot] != kInvalidSlot)
+        {
+            mPrev[mNext[slot]] = mPrev[slot];
+        }
+        else
+        {
+            mIdleTail = mPrev[slot];
+        }
+
+        mPrev[slot] = kInvalidSlot;
+        mNext[slot] = kInvalidSlot;
+    }
+
     Time::TimeSource<kTimeSource> mTimeSource;
     PeerConnectionState mStates[kMaxConnectionCount];
+    SlotIndex mNext[kMaxConnectionCount]; ///< Next slot on the free list (unused slots) or idle list (used slots)
+    SlotIndex mPrev[kMaxConnectionCount]; ///< Previous slot on the idle list
+    SlotIndex mFreeListHead;              ///< First unused slot, kInvalidSlot when full
+    SlotIndex mIdleHead;                  ///< Least recently active slot, kInvalidSlot when empty
+    SlotIndex mIdleTail;                  ///< Most recently active slot, kInvalidSlot when empty
+    SlotHashIndex mAddressIndex;          ///< Slots indexed by peer address
+    SlotHashIndex mNodeIdIndex;           ///< Slots indexed by peer node id
 
     typedef void (*ConnectionExpiredHandler)(const PeerConnectionState & state, void * param);
 
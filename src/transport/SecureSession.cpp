@@ -42,6 +42,27 @@ using namespace Crypto;
 
 SecureSession::SecureSession() : mKeyAvailable(false) {}
 
+SecureSession::SecureSession(const SecureSession & other) : mKeyAvailable(false)
+{
+    *this = other;
+}
+
+SecureSession & SecureSession::operator=(const SecureSession & other)
+{
+    if (this != &other)
+    {
+        Reset();
+
+        if (other.mKeyAvailable)
+        {
+            memcpy(mKey, other.mKey, sizeof(mKey));
+            mKeyAvailable = (mCipher.SetKey(mKey, sizeof(mKey)) == CHIP_NO_ERROR);
+        }
+    }
+
+    return *this;
+}
+
 CHIP_ERROR SecureSession::InitFromSecret(const unsigned char * secret, const size_t secret_length, const unsigned char * salt,
                                          const size_t salt_length, const unsigned char * info, const size_t info_length)
 {
@@ -62,6 +83,9 @@ CHIP_ERROR SecureSession::InitFromSecret(const unsigned char * secret, const siz
     error = HKDF_SHA256(secret, secret_length, salt, salt_length, info, info_length, mKey, sizeof(mKey));
     SuccessOrExit(error);
 
+    error = mCipher.SetKey(mKey, sizeof(mKey));
+    SuccessOrExit(error);
+
     mKeyAvailable = true;
 
 exit:
@@ -102,6 +126,7 @@ void SecureSession::Reset(void)
 {
     mKeyAvailable = false;
     memset(mKey, 0, sizeof(mKey));
+    mCipher.Clear();
 }
 
 uint64_t SecureSession::GetIV(const MessageHeader & header)
@@ -120,18 +145,82 @@ uint64_t SecureSession::GetIV(const MessageHeader & header)
 }
 
 CHIP_ERROR SecureSession::Encrypt(const unsigned char * input, size_t input_length, unsigned char * output, MessageHeader & header)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    VerifyOrExit(mKeyAvailable, error = CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+
+    error = EncryptMessage(input, input_length, output, header);
+
+exit:
+    return error;
+}
+
+CHIP_ERROR SecureSession::Decrypt(const unsigned char * input, size_t input_length, unsigned char * output,
+                                  const MessageHeader & header)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    VerifyOrExit(mKeyAvailable, error = CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+
+    error = DecryptMessage(input, input_length, output, header);
+
+exit:
+    return error;
+}
+
+CHIP_ERROR SecureSession::EncryptBatch(BatchMessage * messages, size_t count)
+{
+    CHIP_ERROR error = CHIP_NO_ERROR;
+
+    VerifyOrExit(messages != NULL || count == 0, error = CHIP_ERROR_INVALID_ARGUMENT);
+
+    // Without a key no message can be encrypted, so the key is checked once for the batch rather than per message.
+    if (!mKeyAvailable)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            messages[i].result = CHIP_ERROR_INVALID_USE_OF_SESSION_KEY;
+        }
+        ExitNow(error = (count > 0) ? CHIP_ERROR_INVALID_USE_OF_SESSION_KEY : CHIP_NO_ERROR);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        BatchMessage & message = messages[i];
+
+        if (message.header == NULL)
+        {
+            message.result = CHIP_ERROR_INVALID_ARGUMENT;
+        }
+        else
+        {
+            message.result = EncryptMessage(message.input, message.input_length, message.output, *message.header);
+        }
+
+        if (error == CHIP_NO_ERROR)
+        {
+            error = message.result;
+        }
+    }
+
+exit:
+    return error;
+}
+
+CHIP_ERROR SecureSession::EncryptMessage(const unsigned char * input, size_t input_length, unsigned char * output,
+                                         MessageHeader & header)
 {
     CHIP_ERROR error = CHIP_NO_ERROR;
     uint64_t tag     = 0;
     uint64_t IV      = SecureSession::GetIV(header);
 
-    VerifyOrExit(mKeyAvailable, error = CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
     VerifyOrExit(input != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(input_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(output != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    error = AES_CCM_encrypt(input, input_length, NULL, 0, mKey, sizeof(mKey), (const unsigned char *) &IV, sizeof(IV), output,
-                            (unsigned char *) &tag, sizeof(tag));
+    error = mCipher.Encrypt(input, input_length, NULL, 0, (const unsigned char *) &IV, sizeof(IV), output, (unsigned char *) &tag,
+                            sizeof(tag));
     SuccessOrExit(error);
 
     header.SetTag(MessageHeader::EncryptionType::kAESCCMTagLen8, (uint8_t *) &tag, sizeof(tag));
@@ -140,21 +229,20 @@ exit:
     return error;
 }
 
-CHIP_ERROR SecureSession::Decrypt(const unsigned char * input, size_t input_length, unsigned char * output,
-                                  const MessageHeader & header)
+CHIP_ERROR SecureSession::DecryptMessage(const unsigned char * input, size_t input_length, unsigned char * output,
+                                         const MessageHeader & header)
 {
     CHIP_ERROR error    = CHIP_NO_ERROR;
     size_t taglen       = header.GetTagLength();
     const uint8_t * tag = header.GetTag();
     uint64_t IV         = SecureSession::GetIV(header);
 
-    VerifyOrExit(mKeyAvailable, error = CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
     VerifyOrExit(input != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(input_length > 0, error = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(output != NULL, error = CHIP_ERROR_INVALID_ARGUMENT);
 
-    error = AES_CCM_decrypt(input, input_length, NULL, 0, (const unsigned char *) tag, taglen, mKey, sizeof(mKey),
-                            (const unsigned char *) &IV, sizeof(IV), output);
+    error = mCipher.Decrypt(input, input_length, NULL, 0, (const unsigned char *) tag, taglen, (const unsigned char *) &IV,
+                            sizeof(IV), output);
 exit:
     return error;
 }
@@ -27,6 +27,7 @@
 #define __SECURESESSION_H__
 
 #include <core/CHIPCore.h>
+#include <crypto/CHIPCryptoPAL.h>
 #include <transport/MessageHeader.h>
 
 namespace chip {
@@ -34,11 +35,24 @@ namespace chip {
 class DLL_EXPORT SecureSession
 {
 public:
+    /**
+     * One message of a batch passed to EncryptBatch. The fields have the same
+     * meaning as the arguments of Encrypt.
+     */
+    struct BatchMessage
+    {
+        const unsigned char * input;
+        size_t input_length;
+        unsigned char * output;
+        MessageHeader * header;
+        CHIP_ERROR result; ///< Set by the batch call to the outcome for this message
+    };
+
     SecureSession(void);
-    SecureSession(SecureSession &&)      = default;
-    SecureSession(const SecureSession &) = default;
-    SecureSession & operator=(const SecureSession &) = default;
-    SecureSession & operator=(SecureSession &&) = default;
+
+    // Copies get their own cipher context, keyed with the same session key.
+    SecureSession(const SecureSession & other);
+    SecureSession & operator=(const SecureSession & other);
 
     /**
      * @brief
@@ -85,14 +99,32 @@ public:
      * @brief
      *   Decrypt the input data using keys established in the secure channel
      *
+     *   Decryption may be done in place, by passing the same buffer as input and output.
+     *
      * @param input Encrypted input data
      * @param input_length Length of the input data
-     * @param output Output buffer for decrypted data
+     * @param output Output buffer for decrypted data, at least input_length bytes long. May be the same as input.
      * @param header message header structure
      * @return CHIP_ERROR The result of decryption
      */
     CHIP_ERROR Decrypt(const unsigned char * input, size_t input_length, unsigned char * output, const MessageHeader & header);
 
+    /**
+     * @brief
+     *   Encrypt several messages using keys established in the secure channel
+     *
+     *   The session key is checked once for the whole batch. Each message is then encrypted
+     *   with the session's keyed cipher context, as Encrypt does, so a batch saves no
+     *   per-message cipher work; it lets a sender that looks a peer up once encrypt all of
+     *   its messages in one call. A failure to encrypt one message does not stop the others
+     *   from being encrypted; the outcome for each message is stored in its result field.
+     *
+     * @param messages Messages to encrypt. The header of each message receives its tag.
+     * @param count Number of messages
+     * @return CHIP_ERROR CHIP_NO_ERROR if all messages were encrypted, otherwise the first error
+     */
+    CHIP_ERROR EncryptBatch(BatchMessage * messages, size_t count);
+
     /**
      * @brief
      *   Memory overhead of encrypting data. The overhead is indepedent of size of
@@ -129,7 +161,15 @@ private:
     bool mKeyAvailable;
     uint8_t mKey[kAES_CCM128_Key_Length];
 
+    // Keyed from mKey once the key is derived, and reused for every message of the session.
+    Crypto::AES_CCM_context mCipher;
+
     static uint64_t GetIV(const MessageHeader & header);
+
+    // Encrypt and Decrypt without the session key check, which callers do once per call or batch.
+    CHIP_ERROR EncryptMessage(const unsigned char * input, size_t input_length, unsigned char * output, MessageHeader & header);
+    CHIP_ERROR DecryptMessage(const unsigned char * input, size_t input_length, unsigned char * output,
+                              const MessageHeader & header);
 };
 
 } // namespace chip
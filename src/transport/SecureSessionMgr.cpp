@@ -95,7 +95,7 @@ CHIP_ERROR SecureSessionMgrBase::Connect(NodeId peerNodeId, const Transport::Pee
     err = mPeerConnections.CreateNewPeerConnectionState(peerAddress, &state);
     SuccessOrExit(err);
 
-    state->SetPeerNodeId(peerNodeId);
+    mPeerConnections.SetPeerNodeId(state, peerNodeId);
 
     if (mCB != nullptr)
     {
@@ -107,15 +107,25 @@ exit:
 }
 
 CHIP_ERROR SecureSessionMgrBase::SendMessage(NodeId peerNodeId, System::PacketBuffer * msgBuf)
+{
+    return SendMessages(peerNodeId, &msgBuf, 1);
+}
+
+CHIP_ERROR SecureSessionMgrBase::SendMessages(NodeId peerNodeId, System::PacketBuffer * const * msgBufs, size_t count)
 {
     CHIP_ERROR err              = CHIP_NO_ERROR;
     PeerConnectionState * state = nullptr;
+    size_t sent                 = 0; // Buffers before this index have been handed over to the transport
 
     VerifyOrExit(mState == State::kInitialized, err = CHIP_ERROR_INCORRECT_STATE);
 
-    VerifyOrExit(msgBuf != NULL, err = CHIP_ERROR_INVALID_ARGUMENT);
-    VerifyOrExit(msgBuf->Next() == NULL, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
-    VerifyOrExit(msgBuf->TotalLength() < kMax_SecureSDU_Length, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    VerifyOrExit(msgBufs != NULL, err = CHIP_ERROR_INVALID_ARGUMENT);
+    for (size_t i = 0; i < count; i++)
+    {
+        VerifyOrExit(msgBufs[i] != NULL, err = CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(msgBufs[i]->Next() == NULL, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+        VerifyOrExit(msgBufs[i]->TotalLength() < kMax_SecureSDU_Length, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+    }
 
     // Find an active connection to the specified peer node
     VerifyOrExit(mPeerConnections.FindPeerConnectionState(peerNodeId, &state), err = CHIP_ERROR_INVALID_DESTINATION_NODE_ID);
@@ -123,47 +133,57 @@ CHIP_ERROR SecureSessionMgrBase::SendMessage(NodeId peerNodeId, System::PacketBu
     // This marks any connection where we send data to as 'active'
     mPeerConnections.MarkConnectionActive(state);
 
+    while (sent < count)
     {
-        uint8_t * data = nullptr;
-        MessageHeader header;
-        const size_t headerSize = header.EncryptedHeaderSizeBytes();
-        size_t actualEncodedHeaderSize;
-        size_t totalLen = 0;
-        size_t taglen   = 0;
+        MessageHeader headers[CHIP_CONFIG_SECURE_SEND_BATCH_SIZE];
+        SecureSession::BatchMessage messages[CHIP_CONFIG_SECURE_SEND_BATCH_SIZE];
+        const size_t batchSize = (count - sent < ArraySize(messages)) ? count - sent : ArraySize(messages);
+        CHIP_ERROR prepareErr  = CHIP_NO_ERROR;
+        size_t prepared;
+
+        // The send index only advances once a message is sent, so the batch uses the ids that follow it
+        for (prepared = 0; prepared < batchSize; prepared++)
+        {
+            prepareErr = PrepareMessage(peerNodeId, state->GetSendMessageIndex() + static_cast<uint32_t>(prepared),
+                                        msgBufs[sent + prepared], headers[prepared], messages[prepared]);
+            if (prepareErr != CHIP_NO_ERROR)
+            {
+                break;
+            }
+        }
 
-        header
-            .SetSourceNodeId(mLocalNodeId)              //
-            .SetDestinationNodeId(peerNodeId)           //
-            .SetMessageId(state->GetSendMessageIndex()) //
-            .SetPayloadLength(headerSize + msgBuf->TotalLength());
+        // Failures are handled per message below, so that the messages before a failed one still go out
+        state->GetSecureSession().EncryptBatch(messages, prepared);
 
-        VerifyOrExit(msgBuf->EnsureReservedSize(headerSize), err = CHIP_ERROR_NO_MEMORY);
+        for (size_t i = 0; i < prepared; i++)
+        {
+            PacketBuffer * msgBuf = msgBufs[sent];
+            const size_t totalLen = messages[i].input_length;
+            size_t taglen         = 0;
 
-        msgBuf->SetStart(msgBuf->Start() - headerSize);
-        data     = msgBuf->Start();
-        totalLen = msgBuf->TotalLength();
+            err = messages[i].result;
+            SuccessOrExit(err);
 
-        err = header.EncodeEncryptedHeader(data, totalLen, &actualEncodedHeaderSize);
-        SuccessOrExit(err);
+            err = headers[i].EncodeMACTag(&msgBuf->Start()[totalLen], kMaxTagLen, &taglen);
+            SuccessOrExit(err);
 
-        err = state->GetSecureSession().Encrypt(data, totalLen, data, header);
-        SuccessOrExit(err);
+            msgBuf->SetDataLength(totalLen + taglen, NULL);
 
-        err = header.EncodeMACTag(&data[totalLen], kMaxTagLen, &taglen);
-        SuccessOrExit(err);
+            ChipLogProgress(Inet, "Secure transport transmitting msg %u after encryption", state->GetSendMessageIndex());
 
-        msgBuf->SetDataLength(totalLen + taglen, NULL);
+            sent++;
+            err = mTransport->SendMessage(headers[i], state->GetPeerAddress(), msgBuf);
+            SuccessOrExit(err);
 
-        ChipLogProgress(Inet, "Secure transport transmitting msg %u after encryption", state->GetSendMessageIndex());
+            state->IncrementSendMessageIndex();
+        }
 
-        err    = mTransport->SendMessage(header, state->GetPeerAddress(), msgBuf);
-        msgBuf = NULL;
+        err = prepareErr;
+        SuccessOrExit(err);
     }
-    SuccessOrExit(err);
-    state->IncrementSendMessageIndex();
 
 exit:
-    if (msgBuf != NULL)
+    if (msgBufs != NULL && sent < count)
     {
         const char * errStr = ErrorStr(err);
         if (state == nullptr)
@@ -172,15 +192,51 @@ exit:
         }
         else
         {
-            ChipLogProgress(Inet, "Secure transport failed to encrypt msg %u: %s", state->GetSendMessageIndex(), errStr);
+            // The send index still refers to the message that failed, whether it failed to encrypt or to send
+            ChipLogProgress(Inet, "Secure transport failed to send msg %u: %s", state->GetSendMessageIndex(), errStr);
+        }
+
+        for (size_t i = sent; i < count; i++)
+        {
+            if (msgBufs[i] != NULL)
+            {
+                PacketBuffer::Free(msgBufs[i]);
+            }
         }
-        PacketBuffer::Free(msgBuf);
-        msgBuf = NULL;
     }
 
     return err;
 }
 
+CHIP_ERROR SecureSessionMgrBase::PrepareMessage(NodeId peerNodeId, uint32_t messageId, System::PacketBuffer * msgBuf,
+                                                MessageHeader & header, SecureSession::BatchMessage & message)
+{
+    CHIP_ERROR err          = CHIP_NO_ERROR;
+    const size_t headerSize = header.EncryptedHeaderSizeBytes();
+    size_t actualEncodedHeaderSize;
+
+    header
+        .SetSourceNodeId(mLocalNodeId)    //
+        .SetDestinationNodeId(peerNodeId) //
+        .SetMessageId(messageId)          //
+        .SetPayloadLength(headerSize + msgBuf->TotalLength());
+
+    VerifyOrExit(msgBuf->EnsureReservedSize(headerSize), err = CHIP_ERROR_NO_MEMORY);
+
+    msgBuf->SetStart(msgBuf->Start() - headerSize);
+
+    err = header.EncodeEncryptedHeader(msgBuf->Start(), msgBuf->TotalLength(), &actualEncodedHeaderSize);
+    SuccessOrExit(err);
+
+    message.input        = msgBuf->Start();
+    message.input_length = msgBuf->TotalLength();
+    message.output       = msgBuf->Start();
+    message.header       = &header;
+
+exit:
+    return err;
+}
+
 CHIP_ERROR SecureSessionMgrBase::AllocateNewConnection(const MessageHeader & header, const PeerAddress & address,
                                                        Transport::PeerConnectionState ** state)
 {
@@ -191,7 +247,7 @@ CHIP_ERROR SecureSessionMgrBase::AllocateNewConnection(const MessageHeader & hea
 
     if (header.GetSourceNodeId().HasValue())
     {
-        (*state)->SetPeerNodeId(header.GetSourceNodeId().Value());
+        mPeerConnections.SetPeerNodeId(*state, header.GetSourceNodeId().Value());
     }
 
     if (mCB != nullptr)
@@ -205,8 +261,25 @@ exit:
 
 void SecureSessionMgrBase::ScheduleExpiryTimer(void)
 {
-    CHIP_ERROR err =
-        mSystemLayer->StartTimer(CHIP_PEER_CONNECTION_TIMEOUT_CHECK_FREQUENCY_MS, SecureSessionMgrBase::ExpiryTimerCallback, this);
+    // Connections created from now on cannot expire before a full timeout has elapsed, so
+    // only the least recently active connection can require an earlier check.
+    uint64_t delayMs            = CHIP_PEER_CONNECTION_TIMEOUT_MS;
+    PeerConnectionState * state = nullptr;
+
+    if (mPeerConnections.FindLeastRecentlyActiveConnection(&state))
+    {
+        const uint64_t now        = mPeerConnections.GetTimeSource().GetCurrentMonotonicTimeMs();
+        const uint64_t expiryTime = state->GetLastActivityTimeMs() + CHIP_PEER_CONNECTION_TIMEOUT_MS + 1;
+
+        delayMs = (expiryTime > now) ? (expiryTime - now) : 0;
+    }
+
+    if (delayMs < CHIP_PEER_CONNECTION_TIMEOUT_CHECK_FREQUENCY_MS)
+    {
+        delayMs = CHIP_PEER_CONNECTION_TIMEOUT_CHECK_FREQUENCY_MS;
+    }
+
+    CHIP_ERROR err = mSystemLayer->StartTimer(static_cast<uint32_t>(delayMs), SecureSessionMgrBase::ExpiryTimerCallback, this);
 
     VerifyOrDie(err == CHIP_NO_ERROR);
 }
@@ -223,9 +296,8 @@ void SecureSessionMgrBase::HandleDataReceived(MessageHeader & header, const Peer
                                               SecureSessionMgrBase * connection)
 
 {
-    CHIP_ERROR err                 = CHIP_NO_ERROR;
-    System::PacketBuffer * origMsg = nullptr;
-    PeerConnectionState * state    = nullptr;
+    CHIP_ERROR err              = CHIP_NO_ERROR;
+    PeerConnectionState * state = nullptr;
 
     VerifyOrExit(msg != nullptr, ChipLogError(Inet, "Secure transport received NULL packet, discarding"));
 
@@ -255,35 +327,46 @@ void SecureSessionMgrBase::HandleDataReceived(MessageHeader & header, const Peer
 
     // TODO this is where messages should be decoded
     {
-        uint8_t * data          = msg->Start();
-        uint8_t * plainText     = nullptr;
-        uint16_t len            = msg->TotalLength();
+        uint8_t * data          = nullptr;
+        uint16_t len            = 0;
         const size_t headerSize = header.EncryptedHeaderSizeBytes();
         size_t decodedSize      = 0;
         size_t taglen           = 0;
-#if CHIP_SYSTEM_CONFIG_USE_LWIP
-        /* This is a workaround for the case where PacketBuffer payload is not
-           allocated as an inline buffer to PacketBuffer structure */
-        origMsg = msg;
-        msg     = PacketBuffer::NewWithAvailableSize(len);
-        msg->SetDataLength(len, msg);
-#endif
-        plainText = msg->Start();
-
-        err = header.DecodeMACTag(&data[header.GetPayloadLength()], kMaxTagLen, &taglen);
+
+        // The message is decrypted in place, which requires the whole of it in the first buffer of the chain.
+        if (msg->Next() != nullptr)
+        {
+            msg->CompactHead();
+        }
+        VerifyOrExit(msg->Next() == nullptr, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+        // Replayed and stale messages are dropped before paying for their decryption
+        err = state->GetReceiveWindow().Check(header.GetMessageId());
+        VerifyOrExit(err == CHIP_NO_ERROR,
+                     ChipLogProgress(Inet, "Secure transport dropped duplicate msg %u", header.GetMessageId()));
+
+        data = msg->Start();
+        len  = msg->DataLength();
+
+        VerifyOrExit(header.GetPayloadLength() <= len, err = CHIP_ERROR_INVALID_MESSAGE_LENGTH);
+
+        err = header.DecodeMACTag(&data[header.GetPayloadLength()], len - header.GetPayloadLength(), &taglen);
         VerifyOrExit(err == CHIP_NO_ERROR, ChipLogProgress(Inet, "Secure transport failed to decode MAC Tag: err %d", err));
         len -= taglen;
         msg->SetDataLength(len, NULL);
 
-        err = state->GetSecureSession().Decrypt(data, len, plainText, header);
+        err = state->GetSecureSession().Decrypt(data, len, data, header);
         VerifyOrExit(err == CHIP_NO_ERROR, ChipLogProgress(Inet, "Secure transport failed to decrypt msg: err %d", err));
 
-        err = header.DecodeEncryptedHeader(plainText, headerSize, &decodedSize);
+        err = header.DecodeEncryptedHeader(data, headerSize, &decodedSize);
         VerifyOrExit(err == CHIP_NO_ERROR,
                      ChipLogProgress(Inet, "Secure transport failed to decode encrypted header: err %d", err));
         VerifyOrExit(headerSize == decodedSize,
                      ChipLogProgress(Inet, "Secure transport decode encrypted header length mismatched"));
 
+        // Only authenticated messages may move the window
+        state->GetReceiveWindow().Commit(header.GetMessageId());
+
         msg->ConsumeHead(headerSize);
 
         if (connection->mCB != nullptr)
@@ -294,11 +377,6 @@ void SecureSessionMgrBase::HandleDataReceived(MessageHeader & header, const Peer
     }
 
 exit:
-    if (origMsg != nullptr)
-    {
-        PacketBuffer::Free(origMsg);
-    }
-
     if (msg != nullptr)
     {
         PacketBuffer::Free(msg);
@@ -106,6 +106,20 @@ public:
      */
     CHIP_ERROR SendMessage(NodeId peerNodeId, System::PacketBuffer * msgBuf);
 
+    /**
+     * @brief
+     *   Send several messages, in order, to a currently connected peer
+     *
+     * @details
+     *   The messages get consecutive message ids and are encrypted together, in batches of
+     *   up to CHIP_CONFIG_SECURE_SEND_BATCH_SIZE messages. Sending stops at the first message
+     *   that cannot be encrypted or sent; the messages after it are dropped.
+     *
+     *   This method calls <tt>chip::System::PacketBuffer::Free</tt> on
+     *   behalf of the caller for every message regardless of the return status.
+     */
+    CHIP_ERROR SendMessages(NodeId peerNodeId, System::PacketBuffer * const * msgBufs, size_t count);
+
     SecureSessionMgrBase();
     virtual ~SecureSessionMgrBase();
 
@@ -154,7 +168,12 @@ private:
 
     SecureSessionMgrCallback * mCB = nullptr;
 
-    /** Schedules a new oneshot timer for checking connection expiry. */
+    /**
+     * Schedules a new oneshot timer for checking connection expiry.
+     *
+     * The timer fires when the least recently active connection is due, but not sooner than
+     * CHIP_PEER_CONNECTION_TIMEOUT_CHECK_FREQUENCY_MS.
+     */
     void ScheduleExpiryTimer(void);
 
     /** Cancels any active timers for connection expiry checks. */
@@ -170,6 +189,18 @@ private:
     CHIP_ERROR AllocateNewConnection(const MessageHeader & header, const Transport::PeerAddress & address,
                                      Transport::PeerConnectionState ** state);
 
+    /**
+     * Fills in the header of a message about to be sent, and prepends its encrypted part to the message.
+     *
+     * @param peerNodeId Node the message is sent to
+     * @param messageId Message id to use for the message
+     * @param msgBuf The message, which must fit in a single buffer
+     * @param header [out] The header of the message
+     * @param message [out] Describes the part of the message to encrypt
+     */
+    CHIP_ERROR PrepareMessage(NodeId peerNodeId, uint32_t messageId, System::PacketBuffer * msgBuf, MessageHeader & header,
+                              SecureSession::BatchMessage & message);
+
     static void HandleDataReceived(MessageHeader & header, const Transport::PeerAddress & source, System::PacketBuffer * msgBuf,
                                    SecureSessionMgrBase * transport);
 
@@ -0,0 +1,175 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a process to effect a functional test for
+ *      the MessageCounterWindow class within the transport layer
+ *
+ */
+#include "TestTransportLayer.h"
+
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+#include <transport/MessageCounterWindow.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Transport;
+
+constexpr uint32_t kWindowSize = MessageCounterWindow::kWindowSize;
+
+// Checks a counter and commits it if accepted, as done for a received message that authenticates
+bool Receive(MessageCounterWindow & window, uint32_t counter)
+{
+    if (window.Check(counter) != CHIP_NO_ERROR)
+    {
+        return false;
+    }
+
+    window.Commit(counter);
+    return true;
+}
+
+void TestInOrder(nlTestSuite * inSuite, void * inContext)
+{
+    MessageCounterWindow window;
+
+    // Any counter is accepted first
+    NL_TEST_ASSERT(inSuite, Receive(window, 1000));
+
+    for (uint32_t counter = 1001; counter < 1001 + 3 * kWindowSize; counter++)
+    {
+        NL_TEST_ASSERT(inSuite, Receive(window, counter));
+        NL_TEST_ASSERT(inSuite, window.Check(counter) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+        NL_TEST_ASSERT(inSuite, window.Check(counter - 1) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+    }
+}
+
+void TestOutOfOrder(nlTestSuite * inSuite, void * inContext)
+{
+    MessageCounterWindow window;
+
+    NL_TEST_ASSERT(inSuite, Receive(window, 10));
+    NL_TEST_ASSERT(inSuite, Receive(window, 15));
+
+    // Counters skipped inside the window are still accepted, once
+    NL_TEST_ASSERT(inSuite, Receive(window, 12));
+    NL_TEST_ASSERT(inSuite, !Receive(window, 12));
+    NL_TEST_ASSERT(inSuite, Receive(window, 11));
+    NL_TEST_ASSERT(inSuite, Receive(window, 13));
+    NL_TEST_ASSERT(inSuite, Receive(window, 14));
+    NL_TEST_ASSERT(inSuite, !Receive(window, 10));
+    NL_TEST_ASSERT(inSuite, !Receive(window, 15));
+
+    // Counters below the first one received are accepted while they are inside the window
+    NL_TEST_ASSERT(inSuite, Receive(window, 9));
+}
+
+void TestWindowEdge(nlTestSuite * inSuite, void * inContext)
+{
+    MessageCounterWindow window;
+    const uint32_t top = 5 * kWindowSize;
+
+    NL_TEST_ASSERT(inSuite, Receive(window, top));
+
+    // The oldest counter inside the window is accepted, the next older one is too old to tell
+    NL_TEST_ASSERT(inSuite, window.Check(top - (kWindowSize - 1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, window.Check(top - kWindowSize) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+
+    // Slide the window by less than a word, by a whole word and by more than a word, checking
+    // that marked counters move with it
+    NL_TEST_ASSERT(inSuite, Receive(window, top + 5));
+    NL_TEST_ASSERT(inSuite, window.Check(top) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+    NL_TEST_ASSERT(inSuite, window.Check(top + 1) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, Receive(window, top + 5 + 32));
+    NL_TEST_ASSERT(inSuite, window.Check(top) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+    NL_TEST_ASSERT(inSuite, window.Check(top + 5) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+    NL_TEST_ASSERT(inSuite, window.Check(top + 6) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, Receive(window, top + 5 + 32 + 45));
+    NL_TEST_ASSERT(inSuite, window.Check(top + 5 + 32) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+    NL_TEST_ASSERT(inSuite, window.Check(top + 5 + 33) == CHIP_NO_ERROR);
+
+    // A jump larger than the window forgets everything before it
+    NL_TEST_ASSERT(inSuite, Receive(window, top + 10 * kWindowSize));
+    NL_TEST_ASSERT(inSuite, window.Check(top + 10 * kWindowSize - 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, window.Check(top + 5 + 32 + 45) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+}
+
+void TestWrapAround(nlTestSuite * inSuite, void * inContext)
+{
+    MessageCounterWindow window;
+
+    NL_TEST_ASSERT(inSuite, Receive(window, 0xfffffffe));
+    NL_TEST_ASSERT(inSuite, Receive(window, 0xffffffff));
+    NL_TEST_ASSERT(inSuite, Receive(window, 0));
+    NL_TEST_ASSERT(inSuite, Receive(window, 2));
+    NL_TEST_ASSERT(inSuite, !Receive(window, 0xffffffff));
+    NL_TEST_ASSERT(inSuite, Receive(window, 1));
+    NL_TEST_ASSERT(inSuite, !Receive(window, 0xfffffffe));
+    NL_TEST_ASSERT(inSuite, window.Check(0xfffffffd) == CHIP_NO_ERROR);
+}
+
+void TestReset(nlTestSuite * inSuite, void * inContext)
+{
+    MessageCounterWindow window;
+
+    NL_TEST_ASSERT(inSuite, Receive(window, 100));
+    NL_TEST_ASSERT(inSuite, !Receive(window, 100));
+
+    // A failed check leaves the window untouched, and only Commit moves it
+    NL_TEST_ASSERT(inSuite, window.Check(500) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, window.Check(100) == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+
+    // After a reset, the next counter starts a new window wherever it is
+    window.Reset();
+    NL_TEST_ASSERT(inSuite, Receive(window, 100 + 2 * kWindowSize));
+    window.Reset();
+    NL_TEST_ASSERT(inSuite, Receive(window, 100));
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("InOrder", TestInOrder),
+    NL_TEST_DEF("OutOfOrder", TestOutOfOrder),
+    NL_TEST_DEF("WindowEdge", TestWindowEdge),
+    NL_TEST_DEF("WrapAround", TestWrapAround),
+    NL_TEST_DEF("Reset", TestReset),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestMessageCounterWindowFn(void)
+{
+    nlTestSuite theSuite = { "Transport-MessageCounterWindow", &sTests[0], NULL, NULL };
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
+
+static void __attribute__((constructor)) TestMessageCounterWindowCtor(void)
+{
+    VerifyOrDie(RegisterUnitTests(&TestMessageCounterWindowFn) == CHIP_NO_ERROR);
+}
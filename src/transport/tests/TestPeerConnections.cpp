@@ -103,11 +103,11 @@ void TestFindByNodeId(nlTestSuite * inSuite, void * inContext)
 
     err = connections.CreateNewPeerConnectionState(kPeer1Addr, &statePtr);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
-    statePtr->SetPeerNodeId(kPeer1NodeId);
+    connections.SetPeerNodeId(statePtr, kPeer1NodeId);
 
     err = connections.CreateNewPeerConnectionState(kPeer2Addr, &statePtr);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
-    statePtr->SetPeerNodeId(kPeer2NodeId);
+    connections.SetPeerNodeId(statePtr, kPeer2NodeId);
 
     NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer1NodeId, &statePtr));
     NL_TEST_ASSERT(inSuite, statePtr->GetPeerAddress() == kPeer1Addr);
@@ -152,7 +152,7 @@ void TestExpireConnections(nlTestSuite * inSuite, void * inContext)
     connections.GetTimeSource().SetCurrentMonotonicTimeMs(200);
     err = connections.CreateNewPeerConnectionState(kPeer2Addr, &statePtr);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
-    statePtr->SetPeerNodeId(kPeer2NodeId);
+    connections.SetPeerNodeId(statePtr, kPeer2NodeId);
 
     // cannot add before expiry
     connections.GetTimeSource().SetCurrentMonotonicTimeMs(300);
@@ -170,7 +170,7 @@ void TestExpireConnections(nlTestSuite * inSuite, void * inContext)
     connections.GetTimeSource().SetCurrentMonotonicTimeMs(300);
     err = connections.CreateNewPeerConnectionState(kPeer3Addr, &statePtr);
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
-    statePtr->SetPeerNodeId(kPeer3NodeId);
+    connections.SetPeerNodeId(statePtr, kPeer3NodeId);
 
     connections.GetTimeSource().SetCurrentMonotonicTimeMs(400);
     NL_TEST_ASSERT(inSuite, connections.FindPeerConnectionState(kPeer2NodeId, &statePtr));
@@ -210,6 +210,59 @@ void TestExpireConnections(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, !connections.FindPeerConnectionState(kPeer3Addr, &statePtr));
 }
 
+void TestLeastRecentlyActive(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_ERROR err;
+    ExpiredCallInfo callInfo;
+    PeerConnectionState * statePtr;
+    PeerConnectionState * peer1State;
+    PeerConnections<3, Time::Source::kTest> connections;
+
+    connections.SetConnectionExpiredHandler(OnConnectionExpired, &callInfo);
+
+    NL_TEST_ASSERT(inSuite, !connections.FindLeastRecentlyActiveConnection(&statePtr));
+    NL_TEST_ASSERT(inSuite, statePtr == nullptr);
+
+    connections.GetTimeSource().SetCurrentMonotonicTimeMs(100);
+    err = connections.CreateNewPeerConnectionState(kPeer1Addr, &peer1State);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    connections.GetTimeSource().SetCurrentMonotonicTimeMs(200);
+    err = connections.CreateNewPeerConnectionState(kPeer2Addr, nullptr);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    connections.GetTimeSource().SetCurrentMonotonicTimeMs(300);
+    err = connections.CreateNewPeerConnectionState(kPeer3Addr, nullptr);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, connections.FindLeastRecentlyActiveConnection(&statePtr));
+    NL_TEST_ASSERT(inSuite, statePtr->GetPeerAddress() == kPeer1Addr);
+
+    // Activity moves peer 1 behind the other connections
+    connections.GetTimeSource().SetCurrentMonotonicTimeMs(400);
+    connections.MarkConnectionActive(peer1State);
+    NL_TEST_ASSERT(inSuite, connections.FindLeastRecentlyActiveConnection(&statePtr));
+    NL_TEST_ASSERT(inSuite, statePtr->GetPeerAddress() == kPeer2Addr);
+
+    // at time 450, only peer 2 has been idle for more than 200ms
+    connections.GetTimeSource().SetCurrentMonotonicTimeMs(450);
+    connections.ExpireInactiveConnections(200);
+    NL_TEST_ASSERT(inSuite, callInfo.callCount == 1);
+    NL_TEST_ASSERT(inSuite, callInfo.lastCallPeerAddress == kPeer2Addr);
+    NL_TEST_ASSERT(inSuite, connections.FindLeastRecentlyActiveConnection(&statePtr));
+    NL_TEST_ASSERT(inSuite, statePtr->GetPeerAddress() == kPeer3Addr);
+
+    // Expiring a connection directly also removes it from the idle order
+    connections.MarkConnectionExpired(statePtr);
+    NL_TEST_ASSERT(inSuite, connections.FindLeastRecentlyActiveConnection(&statePtr));
+    NL_TEST_ASSERT(inSuite, statePtr == peer1State);
+
+    connections.GetTimeSource().SetCurrentMonotonicTimeMs(1000);
+    connections.ExpireInactiveConnections(200);
+    NL_TEST_ASSERT(inSuite, callInfo.callCount == 3);
+    NL_TEST_ASSERT(inSuite, !connections.FindLeastRecentlyActiveConnection(&statePtr));
+}
+
 } // namespace
 
 // clang-format off
@@ -219,6 +272,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("FindByPeerAddress", TestFindByAddress),
     NL_TEST_DEF("FindByNodeId", TestFindByNodeId),
     NL_TEST_DEF("ExpireConnections", TestExpireConnections),
+    NL_TEST_DEF("LeastRecentlyActive", TestLeastRecentlyActive),
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -0,0 +1,274 @@
+/*
+ *
+ *    Copyright (c) 2020 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a benchmark comparing the cost of looking up
+ *      peers in PeerConnections against a linear scan over the same number
+ *      of connection states.
+ *
+ *      Timings are only reported; the assertions verify that every lookup
+ *      resolves to the expected connection.
+ */
+#include "TestTransportLayer.h"
+
+#include <inttypes.h>
+#include <new>
+
+#include <support/BenchmarkUtils.h>
+#include <support/CodeUtils.h>
+#include <support/TestUtils.h>
+#include <support/logging/CHIPLogging.h>
+#include <transport/PeerConnections.h>
+
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::Transport;
+
+constexpr size_t kLookupRounds = 16;
+
+PeerAddress AddressForPeer(size_t index)
+{
+    Inet::IPAddress addr;
+
+    addr.Addr[0] = 0xfd000000;
+    addr.Addr[1] = 0;
+    addr.Addr[2] = 0;
+    addr.Addr[3] = static_cast<uint32_t>(index + 1);
+
+    return PeerAddress::UDP(addr);
+}
+
+NodeId NodeIdForPeer(size_t index)
+{
+    return 0x1000 + index;
+}
+
+/**
+ * Reference implementation: the slot walk previously done by PeerConnections.
+ */
+template <size_t kPeerCount>
+class LinearPeerTable
+{
+public:
+    void Add(size_t index, const PeerAddress & address, NodeId nodeId)
+    {
+        mStates[index]  = PeerConnectionState(address);
+        mNodeIds[index] = nodeId;
+    }
+
+    PeerConnectionState * Find(const PeerAddress & address)
+    {
+        for (size_t i = 0; i < kPeerCount; i++)
+        {
+            if (mStates[i].GetPeerAddress() == address)
+            {
+                return &mStates[i];
+            }
+        }
+        return nullptr;
+    }
+
+    PeerConnectionState * Find(NodeId nodeId)
+    {
+        for (size_t i = 0; i < kPeerCount; i++)
+        {
+            if (mStates[i].GetPeerAddress().IsInitialized() && mNodeIds[i] == nodeId)
+            {
+                return &mStates[i];
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    PeerConnectionState mStates[kPeerCount];
+    NodeId mNodeIds[kPeerCount];
+};
+
+template <size_t kPeerCount>
+void BenchmarkPeerCount(nlTestSuite * inSuite)
+{
+    constexpr size_t kLookups = kLookupRounds * kPeerCount;
+
+    CHIP_ERROR err;
+    PeerConnectionState * statePtr;
+    uint64_t start;
+    size_t matches;
+
+    // Tables holding thousands of peers are too large for test stacks, and may not fit
+    // at all on embedded targets running the whole test library.
+    auto * connections = new (std::nothrow) PeerConnections<kPeerCount, Time::Source::kTest>();
+    auto * linear      = new (std::nothrow) LinearPeerTable<kPeerCount>();
+
+    VerifyOrExit(connections != nullptr && linear != nullptr,
+                 ChipLogProgress(Inet, "%4u peers: not enough memory, skipped", static_cast<unsigned>(kPeerCount)));
+
+    for (size_t i = 0; i < kPeerCount; i++)
+    {
+        err = connections->CreateNewPeerConnectionState(AddressForPeer(i), &statePtr);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+        VerifyOrExit(err == CHIP_NO_ERROR, );
+        connections->SetPeerNodeId(statePtr, NodeIdForPeer(i));
+
+        linear->Add(i, AddressForPeer(i), NodeIdForPeer(i));
+    }
+
+    {
+        uint64_t indexedAddressNs, indexedNodeIdNs, linearAddressNs, linearNodeIdNs;
+
+        matches = 0;
+        start   = Benchmark::NowNs();
+        for (size_t round = 0; round < kLookupRounds; round++)
+        {
+            for (size_t i = 0; i < kPeerCount; i++)
+            {
+                if (connections->FindPeerConnectionState(AddressForPeer(i), &statePtr) &&
+                    statePtr->GetPeerNodeId() == NodeIdForPeer(i))
+                {
+                    matches++;
+                }
+            }
+        }
+        indexedAddressNs = Benchmark::NanosecondsPerOp(start, kLookups);
+        NL_TEST_ASSERT(inSuite, matches == kLookups);
+
+        matches = 0;
+        start   = Benchmark::NowNs();
+        for (size_t round = 0; round < kLookupRounds; round++)
+        {
+            for (size_t i = 0; i < kPeerCount; i++)
+            {
+                if (connections->FindPeerConnectionState(NodeIdForPeer(i), &statePtr) &&
+                    statePtr->GetPeerAddress() == AddressForPeer(i))
+                {
+                    matches++;
+                }
+            }
+        }
+        indexedNodeIdNs = Benchmark::NanosecondsPerOp(start, kLookups);
+        NL_TEST_ASSERT(inSuite, matches == kLookups);
+
+        matches = 0;
+        start   = Benchmark::NowNs();
+        for (size_t round = 0; round < kLookupRounds; round++)
+        {
+            for (size_t i = 0; i < kPeerCount; i++)
+            {
+                if (linear->Find(AddressForPeer(i)) != nullptr)
+                {
+                    matches++;
+                }
+            }
+        }
+        linearAddressNs = Benchmark::NanosecondsPerOp(start, kLookups);
+        NL_TEST_ASSERT(inSuite, matches == kLookups);
+
+        matches = 0;
+        start   = Benchmark::NowNs();
+        for (size_t round = 0; round < kLookupRounds; round++)
+        {
+            for (size_t i = 0; i < kPeerCount; i++)
+            {
+                if (linear->Find(NodeIdForPeer(i)) != nullptr)
+                {
+                    matches++;
+                }
+            }
+        }
+        linearNodeIdNs = Benchmark::NanosecondsPerOp(start, kLookups);
+        NL_TEST_ASSERT(inSuite, matches == kLookups);
+
+        ChipLogProgress(Inet,
+                        "%4u peers: indexed address %" PRIu64 " ns, node id %" PRIu64 " ns | linear address %" PRIu64
+                        " ns, node id %" PRIu64 " ns (per lookup)",
+                        static_cast<unsigned>(kPeerCount), indexedAddressNs, indexedNodeIdNs, linearAddressNs, linearNodeIdNs);
+    }
+
+    // Expire every other peer and make sure the indexes stay consistent for the remaining ones
+    for (size_t i = 0; i < kPeerCount; i += 2)
+    {
+        NL_TEST_ASSERT(inSuite, connections->FindPeerConnectionState(NodeIdForPeer(i), &statePtr));
+        VerifyOrExit(statePtr != nullptr, );
+        connections->MarkConnectionExpired(statePtr);
+    }
+
+    for (size_t i = 0; i < kPeerCount; i++)
+    {
+        const bool expectFound = (i % 2) != 0;
+
+        NL_TEST_ASSERT(inSuite, connections->FindPeerConnectionState(AddressForPeer(i), &statePtr) == expectFound);
+        NL_TEST_ASSERT(inSuite, connections->FindPeerConnectionState(NodeIdForPeer(i), &statePtr) == expectFound);
+        NL_TEST_ASSERT(inSuite, !expectFound || statePtr->GetPeerAddress() == AddressForPeer(i));
+    }
+
+    // Freed slots are reusable
+    for (size_t i = 0; i < kPeerCount; i += 2)
+    {
+        err = connections->CreateNewPeerConnectionState(AddressForPeer(i), nullptr);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+    err = connections->CreateNewPeerConnectionState(AddressForPeer(kPeerCount), nullptr);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_NO_MEMORY);
+
+exit:
+    delete connections;
+    delete linear;
+}
+
+void TestLookup16Peers(nlTestSuite * inSuite, void * inContext)
+{
+    BenchmarkPeerCount<16>(inSuite);
+}
+
+void TestLookup256Peers(nlTestSuite * inSuite, void * inContext)
+{
+    BenchmarkPeerCount<256>(inSuite);
+}
+
+void TestLookup4096Peers(nlTestSuite * inSuite, void * inContext)
+{
+    BenchmarkPeerCount<4096>(inSuite);
+}
+
+} // namespace
+
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("Lookup16Peers", TestLookup16Peers),
+    NL_TEST_DEF("Lookup256Peers", TestLookup256Peers),
+    NL_TEST_DEF("Lookup4096Peers", TestLookup4096Peers),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestPeerConnectionsBenchmarkFn(void)
+{
+    nlTestSuite theSuite = { "Transport-PeerConnectionsBenchmark", &sTests[0], NULL, NULL };
+    nlTestRunner(&theSuite, NULL);
+    return nlTestRunnerStats(&theSuite);
+}
+
+static void __attribute__((constructor)) TestPeerConnectionsBenchmarkCtor(void)
+{
+    VerifyOrDie(RegisterUnitTests(&TestPeerConnectionsBenchmarkFn) == CHIP_NO_ERROR);
+}
@@ -172,6 +172,110 @@ void SecureChannelDecryptTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, memcmp(plain_text, output, sizeof(plain_text)) == 0);
 }
 
+void SecureChannelDecryptInPlaceTest(nlTestSuite * inSuite, void * inContext)
+{
+    SecureSession channel;
+    const unsigned char plain_text[] = { 0x86, 0x74, 0x64, 0xe5, 0x0b, 0xd4, 0x0d, 0x90,
+                                         0xe1, 0x17, 0xa3, 0x2d, 0x4b, 0xd4, 0xe1, 0xe6 };
+    unsigned char buffer[sizeof(plain_text)];
+    MessageHeader header;
+
+    const char * info = "Test Info";
+    const char * salt = "Test Salt";
+
+    NL_TEST_ASSERT(inSuite,
+                   channel.Init(secure_channel_test_public_key1, sizeof(secure_channel_test_public_key1),
+                                secure_channel_test_private_key2, sizeof(secure_channel_test_private_key2),
+                                (const unsigned char *) salt, sizeof(salt), (const unsigned char *) info,
+                                sizeof(info)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, channel.Encrypt(plain_text, sizeof(plain_text), buffer, header) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(plain_text, buffer, sizeof(plain_text)) != 0);
+
+    SecureSession channel2;
+    NL_TEST_ASSERT(inSuite,
+                   channel2.Init(secure_channel_test_public_key2, sizeof(secure_channel_test_public_key2),
+                                 secure_channel_test_private_key1, sizeof(secure_channel_test_private_key1),
+                                 (const unsigned char *) salt, sizeof(salt), (const unsigned char *) info,
+                                 sizeof(info)) == CHIP_NO_ERROR);
+
+    // The ciphertext is replaced by the plain text
+    NL_TEST_ASSERT(inSuite, channel2.Decrypt(buffer, sizeof(buffer), buffer, header) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, memcmp(plain_text, buffer, sizeof(plain_text)) == 0);
+}
+
+void SecureChannelBatchTest(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kMessageCount = 4;
+
+    SecureSession channel;
+    SecureSession channel2;
+    unsigned char plain_text[kMessageCount][16];
+    unsigned char buffers[kMessageCount][16];
+    MessageHeader headers[kMessageCount];
+    SecureSession::BatchMessage messages[kMessageCount];
+
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        memset(plain_text[i], static_cast<int>(0x40 + i), sizeof(plain_text[i]));
+        memcpy(buffers[i], plain_text[i], sizeof(buffers[i]));
+        headers[i].SetMessageId(static_cast<uint32_t>(i));
+
+        messages[i].input        = buffers[i];
+        messages[i].input_length = sizeof(buffers[i]);
+        messages[i].output       = buffers[i];
+        messages[i].header       = &headers[i];
+    }
+
+    // Every message reports the uninitialized channel
+    NL_TEST_ASSERT(inSuite, channel.EncryptBatch(messages, kMessageCount) == CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+    NL_TEST_ASSERT(inSuite, messages[kMessageCount - 1].result == CHIP_ERROR_INVALID_USE_OF_SESSION_KEY);
+
+    const char * info = "Test Info";
+    const char * salt = "Test Salt";
+
+    NL_TEST_ASSERT(inSuite,
+                   channel.Init(secure_channel_test_public_key1, sizeof(secure_channel_test_public_key1),
+                                secure_channel_test_private_key2, sizeof(secure_channel_test_private_key2),
+                                (const unsigned char *) salt, sizeof(salt), (const unsigned char *) info,
+                                sizeof(info)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   channel2.Init(secure_channel_test_public_key2, sizeof(secure_channel_test_public_key2),
+                                 secure_channel_test_private_key1, sizeof(secure_channel_test_private_key1),
+                                 (const unsigned char *) salt, sizeof(salt), (const unsigned char *) info,
+                                 sizeof(info)) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, channel.EncryptBatch(NULL, 1) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, channel.EncryptBatch(messages, kMessageCount) == CHIP_NO_ERROR);
+
+    // A batch gives the same result as encrypting the messages one at a time
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        unsigned char encrypted[sizeof(plain_text[i])];
+        MessageHeader header;
+
+        header.SetMessageId(static_cast<uint32_t>(i));
+        NL_TEST_ASSERT(inSuite, messages[i].result == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, channel.Encrypt(plain_text[i], sizeof(plain_text[i]), encrypted, header) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, memcmp(encrypted, buffers[i], sizeof(encrypted)) == 0);
+        NL_TEST_ASSERT(inSuite, memcmp(header.GetTag(), headers[i].GetTag(), header.GetTagLength()) == 0);
+    }
+
+    // Each message of the batch decrypts on its own, and a tampered one fails authentication
+    buffers[1][0] ^= 0x01;
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        if (i == 1)
+        {
+            NL_TEST_ASSERT(inSuite, channel2.Decrypt(buffers[i], sizeof(buffers[i]), buffers[i], headers[i]) != CHIP_NO_ERROR);
+        }
+        else
+        {
+            NL_TEST_ASSERT(inSuite, channel2.Decrypt(buffers[i], sizeof(buffers[i]), buffers[i], headers[i]) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, memcmp(plain_text[i], buffers[i], sizeof(plain_text[i])) == 0);
+        }
+    }
+}
+
 // Test Suite
 
 /**
@@ -180,9 +284,11 @@ void SecureChannelDecryptTest(nlTestSuite * inSuite, void * inContext)
 // clang-format off
 static const nlTest sTests[] =
 {
-    NL_TEST_DEF("Init",    SecureChannelInitTest),
-    NL_TEST_DEF("Encrypt", SecureChannelEncryptTest),
-    NL_TEST_DEF("Decrypt", SecureChannelDecryptTest),
+    NL_TEST_DEF("Init",           SecureChannelInitTest),
+    NL_TEST_DEF("Encrypt",        SecureChannelEncryptTest),
+    NL_TEST_DEF("Decrypt",        SecureChannelDecryptTest),
+    NL_TEST_DEF("DecryptInPlace", SecureChannelDecryptInPlaceTest),
+    NL_TEST_DEF("Batch",          SecureChannelBatchTest),
 
     NL_TEST_SENTINEL()
 };
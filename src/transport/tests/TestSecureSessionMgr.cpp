@@ -72,6 +72,29 @@ public:
     bool CanSendToPeer(const PeerAddress & address) override { return true; }
 };
 
+/// Delivers every message twice, as an attacker replaying captured messages would
+class ReplayingLoopbackTransport : public Transport::Base
+{
+public:
+    CHIP_ERROR Init(const char * unused) { return CHIP_NO_ERROR; }
+
+    CHIP_ERROR SendMessage(const MessageHeader & header, const PeerAddress & address, System::PacketBuffer * msgBuf) override
+    {
+        MessageHeader replayHeader           = header;
+        System::PacketBuffer * replayedMsgBuf = System::PacketBuffer::NewWithAvailableSize(msgBuf->DataLength());
+
+        VerifyOrDie(replayedMsgBuf != nullptr);
+        memcpy(replayedMsgBuf->Start(), msgBuf->Start(), msgBuf->DataLength());
+        replayedMsgBuf->SetDataLength(msgBuf->DataLength());
+
+        HandleMessageReceived(header, address, msgBuf);
+        HandleMessageReceived(replayHeader, address, replayedMsgBuf);
+        return CHIP_NO_ERROR;
+    }
+
+    bool CanSendToPeer(const PeerAddress & address) override { return true; }
+};
+
 class TestSessMgrCallback : public SecureSessionMgrCallback
 {
 public:
@@ -90,6 +113,12 @@ public:
         ReceiveHandlerCallCount++;
     }
 
+    virtual void OnReceiveError(CHIP_ERROR error, const PeerAddress & source, SecureSessionMgrBase * mgr)
+    {
+        LastReceiveError = error;
+        ReceiveErrorCallCount++;
+    }
+
     virtual void OnNewConnection(PeerConnectionState * state, SecureSessionMgrBase * mgr)
     {
         CHIP_ERROR err;
@@ -104,6 +133,8 @@ public:
     nlTestSuite * mSuite              = nullptr;
     int ReceiveHandlerCallCount       = 0;
     int NewConnectionHandlerCallCount = 0;
+    int ReceiveErrorCallCount         = 0;
+    CHIP_ERROR LastReceiveError       = CHIP_NO_ERROR;
 };
 
 TestSessMgrCallback callback;
@@ -163,6 +194,106 @@ void CheckMessageTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == 1);
 }
 
+void CheckMessageBatchTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    // More messages than are encrypted together, so that the batch is split
+    constexpr size_t kMessageCount = CHIP_CONFIG_SECURE_SEND_BATCH_SIZE * 2 + 1;
+
+    size_t payload_len = sizeof(PAYLOAD);
+    chip::System::PacketBuffer * buffers[kMessageCount];
+
+    ctx.GetInetLayer().SystemLayer()->Init(NULL);
+
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    SecureSessionMgr<LoopbackTransport> conn;
+
+    err = conn.Init(kSourceNodeId, ctx.GetInetLayer().SystemLayer(), "LOOPBACK");
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    callback.mSuite = inSuite;
+
+    conn.SetDelegate(&callback);
+
+    err = conn.Connect(kDestinationNodeId, PeerAddress::UDP(addr));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        buffers[i] = chip::System::PacketBuffer::NewWithAvailableSize(payload_len);
+        memmove(buffers[i]->Start(), PAYLOAD, payload_len);
+        buffers[i]->SetDataLength(payload_len);
+    }
+
+    callback.ReceiveHandlerCallCount = 0;
+
+    err = conn.SendMessages(kDestinationNodeId, buffers, kMessageCount);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    ctx.DriveIOUntil(1000 /* ms */, []() { return callback.ReceiveHandlerCallCount == kMessageCount; });
+
+    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == kMessageCount);
+
+    // An invalid buffer rejects the whole batch, and the valid buffers are still released
+    buffers[0] = chip::System::PacketBuffer::NewWithAvailableSize(payload_len);
+    buffers[1] = NULL;
+
+    err = conn.SendMessages(kDestinationNodeId, buffers, 2);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == kMessageCount);
+}
+
+void CheckReplayedMessageTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    constexpr int kMessageCount = 3;
+
+    size_t payload_len = sizeof(PAYLOAD);
+
+    ctx.GetInetLayer().SystemLayer()->Init(NULL);
+
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    SecureSessionMgr<ReplayingLoopbackTransport> conn;
+
+    err = conn.Init(kSourceNodeId, ctx.GetInetLayer().SystemLayer(), "LOOPBACK");
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    callback.mSuite = inSuite;
+
+    conn.SetDelegate(&callback);
+
+    err = conn.Connect(kDestinationNodeId, PeerAddress::UDP(addr));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    callback.ReceiveHandlerCallCount = 0;
+    callback.ReceiveErrorCallCount   = 0;
+
+    for (int i = 0; i < kMessageCount; i++)
+    {
+        chip::System::PacketBuffer * buffer = chip::System::PacketBuffer::NewWithAvailableSize(payload_len);
+        memmove(buffer->Start(), PAYLOAD, payload_len);
+        buffer->SetDataLength(payload_len);
+
+        err = conn.SendMessage(kDestinationNodeId, buffer);
+        NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    }
+
+    ctx.DriveIOUntil(1000 /* ms */, []() { return callback.ReceiveErrorCallCount == kMessageCount; });
+
+    // Each message is delivered once, and each replay is rejected
+    NL_TEST_ASSERT(inSuite, callback.ReceiveHandlerCallCount == kMessageCount);
+    NL_TEST_ASSERT(inSuite, callback.ReceiveErrorCallCount == kMessageCount);
+    NL_TEST_ASSERT(inSuite, callback.LastReceiveError == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED);
+}
+
 // Test Suite
 
 /**
@@ -173,6 +304,8 @@ const nlTest sTests[] =
 {
     NL_TEST_DEF("Simple Init Test",              CheckSimpleInitTest),
     NL_TEST_DEF("Message Self Test",             CheckMessageTest),
+    NL_TEST_DEF("Message Batch Self Test",       CheckMessageBatchTest),
+    NL_TEST_DEF("Replayed Message Test",         CheckReplayedMessageTest),
 
     NL_TEST_SENTINEL()
 };
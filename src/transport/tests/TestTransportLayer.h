@@ -29,8 +29,10 @@
 extern "C" {
 #endif
 
+int TestMessageCounterWindowFn(void);
 int TestMessageHeader(void);
 int TestPeerConnectionsFn(void);
+int TestPeerConnectionsBenchmarkFn(void);
 int TestSecurePairingSession(void);
 int TestSecureSession(void);
 int TestSecureSessionMgr(void);